@@ -0,0 +1,436 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "benchmark.hpp"
+
+#include "atmosphere_utils.hpp"
+#include "testing.hpp"
+
+#include <ekat/kokkos/ekat_subview_utils.hpp>
+
+#include <iomanip>
+
+namespace mam4 {
+
+void write_json(std::ostream &out,
+                const std::vector<BenchmarkResult> &results) {
+  out << "[" << std::endl;
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto &r = results[i];
+    out << "  {\"name\": \"" << r.name << "\", "
+        << "\"ncol\": " << r.num_columns << ", "
+        << "\"nlev\": " << r.num_levels << ", "
+        << "\"reps\": " << r.num_reps << ", " << std::setprecision(6)
+        << "\"min_seconds\": " << r.min_seconds << ", "
+        << "\"mean_seconds\": " << r.mean_seconds << ", "
+        << "\"columns_per_second\": " << r.columns_per_second << ", "
+        << "\"bytes_per_column\": " << r.bytes_per_column << "}"
+        << ((i + 1 < results.size()) ? "," : "") << std::endl;
+  }
+  out << "]" << std::endl;
+}
+
+SyntheticColumns::SyntheticColumns(const int num_columns,
+                                   const int num_levels)
+    : sfc(testing::create_surface()), progs(num_columns, num_levels),
+      tends(num_columns, num_levels), diags("diagnostics", num_columns),
+      ncol_(num_columns), nlev_(num_levels) {
+  const auto create = [=](const std::string &name, const int n) {
+    return ColumnBatchView(name, num_columns, n);
+  };
+  atm.temperature = create("T", num_levels);
+  atm.pressure = create("p", num_levels);
+  atm.vapor_mixing_ratio = create("qv", num_levels);
+  atm.liquid_mixing_ratio = create("qc", num_levels);
+  atm.cloud_liquid_number_mixing_ratio = create("nc", num_levels);
+  atm.ice_mixing_ratio = create("qi", num_levels);
+  atm.cloud_ice_number_mixing_ratio = create("ni", num_levels);
+  atm.height = create("z", num_levels);
+  atm.hydrostatic_dp = create("hdp", num_levels);
+  atm.interface_pressure = create("pint", num_levels + 1);
+  atm.cloud_fraction = create("cldfrac", num_levels);
+  atm.updraft_vel_ice_nucleation = create("w", num_levels);
+  atm.planetary_boundary_layer_height =
+      DeviceType::view_1d<Real>("pblh", num_columns);
+
+  // hydrostatic columns whose surface temperature and humidity vary
+  const Real pblh = 1000;
+  Kokkos::deep_copy(atm.planetary_boundary_layer_height, pblh);
+  for (int icol = 0; icol < num_columns; ++icol) {
+    const Real frac = (num_columns > 1) ? Real(icol) / (num_columns - 1) : 0;
+    const Real Tv0 = 280 + 20 * frac; // reference virtual temperature [K]
+    const Real qv0 = 0.005 + 0.01 * frac; // surface specific humidity
+    const Atmosphere column = init_atm_const_tv_lapse_rate(
+        num_levels, pblh, Tv0, 0.01, qv0, 7.5e-4);
+    const auto copy = [=](const ColumnBatchView &batch, const auto &view) {
+      Kokkos::deep_copy(ekat::subview(batch, icol), view);
+    };
+    copy(atm.temperature, column.temperature);
+    copy(atm.pressure, column.pressure);
+    copy(atm.vapor_mixing_ratio, column.vapor_mixing_ratio);
+    copy(atm.height, column.height);
+    copy(atm.hydrostatic_dp, column.hydrostatic_dp);
+  }
+
+  // interface pressures bracketing the midpoint pressures
+  auto p = Kokkos::create_mirror_view(atm.pressure);
+  auto hdp = Kokkos::create_mirror_view(atm.hydrostatic_dp);
+  auto pint = Kokkos::create_mirror_view(atm.interface_pressure);
+  Kokkos::deep_copy(p, atm.pressure);
+  Kokkos::deep_copy(hdp, atm.hydrostatic_dp);
+  for (int icol = 0; icol < num_columns; ++icol) {
+    for (int k = 0; k < num_levels; ++k)
+      pint(icol, k) = p(icol, k) - 0.5 * hdp(icol, k);
+    pint(icol, num_levels) =
+        p(icol, num_levels - 1) + 0.5 * hdp(icol, num_levels - 1);
+  }
+  Kokkos::deep_copy(atm.interface_pressure, pint);
+
+  // a partly cloudy atmosphere
+  Kokkos::deep_copy(atm.cloud_fraction, 0.3);
+  Kokkos::deep_copy(atm.liquid_mixing_ratio, 1.0e-5);
+  Kokkos::deep_copy(atm.cloud_liquid_number_mixing_ratio, 1.0e8);
+  Kokkos::deep_copy(atm.updraft_vel_ice_nucleation, 0.5);
+
+  // sulfate in every mode, and some sulfuric acid gas
+  const int iso4 = static_cast<int>(AeroId::SO4);
+  const int ih2so4 = static_cast<int>(GasId::H2SO4);
+  Kokkos::deep_copy(progs.q_gas[ih2so4], 5.0e-12);
+  for (int n = 0; n < AeroConfig::num_modes(); ++n) {
+    Kokkos::deep_copy(progs.n_mode_i[n], 1.0e9);
+    Kokkos::deep_copy(progs.n_mode_c[n], 1.0e8);
+    Kokkos::deep_copy(progs.q_aero_i[n][iso4], 1.0e-10);
+    Kokkos::deep_copy(progs.q_aero_c[n][iso4], 1.0e-11);
+  }
+#ifdef MAM4XX_ENABLE_NH3
+  // ammonia gas (~100 ppt) and ammonium in the modes that carry it
+  const int inh4 = static_cast<int>(AeroId::NH4);
+  const int inh3 = static_cast<int>(GasId::NH3);
+  Kokkos::deep_copy(progs.q_gas[inh3], 1.0e-10);
+  for (int n = 0; n < AeroConfig::num_modes(); ++n) {
+    if (mode_contains_species(static_cast<ModeIndex>(n), AeroId::NH4)) {
+      Kokkos::deep_copy(progs.q_aero_i[n][inh4], 5.0e-11);
+      Kokkos::deep_copy(progs.q_aero_c[n][inh4], 5.0e-12);
+    }
+  }
+#endif
+
+  // diagnostics with nominal mode sizes
+  diags_host_ = Kokkos::create_mirror_view(diags);
+  for (int icol = 0; icol < num_columns; ++icol) {
+    Diagnostics d = testing::create_diagnostics(num_levels);
+    for (int n = 0; n < AeroConfig::num_modes(); ++n) {
+      Kokkos::deep_copy(d.dry_geometric_mean_diameter_i[n],
+                        modes(n).nom_diameter);
+      Kokkos::deep_copy(d.wet_geometric_mean_diameter_i[n],
+                        modes(n).nom_diameter);
+      Kokkos::deep_copy(d.dry_geometric_mean_diameter_c[n],
+                        modes(n).nom_diameter);
+      Kokkos::deep_copy(d.wet_geometric_mean_diameter_c[n],
+                        modes(n).nom_diameter);
+      Kokkos::deep_copy(d.wet_density[n], 1770.0);
+      Kokkos::deep_copy(d.hygroscopicity[n], mam4_hyg_so4);
+    }
+    diags_host_(icol) = d;
+  }
+  Kokkos::deep_copy(diags, diags_host_);
+}
+
+Real SyntheticColumns::bytes_per_column() const {
+  const int num_prog_fields =
+      2 * AeroConfig::num_modes() +
+      2 * AeroConfig::num_modes() * AeroConfig::num_aerosol_ids() +
+      2 * AeroConfig::num_gas_ids() +
+      AeroConfig::num_gas_ids() * AeroConfig::num_modes();
+  const int num_atm_fields = 11; // excluding interface pressure
+  // atmosphere read, prognostics read and written, tendencies written
+  const Real num_values = num_atm_fields * nlev_ + (nlev_ + 1) +
+                          3 * num_prog_fields * nlev_;
+  return sizeof(Real) * num_values;
+}
+
+BenchmarkResult benchmark_setsox(const SyntheticColumns &columns,
+                                 const int num_reps) {
+  const int ncol = columns.num_columns();
+  const int nlev = columns.num_levels();
+  EKAT_REQUIRE_MSG(nlev == mam4::nlev,
+                   "setsox requires columns with mam4::nlev levels");
+  const int nspec = AeroConfig::num_gas_phase_species();
+  const int loffset = 9; // offset of the first aerosol in qin/qcw
+  const Real dt = 30.0;
+
+  const auto atm = columns.atm;
+  ColumnBatchView mbar("mbar", ncol, nlev), lwc("lwc", ncol, nlev),
+      cldnum("cldnum", ncol, nlev), xhnm("xhnm", ncol, nlev);
+  DeviceType::view_3d<Real> qcw("qcw", ncol, nspec, nlev),
+      qin("qin", ncol, nspec, nlev);
+  Kokkos::deep_copy(mbar, 28.966);  // mean molecular weight of air [g/mol]
+  Kokkos::deep_copy(lwc, 1.0e-4);   // liquid water content [kg/kg]
+  Kokkos::deep_copy(cldnum, 1.0e8); // droplet number [#/kg]
+  Kokkos::deep_copy(xhnm, 2.0e19);  // air number density [molecules/cm3]
+  Kokkos::deep_copy(qcw, 1.0e-12);
+  Kokkos::deep_copy(qin, 1.0e-10);
+
+  // qin and qcw are read and written, the other fields are read
+  const Real bytes_per_column = sizeof(Real) * nlev * (4 * nspec + 8);
+  return time_kernel(
+      "setsox", ncol, nlev, num_reps, bytes_per_column, [=]() {
+        mo_setsox::setsox_for_columns(
+            ncol, KOKKOS_LAMBDA(const ThreadTeam &team, const int icol) {
+              ColumnView qcw_col[nspec], qin_col[nspec];
+              for (int i = 0; i < nspec; ++i) {
+                qcw_col[i] = Kokkos::subview(qcw, icol, i, Kokkos::ALL());
+                qin_col[i] = Kokkos::subview(qin, icol, i, Kokkos::ALL());
+              }
+              mo_setsox::setsox(team, loffset, dt,
+                                ekat::subview(atm.pressure, icol),
+                                ekat::subview(atm.hydrostatic_dp, icol),
+                                ekat::subview(atm.temperature, icol),
+                                ekat::subview(mbar, icol),
+                                ekat::subview(lwc, icol),
+                                ekat::subview(atm.cloud_fraction, icol),
+                                ekat::subview(cldnum, icol),
+                                ekat::subview(xhnm, icol), qcw_col, qin_col);
+            });
+      });
+}
+
+BenchmarkResult benchmark_gas_chem(const SyntheticColumns &columns,
+                                   const int num_reps) {
+  using namespace gas_chemistry;
+  const int ncol = columns.num_columns();
+  const int nlev = columns.num_levels();
+  Real dt = 30.0;
+
+  // species mixing ratios [vmr], advanced in place
+  DeviceType::view_3d<Real> vmr("vmr", ncol, nlev, gas_pcnst);
+  Kokkos::deep_copy(vmr, 1.0e-10);
+
+  const Real bytes_per_column = sizeof(Real) * nlev * 2 * gas_pcnst;
+  return time_kernel(
+      "gas_chem", ncol, nlev, num_reps, bytes_per_column, [=]() {
+        imp_sol_for_columns(
+            ncol, nlev,
+            KOKKOS_LAMBDA(const ThreadTeam &team, const int icol) {
+              Kokkos::parallel_for(
+                  Kokkos::TeamThreadRange(team, nlev), [&](const int k) {
+                    Real base_sol[gas_pcnst];
+                    for (int i = 0; i < gas_pcnst; ++i)
+                      base_sol[i] = vmr(icol, k, i);
+                    Real reaction_rates[rxntot];
+                    for (int i = 0; i < rxntot; ++i)
+                      reaction_rates[i] = 1.0e-12;
+                    const Real het_rates[gas_pcnst] = {};
+                    const Real extfrc[extcnt] = {};
+                    bool factor[itermax];
+                    for (int i = 0; i < itermax; ++i)
+                      factor[i] = true;
+                    Real epsilon[clscnt4];
+                    imp_slv_inti(epsilon);
+                    Real prod_out[clscnt4], loss_out[clscnt4];
+                    Real delt = dt;
+                    imp_sol(base_sol, reaction_rates, het_rates, extfrc,
+                            delt, permute_4, clsmap_4, factor, epsilon,
+                            prod_out, loss_out);
+                    for (int i = 0; i < gas_pcnst; ++i)
+                      vmr(icol, k, i) = base_sol[i];
+                  });
+            });
+      });
+}
+
+BenchmarkResult benchmark_dropmixnuc(const SyntheticColumns &columns,
+                                     const int num_reps) {
+  using namespace ndrop;
+  const int ncol = columns.num_columns();
+  const int nlev = columns.num_levels();
+  EKAT_REQUIRE_MSG(nlev == pver,
+                   "dropmixnuc requires columns with mam4::nlev levels");
+  constexpr int ntot_amode = AeroConfig::num_modes();
+  constexpr int pcnst = aero_model::pcnst;
+  const Real dtmicro = 300.0;
+
+  int numptr_amode[ntot_amode];
+  {
+    int nspec_amode[ntot_amode];
+    int lspectype_amode[maxd_aspectype][ntot_amode];
+    int lmassptr_amode[maxd_aspectype][ntot_amode];
+    Real specdens_amode[maxd_aspectype], spechygro[maxd_aspectype];
+    int mam_idx[ntot_amode][nspec_max], mam_cnst_idx[ntot_amode][nspec_max];
+    get_e3sm_parameters(nspec_amode, lspectype_amode, lmassptr_amode,
+                        numptr_amode, specdens_amode, spechygro, mam_idx,
+                        mam_cnst_idx);
+  }
+
+  // the cloud fraction of the synthetic columns grows from cldo during the
+  // step, so that activation, mixing and the ccn calculation all take part
+  const auto atm = columns.atm;
+  ColumnBatchView rpdel("rpdel", ncol, nlev), kvh("kvh", ncol, nlev),
+      cldo("cldo", ncol, nlev), wsub("wsub", ncol, nlev);
+  {
+    auto hdp = Kokkos::create_mirror_view(atm.hydrostatic_dp);
+    auto rpdel_h = Kokkos::create_mirror_view(rpdel);
+    auto kvh_h = Kokkos::create_mirror_view(kvh);
+    Kokkos::deep_copy(hdp, atm.hydrostatic_dp);
+    for (int icol = 0; icol < ncol; ++icol) {
+      for (int k = 0; k < nlev; ++k) {
+        rpdel_h(icol, k) = 1.0 / hdp(icol, k);
+        kvh_h(icol, k) = 1.0 + 0.01 * k; // eddy diffusivity [m2/s]
+      }
+    }
+    Kokkos::deep_copy(rpdel, rpdel_h);
+    Kokkos::deep_copy(kvh, kvh_h);
+  }
+  Kokkos::deep_copy(cldo, 0.2);
+  Kokkos::deep_copy(wsub, 0.4);
+
+  // interstitial mixing ratios (number species at 1e8 #/kg), and the
+  // cloud-borne ones advanced in place
+  DeviceType::view_3d<Real> state_q("state_q", ncol, nlev, pcnst);
+  {
+    auto host = Kokkos::create_mirror_view(state_q);
+    Kokkos::deep_copy(host, 1.0e-9);
+    for (int icol = 0; icol < ncol; ++icol)
+      for (int k = 0; k < nlev; ++k)
+        for (int imode = 0; imode < ntot_amode; ++imode)
+          host(icol, k, numptr_amode[imode] - 1) = 1.0e8;
+    Kokkos::deep_copy(state_q, host);
+  }
+  DeviceType::view_3d<Real> qqcw("qqcw", ncol, ncnst_tot, nlev),
+      coltend("coltend", ncol, ncnst_tot, nlev),
+      coltend_cw("coltend_cw", ncol, ncnst_tot, nlev),
+      ptend_q("ptend_q", ncol, pcnst, nlev),
+      factnum("factnum", ncol, ntot_amode, nlev),
+      ccn("ccn", ncol, nlev, psat);
+  Kokkos::deep_copy(qqcw, 1.0e-10);
+  ColumnBatchView qcld("qcld", ncol, nlev), tendnd("tendnd", ncol, nlev),
+      ndropcol("ndropcol", ncol, nlev), ndropmix("ndropmix", ncol, nlev),
+      nsource("nsource", ncol, nlev), wtke("wtke", ncol, nlev);
+
+  const auto work_memory = dropmixnuc_work_memory(ncol);
+
+  // state_q is read, qqcw is read and written, and the other arrays are
+  // written, except for the 10 per-level inputs
+  const Real bytes_per_column =
+      sizeof(Real) * nlev *
+      (2 * pcnst + 4 * ncnst_tot + ntot_amode + psat + 16);
+  return time_kernel(
+      "dropmixnuc", ncol, nlev, num_reps, bytes_per_column, [=]() {
+        dropmixnuc_for_columns(
+            ncol, work_memory,
+            KOKKOS_LAMBDA(const ThreadTeam &team, const int icol,
+                          const View1D &work) {
+              int nspec_amode[ntot_amode];
+              int lspectype_amode[maxd_aspectype][ntot_amode];
+              int lmassptr_amode[maxd_aspectype][ntot_amode];
+              Real specdens_amode[maxd_aspectype];
+              Real spechygro[maxd_aspectype];
+              int numptr_amode[ntot_amode];
+              int mam_idx[ntot_amode][nspec_max];
+              int mam_cnst_idx[ntot_amode][nspec_max];
+              get_e3sm_parameters(nspec_amode, lspectype_amode,
+                                  lmassptr_amode, numptr_amode,
+                                  specdens_amode, spechygro, mam_idx,
+                                  mam_cnst_idx);
+              Real exp45logsig[ntot_amode], alogsig[ntot_amode],
+                  num2vol_ratio_min[ntot_amode], num2vol_ratio_max[ntot_amode];
+              Real aten = 0;
+              ndrop_init(exp45logsig, alogsig, aten, num2vol_ratio_min,
+                         num2vol_ratio_max);
+
+              ColumnView qqcw_col[ncnst_tot], coltend_col[ncnst_tot],
+                  coltend_cw_col[ncnst_tot], ptend_q_col[pcnst];
+              for (int i = 0; i < ncnst_tot; ++i) {
+                qqcw_col[i] = Kokkos::subview(qqcw, icol, i, Kokkos::ALL());
+                coltend_col[i] =
+                    Kokkos::subview(coltend, icol, i, Kokkos::ALL());
+                coltend_cw_col[i] =
+                    Kokkos::subview(coltend_cw, icol, i, Kokkos::ALL());
+              }
+              for (int i = 0; i < pcnst; ++i)
+                ptend_q_col[i] =
+                    Kokkos::subview(ptend_q, icol, i, Kokkos::ALL());
+              const View2D factnum_col = Kokkos::subview(
+                  factnum, icol, Kokkos::ALL(), Kokkos::ALL());
+              const View2D ccn_col =
+                  Kokkos::subview(ccn, icol, Kokkos::ALL(), Kokkos::ALL());
+              const ConstView2D state_q_col = Kokkos::subview(
+                  state_q, icol, Kokkos::ALL(), Kokkos::ALL());
+
+              dropmixnuc(
+                  team, dtmicro, ekat::subview(atm.temperature, icol),
+                  ekat::subview(atm.pressure, icol),
+                  ekat::subview(atm.interface_pressure, icol),
+                  ekat::subview(atm.hydrostatic_dp, icol),
+                  ekat::subview(rpdel, icol), ekat::subview(atm.height, icol),
+                  state_q_col,
+                  ekat::subview(atm.cloud_liquid_number_mixing_ratio, icol),
+                  ekat::subview(kvh, icol),
+                  ekat::subview(atm.cloud_fraction, icol), lspectype_amode,
+                  specdens_amode, spechygro, lmassptr_amode,
+                  num2vol_ratio_min, num2vol_ratio_max, numptr_amode,
+                  nspec_amode, exp45logsig, alogsig, aten, mam_idx,
+                  mam_cnst_idx, ekat::subview(qcld, icol),
+                  ekat::subview(wsub, icol), ekat::subview(cldo, icol),
+                  qqcw_col, ptend_q_col, ekat::subview(tendnd, icol),
+                  factnum_col, ekat::subview(ndropcol, icol),
+                  ekat::subview(ndropmix, icol), ekat::subview(nsource, icol),
+                  ekat::subview(wtke, icol), ccn_col, coltend_col,
+                  coltend_cw_col, work);
+            });
+      });
+}
+
+BenchmarkResult benchmark_kohler(const SyntheticColumns &columns,
+                                 const int num_reps, const bool quartic) {
+  const int ncol = columns.num_columns();
+  const int nlev = columns.num_levels();
+  const int nmodes = AeroConfig::num_modes();
+  const std::string name = quartic ? "kohler_quartic" : "kohler";
+
+  // wet radii [m] of every mode at every level
+  DeviceType::view_3d<Real> rwet("rwet", ncol, nlev, nmodes);
+
+  const Real bytes_per_column = sizeof(Real) * nlev * nmodes;
+  return time_kernel(
+      name, ncol, nlev, num_reps, bytes_per_column, [=]() {
+        MAM4XX_PROFILE_REGION(name);
+        Kokkos::parallel_for(
+            name, column_batch_team_policy(ncol, nlev),
+            KOKKOS_LAMBDA(const ThreadTeam &team) {
+              const int icol = team.league_rank();
+              Kokkos::parallel_for(
+                  Kokkos::TeamThreadRange(team, nlev), [&](const int k) {
+                    // relative humidity increasing from 30% to 95% downward
+                    const Real rh = 0.3 + 0.65 * (k + 0.5) / nlev;
+                    for (int m = 0; m < nmodes; ++m) {
+                      const Real rdry = 0.5 * modes(m).nom_diameter;
+                      const Real hygro = 0.1 + 0.2 * m;
+                      if (quartic) {
+                        // MAM4's complex-arithmetic quartic formula
+                        const Real aa = 2.0e4 * 18.0 * 76.0 / (8.3e7 * 273.0);
+                        const Real rdry_um = rdry * 1e6;
+                        const Real vol = haero::cube(rdry_um);
+                        const Real slog = haero::log(rh);
+                        Kokkos::complex<Real> cx4[4] = {};
+                        water_uptake::makoh_quartic(cx4, -aa / slog, 0.0,
+                                                    hygro * vol / slog - vol,
+                                                    aa * vol / slog);
+                        Real rwet_um = 0;
+                        int nsol = 0;
+                        water_uptake::find_real_solution(rdry_um, cx4, rwet_um,
+                                                         nsol);
+                        rwet(icol, k, m) = rwet_um * 1e-6;
+                      } else {
+                        water_uptake::modal_aero_kohler(rdry, hygro, rh,
+                                                        rwet(icol, k, m));
+                      }
+                    }
+                  });
+            });
+      });
+}
+
+} // namespace mam4
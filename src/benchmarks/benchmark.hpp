@@ -0,0 +1,159 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_BENCHMARK_HPP
+#define MAM4XX_BENCHMARK_HPP
+
+// This header defines the timing harness used by the mam4xx_benchmarks
+// executable, along with a generator of synthetic columns on which the
+// aerosol processes are run.
+
+#include <mam4xx/mam4.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mam4 {
+
+/// Timing results for a single benchmark configuration.
+struct BenchmarkResult {
+  std::string name;        // name of the benchmarked process
+  int num_columns;         // number of columns per launch
+  int num_levels;          // number of vertical levels per column
+  int num_reps;            // number of timed launches
+  Real min_seconds;        // fastest launch [s]
+  Real mean_seconds;       // mean time per launch [s]
+  Real columns_per_second; // throughput of the mean launch [1/s]
+  Real bytes_per_column;   // estimated memory traffic per column [bytes]
+};
+
+/// Times the given kernel, which processes num_columns columns each time it
+/// is called. The kernel is called once untimed to warm up, then num_reps
+/// times with a fence after each call.
+template <typename Kernel>
+BenchmarkResult time_kernel(const std::string &name, const int num_columns,
+                            const int num_levels, const int num_reps,
+                            const Real bytes_per_column, Kernel &&kernel) {
+  using clock = std::chrono::steady_clock;
+  kernel();
+  Kokkos::fence();
+
+  Real total = 0, fastest = 0;
+  for (int rep = 0; rep < num_reps; ++rep) {
+    const auto start = clock::now();
+    kernel();
+    Kokkos::fence();
+    const Real elapsed =
+        std::chrono::duration<Real>(clock::now() - start).count();
+    total += elapsed;
+    fastest = (rep == 0) ? elapsed : std::min(fastest, elapsed);
+  }
+
+  BenchmarkResult result;
+  result.name = name;
+  result.num_columns = num_columns;
+  result.num_levels = num_levels;
+  result.num_reps = num_reps;
+  result.min_seconds = fastest;
+  result.mean_seconds = total / num_reps;
+  result.columns_per_second = num_columns / result.mean_seconds;
+  result.bytes_per_column = bytes_per_column;
+  return result;
+}
+
+/// Writes the given results to the given stream as a JSON array of objects.
+void write_json(std::ostream &out, const std::vector<BenchmarkResult> &results);
+
+/// SyntheticColumns holds the state of a set of columns built from the
+/// hydrostatic profiles in atmosphere_utils.hpp, with the reference
+/// temperature and humidity varying from column to column, and with a
+/// typical aerosol population (nominal mode sizes, sulfate in every mode).
+class SyntheticColumns final {
+public:
+  SyntheticColumns(const int num_columns, const int num_levels);
+
+  int num_columns() const { return ncol_; }
+  int num_levels() const { return nlev_; }
+
+  /// Returns the estimated memory traffic per column of a process that reads
+  /// the atmospheric state and reads/writes the prognostics and tendencies.
+  /// Diagnostics are not counted, since each process uses a different subset.
+  Real bytes_per_column() const;
+
+  AtmosphereColumns atm;
+  Surface sfc;
+  PrognosticsColumns progs;
+  TendenciesColumns tends;
+  // one fully-populated Diagnostics object per column
+  DeviceType::view_1d<Diagnostics> diags;
+
+private:
+  int ncol_, nlev_;
+  // host copy of diags, which keeps the per-column views alive
+  DeviceType::view_1d<Diagnostics>::HostMirror diags_host_;
+};
+
+/// Runs the given aerosol process on all synthetic columns, one team per
+/// column, and returns its timings. The state evolves from one launch to the
+/// next, as it would in a host model. Each thread of a team gets
+/// vector_length vector lanes (see column_batch_team_policy).
+template <typename Process>
+BenchmarkResult benchmark_process(const std::string &name,
+                                  const Process &process,
+                                  const SyntheticColumns &columns,
+                                  const int num_reps,
+                                  const int vector_length = 1) {
+  const int ncol = columns.num_columns();
+  const int nlev = columns.num_levels();
+  const auto atm = columns.atm;
+  const auto sfc = columns.sfc;
+  const auto progs = columns.progs;
+  const auto tends = columns.tends;
+  const auto diags = columns.diags;
+  const Real t = 0.0, dt = 30.0;
+  return time_kernel(
+      name, ncol, nlev, num_reps, columns.bytes_per_column(), [=]() {
+        MAM4XX_PROFILE_REGION(name);
+        Kokkos::parallel_for(
+            name, column_batch_team_policy(ncol, nlev, vector_length),
+            KOKKOS_LAMBDA(const ThreadTeam &team) {
+              const int icol = team.league_rank();
+              process.compute_tendencies(team, t, dt, atm.column(icol), sfc,
+                                         progs.column(icol), diags(icol),
+                                         tends.column(icol));
+            });
+      });
+}
+
+/// Runs mo_setsox::setsox on all synthetic columns. setsox works on
+/// mam4::nlev levels, so the columns must have that many levels.
+BenchmarkResult benchmark_setsox(const SyntheticColumns &columns,
+                                 const int num_reps);
+
+/// Runs the implicit gas chemistry solver (gas_chemistry::imp_sol) at every
+/// level of all synthetic columns.
+BenchmarkResult benchmark_gas_chem(const SyntheticColumns &columns,
+                                   const int num_reps);
+
+/// Runs ndrop::dropmixnuc on all synthetic columns, with its work arrays
+/// taken from TeamWorkMemory (see ndrop::dropmixnuc_work_memory). dropmixnuc
+/// works on mam4::nlev levels, so the columns must have that many levels.
+BenchmarkResult benchmark_dropmixnuc(const SyntheticColumns &columns,
+                                     const int num_reps);
+
+/// Computes the equilibrium wet radius of every mode at every level of all
+/// synthetic columns, with water_uptake::modal_aero_kohler or (if quartic is
+/// true) with MAM4's complex-arithmetic quartic formula (makoh_quartic).
+BenchmarkResult benchmark_kohler(const SyntheticColumns &columns,
+                                 const int num_reps, const bool quartic);
+
+} // namespace mam4
+
+#endif
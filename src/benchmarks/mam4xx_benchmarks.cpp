@@ -0,0 +1,287 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "benchmark.hpp"
+#include "testing.hpp"
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+// This program times each MAM4 process on sets of synthetic columns, sweeping
+// over the number of columns and vertical levels, and writes the results as
+// JSON to stdout or to a file.
+
+// prints usage information and exits with the given status
+void usage(const int status) {
+  std::cerr << "mam4xx_benchmarks: times MAM4 processes on synthetic columns."
+            << std::endl;
+  std::cerr << "mam4xx_benchmarks: usage:" << std::endl;
+  std::cerr << "mam4xx_benchmarks [--ncol=n1,n2,...] [--nlev=n1,n2,...] "
+               "[--reps=n] [--only=name1,name2,...] [--output=file.json] "
+               "[--check-nh3] [--help]"
+            << std::endl;
+  std::cerr << "With MAM4XX_ENABLE_NH3, the ratio of the time of each "
+               "benchmark with NH3 to that with NH3 switched off is reported; "
+               "--check-nh3 exits with status 2 if one exceeds the ratio of "
+               "the tracer counts."
+            << std::endl;
+  exit(status);
+}
+
+using namespace mam4;
+
+namespace {
+
+// splits a comma-separated list of values
+template <typename T> std::vector<T> parse_list(const std::string &list) {
+  std::vector<T> values;
+  std::istringstream ss(list);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    std::istringstream is(item);
+    T value;
+    is >> value;
+    values.push_back(value);
+  }
+  return values;
+}
+
+// a named benchmark, and whether it only supports mam4::nlev levels
+struct Benchmark {
+  std::string name;
+  bool fixed_nlev;
+  std::function<BenchmarkResult(const SyntheticColumns &, int)> run;
+};
+
+template <typename Process>
+Benchmark process_benchmark(const std::string &name,
+                            const bool fixed_nlev = false) {
+  return {name, fixed_nlev,
+          [name](const SyntheticColumns &columns, const int num_reps) {
+            AeroConfig aero_config;
+            Process process(aero_config);
+            return benchmark_process(name, process, columns, num_reps);
+          }};
+}
+
+// a benchmark of a process with a non-default configuration, launched with
+// the given number of vector lanes per thread
+template <typename Process, typename Config>
+Benchmark configured_benchmark(const std::string &name, const Config &config,
+                               const int vector_length = 1) {
+  return {name, false,
+          [name, config, vector_length](const SyntheticColumns &columns,
+                                        const int num_reps) {
+            AeroConfig aero_config;
+            Process process(aero_config, config);
+            return benchmark_process(name, process, columns, num_reps,
+                                     vector_length);
+          }};
+}
+
+// coagulation with the pairs and species of each level on vector lanes
+Coagulation::Config coagulation_vector_lanes() {
+  Coagulation::Config config;
+  config.use_vector_lanes = true;
+  return config;
+}
+
+#ifdef MAM4XX_ENABLE_NH3
+// configurations that switch NH3 off (or ternary nucleation on) at run time,
+// so that the cost of carrying NH3 can be compared within one build
+GasAerExch::Config gasaerexch_without_nh3() {
+  GasAerExch::Config config;
+  config.igas_nh3 = false;
+  return config;
+}
+
+Nucleation::Config nucleation_ternary(const bool do_nh3) {
+  Nucleation::Config config;
+  config.newnuc_method_user_choice = 3;
+  config.do_nh3 = do_nh3;
+  return config;
+}
+
+Microphysics::Config microphysics_ternary(const bool do_nh3) {
+  Microphysics::Config config;
+  config.gasaerexch.igas_nh3 = do_nh3;
+  config.nucleation = nucleation_ternary(do_nh3);
+  return config;
+}
+
+// returns the ratio of the number of tracers per level (gases, and the
+// interstitial and cloud-borne mode species and numbers) with NH3 and NH4 to
+// that without them. Carrying NH3 should cost no more than this proportional
+// increase in column time.
+Real nh3_tracer_ratio() {
+  const int inh4 = static_cast<int>(AeroId::NH4);
+  int num_tracers = AeroConfig::num_gas_ids(), num_nh3_tracers = 1;
+  for (int m = 0; m < AeroConfig::num_modes(); ++m) {
+    num_tracers += 2 * (AeroConfig::num_species_in_mode(m) + 1);
+    for (int s = 0; s < AeroConfig::num_species_in_mode(m); ++s)
+      if (AeroConfig::mode_species(m, s) == inh4)
+        num_nh3_tracers += 2;
+  }
+  return Real(num_tracers) / (num_tracers - num_nh3_tracers);
+}
+
+// reports the ratio of the mean time of each benchmark with NH3 to that of
+// its counterpart with NH3 switched off at run time, for every number of
+// columns and levels, against nh3_tracer_ratio(). Returns the number of
+// ratios that exceed it.
+int report_nh3_cost(std::ostream &out,
+                    const std::vector<BenchmarkResult> &results) {
+  const Real budget = nh3_tracer_ratio();
+  int num_over = 0;
+  for (const auto &with : results) {
+    for (const auto &without : results) {
+      if (without.name != with.name + "_no_nh3" ||
+          without.num_columns != with.num_columns ||
+          without.num_levels != with.num_levels)
+        continue;
+      const Real ratio = with.mean_seconds / without.mean_seconds;
+      const bool over = ratio > budget;
+      out << "mam4xx_benchmarks: NH3 cost of " << with.name
+          << " (ncol = " << with.num_columns << ", nlev = " << with.num_levels
+          << "): " << ratio << " (tracer ratio " << budget << ")"
+          << (over ? " exceeds the tracer ratio" : "") << std::endl;
+      if (over)
+        ++num_over;
+    }
+  }
+  return num_over;
+}
+#endif
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<int> ncols = {1, 64, 1024};
+  std::vector<int> nlevs = {mam4::nlev};
+  std::vector<std::string> only;
+  int num_reps = 10;
+  std::string output_file;
+  bool check_nh3 = false;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto eq = arg.find('=');
+    const std::string key = arg.substr(0, eq);
+    const std::string value =
+        (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+    if (key == "--ncol") {
+      ncols = parse_list<int>(value);
+    } else if (key == "--nlev") {
+      nlevs = parse_list<int>(value);
+    } else if (key == "--reps") {
+      num_reps = std::stoi(value);
+    } else if (key == "--only") {
+      only = parse_list<std::string>(value);
+    } else if (key == "--output") {
+      output_file = value;
+    } else if (key == "--check-nh3") {
+      check_nh3 = true;
+    } else if (key == "--help") {
+      usage(0);
+    } else {
+      std::cerr << "mam4xx_benchmarks: unknown argument: " << arg << std::endl;
+      usage(1);
+    }
+  }
+
+  const std::vector<Benchmark> benchmarks = {
+      process_benchmark<NucleationProcess>("nucleation"),
+      process_benchmark<CoagulationProcess>("coagulation"),
+      configured_benchmark<CoagulationProcess>(
+          "coagulation_vector", coagulation_vector_lanes(),
+          Coagulation::max_coagpair),
+      process_benchmark<GasAerExchProcess>("gasaerexch"),
+      process_benchmark<AgingProcess>("aging"),
+      process_benchmark<RenameProcess>("rename"),
+      process_benchmark<CalcSizeProcess>("calcsize"),
+      process_benchmark<WaterUptakeProcess>("water_uptake"),
+      process_benchmark<DryDepositionProcess>("drydep", true),
+      process_benchmark<WetDepositionProcess>("wetdep", true),
+      process_benchmark<ConvProcProcess>("convproc", true),
+      process_benchmark<HetfrzProcess>("hetfrz"),
+      process_benchmark<NucleateIceProcess>("nucleate_ice"),
+      process_benchmark<MicrophysicsProcess>("microphysics"),
+#ifdef MAM4XX_ENABLE_NH3
+      configured_benchmark<GasAerExchProcess>("gasaerexch_no_nh3",
+                                              gasaerexch_without_nh3()),
+      configured_benchmark<NucleationProcess>("nucleation_ternary",
+                                              nucleation_ternary(true)),
+      configured_benchmark<NucleationProcess>("nucleation_ternary_no_nh3",
+                                              nucleation_ternary(false)),
+      configured_benchmark<MicrophysicsProcess>("microphysics_ternary",
+                                                microphysics_ternary(true)),
+      configured_benchmark<MicrophysicsProcess>("microphysics_ternary_no_nh3",
+                                                microphysics_ternary(false)),
+#endif
+      {"mo_setsox", true, benchmark_setsox},
+      {"gas_chem", false, benchmark_gas_chem},
+      {"dropmixnuc", true, benchmark_dropmixnuc},
+      {"kohler", false,
+       [](const SyntheticColumns &columns, const int num_reps) {
+         return benchmark_kohler(columns, num_reps, false);
+       }},
+      {"kohler_quartic", false,
+       [](const SyntheticColumns &columns, const int num_reps) {
+         return benchmark_kohler(columns, num_reps, true);
+       }},
+  };
+
+  Kokkos::initialize(argc, argv);
+  std::vector<BenchmarkResult> results;
+  {
+    for (const int nlev : nlevs) {
+      for (const int ncol : ncols) {
+        SyntheticColumns columns(ncol, nlev);
+        for (const auto &benchmark : benchmarks) {
+          if (!only.empty() && std::find(only.begin(), only.end(),
+                                         benchmark.name) == only.end())
+            continue;
+          if (benchmark.fixed_nlev && (nlev != mam4::nlev)) {
+            std::cerr << "mam4xx_benchmarks: skipping " << benchmark.name
+                      << " (requires nlev = " << mam4::nlev << ")"
+                      << std::endl;
+            continue;
+          }
+          std::cerr << "mam4xx_benchmarks: " << benchmark.name
+                    << " (ncol = " << ncol << ", nlev = " << nlev << ")"
+                    << std::endl;
+          results.push_back(benchmark.run(columns, num_reps));
+        }
+      }
+    }
+  }
+
+  if (output_file.empty()) {
+    write_json(std::cout, results);
+  } else {
+    std::ofstream out(output_file);
+    write_json(out, results);
+  }
+
+#ifdef MAM4XX_ENABLE_PROFILING
+  TimerRegistry::instance().report(std::cerr);
+#endif
+
+  int status = 0;
+#ifdef MAM4XX_ENABLE_NH3
+  if (report_nh3_cost(std::cerr, results) > 0 && check_nh3)
+    status = 2;
+#else
+  if (check_nh3)
+    std::cerr << "mam4xx_benchmarks: --check-nh3 has no effect without "
+                 "MAM4XX_ENABLE_NH3"
+              << std::endl;
+#endif
+
+  testing::finalize();
+  Kokkos::finalize();
+  return status;
+}
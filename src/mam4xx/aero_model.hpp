@@ -33,8 +33,8 @@ KOKKOS_INLINE_FUNCTION
 void modal_aero_bcscavcoef_get(
     const int imode, const bool isprx_kk, const Real dgn_awet_imode_kk, //& ! in
     const Real dgnum_amode_imode,
-    const Real scavimptblvol[nimptblgrow_total][AeroConfig::num_modes()],
-    const Real scavimptblnum[nimptblgrow_total][AeroConfig::num_modes()],
+    const TableReal scavimptblvol[nimptblgrow_total][AeroConfig::num_modes()],
+    const TableReal scavimptblnum[nimptblgrow_total][AeroConfig::num_modes()],
     Real &scavcoefnum_kk, Real &scavcoefvol_kk) {
 
   // !-----------------------------------------------------------------------
@@ -551,8 +551,8 @@ void modal_aero_bcscavcoef_init(
     const Real dgnum_amode[AeroConfig::num_modes()],
     const Real sigmag_amode[AeroConfig::num_modes()],
     const Real aerosol_dry_density[AeroConfig::num_modes()],
-    Real scavimptblnum[nimptblgrow_total][AeroConfig::num_modes()],
-    Real scavimptblvol[nimptblgrow_total][AeroConfig::num_modes()]) {
+    TableReal scavimptblnum[nimptblgrow_total][AeroConfig::num_modes()],
+    TableReal scavimptblvol[nimptblgrow_total][AeroConfig::num_modes()]) {
   // -----------------------------------------------------------------------
   //
   //  Purpose:
@@ -56,6 +56,11 @@ std::string aero_id_str(const AeroId aid) {
   case (AeroId::MOM): {
     return "marine_organic_matter";
   }
+#ifdef MAM4XX_ENABLE_NH3
+  case (AeroId::NH4): {
+    return "ammonium";
+  }
+#endif
   case (AeroId::None): {
     return "none";
   }
@@ -87,6 +92,11 @@ std::string aero_id_short_name(const AeroId aid) {
   case (AeroId::MOM): {
     return "mom";
   }
+#ifdef MAM4XX_ENABLE_NH3
+  case (AeroId::NH4): {
+    return "nh4";
+  }
+#endif
   case (AeroId::None): {
     return "none";
   }
@@ -12,6 +12,7 @@
 #include <haero/math.hpp>
 
 #include "mam4_types.hpp"
+#include <mam4xx/species_config.hpp>
 
 #include <iostream>
 #include <string>
@@ -135,7 +136,12 @@ enum class AeroId {
   NaCl = 4, // sodium chloride
   DST = 5,  // dust
   MOM = 6,  // marine organic matter,
+#ifdef MAM4XX_ENABLE_NH3
+  NH4 = 7,  // ammonium
+  None = 8  // invalid aerosol species
+#else
   None = 7  // invalid aerosol species
+#endif
 };
 
 /// Map ModeIndex to string (for logging, e.g.)
@@ -155,6 +161,9 @@ static constexpr Real mam4_molec_weight_dst = 0.135065;
 /// Molecular weight of mam4 marine organic matter [kg/mol]
 static constexpr Real mam4_molec_weight_mom = 250.093;
 
+/// Molecular weight of mam4 ammonium [kg/mol]
+static constexpr Real mam4_molec_weight_nh4 = 0.018;
+
 /// mam4 aerosol densities [kg/m3]
 static constexpr Real mam4_density_soa = 1000.0;
 static constexpr Real mam4_density_so4 = 1770.0;
@@ -163,6 +172,7 @@ static constexpr Real mam4_density_bc = 1700.0;
 static constexpr Real mam4_density_nacl = 1900.0;
 static constexpr Real mam4_density_dst = 2600.0;
 static constexpr Real mam4_density_mom = 1601.0;
+static constexpr Real mam4_density_nh4 = 1770.0;
 
 /// mam4 aerosol hygroscopicities
 static constexpr Real mam4_hyg_soa = 0.1;
@@ -172,6 +182,7 @@ static constexpr Real mam4_hyg_bc = 1e-10;
 static constexpr Real mam4_hyg_nacl = 1.16;
 static constexpr Real mam4_hyg_dst = 0.14;
 static constexpr Real mam4_hyg_mom = 0.1;
+static constexpr Real mam4_hyg_nh4 = 0.507;
 
 /// A list of aerosol species in MAM4.
 /**
@@ -196,7 +207,7 @@ static constexpr Real mam4_hyg_mom = 0.1;
   here as mam4_* constants.
 */
 KOKKOS_INLINE_FUNCTION AeroSpecies aero_species(const int i) {
-  static const AeroSpecies species[7] = {
+  static const AeroSpecies species[static_cast<int>(AeroId::None)] = {
       AeroSpecies{Constants::molec_weight_c, mam4_density_soa,
                   mam4_hyg_soa}, // secondary organic aerosol
       AeroSpecies{Constants::molec_weight_so4, mam4_density_so4, mam4_hyg_so4},
@@ -210,13 +221,27 @@ KOKKOS_INLINE_FUNCTION AeroSpecies aero_species(const int i) {
                   mam4_hyg_dst}, // dust
       AeroSpecies{mam4_molec_weight_mom, mam4_density_mom,
                   mam4_hyg_mom} // marine organic matter
+#ifdef MAM4XX_ENABLE_NH3
+      ,
+      AeroSpecies{mam4_molec_weight_nh4, mam4_density_nh4,
+                  mam4_hyg_nh4} // ammonium
+#endif
   };
   return species[i];
 }
 
-// A list of species within each mode for MAM4.
+// A list of species within each mode for MAM4. Ammonium (if enabled) is not
+// one of the num_species_mode(m) species of the E3SM tracer layout: it
+// occupies the last slot of the modes that carry sulphate (see
+// aerosol_index_for_mode).
 KOKKOS_INLINE_FUNCTION AeroId mode_aero_species(const int modeNo,
                                                 const int speciesNo) {
+#ifdef MAM4XX_ENABLE_NH3
+  if (speciesNo == static_cast<int>(AeroId::NH4))
+    return (modeNo != static_cast<int>(ModeIndex::PrimaryCarbon))
+               ? AeroId::NH4
+               : AeroId::None;
+#endif
   // A list of species within each mode for MAM4.
   static constexpr AeroId mode_aero_species[4][7] = {
       {// accumulation mode
@@ -251,7 +276,7 @@ KOKKOS_INLINE_FUNCTION int num_species_mode(const int i) {
 KOKKOS_INLINE_FUNCTION
 int aerosol_index_for_mode(ModeIndex mode, AeroId aero_id) {
   int mode_index = static_cast<int>(mode);
-  for (int s = 0; s < 7; ++s) {
+  for (int s = 0; s < static_cast<int>(AeroId::None); ++s) {
     if (aero_id == mode_aero_species(mode_index, s)) {
       return s;
     }
@@ -273,7 +298,12 @@ enum class GasId {
   SO2 = 3,   // sulfur dioxide
   DMS = 4,   // dimethyl sulfide
   SOAG = 5,  // secondary organic aerosol precursor
+#ifdef MAM4XX_ENABLE_NH3
+  NH3 = 6,   // ammonia
+  None = 7,  // invalid gas id
+#else
   None = 6,  // invalid gas id
+#endif
 };
 
 /// Molecular weight of carbon dioxide [kg/mol]
@@ -306,13 +336,18 @@ KOKKOS_INLINE_FUNCTION GasSpecies gas_species(const int i) {
       {molec_weight_so2},              // sulfur dioxide
       {molec_weight_dms},              // dimethylsulfide
       {Constants::molec_weight_c},     // secondary organic aerosol precursor
+#ifdef MAM4XX_ENABLE_NH3
+      {Constants::molec_weight_nh3},   // ammonia
+#endif
       {molec_weight_o2},               // oxygen
       {molec_weight_co2},              // carbon dioxide
       {molec_weight_n2o},              // nitrous oxide
       {molec_weight_ch4},              // methane
       {molec_weight_ccl3f},            // thrichlorofluoromethane
       {molec_weight_chcl2f},           // dichlorofluoromethane
+#ifndef MAM4XX_ENABLE_NH3
       {Constants::molec_weight_nh3}    // ammonia
+#endif
   };
   return species[i];
 }
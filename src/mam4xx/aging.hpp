@@ -121,10 +121,24 @@ void mam_pcarbon_aging_frac(
       qaer_del_cond[iaer_so4][imom_pc] * so4_vol +
       qaer_del_cond[iaer_soa][imom_pc] * fac_m2v_eqvhyg_aer;
 
-  const Real qaer_del_coag_tmp =
+  Real qaer_del_coag_tmp =
       qaer_del_coag_in[iaer_so4][ipair] * so4_vol +
       qaer_del_coag_in[iaer_soa][ipair] * fac_m2v_eqvhyg_aer;
 
+  // for default MAM4 only so4 and soa contribute to aging
+  Real vol_shell = qaer_cur[iaer_so4][imom_pc] * so4_vol +
+                   qaer_cur[iaer_soa][imom_pc] * fac_m2v_eqvhyg_aer;
+
+#ifdef MAM4XX_ENABLE_NH3
+  // nh4 (as hygroscopic as so4) also coats the primary carbon core
+  const int iaer_nh4 = static_cast<int>(AeroId::NH4);
+  const Real nh4_vol = aero_species(iaer_nh4).molecular_weight * 1000.0 /
+                       aero_species(iaer_nh4).density;
+  qaer_del_cond_tmp += qaer_del_cond[iaer_nh4][imom_pc] * nh4_vol;
+  qaer_del_coag_tmp += qaer_del_coag_in[iaer_nh4][ipair] * nh4_vol;
+  vol_shell += qaer_cur[iaer_nh4][imom_pc] * nh4_vol;
+#endif
+
   qaer_del_cond_tmp = haero::max(qaer_del_cond_tmp, 1e-35);
 
   frac_cond = qaer_del_cond_tmp /
@@ -132,10 +146,6 @@ void mam_pcarbon_aging_frac(
 
   frac_coag = 1.0 - frac_cond;
 
-  // for default MAM4 only so4 and soa contribute to aging
-  const Real vol_shell = qaer_cur[iaer_so4][imom_pc] * so4_vol +
-                         qaer_cur[iaer_soa][imom_pc] * fac_m2v_eqvhyg_aer;
-
   const int spec_modes[3] = {iaer_bc, iaer_pom, iaer_mom};
   const Real core_volumes[3] = {bc_vol, pom_vol, mom_vol};
   Real vol_core = 0.0;
@@ -257,8 +267,8 @@ void mam_pcarbon_aging_1subarea(
 
   Real xferfrac_pcage, frac_cond, frac_coag;
 
-  const int nsrc = static_cast<int>(ModeIndex::PrimaryCarbon);
-  const int ndest = static_cast<int>(ModeIndex::Accumulation);
+  constexpr int nsrc = static_cast<int>(ModeIndex::PrimaryCarbon);
+  constexpr int ndest = static_cast<int>(ModeIndex::Accumulation);
 
   mam_pcarbon_aging_frac(dgn_a, qaer_cur, qaer_del_cond, qaer_del_coag_in,
                          xferfrac_pcage, frac_cond, frac_coag);
@@ -270,16 +280,23 @@ void mam_pcarbon_aging_1subarea(
   //  include this transfer change in the cond and/or coag change (for mass
   //  budget)
 
-  static constexpr int num_pcarbon_to_accum = 3;
-  static constexpr int num_cond_coag_to_accum = 4;
+  // the species transferred by aging are those of the pcarbon mode (pom, bc,
+  // mom), taken from the compile-time species table of AeroConfig
+  constexpr int num_pcarbon_to_accum = AeroConfig::num_species_in_mode(nsrc);
+#ifdef MAM4XX_ENABLE_NH3
+  static constexpr int num_cond_coag_to_accum = 5;
 
-  static constexpr int indx_aer_pcarbon_to_accum[num_pcarbon_to_accum] = {
-      static_cast<int>(AeroId::POM), static_cast<int>(AeroId::BC),
-      static_cast<int>(AeroId::MOM)};
+  static constexpr int indx_aer_cond_coag_to_accum[num_cond_coag_to_accum] = {
+      static_cast<int>(AeroId::SOA), static_cast<int>(AeroId::SO4),
+      static_cast<int>(AeroId::NaCl), static_cast<int>(AeroId::DST),
+      static_cast<int>(AeroId::NH4)};
+#else
+  static constexpr int num_cond_coag_to_accum = 4;
 
   static constexpr int indx_aer_cond_coag_to_accum[num_cond_coag_to_accum] = {
       static_cast<int>(AeroId::SOA), static_cast<int>(AeroId::SO4),
       static_cast<int>(AeroId::NaCl), static_cast<int>(AeroId::DST)};
+#endif
 
   Real qaer_cur_modes[AeroConfig::num_modes()];
   Real qaer_del_cond_modes[AeroConfig::num_modes()];
@@ -287,7 +304,7 @@ void mam_pcarbon_aging_1subarea(
 
   for (int a = 0; a < num_pcarbon_to_accum; ++a) {
 
-    const int ispec = indx_aer_pcarbon_to_accum[a];
+    const int ispec = AeroConfig::mode_species(nsrc, a);
 
     // Pack mode information per aerosol
     for (int imode = 0; imode < AeroConfig::num_modes(); imode++) {
@@ -23,11 +23,225 @@ using haero::sqrt;
 
 namespace calcsize {
 
+/*-----------------------------------------------------------------------------
+Per-mode constants of the calcsize engine (calcsize_1level). They depend only
+on the mode and species definitions, so they are computed once (by init) and
+shared by all levels and columns, whatever the storage of the aerosol state.
+ -----------------------------------------------------------------------------*/
+struct CalcSizeData {
+  static constexpr int nmodes = AeroConfig::num_modes();
+  static constexpr int naero = AeroConfig::num_aerosol_ids();
+
+  // number-to-volume ratios computed with the max, min and nominal diameters
+  Real num2vol_ratio_min_nmodes[nmodes] = {};
+  Real num2vol_ratio_max_nmodes[nmodes] = {};
+  Real num2vol_ratio_nom_nmodes[nmodes] = {};
+  // min, max and nominal geometric number diameters [m]
+  Real dgnmin_nmodes[nmodes] = {};
+  Real dgnmax_nmodes[nmodes] = {};
+  Real dgnnom_nmodes[nmodes] = {};
+  Real mean_std_dev_nmodes[nmodes] = {};
+  // inverse of the species densities [m3/kg]
+  Real inv_density[nmodes][naero] = {};
+  // bounds of the number adjustment (adjust_num_sizes)
+  Real num2vol_ratio_min[nmodes] = {};
+  Real num2vol_ratio_max[nmodes] = {};
+  // bounds of the diameter update that follows the number adjustment (see
+  // set_size_bounds)
+  Real num2vol_ratio_min_sz[nmodes] = {};
+  Real num2vol_ratio_max_sz[nmodes] = {};
+  // number-to-volume ratio of the accumulation species that cannot be moved
+  // to the aitken mode
+  Real num2vol_ratio_noxf = 0;
+
+  // true: accumulation species cannot be transferred to the aitken mode
+  bool noxf_acc2ait[naero] = {};
+  // number of common species between accum and aitken modes
+  int n_common_species_ait_accum = 0;
+  // index (within the aitken mode) of the aitken species in accum mode
+  int ait_spec_in_acc[naero] = {};
+  // index (within the accumulation mode) of the accum species in aitken mode
+  int acc_spec_in_ait[naero] = {};
+
+  // Sets the bounds derived from num2vol_ratio_*_nmodes. With e3sm_bounds,
+  // these follow modal_aero_calcsize_sub in E3SM: the diameter update does
+  // not limit the size of large aitken or small accumulation particles (those
+  // are moved by the aitken<->accumulation transfer instead), and the
+  // non-transferable accumulation species are counted with the ratio of the
+  // min diameter. Otherwise the diameter update uses the plain bounds and the
+  // non-transferable species use the ratio of the max diameter, as CalcSize
+  // always has.
+  KOKKOS_INLINE_FUNCTION
+  void set_size_bounds(const bool e3sm_bounds) {
+    const int aitken_idx = int(ModeIndex::Aitken);
+    const int accum_idx = int(ModeIndex::Accumulation);
+    // BAD CONSTANT
+    constexpr Real szadj_block_fac = 1.0e6;
+    for (int m = 0; m < nmodes; ++m) {
+      num2vol_ratio_min_sz[m] = num2vol_ratio_min[m];
+      num2vol_ratio_max_sz[m] = num2vol_ratio_max[m];
+    }
+    if (e3sm_bounds) {
+      num2vol_ratio_min_sz[aitken_idx] /= szadj_block_fac;
+      num2vol_ratio_max_sz[accum_idx] *= szadj_block_fac;
+      num2vol_ratio_noxf = num2vol_ratio_max_nmodes[accum_idx];
+    } else {
+      num2vol_ratio_noxf = num2vol_ratio_min_nmodes[accum_idx];
+    }
+  }
+
+  // Computes all the constants from the mode and species definitions.
+  KOKKOS_INLINE_FUNCTION
+  void init(const bool e3sm_bounds) {
+    const Real one = 1.0;
+
+    // find aerosol species in accumulation that can be transfer to aitken mode
+    const int accum_idx = int(ModeIndex::Accumulation);
+    const int aitken_idx = int(ModeIndex::Aitken);
+
+    // check if accumulation species exists in aitken mode
+    // also save idx for transfer
+    int count = 0;
+    for (int isp = 0; isp < num_species_mode(accum_idx); ++isp) {
+      // assume species can not be transfer.
+      noxf_acc2ait[isp] = true;
+      AeroId sp_accum = mode_aero_species(accum_idx, isp);
+
+      for (int jsp = 0; jsp < num_species_mode(aitken_idx); ++jsp) {
+        AeroId sp_aitken = mode_aero_species(aitken_idx, jsp);
+        if (sp_accum == sp_aitken) {
+          // false : can be transfer.
+          noxf_acc2ait[isp] = false;
+          // save index for transfer from accumulation to aitken mode
+          acc_spec_in_ait[count] = isp;
+          // save index for transfer from aitken to accumulation mode
+          ait_spec_in_acc[count] = jsp;
+          count++;
+          break;
+        }
+      } // end aitken foor
+    }   // end accumulation for
+    n_common_species_ait_accum = count;
+
+    // Set mode parameters.
+    for (int m = 0; m < nmodes; ++m) {
+      // FIXME: There is a comment in modal_aero_newnuc.F90 that Dick Easter
+      // FIXME: thinks that dgnum_aer isn't used in MAM4, but it is actually
+      // FIXME: used in this nucleation parameterization. So we will have to
+      // FIXME: figure this out.
+      dgnnom_nmodes[m] = modes(m).nom_diameter;
+      dgnmin_nmodes[m] = modes(m).min_diameter;
+      dgnmax_nmodes[m] = modes(m).max_diameter;
+      mean_std_dev_nmodes[m] = modes(m).mean_std_dev;
+      num2vol_ratio_nom_nmodes[m] =
+          one / conversions::mean_particle_volume_from_diameter(
+                    dgnnom_nmodes[m], modes(m).mean_std_dev);
+      num2vol_ratio_min_nmodes[m] =
+          one / conversions::mean_particle_volume_from_diameter(
+                    dgnmax_nmodes[m], modes(m).mean_std_dev);
+      num2vol_ratio_max_nmodes[m] =
+          one / conversions::mean_particle_volume_from_diameter(
+                    dgnmin_nmodes[m], modes(m).mean_std_dev);
+
+      // compute inv density; density is constant, so we can compute in init.
+      const auto n_spec = num_species_mode(m);
+      for (int ispec = 0; ispec < n_spec; ispec++) {
+        const int aero_id = int(mode_aero_species(m, ispec));
+        inv_density[m][ispec] = Real(1.0) / aero_species(aero_id).density;
+      } // for(ispec)
+      // FIXME: do we need to update num2vol_ratio_min_nmodes and
+      // num2vol_ratio_max_nmodes as well?
+      num2vol_ratio_min[m] = num2vol_ratio_min_nmodes[m];
+      num2vol_ratio_max[m] = num2vol_ratio_max_nmodes[m];
+    } // for(m)
+
+    set_size_bounds(e3sm_bounds);
+  } // end(init)
+};
+
+/*-----------------------------------------------------------------------------
+Storage accessors of the calcsize engine. An accessor gives the engine the
+mass and number mixing ratios of one level (q_i, q_c, n_i, n_c), their
+tendencies (dqdt_i, dqdt_c, dndt_i, dndt_c) and the dry diameters
+(dgncur_i, dgncur_c), indexed by mode and by species within the mode, so the
+same engine runs on any storage without copying the state.
+
+PrognosticsAccessor reads level k of the Prognostics column views, and writes
+Tendencies and Diagnostics (modal_aero_calcsize::StateQAccessor does the same
+for E3SM state_q/qqcw rows).
+ -----------------------------------------------------------------------------*/
+struct PrognosticsAccessor {
+  const Prognostics *prognostics;
+  const Diagnostics *diagnostics; // may be null if no diameter is written
+  const Tendencies *tendencies;   // may be null if no tendency is written
+  int k;
+
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsAccessor(const Prognostics &progs, const Diagnostics *diags,
+                      const Tendencies *tends, const int klev)
+      : prognostics(&progs), diagnostics(diags), tendencies(tends), k(klev) {}
+
+  KOKKOS_INLINE_FUNCTION
+  Real q_i(const int imode, const int ispec) const {
+    return prognostics->q_aero_i[imode][ispec](k);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real q_c(const int imode, const int ispec) const {
+    return prognostics->q_aero_c[imode][ispec](k);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real n_i(const int imode) const { return prognostics->n_mode_i[imode](k); }
+  KOKKOS_INLINE_FUNCTION
+  Real n_c(const int imode) const { return prognostics->n_mode_c[imode](k); }
+
+  KOKKOS_INLINE_FUNCTION
+  Real &dqdt_i(const int imode, const int ispec) const {
+    return tendencies->q_aero_i[imode][ispec](k);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real &dqdt_c(const int imode, const int ispec) const {
+    return tendencies->q_aero_c[imode][ispec](k);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real &dndt_i(const int imode) const { return tendencies->n_mode_i[imode](k); }
+  KOKKOS_INLINE_FUNCTION
+  Real &dndt_c(const int imode) const { return tendencies->n_mode_c[imode](k); }
+
+  KOKKOS_INLINE_FUNCTION
+  Real &dgncur_i(const int imode) const {
+    return diagnostics->dry_geometric_mean_diameter_i[imode](k);
+  }
+  KOKKOS_INLINE_FUNCTION
+  Real &dgncur_c(const int imode) const {
+    return diagnostics->dry_geometric_mean_diameter_c[imode](k);
+  }
+};
+
 /*-----------------------------------------------------------------------------
 Compute initial dry volume based on bulk mass mixing ratio (mmr) and species
 density  volume = mmr/density
  -----------------------------------------------------------------------------*/
+template <typename Accessor>
+KOKKOS_INLINE_FUNCTION void
+compute_dry_volume(const int imode, // in
+                   const Real inv_density[AeroConfig::num_modes()]
+                                         [AeroConfig::num_aerosol_ids()],
+                   const Accessor &q, // in
+                   Real &dryvol_i,    // out
+                   Real &dryvol_c)    // out
+{
+  const Real zero = 0;
+  dryvol_i = zero;
+  dryvol_c = zero;
+  const auto n_spec = num_species_mode(imode);
+  for (int ispec = 0; ispec < n_spec; ispec++) {
+    dryvol_i += max(zero, q.q_i(imode, ispec)) * inv_density[imode][ispec];
+    dryvol_c += max(zero, q.q_c(imode, ispec)) * inv_density[imode][ispec];
+  } // end ispec
 
+} // end
+
+// compute_dry_volume for level k of Prognostics
 KOKKOS_INLINE_FUNCTION
 void compute_dry_volume_k(int k, int imode,
                           const Real inv_density[AeroConfig::num_modes()]
@@ -36,16 +250,9 @@ void compute_dry_volume_k(int k, int imode,
                           Real &dryvol_i,                 // out
                           Real &dryvol_c)                 // out
 {
-  const auto q_i = prognostics.q_aero_i;
-  const auto q_c = prognostics.q_aero_c;
-  dryvol_i = 0;
-  dryvol_c = 0;
-  const auto n_spec = num_species_mode(imode);
-  for (int ispec = 0; ispec < n_spec; ispec++) {
-    dryvol_i += max(0.0, q_i[imode][ispec](k)) * inv_density[imode][ispec];
-    dryvol_c += max(0.0, q_c[imode][ispec](k)) * inv_density[imode][ispec];
-  } // end ispec
-
+  // only the mixing ratios are read
+  const PrognosticsAccessor q(prognostics, nullptr, nullptr, k);
+  compute_dry_volume(imode, inv_density, q, dryvol_i, dryvol_c);
 } // end
 
 /*----------------------------------------------------------------------------
@@ -378,23 +585,18 @@ void compute_coef_ait_acc_transfer(const int iacc,                   // in
 
 } // end compute_coef_ait_acc_transfer
 
-KOKKOS_INLINE_FUNCTION
-void compute_coef_acc_ait_transfer(
-    int iacc, int klev, const Real num2vol_ratio_geomean,
-    const Real adj_tscale_inv, const Prognostics &prognostics,
+template <typename Accessor>
+KOKKOS_INLINE_FUNCTION void compute_coef_acc_ait_transfer(
+    const CalcSizeData &data, const Accessor &q,
+    const Real num2vol_ratio_geomean, const Real adj_tscale_inv,
     const Real drv_i_accsv, const Real drv_c_accsv, const Real num_i_accsv,
-    const Real num_c_accsv,
-    const bool noxf_acc2ait[AeroConfig::num_aerosol_ids()],
-    const Real voltonum_ait,
-    const Real inv_density[AeroConfig::num_modes()]
-                          [AeroConfig::num_aerosol_ids()],
-    const Real num2vol_ratio_min_nmodes[AeroConfig::num_modes()],
-    Real &drv_i_noxf, Real &drv_c_noxf, int &acc2_ait_index,
-    Real &xfercoef_num_acc2ait, Real &xfercoef_vol_acc2ait,
-    Real xfertend_num[2][2]) {
+    const Real num_c_accsv, const Real voltonum_ait, Real &drv_i_noxf,
+    Real &drv_c_noxf, int &acc2_ait_index, Real &xfercoef_num_acc2ait,
+    Real &xfercoef_vol_acc2ait, Real xfertend_num[2][2]) {
 
-  const auto q_i = prognostics.q_aero_i;
-  const auto q_c = prognostics.q_aero_c;
+  const int iacc = int(ModeIndex::Accumulation);
+  const auto noxf_acc2ait = data.noxf_acc2ait;
+  const auto inv_density = data.inv_density;
   const Real zero = 0.0, one = 1.0;
 
   Real drv_t_noxf = zero, num_t0 = zero;
@@ -419,25 +621,22 @@ void compute_coef_acc_ait_transfer(
       // As there may be more species in the accumulation mode which are not
       // present in the aitken mode, we need to compute the num and volume only
       // for the species which can be transferred
-
-      // In mam4xx q_i and q_c have a different structure that mam4, i.e,
-      // q_i[nmode][nspecies](k). So, we need to modify the following for loop
       for (int ispec = 0; ispec < n_spec; ++ispec) {
         if (noxf_acc2ait[ispec]) { // then species which can't be
                                    // transferred
           // need qmass*invdens = (kg/kg-air) * [1/(kg/m3)] = m3/kg-air
           drv_i_noxf +=
-              max(zero, q_i[iacc][ispec](klev)) * inv_density[iacc][ispec];
+              max(zero, q.q_i(iacc, ispec)) * inv_density[iacc][ispec];
           drv_c_noxf +=
-              max(zero, q_c[iacc][ispec](klev)) * inv_density[iacc][ispec];
+              max(zero, q.q_c(iacc, ispec)) * inv_density[iacc][ispec];
         } // end if
       }   // end ispec
       drv_t_noxf =
           drv_i_noxf +
           drv_c_noxf; // total volume that can't be moved to the aitken mode
       num_t_noxf = drv_t_noxf *
-                   num2vol_ratio_min_nmodes[iacc]; // total number that can't be
-                                                   // moved to the aitken mode
+                   data.num2vol_ratio_noxf; // total number that can't be
+                                            // moved to the aitken mode
       num_t0 = num_t;
       num_t = max(zero, num_t - num_t_noxf);
       drv_t = max(zero, drv_t - drv_t_noxf);
@@ -526,17 +725,16 @@ void update_num_tends(const int jmode, const int aer_type, Real &dqdt_src,
 } // end update_num_tends
 
 //------------------------------------------------------------------------------------------------
-KOKKOS_INLINE_FUNCTION
-void update_tends_flx(const int klev,          // in
-                      const int jmode,         // in
-                      const int src_mode_ixd,  // in
-                      const int dest_mode_ixd, // in
-                      const int n_common_species_ait_accum,
-                      const int *src_species_idx, //
-                      const int *dest_species_idx,
-                      const Real xfertend_num[2][2], const Real xfercoef,
-                      const Prognostics &prognostics,
-                      const Tendencies &tendencies) {
+template <typename Accessor>
+KOKKOS_INLINE_FUNCTION void
+update_tends_flx(const int jmode,         // in
+                 const int src_mode_ixd,  // in
+                 const int dest_mode_ixd, // in
+                 const int n_common_species_ait_accum,
+                 const int *src_species_idx, //
+                 const int *dest_species_idx,
+                 const Real xfertend_num[2][2], const Real xfercoef,
+                 const Accessor &q) {
 
   // NOTES on arrays and indices:
   // jmode==0 is aitken->accumulation transfer;
@@ -546,26 +744,19 @@ void update_tends_flx(const int klev,          // in
   // aerosols xfertend_num(jmode,1) contains how much to transfer for cloudborne
   // aerosols
 
-  const auto q_i = prognostics.q_aero_i;
-  const auto q_c = prognostics.q_aero_c;
-  const auto didt = tendencies.q_aero_i;
-  const auto dnidt = tendencies.n_mode_i;
-  const auto dcdt = tendencies.q_aero_c;
-  const auto dncdt = tendencies.n_mode_c;
-
   const Real zero = 0;
 
   // interstiatial species
-  Real &dqdt_src_i = dnidt[src_mode_ixd](klev);
-  Real &dqdt_dest_i = dnidt[dest_mode_ixd](klev);
+  Real &dqdt_src_i = q.dndt_i(src_mode_ixd);
+  Real &dqdt_dest_i = q.dndt_i(dest_mode_ixd);
   const int aer_interstiatial = 0;
   update_num_tends(jmode, aer_interstiatial, dqdt_src_i, dqdt_dest_i,
                    xfertend_num);
 
   // cloud borne apecies
   const int aer_cloud_borne = 1;
-  Real &dqdt_src_c = dncdt[src_mode_ixd](klev);
-  Real &dqdt_dest_c = dncdt[dest_mode_ixd](klev);
+  Real &dqdt_src_c = q.dndt_c(src_mode_ixd);
+  Real &dqdt_dest_c = q.dndt_c(dest_mode_ixd);
 
   update_num_tends(jmode, aer_cloud_borne, dqdt_src_c, dqdt_dest_c,
                    xfertend_num);
@@ -575,15 +766,15 @@ void update_tends_flx(const int klev,          // in
     const int ispec_dest = dest_species_idx[i];
     // interstitial species
     const Real xfertend_i =
-        max(zero, q_i[src_mode_ixd][ispec_src](klev)) * xfercoef;
-    didt[src_mode_ixd][ispec_src](klev) -= xfertend_i;
-    didt[dest_mode_ixd][ispec_dest](klev) += xfertend_i;
+        max(zero, q.q_i(src_mode_ixd, ispec_src)) * xfercoef;
+    q.dqdt_i(src_mode_ixd, ispec_src) -= xfertend_i;
+    q.dqdt_i(dest_mode_ixd, ispec_dest) += xfertend_i;
 
     // cloud borne species
     const Real xfertend_c =
-        max(zero, q_c[src_mode_ixd][ispec_src](klev)) * xfercoef;
-    dcdt[src_mode_ixd][ispec_src](klev) -= xfertend_c;
-    dcdt[dest_mode_ixd][ispec_dest](klev) += xfertend_c;
+        max(zero, q.q_c(src_mode_ixd, ispec_src)) * xfercoef;
+    q.dqdt_c(src_mode_ixd, ispec_src) -= xfertend_c;
+    q.dqdt_c(dest_mode_ixd, ispec_dest) += xfertend_c;
   }
 
 } // end update_tends_flx
@@ -592,27 +783,14 @@ void update_tends_flx(const int klev,          // in
  * \brief Exchange aerosols between aitken and accumulation modes based on new
     sizes.
  */
-KOKKOS_INLINE_FUNCTION
-void aitken_accum_exchange(
-    const int k, const int aitken_idx, const int accum_idx,
-    const bool noxf_acc2ait[AeroConfig::num_aerosol_ids()],
-    const int n_common_species_ait_accum, const int *ait_spec_in_acc,
-    const int *acc_spec_in_ait,
-    const Real num2vol_ratio_max_nmodes[AeroConfig::num_modes()],
-    const Real num2vol_ratio_min_nmodes[AeroConfig::num_modes()],
-    const Real num2vol_ratio_nom_nmodes[AeroConfig::num_modes()],
-    const Real dgnmax_nmodes[AeroConfig::num_modes()],
-    const Real dgnmin_nmodes[AeroConfig::num_modes()],
-    const Real dgnnom_nmodes[AeroConfig::num_modes()],
-    const Real mean_std_dev_nmodes[AeroConfig::num_modes()],
-    const Real inv_density[AeroConfig::num_modes()]
-                          [AeroConfig::num_aerosol_ids()],
-    const Real adj_tscale_inv, const Real dt, const Prognostics &prognostics,
-    const Real drv_i_aitsv, const Real num_i_aitsv, const Real drv_c_aitsv,
-    const Real num_c_aitsv, const Real drv_i_accsv, const Real num_i_accsv,
-    const Real drv_c_accsv, const Real num_c_accsv, Real &dgncur_i_aitken,
-    Real &dgncur_i_accum, Real &dgncur_c_aitken, Real &dgncur_c_accum,
-    const Tendencies &tendencies) {
+template <typename Accessor>
+KOKKOS_INLINE_FUNCTION void aitken_accum_exchange(
+    const CalcSizeData &data, const Accessor &q, const Real adj_tscale_inv,
+    const Real dt, const Real drv_i_aitsv, const Real num_i_aitsv,
+    const Real drv_c_aitsv, const Real num_c_aitsv, const Real drv_i_accsv,
+    const Real num_i_accsv, const Real drv_c_accsv, const Real num_c_accsv,
+    Real &dgncur_i_aitken, Real &dgncur_i_accum, Real &dgncur_c_aitken,
+    Real &dgncur_c_accum) {
 
   // -----------------------------------------------------------------------------
   // Purpose: Exchange aerosols between aitken and accumulation modes based on
@@ -625,6 +803,16 @@ void aitken_accum_exchange(
   // Ported to C++/Kokkos by: Oscar Diaz-Ibarra and Michael Schmidt
   // -----------------------------------------------------------------------------
 
+  const int aitken_idx = int(ModeIndex::Aitken);
+  const int accum_idx = int(ModeIndex::Accumulation);
+  const auto num2vol_ratio_max_nmodes = data.num2vol_ratio_max_nmodes;
+  const auto num2vol_ratio_min_nmodes = data.num2vol_ratio_min_nmodes;
+  const auto num2vol_ratio_nom_nmodes = data.num2vol_ratio_nom_nmodes;
+  const auto dgnmax_nmodes = data.dgnmax_nmodes;
+  const auto dgnmin_nmodes = data.dgnmin_nmodes;
+  const auto dgnnom_nmodes = data.dgnnom_nmodes;
+  const auto mean_std_dev_nmodes = data.mean_std_dev_nmodes;
+
   const Real zero = 0;
 
   Real num2vol_ratio_cur_c_accum = zero;
@@ -684,10 +872,9 @@ void aitken_accum_exchange(
   //  ----------------------------------------------------------------------------------------
 
   compute_coef_acc_ait_transfer(
-      accum_idx, k, num2vol_ratio_geomean, adj_tscale_inv, prognostics,
-      drv_i_accsv, drv_c_accsv, num_i_accsv, num_c_accsv, noxf_acc2ait,
-      voltonum_ait, inv_density, num2vol_ratio_min_nmodes, drv_i_noxf,
-      drv_c_noxf, acc2_ait_index, xfercoef_num_acc2ait, xfercoef_vol_acc2ait,
+      data, q, num2vol_ratio_geomean, adj_tscale_inv, drv_i_accsv, drv_c_accsv,
+      num_i_accsv, num_c_accsv, voltonum_ait, drv_i_noxf, drv_c_noxf,
+      acc2_ait_index, xfercoef_num_acc2ait, xfercoef_vol_acc2ait,
       xfertend_num);
 
   // jump to end of loop if no transfer is needed
@@ -795,14 +982,13 @@ void aitken_accum_exchange(
       const int jmode = 0;
       // Since jmode = 0, source mode = aitken and destination mode accumulation
       update_tends_flx(
-          k,          // in
           jmode,      // in
           aitken_idx, // in src => aitken
           accum_idx,  // in dest => accumulation
-          n_common_species_ait_accum,
-          ait_spec_in_acc, // defined in aero_modes - src => aitken
-          acc_spec_in_ait, // defined in aero_modes - src => accumulation
-          xfertend_num, xfercoef_vol_ait2acc, prognostics, tendencies);
+          data.n_common_species_ait_accum,
+          data.ait_spec_in_acc, // defined in aero_modes - src => aitken
+          data.acc_spec_in_ait, // defined in aero_modes - src => accumulation
+          xfertend_num, xfercoef_vol_ait2acc, q);
     } // end if (ait2acc_index)
 
     // jmode = 1 does accum --> aitken
@@ -814,19 +1000,244 @@ void aitken_accum_exchange(
       // xfercoef_vol_ait2acc in this call as we are doing accum -> aitken
       // transfer
       update_tends_flx(
-          k,          // in
           jmode,      // in
           accum_idx,  // in src=> accumulation
           aitken_idx, // in dest => aitken
-          n_common_species_ait_accum,
-          acc_spec_in_ait, // defined in aero_modes - src => accumulation
-          ait_spec_in_acc, // defined in aero_modes - src => aitken
-          xfertend_num, xfercoef_vol_acc2ait, prognostics, tendencies);
+          data.n_common_species_ait_accum,
+          data.acc_spec_in_ait, // defined in aero_modes - src => accumulation
+          data.ait_spec_in_acc, // defined in aero_modes - src => aitken
+          xfertend_num, xfercoef_vol_acc2ait, q);
     } // end if (acc2_ait_index)
   }   // end if (ait2acc_index+acc2_ait_index > 0)
 
 } // aitken_accum_exchange
 
+// aitken_accum_exchange for level k of Prognostics, with the constants given
+// as separate arrays (the mode indices must be those of ModeIndex). The
+// non-transferable accumulation species use num2vol_ratio_min_nmodes.
+KOKKOS_INLINE_FUNCTION
+void aitken_accum_exchange(
+    const int k, const int aitken_idx, const int accum_idx,
+    const bool noxf_acc2ait[AeroConfig::num_aerosol_ids()],
+    const int n_common_species_ait_accum, const int *ait_spec_in_acc,
+    const int *acc_spec_in_ait,
+    const Real num2vol_ratio_max_nmodes[AeroConfig::num_modes()],
+    const Real num2vol_ratio_min_nmodes[AeroConfig::num_modes()],
+    const Real num2vol_ratio_nom_nmodes[AeroConfig::num_modes()],
+    const Real dgnmax_nmodes[AeroConfig::num_modes()],
+    const Real dgnmin_nmodes[AeroConfig::num_modes()],
+    const Real dgnnom_nmodes[AeroConfig::num_modes()],
+    const Real mean_std_dev_nmodes[AeroConfig::num_modes()],
+    const Real inv_density[AeroConfig::num_modes()]
+                          [AeroConfig::num_aerosol_ids()],
+    const Real adj_tscale_inv, const Real dt, const Prognostics &prognostics,
+    const Real drv_i_aitsv, const Real num_i_aitsv, const Real drv_c_aitsv,
+    const Real num_c_aitsv, const Real drv_i_accsv, const Real num_i_accsv,
+    const Real drv_c_accsv, const Real num_c_accsv, Real &dgncur_i_aitken,
+    Real &dgncur_i_accum, Real &dgncur_c_aitken, Real &dgncur_c_accum,
+    const Tendencies &tendencies) {
+  CalcSizeData data;
+  for (int m = 0; m < AeroConfig::num_modes(); ++m) {
+    data.num2vol_ratio_max_nmodes[m] = num2vol_ratio_max_nmodes[m];
+    data.num2vol_ratio_min_nmodes[m] = num2vol_ratio_min_nmodes[m];
+    data.num2vol_ratio_nom_nmodes[m] = num2vol_ratio_nom_nmodes[m];
+    data.dgnmax_nmodes[m] = dgnmax_nmodes[m];
+    data.dgnmin_nmodes[m] = dgnmin_nmodes[m];
+    data.dgnnom_nmodes[m] = dgnnom_nmodes[m];
+    data.mean_std_dev_nmodes[m] = mean_std_dev_nmodes[m];
+    for (int ispec = 0; ispec < num_species_mode(m); ++ispec)
+      data.inv_density[m][ispec] = inv_density[m][ispec];
+  }
+  data.num2vol_ratio_noxf = num2vol_ratio_min_nmodes[accum_idx];
+  for (int ispec = 0; ispec < num_species_mode(accum_idx); ++ispec)
+    data.noxf_acc2ait[ispec] = noxf_acc2ait[ispec];
+  data.n_common_species_ait_accum = n_common_species_ait_accum;
+  for (int i = 0; i < n_common_species_ait_accum; ++i) {
+    data.ait_spec_in_acc[i] = ait_spec_in_acc[i];
+    data.acc_spec_in_ait[i] = acc_spec_in_ait[i];
+  }
+
+  const PrognosticsAccessor q(prognostics, nullptr, &tendencies, k);
+  aitken_accum_exchange(data, q, adj_tscale_inv, dt, drv_i_aitsv, num_i_aitsv,
+                        drv_c_aitsv, num_c_aitsv, drv_i_accsv, num_i_accsv,
+                        drv_c_accsv, num_c_accsv, dgncur_i_aitken,
+                        dgncur_i_accum, dgncur_c_aitken, dgncur_c_accum);
+} // aitken_accum_exchange
+
+/*-----------------------------------------------------------------------------
+Calcsize engine for one level: computes the dry diameters of the interstitial
+and cloud-borne modes from their mass and number mixing ratios, adjusts the
+numbers to within the mode bounds (do_adjust) and exchanges aerosols between
+the aitken and accumulation modes (do_aitacc_transfer). The number and mass
+tendencies of the adjustment and transfer are accumulated in the accessor's
+tendencies; the mixing ratios themselves are not modified.
+
+Used by CalcSize (PrognosticsAccessor) and by
+modal_aero_calcsize::modal_aero_calcsize_sub (StateQAccessor).
+ -----------------------------------------------------------------------------*/
+template <typename Accessor>
+KOKKOS_INLINE_FUNCTION void
+calcsize_1level(const CalcSizeData &data, const Accessor &q, const Real dt,
+                const bool do_adjust, const bool do_aitacc_transfer) {
+  const int aitken_idx = int(ModeIndex::Aitken);
+  const int accumulation_idx = int(ModeIndex::Accumulation);
+  const int nmodes = AeroConfig::num_modes();
+  const Real zero = 0;
+  const Real seconds_in_a_day = 86400.0; // BAD_CONSTANT!!
+
+  //  initialize these variables that are used at the bottom of the
+  //  imode loop and are needed outside the loop scope
+  Real dryvol_i_aitsv = 0;
+  Real num_i_k_aitsv = 0;
+  Real dryvol_c_aitsv = 0;
+  Real num_c_k_aitsv = 0;
+  Real dryvol_i_accsv = 0;
+  Real num_i_k_accsv = 0;
+  Real dryvol_c_accsv = 0;
+  Real num_c_k_accsv = 0;
+
+  // time scale for number adjustment
+  const Real adj_tscale = max(seconds_in_a_day, dt);
+
+  // inverse of the adjustment time scale
+  const Real adj_tscale_inv = FloatingPoint<Real>::safe_denominator(adj_tscale);
+
+  for (int imode = 0; imode < nmodes; imode++) {
+    // Initialize diameter(dgnum), volume to number
+    // ratios(num2vol_ratio_cur) and dry volume (dryvol) for both
+    // interstitial and cloudborne aerosols we did not implement
+    // set_initial_sz_and_volumes
+    Real &dgncur_i = q.dgncur_i(imode);
+    Real &dgncur_c = q.dgncur_c(imode);
+    dgncur_i = data.dgnnom_nmodes[imode]; // diameter [m]
+    Real num2vol_ratio_cur_i =
+        data.num2vol_ratio_nom_nmodes[imode]; // volume to number
+    dgncur_c = data.dgnnom_nmodes[imode];     // diameter [m]
+    Real num2vol_ratio_cur_c =
+        data.num2vol_ratio_nom_nmodes[imode]; // volume to number
+
+    //----------------------------------------------------------------------
+    // Compute dry volume mixratios (aerosol diameter)
+    // Current default: number mmr is prognosed
+    //       Algorithm:calculate aerosol diameter from mass, number, and
+    //       fixed sigmag
+    //
+    // sigmag ("sigma g") is "geometric standard deviation for aerosol
+    // mode"
+    //
+    // Volume = sum_over_components{ component_mass mixratio / density }
+    //----------------------------------------------------------------------
+    // dryvol_i, dryvol_c are set to zero inside compute_dry_volume
+    Real dryvol_i = 0;
+    Real dryvol_c = 0;
+    compute_dry_volume(imode, data.inv_density, q, dryvol_i, dryvol_c);
+
+    const auto dgnmin = data.dgnmin_nmodes[imode];
+    const auto dgnmax = data.dgnmax_nmodes[imode];
+    const auto mean_std_dev = data.mean_std_dev_nmodes[imode];
+
+    // initial value of num interstitial for this Real and mode
+    const auto init_num_i = q.n_i(imode);
+
+    // `adjust_num_sizes` will use the initial value, but other
+    // calculations require this to be nonzero.
+    // Make it non-negative
+    auto num_i_k = init_num_i < 0 ? zero : init_num_i;
+
+    const auto init_num_c = q.n_c(imode);
+    // Make it non-negative
+    auto num_c_k = init_num_c < 0 ? zero : init_num_c;
+
+    const auto is_aitken_or_accumulation =
+        imode == accumulation_idx || imode == aitken_idx;
+    const auto do_adjust_aitken_or_accum =
+        is_aitken_or_accumulation && do_aitacc_transfer;
+    if (do_adjust) {
+      /*------------------------------------------------------------------
+       *  Do number adjustment for interstitial and activated particles
+       *------------------------------------------------------------------
+       * Adjustments that are applied over time-scale deltat
+       * (model time step in seconds):
+       *
+       *   1. make numbers non-negative or
+       *   2. make numbers zero when volume is zero
+       *
+       *
+       * Adjustments that are applied over time-scale of a day (in
+       *seconds)
+       *   3. bring numbers to within specified bounds
+       *
+       * (Adjustment details are explained in the process)
+       *------------------------------------------------------------------*/
+
+      /*NOTE: Only number tendencies (NOT mass mixing ratios) are
+       updated in adjust_num_sizes Effect of these adjustment will be
+       reflected in the particle diameters (via
+       "update_diameter_and_vol2num" subroutine call below) */
+      // Thus, when we are NOT doing the diameter/vol adjustments below,
+      // then we DO the num adjustment here
+      if (!do_adjust_aitken_or_accum) {
+        adjust_num_sizes(dryvol_i, dryvol_c, init_num_i, init_num_c, dt, // in
+                         data.num2vol_ratio_min[imode],
+                         data.num2vol_ratio_max[imode], adj_tscale_inv, // in
+                         num_i_k, num_c_k,                              // out
+                         q.dndt_i(imode), q.dndt_c(imode));             // out
+      }
+    }
+
+    // update diameters and volume to num ratios for interstitial
+    // aerosols
+    update_diameter_and_vol2num(dryvol_i, num_i_k,
+                                data.num2vol_ratio_min_sz[imode],
+                                data.num2vol_ratio_max_sz[imode], dgnmin,
+                                dgnmax, mean_std_dev, dgncur_i,
+                                num2vol_ratio_cur_i);
+
+    // update diameters and volume to num ratios for cloudborne aerosols
+    update_diameter_and_vol2num(dryvol_c, num_c_k,
+                                data.num2vol_ratio_min_sz[imode],
+                                data.num2vol_ratio_max_sz[imode], dgnmin,
+                                dgnmax, mean_std_dev, dgncur_c,
+                                num2vol_ratio_cur_c);
+
+    // save number concentrations and dry volumes for explicit
+    // aitken <--> accum mode transfer, which is the next step in
+    // the calcSize process
+    if (do_aitacc_transfer) {
+      if (imode == aitken_idx) {
+        dryvol_i_aitsv = dryvol_i;
+        num_i_k_aitsv = num_i_k;
+        dryvol_c_aitsv = dryvol_c;
+        num_c_k_aitsv = num_c_k;
+      } else if (imode == accumulation_idx) {
+        dryvol_i_accsv = dryvol_i;
+        num_i_k_accsv = num_i_k;
+        dryvol_c_accsv = dryvol_c;
+        num_c_k_accsv = num_c_k;
+      }
+    }
+  } // for(imode)
+
+  // ------------------------------------------------------------------
+  //  Overall logic for aitken<-->accumulation transfer:
+  //  ------------------------------------------------
+  //  when the aitken mode mean size is too big, the largest
+  //     aitken particles are transferred into the accum mode
+  //     to reduce the aitken mode mean size
+  //  when the accum mode mean size is too small, the smallest
+  //     accum particles are transferred into the aitken mode
+  //     to increase the accum mode mean size
+  // ------------------------------------------------------------------
+  if (do_aitacc_transfer) {
+    aitken_accum_exchange(
+        data, q, adj_tscale_inv, dt, dryvol_i_aitsv, num_i_k_aitsv,
+        dryvol_c_aitsv, num_c_k_aitsv, dryvol_i_accsv, num_i_k_accsv,
+        dryvol_c_accsv, num_c_k_accsv, q.dgncur_i(aitken_idx),
+        q.dgncur_i(accumulation_idx), q.dgncur_c(aitken_idx),
+        q.dgncur_c(accumulation_idx));
+  } // end do_aitacc_transfer
+} // calcsize_1level
+
 } // namespace calcsize
 
 /// @class CalcSize
@@ -850,41 +1261,9 @@ public:
 private:
   Config config_;
 
-  Real num2vol_ratio_min_nmodes[AeroConfig::num_modes()],
-      num2vol_ratio_max_nmodes[AeroConfig::num_modes()],
-      num2vol_ratio_nom_nmodes[AeroConfig::num_modes()];
-  // Mode parameters
-  Real dgnmin_nmodes[AeroConfig::num_modes()], // min geometric number diameter
-      dgnmax_nmodes[AeroConfig::num_modes()],  // max geometric number diameter
-      dgnnom_nmodes[AeroConfig::num_modes()];  // mean geometric number diameter
-
-  Real mean_std_dev_nmodes[AeroConfig::num_modes()];
-
-  Real _inv_density[AeroConfig::num_modes()][AeroConfig::num_aerosol_ids()];
-
-  /*------------------------------------------------------------------------
-  Identify accum species cannot be transferred to aitken mode
-
-  Accumulation mode have more species than Aitken mode. Therefore, there
-  will be some species which cannot be transferred from accumulation to
-  Aitken mode as they don't exist in the Aitken mode
-  ------------------------------------------------------------------------*/
-  // true: cannot be transferred
-  // false: can be transferred
-  // const bool _noxf_acc2ait[AeroConfig::num_aerosol_ids()] = {false, false,
-  // true, true, false, true, false}; set size of _noxf_acc2ait,
-  // _ait_spec_in_acc, and _acc_spec_in_ait to AeroConfig::num_aerosol_ids()
-  // which is maximum number of species; however, we only use first
-  // _n_common_species_ait_accum values of _ait_spec_in_acc and _acc_spec_in_ait
-  bool _noxf_acc2ait[AeroConfig::num_aerosol_ids()];
-  // number of common species between accum and aitken modes
-  int _n_common_species_ait_accum;
-  // index of aitken species in accum mode.
-  int _ait_spec_in_acc[AeroConfig::num_aerosol_ids()]; // = {0, 1, 2, 3};
-  // index of accum species in aitken mode.
-  int _acc_spec_in_ait[AeroConfig::num_aerosol_ids()]; // = {0, 1, 4, 6};
-  Real num2vol_ratio_min[AeroConfig::num_modes()];
-  Real num2vol_ratio_max[AeroConfig::num_modes()];
+  // mode parameters, inverse densities and aitken<->accumulation transfer
+  // tables, precomputed in init
+  calcsize::CalcSizeData data_;
 
 public:
   // name -- unique name of the process implemented by this class
@@ -896,69 +1275,8 @@ public:
             const Config &calcsize_config = Config()) {
     // Set nucleation-specific config parameters.
     config_ = calcsize_config;
-    const Real one = 1.0;
-
-    // find aerosol species in accumulation that can be transfer to aitken mode
-    const int accum_idx = int(ModeIndex::Accumulation);
-    const int aitken_idx = int(ModeIndex::Aitken);
-
-    // check if accumulation species exists in aitken mode
-    // also save idx for transfer
-    int count = 0;
-    for (int isp = 0; isp < num_species_mode(accum_idx); ++isp) {
-      // assume species can not be transfer.
-      _noxf_acc2ait[isp] = true;
-      AeroId sp_accum = mode_aero_species(accum_idx, isp);
-
-      for (int jsp = 0; jsp < num_species_mode(aitken_idx); ++jsp) {
-        AeroId sp_aitken = mode_aero_species(aitken_idx, jsp);
-        if (sp_accum == sp_aitken) {
-          // false : can be transfer.
-          _noxf_acc2ait[isp] = false;
-          // save index for transfer from accumulation to aitken mode
-          _acc_spec_in_ait[count] = isp;
-          // save index for transfer from aitken to accumulation mode
-          _ait_spec_in_acc[count] = jsp;
-          count++;
-          break;
-        }
-      } // end aitken foor
-    }   // end accumulation for
-    _n_common_species_ait_accum = count;
-
-    // Set mode parameters.
-    for (int m = 0; m < AeroConfig::num_modes(); ++m) {
-      // FIXME: There is a comment in modal_aero_newnuc.F90 that Dick Easter
-      // FIXME: thinks that dgnum_aer isn't used in MAM4, but it is actually
-      // FIXME: used in this nucleation parameterization. So we will have to
-      // FIXME: figure this out.
-      dgnnom_nmodes[m] = modes(m).nom_diameter;
-      dgnmin_nmodes[m] = modes(m).min_diameter;
-      dgnmax_nmodes[m] = modes(m).max_diameter;
-      mean_std_dev_nmodes[m] = modes(m).mean_std_dev;
-      num2vol_ratio_nom_nmodes[m] =
-          one / conversions::mean_particle_volume_from_diameter(
-                    dgnnom_nmodes[m], modes(m).mean_std_dev);
-      num2vol_ratio_min_nmodes[m] =
-          one / conversions::mean_particle_volume_from_diameter(
-                    dgnmax_nmodes[m], modes(m).mean_std_dev);
-      num2vol_ratio_max_nmodes[m] =
-          one / conversions::mean_particle_volume_from_diameter(
-                    dgnmin_nmodes[m], modes(m).mean_std_dev);
-
-      // compute inv density; density is constant, so we can compute in init.
-      const auto n_spec = num_species_mode(m);
-      for (int ispec = 0; ispec < n_spec; ispec++) {
-        const int aero_id = int(mode_aero_species(m, ispec));
-        _inv_density[m][ispec] = Real(1.0) / aero_species(aero_id).density;
-      } // for(ispec)
-      // FIXME: do we need to update num2vol_ratio_min_nmodes and
-      // num2vol_ratio_max_nmodes as well?
-      num2vol_ratio_min[m] = num2vol_ratio_min_nmodes[m];
-      num2vol_ratio_max[m] = num2vol_ratio_max_nmodes[m];
-
-    } // for(m)
-
+    const bool e3sm_bounds = false;
+    data_.init(e3sm_bounds);
   } // end(init)
 
   KOKKOS_INLINE_FUNCTION
@@ -971,252 +1289,14 @@ public:
 
     const bool do_aitacc_transfer = config_.do_aitacc_transfer;
     const bool do_adjust = config_.do_adjust;
-
-    const int aitken_idx = int(ModeIndex::Aitken);
-    const int accumulation_idx = int(ModeIndex::Accumulation);
-    const int nmodes = AeroConfig::num_modes();
     const int nk = atmosphere.num_levels();
 
-    // diameter for interstitial aerosols
-    const auto dgncur_i = diagnostics.dry_geometric_mean_diameter_i;
-    // diameter for cloud-borne aerosols
-    const auto dgncur_c = diagnostics.dry_geometric_mean_diameter_c;
-
-    const auto n_i = prognostics.n_mode_i;
-    const auto n_c = prognostics.n_mode_c;
-    // tendencies for interstitial number mixing ratios
-    const auto dnidt = tendencies.n_mode_i;
-    // tendencies for cloud-borne number mixing ratios
-    const auto dncdt = tendencies.n_mode_c;
-
-    const auto inv_density = _inv_density;
-    const Real zero = 0;
-    const Real seconds_in_a_day = 86400.0; // BAD_CONSTANT!!
-    //
-    const auto acc_spec_in_ait = _acc_spec_in_ait;
-    const auto ait_spec_in_acc = _ait_spec_in_acc;
-    const auto n_common_species_ait_accum = _n_common_species_ait_accum;
-    const auto noxf_acc2ait = _noxf_acc2ait;
-
     Kokkos::parallel_for(
         Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
-          Real dryvol_i = 0;
-          Real dryvol_c = 0;
-
-          //  initialize these variables that are used at the bottom of the
-          //  imode loop and are needed outside the loop scope
-          Real dryvol_i_aitsv = 0;
-          Real num_i_k_aitsv = 0;
-          Real dryvol_c_aitsv = 0;
-          Real num_c_k_aitsv = 0;
-          Real dryvol_i_accsv = 0;
-          Real num_i_k_accsv = 0;
-          Real dryvol_c_accsv = 0;
-          Real num_c_k_accsv = 0;
-          // NOTE: these were work arrays and may not be necessary
-          // Real drv_i_sv[nmodes];
-          // Real num_i_sv[nmodes];
-          // Real drv_c_sv[nmodes];
-          // Real num_c_sv[nmodes];
-
-          // time scale for number adjustment
-          const Real adj_tscale = max(seconds_in_a_day, dt);
-
-          // inverse of the adjustment time scale
-          const Real adj_tscale_inv =
-              FloatingPoint<Real>::safe_denominator(adj_tscale);
-
-          for (int imode = 0; imode < nmodes; imode++) {
-
-            // ----------------------------------------------------------------------
-            // Algorithm to compute dry aerosol diameter:
-            // calculate aerosol diameter volume, volume is computed from mass
-            // and density
-            // ----------------------------------------------------------------------
-
-            // FIXME: get rid of these unused bits and related comments?
-            // find start and end index of species in this mode in the
-            // "population" array The indices are same for interstitial and
-            // cloudborne species s_spec_ind = population_offsets(imode) start
-            // index e_spec_ind = population_offsets(imode+1) - 1 end index of
-            // species for all (modes expect the last mode)
-
-            // if(imode.eq.nmodes) then  for last mode
-            //    e_spec_ind = num_populations if imode==nmodes, end index is
-            //    the total number of species
-            // endif
-
-            // nspec = num_mode_species(imode) total number of species in mode
-            // "imode"
-
-            // capture densities for each species in this mode
-            // density(1:max_nspec) = huge(density) initialize the whole array
-            // to a huge value [FIXME: NaN would be better than huge]
-            // density(1:nspec) = spec_density(imode, 1:nspec) assign density
-            // till nspec (as nspec can be different for each mode)
-
-            // Initialize diameter(dgnum), volume to number
-            // ratios(num2vol_ratio_cur) and dry volume (dryvol) for both
-            // interstitial and cloudborne aerosols we did not implement
-            // set_initial_sz_and_volumes
-            dgncur_i[imode](k) = dgnnom_nmodes[imode]; // diameter [m]
-            Real num2vol_ratio_cur_i =
-                num2vol_ratio_nom_nmodes[imode]; // volume to number
-
-            dgncur_c[imode](k) = dgnnom_nmodes[imode]; // diameter [m]
-            Real num2vol_ratio_cur_c =
-                num2vol_ratio_nom_nmodes[imode]; // volume to number
-
-            // dry volume is set to zero inside compute_dry_volume_k
-            //----------------------------------------------------------------------
-            // Compute dry volume mixratios (aerosol diameter)
-            // Current default: number mmr is prognosed
-            //       Algorithm:calculate aerosol diameter from mass, number, and
-            //       fixed sigmag
-            //
-            // sigmag ("sigma g") is "geometric standard deviation for aerosol
-            // mode"
-            //
-            // Volume = sum_over_components{ component_mass mixratio / density }
-            //----------------------------------------------------------------------
-            // dryvol_i, dryvol_c are set to zero inside compute_dry_volume_k
-            calcsize::compute_dry_volume_k(k, imode, inv_density, prognostics,
-                                           dryvol_i, dryvol_c);
-
-            const auto dgnmin = dgnmin_nmodes[imode];
-            const auto dgnmax = dgnmax_nmodes[imode];
-            const auto mean_std_dev = mean_std_dev_nmodes[imode];
-
-            // initial value of num interstitial for this Real and mode
-            auto init_num_i = n_i[imode](k);
-
-            // `adjust_num_sizes` will use the initial value, but other
-            // calculations require this to be nonzero.
-            // Make it non-negative
-            auto num_i_k = init_num_i < 0 ? zero : init_num_i;
-
-            auto init_num_c = n_c[imode](k);
-            // Make it non-negative
-            auto num_c_k = init_num_c < 0 ? zero : init_num_c;
-
-            const auto is_aitken_or_accumulation =
-                imode == accumulation_idx || imode == aitken_idx;
-            const auto do_adjust_aitken_or_accum =
-                is_aitken_or_accumulation && do_aitacc_transfer;
-            if (do_adjust) {
-              /*------------------------------------------------------------------
-               *  Do number adjustment for interstitial and activated particles
-               *------------------------------------------------------------------
-               * Adjustments that are applied over time-scale deltat
-               * (model time step in seconds):
-               *
-               *   1. make numbers non-negative or
-               *   2. make numbers zero when volume is zero
-               *
-               *
-               * Adjustments that are applied over time-scale of a day (in
-               *seconds)
-               *   3. bring numbers to within specified bounds
-               *
-               * (Adjustment details are explained in the process)
-               *------------------------------------------------------------------*/
-
-              // number tendencies to be updated by adjust_num_sizes subroutine
-
-              auto &interstitial_tend = dnidt[imode](k);
-              auto &cloudborne_tend = dncdt[imode](k);
-
-              /*NOTE: Only number tendencies (NOT mass mixing ratios) are
-               updated in adjust_num_sizes Effect of these adjustment will be
-               reflected in the particle diameters (via
-               "update_diameter_and_vol2num" subroutine call below) */
-              // Thus, when we are NOT doing the diameter/vol adjustments below,
-              // then we DO the num adjustment here
-              if (!do_adjust_aitken_or_accum) {
-                calcsize::adjust_num_sizes(
-                    dryvol_i, dryvol_c, init_num_i, init_num_c, dt, // in
-                    num2vol_ratio_min[imode], num2vol_ratio_max[imode],
-                    adj_tscale_inv,                      // in
-                    num_i_k, num_c_k,                    // out
-                    interstitial_tend, cloudborne_tend); // out
-              }
-            }
-
-            // update diameters and volume to num ratios for interstitial
-            // aerosols
-
-            calcsize::update_diameter_and_vol2num(
-                dryvol_i, num_i_k, num2vol_ratio_min[imode],
-                num2vol_ratio_max[imode], dgnmin, dgnmax, mean_std_dev,
-                dgncur_i[imode](k), num2vol_ratio_cur_i);
-
-            // update diameters and volume to num ratios for cloudborne aerosols
-            calcsize::update_diameter_and_vol2num(
-                dryvol_c, num_c_k, num2vol_ratio_min[imode],
-                num2vol_ratio_max[imode], dgnmin, dgnmax, mean_std_dev,
-                dgncur_c[imode](k), num2vol_ratio_cur_c);
-
-            // save number concentrations and dry volumes for explicit
-            // aitken <--> accum mode transfer, which is the next step in
-            // the calcSize process
-            if (do_aitacc_transfer) {
-              if (imode == aitken_idx) {
-                // TODO: determine if we need to save these--i.e., is drv_i ever
-                // changed before the max() calculation in
-                // aitken_accum_exchange() if yes, maybe better to skip the
-                // logic and do it, regardless?
-                dryvol_i_aitsv = dryvol_i;
-                num_i_k_aitsv = num_i_k;
-                dryvol_c_aitsv = dryvol_c;
-                num_c_k_aitsv = num_c_k;
-              } else if (imode == accumulation_idx) {
-                dryvol_i_accsv = dryvol_i;
-                num_i_k_accsv = num_i_k;
-                dryvol_c_accsv = dryvol_c;
-                num_c_k_accsv = num_c_k;
-              }
-            }
-            // these were work variables that seem to not be used
-            // drv_i_sv[imode] = dryvol_i;
-            // num_i_sv[imode] = num_i_k;
-            // drv_c_sv[imode] = dryvol_c;
-            // num_c_sv[imode] = num_c_k;
-          } // for(imode)
-
-          // ------------------------------------------------------------------
-          //  Overall logic for aitken<-->accumulation transfer:
-          //  ------------------------------------------------
-          //  when the aitken mode mean size is too big, the largest
-          //     aitken particles are transferred into the accum mode
-          //     to reduce the aitken mode mean size
-          //  when the accum mode mean size is too small, the smallest
-          //     accum particles are transferred into the aitken mode
-          //     to increase the accum mode mean size
-          // ------------------------------------------------------------------
-          if (do_aitacc_transfer) {
-
-            Real &dgncur_i_aitken =
-                diagnostics.dry_geometric_mean_diameter_i[aitken_idx](k);
-            Real &dgncur_i_accum =
-                diagnostics.dry_geometric_mean_diameter_i[accumulation_idx](k);
-
-            Real &dgncur_c_aitken =
-                diagnostics.dry_geometric_mean_diameter_c[aitken_idx](k);
-            Real &dgncur_c_accum =
-                diagnostics.dry_geometric_mean_diameter_c[accumulation_idx](k);
-
-            calcsize::aitken_accum_exchange(
-                k, aitken_idx, accumulation_idx, noxf_acc2ait,
-                n_common_species_ait_accum, ait_spec_in_acc, acc_spec_in_ait,
-                num2vol_ratio_max_nmodes, num2vol_ratio_min_nmodes,
-                num2vol_ratio_nom_nmodes, dgnmax_nmodes, dgnmin_nmodes,
-                dgnnom_nmodes, mean_std_dev_nmodes, inv_density, adj_tscale_inv,
-                dt, prognostics, dryvol_i_aitsv, num_i_k_aitsv, dryvol_c_aitsv,
-                num_c_k_aitsv, dryvol_i_accsv, num_i_k_accsv, dryvol_c_accsv,
-                num_c_k_accsv, dgncur_i_aitken, dgncur_i_accum, dgncur_c_aitken,
-                dgncur_c_accum, tendencies);
-
-          } // end do_aitacc_transfer
+          const calcsize::PrognosticsAccessor q(prognostics, &diagnostics,
+                                                &tendencies, k);
+          calcsize::calcsize_1level(data_, q, dt, do_adjust,
+                                    do_aitacc_transfer);
         }); // kokkos::parfor(k)
   }
 };
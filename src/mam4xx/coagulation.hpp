@@ -8,8 +8,10 @@
 
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/mam4_types.hpp>
+#include <mam4xx/packs.hpp>
 
 #include <Kokkos_Array.hpp>
+#include <ekat/ekat_assert.hpp>
 #include <haero/atmosphere.hpp>
 #include <haero/constants.hpp>
 #include <haero/haero.hpp>
@@ -19,6 +21,110 @@
 
 namespace mam4 {
 
+namespace coagulation {
+
+/// CoagulationRateGrid defines the grid on which the coagulation coefficients
+/// are tabulated when Coagulation::Config::tabulate_rates is set. Temperature
+/// and pressure enter the coefficients only through exact prefactors and the
+/// mean free path of air, so the grid spans the mean free paths found within
+/// the given temperature and pressure ranges. Coefficients for points outside
+/// the grid are computed analytically.
+struct CoagulationRateGrid {
+  Real min_temperature = 150.0; // [K]
+  Real max_temperature = 350.0; // [K]
+  Real min_pressure = 1.0e2;    // [Pa]
+  Real max_pressure = 1.1e5;    // [Pa]
+  int num_mean_free_paths = 32; // (log-spaced)
+  Real min_diameter = 1.0e-9;   // wet geometric mean diameter [m]
+  Real max_diameter = 1.0e-5;   // wet geometric mean diameter [m]
+  int num_diameters = 48;       // (log-spaced)
+};
+
+/// CoagulationRateTable holds the coagulation coefficients of the coagulation
+/// pairs tabulated on a CoagulationRateGrid. Each coefficient q computed by
+/// getcoags is the harmonic mean of a near-continuum kernel proportional to
+/// knc and a free-molecular kernel proportional to kfm (see
+/// coag_kernel_factors), i.e. q = knc * kfm / (a * kfm + b * knc), where a and
+/// b depend only on the mean free path and the mode diameters. The table
+/// stores a and b for qn11, qn22, qn12 and qv12, in that order.
+struct CoagulationRateTable {
+  static constexpr int num_values = 8;
+  using TableView = DeviceType::view_ND<const TableReal, 5>;
+
+  // indexed by (pair, mean free path, aitken-side diameter, accumulation-side
+  // diameter, value)
+  TableView table;
+  Real log_min_lamda = 0, dlog_lamda = 1;
+  Real log_min_diameter = 0, dlog_diameter = 1;
+  int num_lamda = 0, num_diameters = 0;
+
+  // the largest relative errors of the tabulated betaij0, betaij3, betaii0
+  // and betajj0 found at the centers of the grid cells, computed on creation
+  Real max_relative_error[4] = {0, 0, 0, 0};
+
+  KOKKOS_INLINE_FUNCTION
+  bool enabled() const { return table.data() != nullptr; }
+
+  /// Interpolates the values of pair ip at the mean free path lamda [m] and
+  /// the diameters dgatk and dgacc [m], returning false if the point is
+  /// outside the grid.
+  KOKKOS_INLINE_FUNCTION
+  bool interpolate(const int ip, const Real lamda, const Real dgatk,
+                   const Real dgacc, Real values[num_values]) const {
+    const Real x[3] = {
+        (haero::log(lamda) - log_min_lamda) / dlog_lamda,
+        (haero::log(dgatk) - log_min_diameter) / dlog_diameter,
+        (haero::log(dgacc) - log_min_diameter) / dlog_diameter};
+    const int n[3] = {num_lamda, num_diameters, num_diameters};
+    int i[3];
+    Real w[3];
+    for (int d = 0; d < 3; ++d) {
+      if (!(x[d] >= 0 && x[d] <= n[d] - 1))
+        return false;
+      i[d] = haero::min(static_cast<int>(x[d]), n[d] - 2);
+      w[d] = x[d] - i[d];
+    }
+    for (int v = 0; v < num_values; ++v)
+      values[v] = 0;
+    for (int c = 0; c < 8; ++c) {
+      const int c0 = c & 1, c1 = (c >> 1) & 1, c2 = (c >> 2) & 1;
+      const Real wc = (c0 ? w[0] : 1 - w[0]) * (c1 ? w[1] : 1 - w[1]) *
+                      (c2 ? w[2] : 1 - w[2]);
+      for (int v = 0; v < num_values; ++v)
+        values[v] += wc * table(ip, i[0] + c0, i[1] + c1, i[2] + c2, v);
+    }
+    return true;
+  }
+};
+
+/// CoagulationTables holds, in device memory, the correction factors for the
+/// free-molecular intermodal coagulation rates of the 0th (bm0ij) and 3rd
+/// (bm3i) moments, indexed as by bm0ij_data and bm3i_data. It is created once
+/// by create_coagulation_tables (called by Coagulation::init) and is read-only
+/// thereafter.
+struct CoagulationTables {
+  using TableView = DeviceType::view_3d<const TableReal>;
+
+  TableView bm0ij_table;
+  TableView bm3i_table;
+
+  // coagulation coefficients tabulated by create_coagulation_rate_table, if
+  // requested
+  CoagulationRateTable rates;
+
+  KOKKOS_INLINE_FUNCTION
+  Real bm0ij(const int n1, const int n2a, const int n2n) const {
+    return bm0ij_table(n1, n2a, n2n);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  Real bm3i(const int n1, const int n2a, const int n2n) const {
+    return bm3i_table(n1, n2a, n2n);
+  }
+};
+
+} // namespace coagulation
+
 /// @class Coagulation
 /// This class implements MAM4's gas/aersol exchange  parameterization. Its
 /// structure is defined by the usage of the impl_ member in the AeroProcess
@@ -38,6 +144,20 @@ public:
     Config(const Config &) = default;
     ~Config() = default;
     Config &operator=(const Config &) = default;
+
+    // if true, init tabulates the coagulation coefficients on rate_grid and
+    // they are interpolated instead of computed analytically, trading a few
+    // tenths of a percent of accuracy for speed
+    bool tabulate_rates = false;
+    coagulation::CoagulationRateGrid rate_grid;
+
+    // if true (and pack_size is 1), the work within each level is spread over
+    // the vector lanes of the thread handling it: the coagulation pairs are
+    // computed concurrently, and so are the mass transfers of the aerosol
+    // species. This pays off when a column has fewer levels than a team has
+    // threads, provided the launch has a vector length > 1 (see
+    // column_batch_team_policy).
+    bool use_vector_lanes = false;
   };
 
   // name -- unique name of the process implemented by this class
@@ -68,16 +188,24 @@ public:
                           const Diagnostics &diags,
                           const Tendencies &tends) const;
 
+  // tables -- returns the correction-factor tables created by init
+  KOKKOS_INLINE_FUNCTION
+  const coagulation::CoagulationTables &tables() const { return tables_; }
+
 private:
   // Gas-Aerosol-Exchange-specific configuration
   Config config_;
+
+  // device-resident correction-factor tables
+  coagulation::CoagulationTables tables_;
 };
 
 namespace coagulation {
 
 KOKKOS_INLINE_FUNCTION
 Real bm0ij_data(const int n1, const int n2a, const int n2n) {
-  const Real bm0ij[10][10][10] = {
+  // tabulated with 6 significant digits, so TableReal loses nothing
+  const TableReal bm0ij[10][10][10] = {
       {{0.628539, 0.63961, 0.664514, 0.696278, 0.731558, 0.768211, 0.80448,
         0.83883, 0.870024, 0.897248},
        {0.639178, 0.649966, 0.674432, 0.705794, 0.740642, 0.776751, 0.812323,
@@ -292,30 +420,37 @@ Real bm0ij_data(const int n1, const int n2a, const int n2n) {
 //    Hui Wan, 2022 following a suggestion from Balwinder Singh.
 //---------------------------------------------------------------
 
-KOKKOS_INLINE_FUNCTION
-void intermodal_coag_rate_for_0th_moment(
-    const Real a_const, const Real r1, const Real r2, const Real rx4,
-    const Real ri1, const Real ri2, const Real ri3, const Real knc,
-    const Real kngat, const Real kngac, const Real kfmatac, const Real sqdgat,
+// The level-dependent arguments may be scalars or packs of levels (VT), in
+// which case n1 is a pack of table indices (IT). The correction factors are
+// read from tables (a CoagulationTables or InlineCoagulationTables).
+template <typename VT, typename IT, typename Tables>
+KOKKOS_INLINE_FUNCTION void intermodal_coag_rate_for_0th_moment(
+    const Real a_const, const VT &r1, const VT &r2, const VT &rx4,
+    const VT &ri1, const VT &ri2, const VT &ri3, const VT &knc,
+    const VT &kngat, const VT &kngac, const VT &kfmatac, const VT &sqdgat,
     const Real esat01, const Real esat04, const Real esat09, const Real esat16,
     const Real esac01, const Real esac04, const Real esac09, const Real esac16,
-    const int n1, const int n2a, const int n2n, Real &qn12) {
+    const IT &n1, const int n2a, const int n2n, const Tables &tables,
+    VT &qn12) {
 
-  const Real bm0ij = bm0ij_data(n1, n2n, n2a);
+  using PT = PackTraits<VT>;
+  VT bm0ij;
+  for (int s = 0; s < PT::size; ++s)
+    PT::lane(bm0ij, s) = tables.bm0ij(PackTraits<IT>::lane(n1, s), n2n, n2a);
 
   // --------------
   // Calculations
   // --------------
   // Near-continuum form:  equation h.10a of whitby et al. (1991)
 
-  const Real coagnc0 =
+  const VT coagnc0 =
       knc * (2.0 +
              a_const * (kngat * (esat04 + r2 * esat16 * esac04) +
                         kngac * (esac04 + ri2 * esac16 * esat04)) +
              (r2 + ri2) * esat04 * esac04);
 
   // Free-molecular form:  equation h.7a of whitby et al. (1991)
-  const Real coagfm0 = kfmatac * sqdgat * bm0ij *
+  const VT coagfm0 = kfmatac * sqdgat * bm0ij *
                        (esat01 + r1 * esac01 + 2.0 * r2 * esat01 * esac04 +
                         rx4 * esat09 * esac16 + ri3 * esat16 * esac09 +
                         2.0 * ri1 * esat04 + esac01);
@@ -329,7 +464,7 @@ Real bm3i_data(const int n1, const int n2a, const int n2n) {
   // rpm....   3rd moment nuclei mode corr. fac. for bimodal fm coag rate
   // m3 intermodal fm-rpm values
 
-  const Real bm3i[10][10][10] = {
+  const TableReal bm3i[10][10][10] = {
       {{0.70708, 0.71681, 0.73821, 0.76477, 0.7935, 0.82265, 0.8509, 0.87717,
         0.90069, 0.92097},
        {0.72172, 0.73022, 0.74927, 0.77324, 0.79936, 0.82601, 0.85199, 0.87637,
@@ -534,6 +669,46 @@ Real bm3i_data(const int n1, const int n2a, const int n2n) {
   return bm3i[n1][n2a][n2n];
 }
 
+/// InlineCoagulationTables provides the interface of CoagulationTables using
+/// the tables built within bm0ij_data and bm3i_data. It is used by callers
+/// that have no CoagulationTables (e.g. host-side drivers).
+struct InlineCoagulationTables {
+  KOKKOS_INLINE_FUNCTION
+  Real bm0ij(const int n1, const int n2a, const int n2n) const {
+    return bm0ij_data(n1, n2a, n2n);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  Real bm3i(const int n1, const int n2a, const int n2n) const {
+    return bm3i_data(n1, n2a, n2n);
+  }
+};
+
+/// Creates the device-resident correction-factor tables from bm0ij_data and
+/// bm3i_data.
+inline CoagulationTables create_coagulation_tables() {
+  const int n = 10;
+  DeviceType::view_3d<TableReal> bm0ij("coagulation_bm0ij", n, n, n);
+  DeviceType::view_3d<TableReal> bm3i("coagulation_bm3i", n, n, n);
+  auto h_bm0ij = Kokkos::create_mirror_view(bm0ij);
+  auto h_bm3i = Kokkos::create_mirror_view(bm3i);
+  for (int n1 = 0; n1 < n; ++n1) {
+    for (int n2a = 0; n2a < n; ++n2a) {
+      for (int n2n = 0; n2n < n; ++n2n) {
+        h_bm0ij(n1, n2a, n2n) = bm0ij_data(n1, n2a, n2n);
+        h_bm3i(n1, n2a, n2n) = bm3i_data(n1, n2a, n2n);
+      }
+    }
+  }
+  Kokkos::deep_copy(bm0ij, h_bm0ij);
+  Kokkos::deep_copy(bm3i, h_bm3i);
+
+  CoagulationTables tables;
+  tables.bm0ij_table = bm0ij;
+  tables.bm3i_table = bm3i;
+  return tables;
+}
+
 // ---------------------------------------------------------------------------
 // Purpose: calculate the intermodal coagulation rate for the 3rd moment
 //          using an  analytic expression from Whitby et al. (1991).
@@ -543,31 +718,34 @@ Real bm3i_data(const int n1, const int n2a, const int n2n) {
 //  - Contents here wrapped in a separate subroutine by
 //    Hui Wan, 2022 following a suggestion from Balwinder Singh.
 // ---------------------------------------------------------------------------
-KOKKOS_INLINE_FUNCTION
-void intermodal_coag_rate_for_3rd_moment(
-    const Real a_const, const Real r1, const Real r2, const Real rx4,
-    const Real ri1, const Real ri2, const Real ri3, const Real knc,
-    const Real kngat, const Real kngac, const Real dgat3, const Real kfmatac,
-    const Real sqdgat7, const Real esat04, const Real esat09, const Real esat16,
+template <typename VT, typename IT, typename Tables>
+KOKKOS_INLINE_FUNCTION void intermodal_coag_rate_for_3rd_moment(
+    const Real a_const, const VT &r1, const VT &r2, const VT &rx4,
+    const VT &ri1, const VT &ri2, const VT &ri3, const VT &knc,
+    const VT &kngat, const VT &kngac, const VT &dgat3, const VT &kfmatac,
+    const VT &sqdgat7, const Real esat04, const Real esat09, const Real esat16,
     const Real esat25, const Real esat36, const Real esat49, const Real esat64,
     const Real esac01, const Real esac04, const Real esac09, const Real esac16,
-    const Real esat100, const int n1, const int n2a, const int n2n,
-    Real &qv12) {
+    const Real esat100, const IT &n1, const int n2a, const int n2n,
+    const Tables &tables, VT &qv12) {
 
-  const Real bm3i = bm3i_data(n1, n2n, n2a);
+  using PT = PackTraits<VT>;
+  VT bm3i;
+  for (int s = 0; s < PT::size; ++s)
+    PT::lane(bm3i, s) = tables.bm3i(PackTraits<IT>::lane(n1, s), n2n, n2a);
   // --------------
   // Calculations
   // --------------
   // Near-continuum form: equation h.10b of whitby et al. (1991)
 
-  const Real coagnc3 =
+  const VT coagnc3 =
       knc * dgat3 *
       (2.0 * esat36 + a_const * kngat * (esat16 + r2 * esat04 * esac04) +
        a_const * kngac * (esat36 * esac04 + ri2 * esat64 * esac16) +
        r2 * esat16 * esac04 + ri2 * esat64 * esac04);
 
   // Free-molecular form: equation h.7b of whitby et al. (1991)
-  const Real coagfm3 = kfmatac * sqdgat7 * bm3i *
+  const VT coagfm3 = kfmatac * sqdgat7 * bm3i *
                        (esat49 + r1 * esat36 * esac01 +
                         2.0 * r2 * esat25 * esac04 + rx4 * esat09 * esac16 +
                         ri3 * esat100 * esac09 + 2.0 * ri1 * esat64 * esac01);
@@ -576,14 +754,12 @@ void intermodal_coag_rate_for_3rd_moment(
   qv12 = coagnc3 * coagfm3 / (coagnc3 + coagfm3);
 }
 
-KOKKOS_INLINE_FUNCTION
-void intramodal_coag_rate_for_0th_moment(const Real a_const, const Real knc,
-                                         const Real kngxx, const Real kfmxx,
-                                         const Real sqdgxx, const Real esxx01,
-                                         const Real esxx04, const Real esxx05,
-                                         const Real esxx08, const Real esxx20,
-                                         const Real esxx25, const int n2x,
-                                         Real &qnxx) {
+template <typename VT>
+KOKKOS_INLINE_FUNCTION void intramodal_coag_rate_for_0th_moment(
+    const Real a_const, const VT &knc, const VT &kngxx, const VT &kfmxx,
+    const VT &sqdgxx, const Real esxx01, const Real esxx04, const Real esxx05,
+    const Real esxx08, const Real esxx20, const Real esxx25, const int n2x,
+    VT &qnxx) {
 
   // rpm 0th moment correction factors for unimodal fm coagulation  rates
   // m0 intramodal fm - rpm values
@@ -596,11 +772,11 @@ void intramodal_coag_rate_for_0th_moment(const Real a_const, const Real knc,
   // Calculations
   // --------------
   // Near-continuum form: equation h.12a of whitby et al. (1991)
-  const Real coagnc =
+  const VT coagnc =
       knc * (1.0 + esxx08 + a_const * kngxx * (esxx20 + esxx04));
 
   // Free-molecular form: equation h.11a of whitby et al. (1991)
-  const Real coagfm =
+  const VT coagfm =
       kfmxx * sqdgxx * bm0[n2x] * (esxx01 + esxx25 + 2.0 * esxx05);
 
   // Harmonic mean
@@ -644,13 +820,19 @@ void intramodal_coag_rate_for_0th_moment(const Real a_const, const Real knc,
 //   multiscale air quality (cmaq) model aerosol component 1:
 //   model description.  j. geophys. res., vol 108, no d6, 4183
 //   doi:10.1029/2001jd001409, 2003.
+//
+//  The level-dependent arguments may be scalars or packs of levels (VT); the
+//  mode standard deviations are the same for all levels. The intermodal
+//  correction factors are read from tables.
 // --------------------------------------------------------
-KOKKOS_INLINE_FUNCTION
-void getcoags(const Real lamda, const Real kfmatac, const Real kfmat,
-              const Real kfmac, const Real knc, const Real dgatk,
-              const Real dgacc, const Real sgatk, const Real sgacc,
-              const Real xxlsgat, const Real xxlsgac, Real &qn11, Real &qn22,
-              Real &qn12, Real &qv12) {
+template <typename VT, typename Tables = InlineCoagulationTables>
+KOKKOS_INLINE_FUNCTION void
+getcoags(const VT &lamda, const VT &kfmatac, const VT &kfmat, const VT &kfmac,
+         const VT &knc, const VT &dgatk, const VT &dgacc, const Real sgatk,
+         const Real sgacc, const Real xxlsgat, const Real xxlsgac, VT &qn11,
+         VT &qn22, VT &qn12, VT &qv12, const Tables &tables = Tables()) {
+  using haero::sqrt;
+  using PT = PackTraits<VT>;
 
   const Real a_const = 1.246;
   const Real esat01 = haero::exp(0.125 * xxlsgat * xxlsgat);
@@ -689,24 +871,24 @@ void getcoags(const Real lamda, const Real kfmatac, const Real kfmat,
 
   const Real esat100 = esat64 * esat36;
 
-  const Real dgat3 = dgatk * dgatk * dgatk;
+  const VT dgat3 = dgatk * dgatk * dgatk;
 
-  const Real sqdgat = haero::sqrt(dgatk);
-  const Real sqdgac = haero::sqrt(dgacc);
-  const Real sqdgat7 = dgat3 * sqdgat;
+  const VT sqdgat = sqrt(dgatk);
+  const VT sqdgac = sqrt(dgacc);
+  const VT sqdgat7 = dgat3 * sqdgat;
 
-  const Real r1 = sqdgac / sqdgat;
-  const Real r2 = r1 * r1;
-  const Real rx4 = r2 * r2;
-  const Real ri1 = 1.0 / r1;
-  const Real ri2 = 1.0 / (r1 * r1);
-  const Real ri3 = 1.0 / (r1 * r1 * r1);
-  const Real kngat = 2.0 * lamda / dgatk;
-  const Real kngac = 2.0 * lamda / dgacc;
+  const VT r1 = sqdgac / sqdgat;
+  const VT r2 = r1 * r1;
+  const VT rx4 = r2 * r2;
+  const VT ri1 = 1.0 / r1;
+  const VT ri2 = 1.0 / (r1 * r1);
+  const VT ri3 = 1.0 / (r1 * r1 * r1);
+  const VT kngat = 2.0 * lamda / dgatk;
+  const VT kngac = 2.0 * lamda / dgacc;
 
   //  Calculate ratio of geometric mean diameters
 
-  const Real rat = dgacc / dgatk;
+  const VT rat = dgacc / dgatk;
 
   // Trap subscripts for bm0 and bm0i, between 1 and 10.
   // See page h.5 of whitby et al. (1991)
@@ -714,10 +896,13 @@ void getcoags(const Real lamda, const Real kfmatac, const Real kfmat,
       haero::max(1, haero::min(10, haero::round(4.0 * (sgatk - 0.75)))) - 1;
   const int n2a =
       haero::max(1, haero::min(10, haero::round(4.0 * (sgacc - 0.75)))) - 1;
-  const int n1 =
-      haero::max(1,
-                 haero::min(10, 1 + haero::round(dlgsqt2 * haero::log(rat)))) -
-      1;
+  // (n1 depends on the level, so it is computed lane by lane)
+  typename PT::int_type n1;
+  for (int s = 0; s < PT::size; ++s) {
+    const Real lnrat = haero::log(PT::lane(rat, s));
+    PackTraits<typename PT::int_type>::lane(n1, s) =
+        haero::max(1, haero::min(10, 1 + haero::round(dlgsqt2 * lnrat))) - 1;
+  }
 
   // -----------------------------------------------------------------
   //  Aitken to accumulation mode coagulation rate for the 0th moment
@@ -725,7 +910,8 @@ void getcoags(const Real lamda, const Real kfmatac, const Real kfmat,
   intermodal_coag_rate_for_0th_moment(a_const, r1, r2, rx4, ri1, ri2, ri3, knc,
                                       kngat, kngac, kfmatac, sqdgat, esat01,
                                       esat04, esat09, esat16, esac01, esac04,
-                                      esac09, esac16, n1, n2a, n2n, qn12);
+                                      esac09, esac16, n1, n2a, n2n, tables,
+                                      qn12);
 
   // -----------------------------------------------------------------
   // Aitken to accumulation mode coagulation rate for the 3rd moment
@@ -733,7 +919,7 @@ void getcoags(const Real lamda, const Real kfmatac, const Real kfmat,
   intermodal_coag_rate_for_3rd_moment(
       a_const, r1, r2, rx4, ri1, ri2, ri3, knc, kngat, kngac, dgat3, kfmatac,
       sqdgat7, esat04, esat09, esat16, esat25, esat36, esat49, esat64, esac01,
-      esac04, esac09, esac16, esat100, n1, n2a, n2n, qv12);
+      esac04, esac09, esac16, esat100, n1, n2a, n2n, tables, qv12);
 
   // --------------------------------------------------------
   // Intramodal coagulation (0th moment only), aitken mode
@@ -750,44 +936,81 @@ void getcoags(const Real lamda, const Real kfmatac, const Real kfmat,
                                       esac25, n2a, qn22);
 }
 
-KOKKOS_INLINE_FUNCTION
-void getcoags_wrapper_f(const Real airtemp, const Real airprs, const Real dgatk,
-                        const Real dgacc, const Real sgatk, const Real sgacc,
-                        const Real xxlsgat, const Real xxlsgac,
-                        const Real pdensat, const Real pdensac, Real &betaij0,
-                        Real &betaij3, Real &betaii0, Real &betajj0) {
+// Computes the inputs of getcoags that depend on the state of the air: the
+// mean free path lamda [m] and the factors knc, kfmat, kfmac and kfmatac of
+// the near-continuum and free-molecular kernels.
+template <typename VT>
+KOKKOS_INLINE_FUNCTION void
+coag_kernel_factors(const VT &airtemp, const VT &airprs, const VT &pdensat,
+                    const VT &pdensac, VT &lamda, VT &knc, VT &kfmat,
+                    VT &kfmac, VT &kfmatac) {
+  using haero::sqrt;
 
-  // -----------------------------------------------
-  // Prepare input to getcoags
-  // -----------------------------------------------
   const Real t0 = haero::Constants::freezing_pt_h2o + 15.0;
-  const Real sqrt_temp = haero::sqrt(airtemp);
+  const VT sqrt_temp = sqrt(airtemp);
 
   // Calculate mean free path [m]:
   // 6.6328e-8 is the sea level value given in table i.2.8
   // on page 10 of u.s. standard atmosphere 1962
   // BAD CONSTANT
-  const Real lamda =
-      6.6328e-8 * haero::Constants::pressure_stp * airtemp / (t0 * airprs);
+  lamda = 6.6328e-8 * haero::Constants::pressure_stp * airtemp / (t0 * airprs);
 
   //  Calculate dynamic viscosity [kg m**-1 s**-1]:
   // u.s. standard atmosphere 1962 page 14 expression
   // for dynamic viscosity is:
   // dynamic viscosity =  beta * t * sqrt(t) / ( t + s)
   // where beta = 1.458e-6 [kg s^-1 K**-0.5], s = 110.4 [K].
-  const Real amu = 1.458e-6 * airtemp * sqrt_temp / (airtemp + 110.4);
+  const VT amu = 1.458e-6 * airtemp * sqrt_temp / (airtemp + 110.4);
 
   // Term used in equation a6 of binkowski & shankar (1995)
   // boltzmann BAD CONSTANT
   const Real boltzmann = 1.3806500000000000e-023;
-  const Real knc = (2.0 / 3.0) * boltzmann * airtemp / amu;
+  knc = (2.0 / 3.0) * boltzmann * airtemp / amu;
 
   // Terms used in equation a5 of binkowski & shankar (1995)
 
-  const Real kfmat = haero::sqrt(3.0 * boltzmann * airtemp / pdensat);
-  const Real kfmac = haero::sqrt(3.0 * boltzmann * airtemp / pdensac);
-  const Real kfmatac =
-      haero::sqrt(6.0 * boltzmann * airtemp / (pdensat + pdensac));
+  kfmat = sqrt(3.0 * boltzmann * airtemp / pdensat);
+  kfmac = sqrt(3.0 * boltzmann * airtemp / pdensac);
+  kfmatac = sqrt(6.0 * boltzmann * airtemp / (pdensat + pdensac));
+}
+
+// Converts the coefficients computed by getcoags to the coagulation
+// coefficients [m3/s] used by MAM4.
+template <typename VT>
+KOKKOS_INLINE_FUNCTION void
+coag_betas(const VT &dgatk, const Real xxlsgat, const VT &qn11,
+           const VT &qn22, const VT &qn12, const VT &qv12, VT &betaij0,
+           VT &betaij3, VT &betaii0, VT &betajj0) {
+  using haero::max;
+
+  //  Clip negative values
+
+  betaii0 = max(0.0, qn11);
+  betajj0 = max(0.0, qn22);
+  betaij0 = max(0.0, qn12);
+
+  // For the mass transfer, convert from the CMAQ model's coag rate parameters
+  // to the MIRAGE2 model's parameters
+  const VT dumatk3 =
+      (dgatk * dgatk * dgatk *
+       haero::exp(4.5 * xxlsgat * xxlsgat)); // or unit conversion
+  betaij3 = max(0.0, qv12 / dumatk3);
+}
+
+// The level-dependent arguments may be scalars or packs of levels (VT).
+template <typename VT, typename Tables = InlineCoagulationTables>
+KOKKOS_INLINE_FUNCTION void
+getcoags_wrapper_f(const VT &airtemp, const VT &airprs, const VT &dgatk,
+                   const VT &dgacc, const Real sgatk, const Real sgacc,
+                   const Real xxlsgat, const Real xxlsgac, const VT &pdensat,
+                   const VT &pdensac, VT &betaij0, VT &betaij3, VT &betaii0,
+                   VT &betajj0, const Tables &tables = Tables()) {
+  // -----------------------------------------------
+  // Prepare input to getcoags
+  // -----------------------------------------------
+  VT lamda, knc, kfmat, kfmac, kfmatac;
+  coag_kernel_factors(airtemp, airprs, pdensat, pdensac, lamda, knc, kfmat,
+                      kfmac, kfmatac);
 
   // -------------------------------------------------------------------------------------------------
   // Call subr. getcoags ported from the CMAQ model to calculate
@@ -799,26 +1022,191 @@ void getcoags_wrapper_f(const Real airtemp, const Real airprs, const Real dgatk,
   //  - Coag. coefficient  of the 3rd moment (qv12) correspond to aerosol mass
   //  changes.
   //-------------------------------------------------------------------------------------------------
-  Real qn11, qn22, qn12, qv12;
+  VT qn11, qn22, qn12, qv12;
 
   getcoags(lamda, kfmatac, kfmat, kfmac, knc, dgatk, dgacc, sgatk, sgacc,
-           xxlsgat, xxlsgac, qn11, qn22, qn12, qv12);
+           xxlsgat, xxlsgac, qn11, qn22, qn12, qv12, tables);
 
   // --------------------------------------------------------------------
   //  Adjustments to the output from subr. getcoags
   // --------------------------------------------------------------------
-  //  Clip negative values
+  coag_betas(dgatk, xxlsgat, qn11, qn22, qn12, qv12, betaij0, betaij3,
+             betaii0, betajj0);
+}
 
-  betaii0 = haero::max(0.0, qn11);
-  betajj0 = haero::max(0.0, qn22);
-  betaij0 = haero::max(0.0, qn12);
+// Computes the coagulation coefficients of coagulation pair ip like
+// getcoags_wrapper_f, interpolating them from the rate table of the given
+// tables where possible. Returns false (computing nothing) if the tables hold
+// no rate table, which InlineCoagulationTables never do.
+template <typename VT>
+KOKKOS_INLINE_FUNCTION bool
+tabulated_coag_rates(const InlineCoagulationTables &tables, const int ip,
+                     const VT &airtemp, const VT &airprs, const VT &dgatk,
+                     const VT &dgacc, const Real sgatk, const Real sgacc,
+                     const Real xxlsgat, const Real xxlsgac, const VT &pdensat,
+                     const VT &pdensac, VT &betaij0, VT &betaij3, VT &betaii0,
+                     VT &betajj0) {
+  return false;
+}
 
-  // For the mass transfer, convert from the CMAQ model's coag rate parameters
-  // to the MIRAGE2 model's parameters
-  const Real dumatk3 =
-      (haero::cube(dgatk) *
-       haero::exp(4.5 * xxlsgat * xxlsgat)); // or unit conversion
-  betaij3 = haero::max(0.0, qv12 / dumatk3);
+template <typename VT>
+KOKKOS_INLINE_FUNCTION bool
+tabulated_coag_rates(const CoagulationTables &tables, const int ip,
+                     const VT &airtemp, const VT &airprs, const VT &dgatk,
+                     const VT &dgacc, const Real sgatk, const Real sgacc,
+                     const Real xxlsgat, const Real xxlsgac, const VT &pdensat,
+                     const VT &pdensac, VT &betaij0, VT &betaij3, VT &betaii0,
+                     VT &betajj0) {
+  if (!tables.rates.enabled())
+    return false;
+
+  VT lamda, knc, kfmat, kfmac, kfmatac;
+  coag_kernel_factors(airtemp, airprs, pdensat, pdensac, lamda, knc, kfmat,
+                      kfmac, kfmatac);
+
+  using PT = PackTraits<VT>;
+  VT qn11, qn22, qn12, qv12;
+  for (int s = 0; s < PT::size; ++s) {
+    Real v[CoagulationRateTable::num_values];
+    if (tables.rates.interpolate(ip, PT::lane(lamda, s), PT::lane(dgatk, s),
+                                 PT::lane(dgacc, s), v)) {
+      const Real kn = PT::lane(knc, s);
+      const Real kfm[4] = {PT::lane(kfmat, s), PT::lane(kfmac, s),
+                           PT::lane(kfmatac, s), PT::lane(kfmatac, s)};
+      Real q[4];
+      for (int i = 0; i < 4; ++i)
+        q[i] = kn * kfm[i] / (v[2 * i] * kfm[i] + v[2 * i + 1] * kn);
+      PT::lane(qn11, s) = q[0];
+      PT::lane(qn22, s) = q[1];
+      PT::lane(qn12, s) = q[2];
+      PT::lane(qv12, s) = q[3];
+    } else {
+      // outside the grid: compute the coefficients analytically
+      getcoags(PT::lane(lamda, s), PT::lane(kfmatac, s), PT::lane(kfmat, s),
+               PT::lane(kfmac, s), PT::lane(knc, s), PT::lane(dgatk, s),
+               PT::lane(dgacc, s), sgatk, sgacc, xxlsgat, xxlsgac,
+               PT::lane(qn11, s), PT::lane(qn22, s), PT::lane(qn12, s),
+               PT::lane(qv12, s), tables);
+    }
+  }
+
+  coag_betas(dgatk, xxlsgat, qn11, qn22, qn12, qv12, betaij0, betaij3,
+             betaii0, betajj0);
+  return true;
+}
+
+// fractions of the mass of a species transferred between modes by
+// coagulation over one timestep (see mam_coag_aer_transfer)
+struct CoagMassTransfer {
+  // true if mass leaves the aitken mode, the fraction of it that leaves, and
+  // the portions of the lost mass going to the accumulation and pca modes
+  bool from_aitken;
+  Real aitken_lost, to_accum, to_pca;
+  // true if mass leaves the pca mode, and the fraction of it that leaves (to
+  // the accumulation mode)
+  bool from_pca;
+  Real pca_lost;
+};
+
+// Computes the fractions of the mass of each species transferred between modes
+// by coagulation given the time-averaged number mixing ratios.
+KOKKOS_INLINE_FUNCTION
+CoagMassTransfer
+mam_coag_aer_transfer(const Real ybetaij3[Coagulation::max_coagpair],
+                      const Real deltat,
+                      const Real qnum_tavg[AeroConfig::num_modes()]) {
+  constexpr int nacc = static_cast<int>(ModeIndex::Accumulation);
+  constexpr int npca = static_cast<int>(ModeIndex::PrimaryCarbon);
+  constexpr Real epsilonx2 = haero::epsilon() * 2.0;
+
+  CoagMassTransfer xfer = {false, 0, 0, 0, false, 0};
+
+  // --------------------------------------------------------------------
+  //  Mass transfer out of aitken mode. Two coag pairs are involved:
+  // - coag pair 1: aitken + accumulation -> accumulation
+  // - coag pair 3: aitken + pca          -> pca
+  // --------------------------------------------------------------------
+  // Calculate the rate of mass transfer into different destination modes and
+  // the sum over all modes
+  const Real bijqnumj1 = haero::max(0.0, ybetaij3[0] * qnum_tavg[nacc]);
+  const Real bijqnumj2 = haero::max(0.0, ybetaij3[2] * qnum_tavg[npca]);
+  Real decay_const = bijqnumj1 + bijqnumj2;
+
+  Real decay_factor =
+      deltat * decay_const; // calculate coag-induced changes only when this
+                            // number is not ~= zero
+  if (decay_factor > epsilonx2) {
+    // Portions of mass going into different modes
+    xfer.from_aitken = true;
+    xfer.to_pca = bijqnumj2 / decay_const;
+    xfer.to_accum = 1.0 - xfer.to_pca;
+    // total fraction lost from aitken mode
+    xfer.aitken_lost = 1.0 - haero::exp(-decay_factor);
+  }
+
+  // --------------------------------------------------------------------
+  //  Mass transfer out of pcarbon mode. Only one coag pair is involved:
+  // - coag pair 2: pca + accumulation -> accumulation
+  // --------------------------------------------------------------------
+  decay_const = haero::max(
+      0.0, ybetaij3[1] * qnum_tavg[nacc]); // there is only 1 destination
+
+  decay_factor = deltat * decay_const; // calculate coag-induced changes only
+                                       // when this number is not ~= zero
+  if (decay_factor > epsilonx2) {
+    xfer.from_pca = true;
+    // total fraction lost from pca mode
+    xfer.pca_lost = 1.0 - haero::exp(-decay_factor);
+  }
+  return xfer;
+}
+
+// Marks the species of the aitken mode, which are the only ones that
+// coagulation moves out of it.
+KOKKOS_INLINE_FUNCTION
+void coag_aitken_species(bool aitken_species[AeroConfig::num_aerosol_ids()]) {
+  constexpr int nait = static_cast<int>(ModeIndex::Aitken);
+  for (int iaer = 0; iaer < AeroConfig::num_aerosol_ids(); ++iaer)
+    aitken_species[iaer] = false;
+  for (int ispec = 0; ispec < AeroConfig::num_species_in_mode(nait); ++ispec)
+    aitken_species[AeroConfig::mode_species(nait, ispec)] = true;
+}
+
+// Transfers the mass of one aerosol species between modes given the
+// fractions computed by mam_coag_aer_transfer, adding the mass gained by the
+// pca mode to qaer_del_coag_pca (for aging). Each species is independent of
+// the others; aitken_species tells whether the species is in the aitken mode.
+KOKKOS_INLINE_FUNCTION
+void mam_coag_aer_update_1spec(const bool aitken_species,
+                               const CoagMassTransfer &xfer,
+                               const Real qaer_bgn[AeroConfig::num_modes()],
+                               Real qaer_end[AeroConfig::num_modes()],
+                               Real &qaer_del_coag_pca) {
+  constexpr int nacc = static_cast<int>(ModeIndex::Accumulation);
+  constexpr int npca = static_cast<int>(ModeIndex::PrimaryCarbon);
+  constexpr int nait = static_cast<int>(ModeIndex::Aitken);
+
+  if (xfer.from_aitken && aitken_species) {
+    const Real tmp_dq =
+        xfer.aitken_lost * qaer_bgn[nait]; // total amount lost from aitken mode
+    qaer_end[nait] -= tmp_dq;              // subtract from aitken mode
+    qaer_end[nacc] +=
+        tmp_dq * xfer.to_accum; // add a portion to accumulation mode
+    qaer_end[npca] += tmp_dq * xfer.to_pca; // add a portion to pca mode
+
+    // to_pca (pair 3) corresponds to mass transfer to pca mode, which will
+    // lead to aging. Add this amount to the total mass gained by pca mode, to
+    // be used in the aging parameterization.
+    qaer_del_coag_pca += tmp_dq * xfer.to_pca;
+  }
+  // NOTE: all species can leave the pca mode, since it also holds the so4 and
+  // soa condensed onto it until aging moves them to accumulation
+  if (xfer.from_pca) {
+    const Real tmp_dq =
+        xfer.pca_lost * qaer_bgn[npca]; // total amount lost from pca mode
+    qaer_end[npca] -= tmp_dq;           //  subtract from pca mode
+    qaer_end[nacc] += tmp_dq;           // add to accumulaiton mode
+  }
 }
 
 // --------------------------------------------------------
@@ -870,67 +1258,14 @@ void mam_coag_aer_update(
     }
   }
 
-  // --------------------------------------------------------------------
-  //  Mass transfer out of aitken mode. Two coag pairs are involved:
-  // - coag pair 1: aitken + accumulation -> accumulation
-  // - coag pair 3: aitken + pca          -> pca
-  // --------------------------------------------------------------------
-  // Calculate the rate of mass transfer into different destination modes and
-  // the sum over all modes
-
-  const int nacc = static_cast<int>(ModeIndex::Accumulation);
-  const int npca = static_cast<int>(ModeIndex::PrimaryCarbon);
-  const int nait = static_cast<int>(ModeIndex::Aitken);
-
-  const Real bijqnumj1 = haero::max(0.0, ybetaij3[0] * qnum_tavg[nacc]);
-  const Real bijqnumj2 = haero::max(0.0, ybetaij3[2] * qnum_tavg[npca]);
-  Real decay_const = bijqnumj1 + bijqnumj2;
-
-  constexpr Real epsilonx2 = haero::epsilon() * 2.0;
-  Real decay_factor =
-      deltat * decay_const; // calculate coag-induced changes only when this
-                            // number is not ~= zero
-
-  if (decay_factor > epsilonx2) {
-
-    // Portions of mass going into different modes
-    const Real prtn2 = bijqnumj2 / decay_const;
-    const Real prtn1 = 1.0 - prtn2;
-    const Real tmp_xf =
-        1.0 - haero::exp(-decay_factor); // total fraction lost from aitken mode
-    for (int iaer = 0; iaer < num_aer; ++iaer) {
-      const Real tmp_dq =
-          tmp_xf * qaer_bgn[iaer][nait]; // total amount lost from aitken mode
-      qaer_end[iaer][nait] -= tmp_dq;    // subtract from aitken mode
-      qaer_end[iaer][nacc] +=
-          tmp_dq * prtn1; // add a portion to accumulation mode
-      qaer_end[iaer][npca] += tmp_dq * prtn2; // add a portion to pca mode
-
-      // prtn2 (pair 3) corresponds to mass transfer to pca mode, which will
-      // lead to aging. Add this amount to the total mass gained by pca mode, to
-      // be used in the aging parameterization.
-      qaer_del_coag_out[iaer][Coagulation::i_agepair_pca] += tmp_dq * prtn2;
-    }
-  }
-
-  // --------------------------------------------------------------------
-  //  Mass transfer out of pcarbon mode. Only one coag pair is involved:
-  // - coag pair 2: pca + accumulation -> accumulation
-  // --------------------------------------------------------------------
-  decay_const = haero::max(
-      0.0, ybetaij3[1] * qnum_tavg[nacc]); // there is only 1 destination
-
-  decay_factor = deltat * decay_const; // calculate coag-induced changes only
-                                       // when this number is not ~= zero
-  if (decay_factor > epsilonx2) {
-    const Real tmp_xf =
-        1.0 - haero::exp(-decay_factor); // total fraction lost from pca mode
-    for (int iaer = 0; iaer < num_aer; ++iaer) {
-      const Real tmp_dq =
-          tmp_xf * qaer_bgn[iaer][npca]; // total amount lost from pca mode
-      qaer_end[iaer][npca] -= tmp_dq;    //  subtract from pca mode
-      qaer_end[iaer][nacc] += tmp_dq;    // add to accumulaiton mode
-    }
+  const CoagMassTransfer xfer =
+      mam_coag_aer_transfer(ybetaij3, deltat, qnum_tavg);
+  bool aitken_species[AeroConfig::num_aerosol_ids()];
+  coag_aitken_species(aitken_species);
+  for (int iaer = 0; iaer < num_aer; ++iaer) {
+    mam_coag_aer_update_1spec(
+        aitken_species[iaer], xfer, qaer_bgn[iaer], qaer_end[iaer],
+        qaer_del_coag_out[iaer][Coagulation::i_agepair_pca]);
   }
 }
 
@@ -1039,11 +1374,210 @@ void mam_coag_num_update(Real ybetaij0[Coagulation::max_coagpair],
 // This function is called by MAM4's microphysics driver for clear-air
 // conditions.
 // -----------------------------------------------------------------------------------------
+// Returns the source and destination modes of coagulation pair ip.
 KOKKOS_INLINE_FUNCTION
-void mam_coag_1subarea(
-    const Real deltat, const Real temp, const Real pmid, const Real aircon,
-    Real dgn_a[AeroConfig::num_modes()], Real dgn_awet[AeroConfig::num_modes()],
-    Real wetdens[AeroConfig::num_modes()],
+void coagpair_modes(const int ip, int &src_mode, int &dest_mode) {
+  const int nacc = static_cast<int>(ModeIndex::Accumulation);
+  const int npca = static_cast<int>(ModeIndex::PrimaryCarbon);
+  const int nait = static_cast<int>(ModeIndex::Aitken);
+
+  const int src_mode_coagpair[3] = {nait, npca, nait};
+  const int dest_mode_coagpair[3] = {nacc, nacc, npca};
+
+  src_mode = src_mode_coagpair[ip];
+  dest_mode = dest_mode_coagpair[ip];
+}
+
+// Computes the coagulation coefficients [m3/s] of coagulation pair ip
+// (see mam_coag_1subarea) using the CMAQ model's "fast" method (based on
+// E. Whitby's approximation approach). The level-dependent arguments may be
+// scalars or packs of levels (VT).
+template <typename VT, typename Tables = InlineCoagulationTables>
+KOKKOS_INLINE_FUNCTION void
+mam_coag_rates_1pair(const int ip, const VT &temp, const VT &pmid,
+                     const VT dgn_awet[AeroConfig::num_modes()],
+                     const VT wetdens[AeroConfig::num_modes()], VT &ybetaij0,
+                     VT &ybetaij3, VT &ybetaii0, VT &ybetajj0,
+                     const Tables &tables = Tables()) {
+  int src_mode, dest_mode;
+  coagpair_modes(ip, src_mode, dest_mode);
+
+  const Real sigma_aer_src = mam4::modes(src_mode).mean_std_dev;
+  const Real sigma_aer_dest = mam4::modes(dest_mode).mean_std_dev;
+
+  if (!tabulated_coag_rates(
+          tables, ip, temp, pmid, dgn_awet[src_mode], dgn_awet[dest_mode],
+          sigma_aer_src, sigma_aer_dest, haero::log(sigma_aer_src),
+          haero::log(sigma_aer_dest), wetdens[src_mode], wetdens[dest_mode],
+          ybetaij0, ybetaij3, ybetaii0, ybetajj0)) {
+    getcoags_wrapper_f(temp, pmid, dgn_awet[src_mode], dgn_awet[dest_mode],
+                       sigma_aer_src, sigma_aer_dest,
+                       haero::log(sigma_aer_src), haero::log(sigma_aer_dest),
+                       wetdens[src_mode], wetdens[dest_mode], ybetaij0,
+                       ybetaij3, ybetaii0, ybetajj0, tables);
+  }
+}
+
+// Computes the coagulation coefficients [m3/s] of all coagulation pairs (see
+// mam_coag_rates_1pair).
+template <typename VT, typename Tables = InlineCoagulationTables>
+KOKKOS_INLINE_FUNCTION void
+mam_coag_rates(const VT &temp, const VT &pmid,
+               const VT dgn_awet[AeroConfig::num_modes()],
+               const VT wetdens[AeroConfig::num_modes()],
+               VT ybetaij0[Coagulation::max_coagpair],
+               VT ybetaij3[Coagulation::max_coagpair],
+               VT ybetaii0[Coagulation::max_coagpair],
+               VT ybetajj0[Coagulation::max_coagpair],
+               const Tables &tables = Tables()) {
+  for (int ip = 0; ip < Coagulation::max_coagpair; ++ip) {
+    mam_coag_rates_1pair(ip, temp, pmid, dgn_awet, wetdens, ybetaij0[ip],
+                         ybetaij3[ip], ybetaii0[ip], ybetajj0[ip], tables);
+  }
+}
+
+// Tabulates the coagulation coefficients of the coagulation pairs on the given
+// grid (see CoagulationRateTable), estimating the interpolation errors at the
+// centers of the grid cells.
+inline CoagulationRateTable
+create_coagulation_rate_table(const CoagulationTables &tables,
+                              const CoagulationRateGrid &grid) {
+  EKAT_REQUIRE_MSG(grid.num_mean_free_paths >= 2 && grid.num_diameters >= 2,
+                   "CoagulationRateGrid: at least 2 points are needed along "
+                   "each dimension");
+  EKAT_REQUIRE_MSG(0 < grid.min_temperature &&
+                       grid.min_temperature < grid.max_temperature &&
+                       0 < grid.min_pressure &&
+                       grid.min_pressure < grid.max_pressure &&
+                       0 < grid.min_diameter &&
+                       grid.min_diameter < grid.max_diameter,
+                   "CoagulationRateGrid: invalid ranges");
+
+  const int npair = Coagulation::max_coagpair;
+  const int nv = CoagulationRateTable::num_values;
+  const int nl = grid.num_mean_free_paths, nd = grid.num_diameters;
+
+  // the mean free path computed by coag_kernel_factors is proportional to
+  // temperature / pressure
+  const Real p_stp = haero::Constants::pressure_stp;
+  const Real t_ref = haero::Constants::freezing_pt_h2o;
+  const Real dens_ref = 1000.0;
+  Real lamda_ref, knc_ref, kfm_ref, kfmac_ref, kfmatac_ref;
+  coag_kernel_factors(t_ref, p_stp, dens_ref, dens_ref, lamda_ref, knc_ref,
+                      kfm_ref, kfmac_ref, kfmatac_ref);
+  const Real lamda_min =
+      lamda_ref * (grid.min_temperature / t_ref) * (p_stp / grid.max_pressure);
+  const Real lamda_max =
+      lamda_ref * (grid.max_temperature / t_ref) * (p_stp / grid.min_pressure);
+
+  CoagulationRateTable rates;
+  rates.num_lamda = nl;
+  rates.num_diameters = nd;
+  rates.log_min_lamda = haero::log(lamda_min);
+  rates.dlog_lamda = (haero::log(lamda_max) - rates.log_min_lamda) / (nl - 1);
+  rates.log_min_diameter = haero::log(grid.min_diameter);
+  rates.dlog_diameter =
+      (haero::log(grid.max_diameter) - rates.log_min_diameter) / (nd - 1);
+
+  // Each coefficient q satisfies 1/q = a/knc + b/kfm, so a and b follow from
+  // two evaluations of getcoags with different free-molecular factors.
+  DeviceType::view_ND<TableReal, 5> table("coagulation_rate_table", npair, nl,
+                                          nd, nd, nv);
+  auto h_table = Kokkos::create_mirror_view(table);
+  const InlineCoagulationTables inline_tables;
+  for (int ip = 0; ip < npair; ++ip) {
+    int src_mode, dest_mode;
+    coagpair_modes(ip, src_mode, dest_mode);
+    const Real sgatk = mam4::modes(src_mode).mean_std_dev;
+    const Real sgacc = mam4::modes(dest_mode).mean_std_dev;
+    for (int il = 0; il < nl; ++il) {
+      const Real lamda =
+          haero::exp(rates.log_min_lamda + il * rates.dlog_lamda);
+      for (int i = 0; i < nd; ++i) {
+        const Real dgatk =
+            haero::exp(rates.log_min_diameter + i * rates.dlog_diameter);
+        for (int j = 0; j < nd; ++j) {
+          const Real dgacc =
+              haero::exp(rates.log_min_diameter + j * rates.dlog_diameter);
+          Real q1[4], q2[4];
+          getcoags(lamda, kfm_ref, kfm_ref, kfm_ref, knc_ref, dgatk, dgacc,
+                   sgatk, sgacc, haero::log(sgatk), haero::log(sgacc), q1[0],
+                   q1[1], q1[2], q1[3], inline_tables);
+          getcoags(lamda, 2 * kfm_ref, 2 * kfm_ref, 2 * kfm_ref, knc_ref,
+                   dgatk, dgacc, sgatk, sgacc, haero::log(sgatk),
+                   haero::log(sgacc), q2[0], q2[1], q2[2], q2[3],
+                   inline_tables);
+          for (int v = 0; v < 4; ++v) {
+            h_table(ip, il, i, j, 2 * v) =
+                knc_ref * (2.0 / q2[v] - 1.0 / q1[v]);
+            h_table(ip, il, i, j, 2 * v + 1) =
+                2.0 * kfm_ref * (1.0 / q1[v] - 1.0 / q2[v]);
+          }
+        }
+      }
+    }
+  }
+  Kokkos::deep_copy(table, h_table);
+  rates.table = table;
+
+  // Compare interpolated and analytic coefficients at the centers of the grid
+  // cells, for particle densities differing between modes.
+  CoagulationTables with_rates = tables;
+  with_rates.rates = rates;
+  const int ncell = npair * (nl - 1) * (nd - 1) * (nd - 1);
+  for (int ib = 0; ib < 4; ++ib) {
+    Real max_err = 0;
+    Kokkos::parallel_reduce(
+        "coagulation_rate_table_error", ncell,
+        KOKKOS_LAMBDA(const int icell, Real &err) {
+          const int j = icell % (nd - 1);
+          const int i = (icell / (nd - 1)) % (nd - 1);
+          const int il = (icell / ((nd - 1) * (nd - 1))) % (nl - 1);
+          const int ip = icell / ((nd - 1) * (nd - 1) * (nl - 1));
+          const Real lamda =
+              haero::exp(with_rates.rates.log_min_lamda +
+                         (il + 0.5) * with_rates.rates.dlog_lamda);
+          const Real temp = t_ref;
+          const Real pmid = p_stp * lamda_ref / lamda;
+          const Real dgatk =
+              haero::exp(with_rates.rates.log_min_diameter +
+                         (i + 0.5) * with_rates.rates.dlog_diameter);
+          const Real dgacc =
+              haero::exp(with_rates.rates.log_min_diameter +
+                         (j + 0.5) * with_rates.rates.dlog_diameter);
+          const Real dens_at = 1200.0, dens_ac = 1700.0;
+          int src_mode, dest_mode;
+          coagpair_modes(ip, src_mode, dest_mode);
+          const Real sgatk = mam4::modes(src_mode).mean_std_dev;
+          const Real sgacc = mam4::modes(dest_mode).mean_std_dev;
+          Real tab[4], ana[4];
+          tabulated_coag_rates(with_rates, ip, temp, pmid, dgatk, dgacc, sgatk,
+                               sgacc, haero::log(sgatk), haero::log(sgacc),
+                               dens_at, dens_ac, tab[0], tab[1], tab[2],
+                               tab[3]);
+          getcoags_wrapper_f(temp, pmid, dgatk, dgacc, sgatk, sgacc,
+                             haero::log(sgatk), haero::log(sgacc), dens_at,
+                             dens_ac, ana[0], ana[1], ana[2], ana[3],
+                             with_rates);
+          if (ana[ib] > 0)
+            err = haero::max(err, haero::abs(tab[ib] - ana[ib]) / ana[ib]);
+        },
+        Kokkos::Max<Real>(max_err));
+    rates.max_relative_error[ib] = max_err;
+  }
+  return rates;
+}
+
+// Advances the number and mass mixing ratios of a single grid cell over one
+// timestep given the coagulation coefficients [m3/s] computed by
+// mam_coag_rates.
+KOKKOS_INLINE_FUNCTION
+void mam_coag_update_1subarea(
+    const Real deltat, const Real aircon,
+    const Real betaij0[Coagulation::max_coagpair],
+    const Real betaij3[Coagulation::max_coagpair],
+    const Real betaii0[Coagulation::max_coagpair],
+    const Real betajj0[Coagulation::max_coagpair],
     Real qnum_cur[AeroConfig::num_modes()],
     Real qaer_cur[AeroConfig::num_aerosol_ids()][AeroConfig::num_modes()],
     Real qaer_del_coag_out[AeroConfig::num_aerosol_ids()]
@@ -1051,9 +1585,6 @@ void mam_coag_1subarea(
 
   const int num_aer = AeroConfig::num_aerosol_ids();
   const int num_mode = AeroConfig::num_modes();
-  const int nacc = static_cast<int>(ModeIndex::Accumulation);
-  const int npca = static_cast<int>(ModeIndex::PrimaryCarbon);
-  const int nait = static_cast<int>(ModeIndex::Aitken);
 
   // ----------------------------------------------------
   // Preparation
@@ -1073,40 +1604,16 @@ void mam_coag_1subarea(
     qnum_bgn[imode] = qnum_cur[imode];
   }
 
-  // --------------------------------------------------------------
-  // Compute coagulation rates using the CMAQ models "fast" method
-  // (based on E. Whitby's approximation approach)
-  // Here subr. arguments are all in mks unit.
-  // --------------------------------------------------------------
-  const int src_mode_coagpair[3] = {nait, npca, nait};
-  const int dest_mode_coagpair[3] = {nacc, nacc, npca};
-
+  // Convert coag coefficients from (m3/s) to (kmol-air/s)
   Real ybetaij0[Coagulation::max_coagpair];
   Real ybetaij3[Coagulation::max_coagpair];
   Real ybetaii0[Coagulation::max_coagpair];
   Real ybetajj0[Coagulation::max_coagpair];
-
-  for (int ip = 0; ip < Coagulation::max_coagpair; ++ip) {
-
-    const int src_mode = src_mode_coagpair[ip];
-    const int dest_mode = dest_mode_coagpair[ip];
-
-    // const Real sigma_aer_src  =
-    const Real sigma_aer_src = mam4::modes(src_mode).mean_std_dev;
-    const Real sigma_aer_dest = mam4::modes(dest_mode).mean_std_dev;
-
-    getcoags_wrapper_f(temp, pmid, dgn_awet[src_mode], dgn_awet[dest_mode],
-                       sigma_aer_src, sigma_aer_dest, haero::log(sigma_aer_src),
-                       haero::log(sigma_aer_dest), wetdens[src_mode],
-                       wetdens[dest_mode], ybetaij0[ip], ybetaij3[ip],
-                       ybetaii0[ip], ybetajj0[ip]);
-  }
-  // Convert coag coefficients from (m3/s) to (kmol-air/s)
   for (int ip = 0; ip < Coagulation::max_coagpair; ++ip) {
-    ybetaij0[ip] *= aircon;
-    ybetaij3[ip] *= aircon;
-    ybetaii0[ip] *= aircon;
-    ybetajj0[ip] *= aircon;
+    ybetaij0[ip] = betaij0[ip] * aircon;
+    ybetaij3[ip] = betaij3[ip] * aircon;
+    ybetaii0[ip] = betaii0[ip] * aircon;
+    ybetajj0[ip] = betajj0[ip] * aircon;
   }
 
   //---------------------------------------------------------------------------------------
@@ -1122,12 +1629,44 @@ void mam_coag_1subarea(
   mam_coag_aer_update(ybetaij3, deltat, qnum_tavg, qaer_bgn, qaer_cur,
                       qaer_del_coag_out);
 }
+
+template <typename Tables = InlineCoagulationTables>
+KOKKOS_INLINE_FUNCTION void mam_coag_1subarea(
+    const Real deltat, const Real temp, const Real pmid, const Real aircon,
+    Real dgn_a[AeroConfig::num_modes()], Real dgn_awet[AeroConfig::num_modes()],
+    Real wetdens[AeroConfig::num_modes()],
+    Real qnum_cur[AeroConfig::num_modes()],
+    Real qaer_cur[AeroConfig::num_aerosol_ids()][AeroConfig::num_modes()],
+    Real qaer_del_coag_out[AeroConfig::num_aerosol_ids()]
+                          [AeroConfig::max_agepair()],
+    const Tables &tables = Tables()) {
+
+  // --------------------------------------------------------------
+  // Compute coagulation rates using the CMAQ models "fast" method
+  // (based on E. Whitby's approximation approach)
+  // Here subr. arguments are all in mks unit.
+  // --------------------------------------------------------------
+  Real ybetaij0[Coagulation::max_coagpair];
+  Real ybetaij3[Coagulation::max_coagpair];
+  Real ybetaii0[Coagulation::max_coagpair];
+  Real ybetajj0[Coagulation::max_coagpair];
+  mam_coag_rates(temp, pmid, dgn_awet, wetdens, ybetaij0, ybetaij3, ybetaii0,
+                 ybetajj0, tables);
+
+  mam_coag_update_1subarea(deltat, aircon, ybetaij0, ybetaij3, ybetaii0,
+                           ybetajj0, qnum_cur, qaer_cur, qaer_del_coag_out);
+}
+
+// Applies coagulation at level k given the coagulation coefficients [m3/s]
+// at that level, writing tendencies and updating the prognostics.
 KOKKOS_INLINE_FUNCTION
-void coagulation_rates_1box(const int k, const AeroConfig &aero_config,
-                            const Real dt, const Atmosphere &atm,
-                            const Prognostics &progs, const Diagnostics &diags,
-                            const Tendencies &tends,
-                            const Coagulation::Config &config) {
+void coagulation_update_1box(const int k, const Real dt,
+                             const Atmosphere &atm, const Prognostics &progs,
+                             const Tendencies &tends,
+                             const Real betaij0[Coagulation::max_coagpair],
+                             const Real betaij3[Coagulation::max_coagpair],
+                             const Real betaii0[Coagulation::max_coagpair],
+                             const Real betajj0[Coagulation::max_coagpair]) {
 
   const int num_aer = AeroConfig::num_aerosol_ids();
   const int num_mode = AeroConfig::num_modes();
@@ -1136,15 +1675,6 @@ void coagulation_rates_1box(const int k, const AeroConfig &aero_config,
   const Real pmid = atm.pressure(k);
   const Real aircon = pmid / (mam4::Constants::r_gas * temp);
 
-  Real wet_density[num_mode];
-  Real dgn_a[num_mode];
-  Real dgn_awet[num_mode];
-  for (int imode = 0; imode < num_mode; ++imode) {
-    wet_density[imode] = diags.wet_density[imode](k);
-    dgn_a[imode] = diags.dry_geometric_mean_diameter_i[imode](k);
-    dgn_awet[imode] = diags.wet_geometric_mean_diameter_i[imode](k);
-  }
-
   // Get prognostic fields
   // Aerosol mass
   Real qaer_cur[num_aer][num_mode];
@@ -1161,8 +1691,8 @@ void coagulation_rates_1box(const int k, const AeroConfig &aero_config,
   Real qaer_del_coag_out[AeroConfig::num_aerosol_ids()]
                         [AeroConfig::max_agepair()];
 
-  mam_coag_1subarea(dt, temp, pmid, aircon, dgn_a, dgn_awet, wet_density,
-                    qnum_cur, qaer_cur, qaer_del_coag_out);
+  mam_coag_update_1subarea(dt, aircon, betaij0, betaij3, betaii0, betajj0,
+                           qnum_cur, qaer_cur, qaer_del_coag_out);
 
   // compute the tendencies
   for (int imode = 0; imode < num_mode; ++imode) {
@@ -1189,13 +1719,237 @@ void coagulation_rates_1box(const int k, const AeroConfig &aero_config,
   }
 }
 
+KOKKOS_INLINE_FUNCTION
+void coagulation_rates_1box(const int k, const AeroConfig &aero_config,
+                            const Real dt, const Atmosphere &atm,
+                            const Prognostics &progs, const Diagnostics &diags,
+                            const Tendencies &tends,
+                            const Coagulation::Config &config,
+                            const CoagulationTables &tables) {
+
+  const int num_mode = AeroConfig::num_modes();
+
+  const Real temp = atm.temperature(k);
+  const Real pmid = atm.pressure(k);
+
+  Real wet_density[num_mode];
+  Real dgn_awet[num_mode];
+  for (int imode = 0; imode < num_mode; ++imode) {
+    wet_density[imode] = diags.wet_density[imode](k);
+    dgn_awet[imode] = diags.wet_geometric_mean_diameter_i[imode](k);
+  }
+
+  Real betaij0[Coagulation::max_coagpair], betaij3[Coagulation::max_coagpair];
+  Real betaii0[Coagulation::max_coagpair], betajj0[Coagulation::max_coagpair];
+  mam_coag_rates(temp, pmid, dgn_awet, wet_density, betaij0, betaij3, betaii0,
+                 betajj0, tables);
+
+  coagulation_update_1box(k, dt, atm, progs, tends, betaij0, betaij3, betaii0,
+                          betajj0);
+}
+
+// Same as coagulation_rates_1box, for the pack_size levels of pack ipack. The
+// coagulation coefficients, which account for most of the cost, are computed
+// for the whole pack at once; the (branching) time integration is then done
+// level by level.
+KOKKOS_INLINE_FUNCTION
+void coagulation_rates_1pack(const int ipack, const AeroConfig &aero_config,
+                             const Real dt, const Atmosphere &atm,
+                             const Prognostics &progs,
+                             const Diagnostics &diags, const Tendencies &tends,
+                             const Coagulation::Config &config,
+                             const CoagulationTables &tables) {
+
+  const int num_mode = AeroConfig::num_modes();
+  const int nk = atm.num_levels();
+
+  const PackType temp = load_pack(atm.temperature, ipack, nk);
+  const PackType pmid = load_pack(atm.pressure, ipack, nk);
+
+  PackType wet_density[num_mode];
+  PackType dgn_awet[num_mode];
+  for (int imode = 0; imode < num_mode; ++imode) {
+    wet_density[imode] = load_pack(diags.wet_density[imode], ipack, nk);
+    dgn_awet[imode] =
+        load_pack(diags.wet_geometric_mean_diameter_i[imode], ipack, nk);
+  }
+
+  PackType betaij0[Coagulation::max_coagpair];
+  PackType betaij3[Coagulation::max_coagpair];
+  PackType betaii0[Coagulation::max_coagpair];
+  PackType betajj0[Coagulation::max_coagpair];
+  mam_coag_rates(temp, pmid, dgn_awet, wet_density, betaij0, betaij3, betaii0,
+                 betajj0, tables);
+
+  for (int s = 0; s < pack_size; ++s) {
+    const int k = ipack * pack_size + s;
+    if (k >= nk)
+      break;
+    Real kbetaij0[Coagulation::max_coagpair];
+    Real kbetaij3[Coagulation::max_coagpair];
+    Real kbetaii0[Coagulation::max_coagpair];
+    Real kbetajj0[Coagulation::max_coagpair];
+    for (int ip = 0; ip < Coagulation::max_coagpair; ++ip) {
+      kbetaij0[ip] = betaij0[ip][s];
+      kbetaij3[ip] = betaij3[ip][s];
+      kbetaii0[ip] = betaii0[ip][s];
+      kbetajj0[ip] = betajj0[ip][s];
+    }
+    coagulation_update_1box(k, dt, atm, progs, tends, kbetaij0, kbetaij3,
+                            kbetaii0, kbetajj0);
+  }
+}
+
+// coagulation coefficients [m3/s] of all coagulation pairs. The vector lanes
+// that compute different pairs sum their partial results (each holding zeros
+// for the pairs computed by other lanes) into one of these.
+struct CoagPairRates {
+  Real betaij0[Coagulation::max_coagpair];
+  Real betaij3[Coagulation::max_coagpair];
+  Real betaii0[Coagulation::max_coagpair];
+  Real betajj0[Coagulation::max_coagpair];
+
+  KOKKOS_INLINE_FUNCTION
+  CoagPairRates() {
+    for (int ip = 0; ip < Coagulation::max_coagpair; ++ip) {
+      betaij0[ip] = 0;
+      betaij3[ip] = 0;
+      betaii0[ip] = 0;
+      betajj0[ip] = 0;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  CoagPairRates &operator+=(const CoagPairRates &other) {
+    for (int ip = 0; ip < Coagulation::max_coagpair; ++ip) {
+      betaij0[ip] += other.betaij0[ip];
+      betaij3[ip] += other.betaij3[ip];
+      betaii0[ip] += other.betaii0[ip];
+      betajj0[ip] += other.betajj0[ip];
+    }
+    return *this;
+  }
+};
+
+} // namespace coagulation
+} // namespace mam4
+
+namespace Kokkos {
+// the identity of the sum of CoagPairRates, used by nested reductions
+template <> struct reduction_identity<mam4::coagulation::CoagPairRates> {
+  KOKKOS_FORCEINLINE_FUNCTION
+  static mam4::coagulation::CoagPairRates sum() {
+    return mam4::coagulation::CoagPairRates();
+  }
+};
+} // namespace Kokkos
+
+namespace mam4 {
+namespace coagulation {
+
+// Same as coagulation_rates_1box, with the work within level k spread over
+// the vector lanes of the calling thread of the given team. The coagulation
+// coefficients of the pairs are computed by different lanes, and so are the
+// mass transfers of the aerosol species, which are independent of each other.
+// The number mixing ratios, which are updated mode by mode in a fixed order
+// (see mam_coag_num_update), are updated by every lane and written by one.
+KOKKOS_INLINE_FUNCTION
+void coagulation_rates_1box_vector(const ThreadTeam &team, const int k,
+                                   const Real dt, const Atmosphere &atm,
+                                   const Prognostics &progs,
+                                   const Diagnostics &diags,
+                                   const Tendencies &tends,
+                                   const CoagulationTables &tables) {
+
+  const int num_aer = AeroConfig::num_aerosol_ids();
+  const int num_mode = AeroConfig::num_modes();
+  const int npair = Coagulation::max_coagpair;
+
+  const Real temp = atm.temperature(k);
+  const Real pmid = atm.pressure(k);
+  const Real aircon = pmid / (mam4::Constants::r_gas * temp);
+
+  Real wet_density[num_mode];
+  Real dgn_awet[num_mode];
+  for (int imode = 0; imode < num_mode; ++imode) {
+    wet_density[imode] = diags.wet_density[imode](k);
+    dgn_awet[imode] = diags.wet_geometric_mean_diameter_i[imode](k);
+  }
+
+  CoagPairRates rates;
+  Kokkos::parallel_reduce(
+      Kokkos::ThreadVectorRange(team, npair),
+      [&](const int ip, CoagPairRates &partial) {
+        mam_coag_rates_1pair(ip, temp, pmid, dgn_awet, wet_density,
+                             partial.betaij0[ip], partial.betaij3[ip],
+                             partial.betaii0[ip], partial.betajj0[ip],
+                             tables);
+      },
+      rates);
+
+  // Convert coag coefficients from (m3/s) to (kmol-air/s)
+  Real ybetaij0[npair], ybetaij3[npair], ybetaii0[npair], ybetajj0[npair];
+  for (int ip = 0; ip < npair; ++ip) {
+    ybetaij0[ip] = rates.betaij0[ip] * aircon;
+    ybetaij3[ip] = rates.betaij3[ip] * aircon;
+    ybetaii0[ip] = rates.betaii0[ip] * aircon;
+    ybetajj0[ip] = rates.betajj0[ip] * aircon;
+  }
+
+  // number mixing ratios (clipped), and the fractions of mass transferred
+  Real qnum_bgn[num_mode], qnum_cur[num_mode], qnum_tavg[num_mode];
+  for (int imode = 0; imode < num_mode; ++imode) {
+    qnum_bgn[imode] = haero::max(0.0, progs.n_mode_i[imode](k));
+    qnum_cur[imode] = qnum_bgn[imode];
+  }
+  mam_coag_num_update(ybetaij0, ybetaii0, ybetajj0, dt, qnum_bgn, qnum_cur,
+                      qnum_tavg);
+  const CoagMassTransfer xfer = mam_coag_aer_transfer(ybetaij3, dt, qnum_tavg);
+  bool aitken_species[num_aer];
+  coag_aitken_species(aitken_species);
+
+  // mass transfers, one species per lane
+  Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, num_aer),
+                       [&](const int iaer) {
+                         Real qaer_bgn[num_mode], qaer_cur[num_mode];
+                         for (int imode = 0; imode < num_mode; ++imode) {
+                           qaer_cur[imode] = haero::max(
+                               0.0, progs.q_aero_i[imode][iaer](k));
+                           qaer_bgn[imode] = qaer_cur[imode];
+                         }
+                         Real qaer_del_coag_pca = 0;
+                         mam_coag_aer_update_1spec(aitken_species[iaer], xfer,
+                                                   qaer_bgn, qaer_cur,
+                                                   qaer_del_coag_pca);
+                         for (int imode = 0; imode < num_mode; ++imode) {
+                           tends.q_aero_i[imode][iaer](k) +=
+                               (qaer_cur[imode] -
+                                progs.q_aero_i[imode][iaer](k)) /
+                               dt;
+                           progs.q_aero_i[imode][iaer](k) = qaer_cur[imode];
+                         }
+                       });
+
+  Kokkos::single(Kokkos::PerThread(team), [&]() {
+    for (int imode = 0; imode < num_mode; ++imode) {
+      tends.n_mode_i[imode](k) +=
+          (qnum_cur[imode] - progs.n_mode_i[imode](k)) / dt;
+      progs.n_mode_i[imode](k) = qnum_cur[imode];
+    }
+  });
+}
+
 } // namespace coagulation
 
 // init -- initializes the implementation with MAM4's configuration
 inline void Coagulation::init(const AeroConfig &aero_config,
                               const Config &process_config) {
-  // TODO
   config_ = process_config;
+  tables_ = coagulation::create_coagulation_tables();
+  if (config_.tabulate_rates) {
+    tables_.rates =
+        coagulation::create_coagulation_rate_table(tables_, config_.rate_grid);
+  }
 }
 
 // compute_tendencies -- computes tendencies and updates diagnostics
@@ -1210,11 +1964,31 @@ void Coagulation::compute_tendencies(const AeroConfig &config,
                                      const Tendencies &tends) const {
 
   const int nk = atm.num_levels();
-  Kokkos::parallel_for(
-      Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
-        coagulation::coagulation_rates_1box(k, config, dt, atm, progs, diags,
-                                            tends, config_);
-      });
+  if (pack_size > 1) {
+    // level-vectorized build: each thread handles a pack of levels
+    const int npack = PackInfo::num_packs(nk);
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(team, npack), KOKKOS_CLASS_LAMBDA(int ipack) {
+          coagulation::coagulation_rates_1pack(ipack, config, dt, atm, progs,
+                                               diags, tends, config_,
+                                               tables_);
+        });
+  } else if (config_.use_vector_lanes) {
+    // hierarchical parallelism: levels over threads, and coagulation pairs
+    // and aerosol species over the vector lanes of each thread
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
+          coagulation::coagulation_rates_1box_vector(team, k, dt, atm, progs,
+                                                     diags, tends, tables_);
+        });
+  } else {
+    Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
+          coagulation::coagulation_rates_1box(k, config, dt, atm, progs,
+                                              diags, tends, config_,
+                                              tables_);
+        });
+  }
 }
 } // namespace mam4
 
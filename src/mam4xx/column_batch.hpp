@@ -0,0 +1,389 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_COLUMN_BATCH_HPP
+#define MAM4XX_COLUMN_BATCH_HPP
+
+// This header provides containers for the state of a batch of columns, stored
+// in 2D (ncol x nlev) views, a function that runs an aerosol process over all
+// columns of a batch with a single TeamPolicy launch, and launchers that run a
+// per-column kernel over a batch, optionally with per-column work memory.
+
+#include <mam4xx/aero_config.hpp>
+#include <mam4xx/level_compaction.hpp>
+#include <mam4xx/mam4_types.hpp>
+#include <mam4xx/profiling.hpp>
+#include <mam4xx/work_memory.hpp>
+
+#include <ekat/kokkos/ekat_subview_utils.hpp>
+#include <haero/haero.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+namespace mam4 {
+
+/// 2D (ncol x nlev) view used to store a field for a batch of columns
+using ColumnBatchView = DeviceType::view_2d<Real>;
+
+/// Atmospheric state for a batch of columns. Each field is stored in a
+/// (ncol x nlev) view, except for the interface pressure, which is
+/// (ncol x nlev+1), and the planetary boundary layer height, which has one
+/// value per column. The views must be set by the host model.
+class AtmosphereColumns final {
+public:
+  ColumnBatchView temperature;
+  ColumnBatchView pressure;
+  ColumnBatchView vapor_mixing_ratio;
+  ColumnBatchView liquid_mixing_ratio;
+  ColumnBatchView cloud_liquid_number_mixing_ratio;
+  ColumnBatchView ice_mixing_ratio;
+  ColumnBatchView cloud_ice_number_mixing_ratio;
+  ColumnBatchView height;
+  ColumnBatchView hydrostatic_dp;
+  ColumnBatchView interface_pressure;
+  ColumnBatchView cloud_fraction;
+  ColumnBatchView updraft_vel_ice_nucleation;
+  DeviceType::view_1d<Real> planetary_boundary_layer_height;
+
+  KOKKOS_INLINE_FUNCTION
+  int num_columns() const { return temperature.extent(0); }
+
+  KOKKOS_INLINE_FUNCTION
+  int num_levels() const { return temperature.extent(1); }
+
+  /// Returns the atmospheric state of the given column. The returned object
+  /// refers to the data in this container.
+  KOKKOS_INLINE_FUNCTION
+  Atmosphere column(const int icol) const {
+    return Atmosphere(num_levels(), ekat::subview(temperature, icol),
+                      ekat::subview(pressure, icol),
+                      ekat::subview(vapor_mixing_ratio, icol),
+                      ekat::subview(liquid_mixing_ratio, icol),
+                      ekat::subview(cloud_liquid_number_mixing_ratio, icol),
+                      ekat::subview(ice_mixing_ratio, icol),
+                      ekat::subview(cloud_ice_number_mixing_ratio, icol),
+                      ekat::subview(height, icol),
+                      ekat::subview(hydrostatic_dp, icol),
+                      ekat::subview(interface_pressure, icol),
+                      ekat::subview(cloud_fraction, icol),
+                      ekat::subview(updraft_vel_ice_nucleation, icol),
+                      planetary_boundary_layer_height(icol));
+  }
+};
+
+/// Prognostic aerosol and gas fields for a batch of columns. The layout
+/// mirrors that of mam4::Prognostics, with each ColumnView replaced by a
+/// (ncol x nlev) view.
+class PrognosticsColumns final {
+  // number of columns and vertical levels
+  int ncol_, nlev_;
+
+public:
+  /// Creates a container for prognostic variables for the given number of
+  /// columns and vertical levels, allocating and zeroing all of its views.
+  PrognosticsColumns(const int num_columns, const int num_levels)
+      : ncol_(num_columns), nlev_(num_levels) {
+    const auto create = [=](const std::string &name) {
+      return ColumnBatchView(name, num_columns, num_levels);
+    };
+    for (int mode = 0; mode < AeroConfig::num_modes(); ++mode) {
+      const std::string m = std::to_string(mode);
+      n_mode_i[mode] = create("n_mode_i_" + m);
+      n_mode_c[mode] = create("n_mode_c_" + m);
+      for (int spec = 0; spec < AeroConfig::num_aerosol_ids(); ++spec) {
+        const std::string s = std::to_string(spec);
+        q_aero_i[mode][spec] = create("q_aero_i_" + m + "_" + s);
+        q_aero_c[mode][spec] = create("q_aero_c_" + m + "_" + s);
+      }
+    }
+    for (int gas = 0; gas < AeroConfig::num_gas_ids(); ++gas) {
+      const std::string g = std::to_string(gas);
+      q_gas[gas] = create("q_gas_" + g);
+      q_gas_avg[gas] = create("q_gas_avg_" + g);
+      for (int mode = 0; mode < AeroConfig::num_modes(); ++mode) {
+        const std::string m = std::to_string(mode);
+        uptkaer[gas][mode] = create("uptkaer_" + g + "_" + m);
+      }
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsColumns() = default;
+  KOKKOS_INLINE_FUNCTION
+  ~PrognosticsColumns() = default;
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsColumns(const PrognosticsColumns &rhs) = default;
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsColumns &operator=(const PrognosticsColumns &rhs) = default;
+
+  ColumnBatchView n_mode_i[AeroConfig::num_modes()];
+  ColumnBatchView n_mode_c[AeroConfig::num_modes()];
+  ColumnBatchView q_aero_i[AeroConfig::num_modes()]
+                          [AeroConfig::num_aerosol_ids()];
+  ColumnBatchView q_aero_c[AeroConfig::num_modes()]
+                          [AeroConfig::num_aerosol_ids()];
+  ColumnBatchView q_gas[AeroConfig::num_gas_ids()];
+  ColumnBatchView q_gas_avg[AeroConfig::num_gas_ids()];
+  ColumnBatchView uptkaer[AeroConfig::num_gas_ids()][AeroConfig::num_modes()];
+
+  KOKKOS_INLINE_FUNCTION
+  int num_columns() const { return ncol_; }
+
+  KOKKOS_INLINE_FUNCTION
+  int num_levels() const { return nlev_; }
+
+  /// Returns the prognostics of the given column. The returned object refers
+  /// to the data in this container.
+  KOKKOS_INLINE_FUNCTION
+  Prognostics column(const int icol) const {
+    Prognostics progs(nlev_);
+    for (int mode = 0; mode < AeroConfig::num_modes(); ++mode) {
+      progs.n_mode_i[mode] = ekat::subview(n_mode_i[mode], icol);
+      progs.n_mode_c[mode] = ekat::subview(n_mode_c[mode], icol);
+      for (int spec = 0; spec < AeroConfig::num_aerosol_ids(); ++spec) {
+        progs.q_aero_i[mode][spec] = ekat::subview(q_aero_i[mode][spec], icol);
+        progs.q_aero_c[mode][spec] = ekat::subview(q_aero_c[mode][spec], icol);
+      }
+    }
+    for (int gas = 0; gas < AeroConfig::num_gas_ids(); ++gas) {
+      progs.q_gas[gas] = ekat::subview(q_gas[gas], icol);
+      progs.q_gas_avg[gas] = ekat::subview(q_gas_avg[gas], icol);
+      for (int mode = 0; mode < AeroConfig::num_modes(); ++mode)
+        progs.uptkaer[gas][mode] = ekat::subview(uptkaer[gas][mode], icol);
+    }
+    return progs;
+  }
+};
+
+// Tendencies are identical in structure to prognostics.
+using TendenciesColumns = PrognosticsColumns;
+
+/// Diagnostic fields of the aerosol microphysics processes (sizes, water
+/// uptake, gas-aerosol exchange) for a batch of columns. Diagnostics used by
+/// other processes (ice nucleation, convective transport, deposition) are left
+/// unset in the per-column objects, so only processes that use the fields
+/// below can be run on a batch.
+class DiagnosticsColumns final {
+  // number of columns and vertical levels
+  int ncol_, nlev_;
+
+public:
+  /// Creates a container for diagnostic variables for the given number of
+  /// columns and vertical levels, allocating and zeroing all of its views.
+  DiagnosticsColumns(const int num_columns, const int num_levels)
+      : ncol_(num_columns), nlev_(num_levels) {
+    const auto create = [=](const std::string &name) {
+      return ColumnBatchView(name, num_columns, num_levels);
+    };
+    for (int mode = 0; mode < AeroConfig::num_modes(); ++mode) {
+      const std::string m = std::to_string(mode);
+      hygroscopicity[mode] = create("hygroscopicity_" + m);
+      dry_geometric_mean_diameter_total[mode] =
+          create("dry_geometric_mean_diameter_total_" + m);
+      dry_geometric_mean_diameter_i[mode] =
+          create("dry_geometric_mean_diameter_i_" + m);
+      dry_geometric_mean_diameter_c[mode] =
+          create("dry_geometric_mean_diameter_c_" + m);
+      wet_geometric_mean_diameter_i[mode] =
+          create("wet_geometric_mean_diameter_i_" + m);
+      wet_geometric_mean_diameter_c[mode] =
+          create("wet_geometric_mean_diameter_c_" + m);
+      wet_density[mode] = create("wet_density_" + m);
+      activation_fraction[mode] = create("activation_fraction_" + m);
+      uptkaer_ref[mode] = create("uptkaer_ref_" + m);
+      uptkaer_ref_wet_diameter[mode] = create("uptkaer_ref_wet_diameter_" + m);
+    }
+    uptkrate_h2so4 = create("uptkrate_h2so4");
+    uptkaer_ref_temperature = create("uptkaer_ref_temperature");
+    g0_soa_out = create("g0_soa_out");
+    is_cloudy =
+        DeviceType::view_2d<bool>("is_cloudy", num_columns, num_levels);
+    num_substeps =
+        DeviceType::view_2d<int>("num_substeps", num_columns, num_levels);
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  DiagnosticsColumns() = default;
+  KOKKOS_INLINE_FUNCTION
+  ~DiagnosticsColumns() = default;
+  KOKKOS_INLINE_FUNCTION
+  DiagnosticsColumns(const DiagnosticsColumns &rhs) = default;
+  KOKKOS_INLINE_FUNCTION
+  DiagnosticsColumns &operator=(const DiagnosticsColumns &rhs) = default;
+
+  ColumnBatchView hygroscopicity[AeroConfig::num_modes()];
+  ColumnBatchView dry_geometric_mean_diameter_total[AeroConfig::num_modes()];
+  ColumnBatchView dry_geometric_mean_diameter_i[AeroConfig::num_modes()];
+  ColumnBatchView dry_geometric_mean_diameter_c[AeroConfig::num_modes()];
+  ColumnBatchView wet_geometric_mean_diameter_i[AeroConfig::num_modes()];
+  ColumnBatchView wet_geometric_mean_diameter_c[AeroConfig::num_modes()];
+  ColumnBatchView wet_density[AeroConfig::num_modes()];
+  ColumnBatchView activation_fraction[AeroConfig::num_modes()];
+  ColumnBatchView uptkrate_h2so4;
+  ColumnBatchView uptkaer_ref[AeroConfig::num_modes()];
+  ColumnBatchView uptkaer_ref_temperature;
+  ColumnBatchView uptkaer_ref_wet_diameter[AeroConfig::num_modes()];
+  ColumnBatchView g0_soa_out;
+  DeviceType::view_2d<bool> is_cloudy;
+  DeviceType::view_2d<int> num_substeps;
+
+  KOKKOS_INLINE_FUNCTION
+  int num_columns() const { return ncol_; }
+
+  KOKKOS_INLINE_FUNCTION
+  int num_levels() const { return nlev_; }
+
+  /// Returns the diagnostics of the given column. The returned object refers
+  /// to the data in this container.
+  KOKKOS_INLINE_FUNCTION
+  Diagnostics column(const int icol) const {
+    Diagnostics diags(nlev_);
+    for (int mode = 0; mode < AeroConfig::num_modes(); ++mode) {
+      diags.hygroscopicity[mode] = ekat::subview(hygroscopicity[mode], icol);
+      diags.dry_geometric_mean_diameter_total[mode] =
+          ekat::subview(dry_geometric_mean_diameter_total[mode], icol);
+      diags.dry_geometric_mean_diameter_i[mode] =
+          ekat::subview(dry_geometric_mean_diameter_i[mode], icol);
+      diags.dry_geometric_mean_diameter_c[mode] =
+          ekat::subview(dry_geometric_mean_diameter_c[mode], icol);
+      diags.wet_geometric_mean_diameter_i[mode] =
+          ekat::subview(wet_geometric_mean_diameter_i[mode], icol);
+      diags.wet_geometric_mean_diameter_c[mode] =
+          ekat::subview(wet_geometric_mean_diameter_c[mode], icol);
+      diags.wet_density[mode] = ekat::subview(wet_density[mode], icol);
+      diags.activation_fraction[mode] =
+          ekat::subview(activation_fraction[mode], icol);
+      diags.uptkaer_ref[mode] = ekat::subview(uptkaer_ref[mode], icol);
+      diags.uptkaer_ref_wet_diameter[mode] =
+          ekat::subview(uptkaer_ref_wet_diameter[mode], icol);
+    }
+    diags.uptkrate_h2so4 = ekat::subview(uptkrate_h2so4, icol);
+    diags.uptkaer_ref_temperature =
+        ekat::subview(uptkaer_ref_temperature, icol);
+    diags.g0_soa_out = ekat::subview(g0_soa_out, icol);
+    diags.is_cloudy = ekat::subview(is_cloudy, icol);
+    diags.num_substeps = ekat::subview(num_substeps, icol);
+    return diags;
+  }
+};
+
+/// Returns a team policy with one team per column, with league and team sizes
+/// chosen for the default execution space:
+/// * Serial: one single-thread team per column
+/// * OpenMP: one single-thread team per column when there are at least as many
+///   columns as threads; otherwise the idle threads are spread over the
+///   vertical levels of each column
+/// * other (GPU) backends: Kokkos chooses the team size
+/// Each team gets enough level 0 scratch memory for the list of active levels
+/// used by processes configured to compact levels (see level_compaction.hpp).
+/// A vector_length > 1 gives each thread that many vector lanes, for processes
+/// that spread the work within a level over them (e.g. Coagulation with
+/// use_vector_lanes set).
+inline haero::ThreadTeamPolicy
+column_batch_team_policy(const int num_columns, const int num_levels,
+                         const int vector_length = 1) {
+  using ExecSpace = typename haero::ThreadTeamPolicy::execution_space;
+  const auto scratch = Kokkos::PerTeam(ActiveLevels::scratch_size(num_levels));
+#ifdef KOKKOS_ENABLE_SERIAL
+  if (std::is_same<ExecSpace, Kokkos::Serial>::value) {
+    return haero::ThreadTeamPolicy(num_columns, 1, vector_length)
+        .set_scratch_size(0, scratch);
+  }
+#endif
+#ifdef KOKKOS_ENABLE_OPENMP
+  if (std::is_same<ExecSpace, Kokkos::OpenMP>::value) {
+    const int num_threads = ExecSpace().concurrency();
+    const int team_size =
+        (num_columns >= num_threads)
+            ? 1
+            : std::max(1, std::min(num_threads / num_columns, num_levels));
+    return haero::ThreadTeamPolicy(num_columns, team_size, vector_length)
+        .set_scratch_size(0, scratch);
+  }
+#endif
+  return haero::ThreadTeamPolicy(num_columns, Kokkos::AUTO, vector_length)
+      .set_scratch_size(0, scratch);
+}
+
+/// Runs the given aerosol process (a haero::AeroProcess) on every column of a
+/// batch using a single TeamPolicy launch, one team per column. The launch is
+/// profiled as a region named after the process (see profiling.hpp). The
+/// vector_length is passed on to column_batch_team_policy.
+template <typename Process>
+void compute_tendencies_for_columns(const Process &process, const Real t,
+                                    const Real dt,
+                                    const AtmosphereColumns &atm,
+                                    const Surface &sfc,
+                                    const PrognosticsColumns &progs,
+                                    const DiagnosticsColumns &diags,
+                                    const TendenciesColumns &tends,
+                                    const int vector_length = 1) {
+  MAM4XX_PROFILE_REGION(process.name());
+  const int ncol = atm.num_columns();
+  const auto team_policy =
+      column_batch_team_policy(ncol, atm.num_levels(), vector_length);
+  Kokkos::parallel_for(
+      "mam4::compute_tendencies_for_columns", team_policy,
+      KOKKOS_LAMBDA(const haero::ThreadTeam &team) {
+        const int icol = team.league_rank();
+        process.compute_tendencies(team, t, dt, atm.column(icol), sfc,
+                                   progs.column(icol), diags.column(icol),
+                                   tends.column(icol));
+      });
+}
+
+/// Creates work memory of work_len Reals per column for launches made with
+/// column_batch_team_policy(num_columns, num_levels, vector_length), taking
+/// into account the team scratch memory that policy already requests.
+inline TeamWorkMemory column_batch_work_memory(const int work_len,
+                                               const int num_columns,
+                                               const int num_levels,
+                                               const int vector_length = 1) {
+  return TeamWorkMemory(
+      work_len,
+      column_batch_team_policy(num_columns, num_levels, vector_length));
+}
+
+/// Calls kernel(team, icol) for every column icol of a batch of num_columns
+/// columns using a single TeamPolicy launch, one team per column. The launch
+/// is profiled as a region with the given name (see profiling.hpp), so
+/// drivers of functions that are not aerosol processes (e.g.
+/// mo_setsox::setsox) can be attributed like compute_tendencies_for_columns.
+template <typename Kernel>
+void for_each_column(const std::string &name, const int num_columns,
+                     const int num_levels, const Kernel &kernel,
+                     const int vector_length = 1) {
+  MAM4XX_PROFILE_REGION(name);
+  const auto team_policy =
+      column_batch_team_policy(num_columns, num_levels, vector_length);
+  Kokkos::parallel_for(
+      name, team_policy, KOKKOS_LAMBDA(const haero::ThreadTeam &team) {
+        kernel(team, team.league_rank());
+      });
+}
+
+/// Same as above, but calls kernel(team, icol, work), where work is the work
+/// array of the team taken from the given work memory, which must have been
+/// created for the same batch (see column_batch_work_memory).
+template <typename Kernel>
+void for_each_column(const std::string &name, const int num_columns,
+                     const int num_levels, const TeamWorkMemory &work_memory,
+                     const Kernel &kernel, const int vector_length = 1) {
+  MAM4XX_PROFILE_REGION(name);
+  const auto team_policy = work_memory.configure(
+      column_batch_team_policy(num_columns, num_levels, vector_length));
+  Kokkos::parallel_for(
+      name, team_policy, KOKKOS_LAMBDA(const haero::ThreadTeam &team) {
+        kernel(team, team.league_rank(), work_memory.get(team));
+      });
+}
+
+} // namespace mam4
+
+#endif
@@ -0,0 +1,95 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_COLUMN_SKIP_HPP
+#define MAM4XX_COLUMN_SKIP_HPP
+
+// Processes that can leave a whole column untouched (e.g. wet deposition in a
+// column without precipitation) skip it outright. This header provides the
+// statistics that count how many columns took that fast path.
+
+#include <mam4xx/mam4_types.hpp>
+
+#include <haero/haero.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <string>
+
+namespace mam4 {
+
+/// ColumnSkipStats accumulates the number of columns visited by a process and
+/// the number of them it skipped because it had nothing to do there, over all
+/// launches. A default-constructed object records nothing.
+class ColumnSkipStats final {
+public:
+  using Counter = unsigned long long;
+
+  KOKKOS_INLINE_FUNCTION
+  ColumnSkipStats() = default;
+
+  /// Creates statistics with counters set to zero.
+  explicit ColumnSkipStats(const std::string &name) : counts_(name, 2) {}
+
+  KOKKOS_INLINE_FUNCTION
+  ~ColumnSkipStats() = default;
+  KOKKOS_INLINE_FUNCTION
+  ColumnSkipStats(const ColumnSkipStats &rhs) = default;
+  KOKKOS_INLINE_FUNCTION
+  ColumnSkipStats &operator=(const ColumnSkipStats &rhs) = default;
+
+  /// Returns true if this object records statistics.
+  KOKKOS_INLINE_FUNCTION
+  bool enabled() const { return counts_.data() != nullptr; }
+
+  /// Records a visited column, which was skipped if skipped is true. This
+  /// must be called by all threads of the team.
+  KOKKOS_INLINE_FUNCTION
+  void record(const ThreadTeam &team, const bool skipped) const {
+    if (!enabled())
+      return;
+    const auto counts = counts_;
+    Kokkos::single(Kokkos::PerTeam(team), [&]() {
+      Kokkos::atomic_add(&counts(0), Counter(1));
+      if (skipped)
+        Kokkos::atomic_add(&counts(1), Counter(1));
+    });
+  }
+
+  /// Returns the number of columns visited.
+  Counter num_columns() const { return host_counts()(0); }
+
+  /// Returns the number of skipped columns.
+  Counter num_skipped() const { return host_counts()(1); }
+
+  /// Returns the fraction of visited columns that were skipped, or 0 if no
+  /// columns were visited.
+  Real skipped_fraction() const {
+    const auto counts = host_counts();
+    return (counts(0) > 0) ? Real(counts(1)) / Real(counts(0)) : 0;
+  }
+
+  /// Sets the counters to zero.
+  void reset() const {
+    if (enabled())
+      Kokkos::deep_copy(counts_, Counter(0));
+  }
+
+private:
+  using CounterView = DeviceType::view_1d<Counter>;
+
+  CounterView::HostMirror host_counts() const {
+    CounterView::HostMirror counts("column_skip_counts", 2);
+    if (enabled())
+      Kokkos::deep_copy(counts, counts_);
+    return counts;
+  }
+
+  CounterView counts_;
+};
+
+} // namespace mam4
+
+#endif
@@ -11,6 +11,7 @@
 
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/aero_model.hpp>
+#include <mam4xx/column_skip.hpp>
 #include <mam4xx/mam4_types.hpp>
 #include <mam4xx/utils.hpp>
 
@@ -378,6 +379,10 @@ public:
     bool convproc_do_aer = true;
     bool convproc_do_gas = false;
     int nlev = mam4::nlev;
+    // if true, the cloud top and bottom of each column are found from its deep
+    // convective mass fluxes and precipitation; otherwise the fixed ktop and
+    // kbot below are used
+    bool detect_convective_extent = true;
     int ktop = 47; // BAD_CONSTANT: only true for nlev == 72
     int kbot = mam4::nlev - 1;
     // Flags are defined in "enum ConvProc::species_class".
@@ -388,6 +393,9 @@ public:
         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
         -1, 30, 32, 33, 31, 28, 29, 34, -3, 30, 33, 29, 34, -3,
         28, 29, 30, 31, 32, 33, 34, -3, 32, 31, 34, -3};
+    // counts the columns without deep convection, which skip the deep
+    // convective processing (records nothing by default)
+    ColumnSkipStats skip_stats;
   };
 
   static constexpr int num_modes = AeroConfig::num_modes();
@@ -2925,6 +2933,62 @@ ma_convproc_sh_intr(const int nlev, const Real temperature[/* nlev */],
     dotend[i] = false;
 }
 
+// =========================================================================================
+// Finds the levels [ktop, kbot) of the column on which deep convection is
+// active, from the highest to the lowest level on which the mass fluxes du, eu
+// or ed, the precipitation production rprd or the evaporation evapc is
+// nonzero. Outside these levels there are neither mass fluxes nor sources of
+// precipitation, so the cloud layers [ktop, kbot) and the precipitation sweep
+// [ktop, nlev) of ma_convproc_tend cover all of the deep convective
+// processing. As with a fixed kbot, a downdraft that still carries mass at
+// kbot detrains it in the level above. If none of the fields is nonzero,
+// ktop = kbot = nlev; such a column has no deep convection (see
+// has_deep_convection).
+KOKKOS_INLINE_FUNCTION
+void find_convective_extent(const int nlev, const Real du[/* nlev */],
+                            const Real eu[/* nlev */],
+                            const Real ed[/* nlev */],
+                            const Real rprd[/* nlev */],
+                            const Real evapc[/* nlev */], int &ktop,
+                            int &kbot) {
+  ktop = nlev;
+  kbot = nlev;
+  for (int kk = 0; kk < nlev; ++kk) {
+    if (du[kk] != 0 || eu[kk] != 0 || ed[kk] != 0 || rprd[kk] != 0 ||
+        evapc[kk] != 0) {
+      ktop = kk;
+      break;
+    }
+  }
+  for (int kk = nlev - 1; ktop <= kk; --kk) {
+    if (du[kk] != 0 || eu[kk] != 0 || ed[kk] != 0 || rprd[kk] != 0 ||
+        evapc[kk] != 0) {
+      kbot = kk + 1;
+      break;
+    }
+  }
+}
+
+// =========================================================================================
+// Returns true if deep convection is present in the column, i.e. if any of the
+// updraft/downdraft mass fluxes or the deep convective precipitation production
+// and evaporation is nonzero on some level. Without deep convection the mass
+// fluxes vanish, no updraft is formed, and ma_convproc_dp_intr gives zero
+// tendencies and column fluxes. The values are compared with zero exactly so
+// that any column with deep convection takes the full computation.
+KOKKOS_INLINE_FUNCTION
+bool has_deep_convection(const int nlev, const Real du[/* nlev */],
+                         const Real eu[/* nlev */], const Real ed[/* nlev */],
+                         const Real rprddp[/* nlev */],
+                         const Real evapcdp[/* nlev */]) {
+  for (int kk = 0; kk < nlev; ++kk) {
+    if (du[kk] != 0 || eu[kk] != 0 || ed[kk] != 0 || rprddp[kk] != 0 ||
+        evapcdp[kk] != 0)
+      return true;
+  }
+  return false;
+}
+
 // =========================================================================================
 KOKKOS_INLINE_FUNCTION
 void ma_convproc_intr(
@@ -2946,7 +3010,9 @@ void ma_convproc_intr(
     const int mmtoo_prevap_resusp[aero_model::pcnst],
     const Diagnostics::ColumnTracerView state_q,
     Diagnostics::ColumnTracerView ptend_q, bool ptend_lq[aero_model::pcnst],
-    Real aerdepwetis[aero_model::pcnst]) {
+    Real aerdepwetis[aero_model::pcnst],
+    const ColumnSkipStats &skip_stats = ColumnSkipStats(),
+    const bool allow_column_skip = true) {
 
   //-----------------------------------------------------------------------
   //
@@ -3008,6 +3074,9 @@ void ma_convproc_intr(
            -2 for aerosol mass species WITHOUT coarse mode counterpart
            -3 for aerosol number species
            -1 for other species
+  in    :: skip_stats  ! counts the columns that skip the deep conv processing
+  in    :: allow_column_skip ! if false, columns without deep convection also
+                             ! take the deep conv processing
   */
   // clang-format on
 
@@ -3054,31 +3123,45 @@ void ma_convproc_intr(
     // do deep conv processing
     //
     Real qsrflx[aero_model::pcnst][nsrflx] = {};
-    for (int j = 0; j < nlev; ++j)
-      for (int i = 0; i < aero_model::pcnst; ++i)
-        dqdt(j, i) = 0;
-    for (int j = 0; j < nlev; ++j)
-      dlfdp[j] = haero::max((dlf[j] - dlfsh[j]), 0.0);
-    ma_convproc_dp_intr(scratch1Dviews, nlev, temperature, pmid, dpdry, dt,
-                        dp_frac, icwmrdp, rprddp, evapcdp, du, eu, ed, dp, ktop,
-                        kbot, qnew, species_class, mmtoo_prevap_resusp, dqdt,
-                        qsrflx, dotend);
-    // apply deep conv processing tendency and prepare for shallow conv
-    // processing
-    for (int kk = 0; kk < nlev; ++kk)
-      update_qnew_ptend(dotend, true, Kokkos::subview(dqdt, kk, Kokkos::ALL()),
-                        dt, ptend_lq,
-                        Kokkos::subview(ptend_q, kk, Kokkos::ALL()),
-                        Kokkos::subview(qnew, kk, Kokkos::ALL()));
-    // update variables for output
-    for (int icnst = 0; icnst < aero_model::pcnst; ++icnst) {
-      // this used for surface coupling:
-      //  4 = wet removal
-      //  5 = actual precip-evap resuspension (what actually is applied to a
-      //  species)
-      if (dotend[icnst] &&
-          species_class[icnst] == ConvProc::species_class::aerosol)
-        aerdepwetis[icnst] += qsrflx[icnst][4] + qsrflx[icnst][5];
+    const bool deep_convection =
+        !allow_column_skip ||
+        has_deep_convection(nlev, du, eu, ed, rprddp, evapcdp);
+    skip_stats.record(team, !deep_convection);
+    if (deep_convection) {
+      for (int j = 0; j < nlev; ++j)
+        for (int i = 0; i < aero_model::pcnst; ++i)
+          dqdt(j, i) = 0;
+      for (int j = 0; j < nlev; ++j)
+        dlfdp[j] = haero::max((dlf[j] - dlfsh[j]), 0.0);
+      ma_convproc_dp_intr(scratch1Dviews, nlev, temperature, pmid, dpdry, dt,
+                          dp_frac, icwmrdp, rprddp, evapcdp, du, eu, ed, dp,
+                          ktop, kbot, qnew, species_class, mmtoo_prevap_resusp,
+                          dqdt, qsrflx, dotend);
+      // apply deep conv processing tendency and prepare for shallow conv
+      // processing
+      for (int kk = 0; kk < nlev; ++kk)
+        update_qnew_ptend(dotend, true,
+                          Kokkos::subview(dqdt, kk, Kokkos::ALL()), dt,
+                          ptend_lq, Kokkos::subview(ptend_q, kk, Kokkos::ALL()),
+                          Kokkos::subview(qnew, kk, Kokkos::ALL()));
+      // update variables for output
+      for (int icnst = 0; icnst < aero_model::pcnst; ++icnst) {
+        // this used for surface coupling:
+        //  4 = wet removal
+        //  5 = actual precip-evap resuspension (what actually is applied to a
+        //  species)
+        if (dotend[icnst] &&
+            species_class[icnst] == ConvProc::species_class::aerosol)
+          aerdepwetis[icnst] += qsrflx[icnst][4] + qsrflx[icnst][5];
+      }
+    } else {
+      // the deep conv tendencies and column fluxes are zero, so ptend_q and
+      // aerdepwetis are unchanged; only the flags are set as the deep conv
+      // processing would set them
+      assign_dotend(species_class, true, false, dotend);
+      for (int icnst = 0; icnst < aero_model::pcnst; ++icnst)
+        if (dotend[icnst])
+          ptend_lq[icnst] = true;
     }
     //
     // do shallow conv processing
@@ -3128,8 +3211,6 @@ void ConvProc::compute_tendencies(const AeroConfig &config,
 
   const bool convproc_do_aer = config_.convproc_do_aer;
   const bool convproc_do_gas = config_.convproc_do_gas;
-  const int ktop = config_.ktop;
-  const int kbot = config_.kbot;
   int species_class[aero_model::pcnst];
   for (int i = 0; i < aero_model::pcnst; ++i)
     species_class[i] = config_.species_class[i];
@@ -3181,6 +3262,13 @@ void ConvProc::compute_tendencies(const AeroConfig &config,
   // Delta pressure between interfaces [mb]
   const Real *dp = diagnostics.delta_pressure.data();
 
+  // Index of cloud top and bottom
+  int ktop = config_.ktop;
+  int kbot = config_.kbot;
+  if (config_.detect_convective_extent)
+    convproc::find_convective_extent(nlev, du, eu, ed, rprddp, evapcdp, ktop,
+                                     kbot);
+
   // Tracer mixing ratio (TMR) including water vapor [kg/kg]
   const auto state_q = diagnostics.tracer_mixing_ratio;
   // Time tendency of tracer mixing ratio (TMR) [kg/kg/s]
@@ -3196,7 +3284,7 @@ void ConvProc::compute_tendencies(const AeroConfig &config,
       pmid, dpdry, pdel, dt, dp_frac, icwmrdp, rprddp, evapcdp, sh_frac,
       icwmrsh, rprdsh, evapcsh, dlftot, dlfsh, sh_e_ed_ratio, du, eu, ed, dp,
       ktop, kbot, species_class, mmtoo_prevap_resusp, state_q, ptend_q,
-      ptend_lq, aerdepwetis);
+      ptend_lq, aerdepwetis, config_.skip_stats);
 }
 } // namespace mam4
 #endif
@@ -8,6 +8,7 @@
 
 #include <haero/atmosphere.hpp>
 #include <mam4xx/aero_config.hpp>
+#include <mam4xx/column_batch.hpp>
 #include <mam4xx/spitfire_transport.hpp>
 
 #include <mam4xx/convproc.hpp>
@@ -1119,6 +1120,16 @@ void aero_model_drydep(
         }
       });
 }
+
+// Calls kernel(team, icol) on each column of a batch of num_columns columns in
+// a single launch, profiled as a region named "aero_model_drydep". The kernel
+// is expected to call aero_model_drydep on column icol.
+template <typename Kernel>
+void aero_model_drydep_for_columns(const int num_columns,
+                                   const Kernel &kernel) {
+  for_each_column("aero_model_drydep", num_columns, mam4::nlev, kernel);
+}
+
 // compute_tendencies -- computes tendencies and updates diagnostics
 // NOTE: that both diags and tends are const below--this means their views
 // NOTE: are fixed, but the data in those views is allowed to vary.
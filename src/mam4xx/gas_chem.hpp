@@ -7,6 +7,7 @@
 #include <haero/math.hpp>
 
 #include <mam4xx/aero_config.hpp>
+#include <mam4xx/column_batch.hpp>
 #include <mam4xx/conversions.hpp>
 #include <mam4xx/gas_chem_mechanism.hpp>
 #include <mam4xx/mam4_types.hpp>
@@ -431,6 +432,16 @@ void imp_sol(Real base_sol[gas_pcnst], // inout - species mixing ratios [vmr]
 
   } // cls_loop
 } // imp_sol
+
+// Calls kernel(team, icol) on each column of a batch of num_columns columns
+// with num_levels levels in a single launch, profiled as a region named
+// "imp_sol". The kernel is expected to call imp_sol on the levels of column
+// icol.
+template <typename Kernel>
+void imp_sol_for_columns(const int num_columns, const int num_levels,
+                         const Kernel &kernel) {
+  for_each_column("imp_sol", num_columns, num_levels, kernel);
+}
 } // namespace gas_chemistry
 } // namespace mam4
 #endif
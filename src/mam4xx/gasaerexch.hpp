@@ -20,6 +20,25 @@
 
 namespace mam4 {
 
+namespace gasaerexch {
+
+/// UptakeRateCache holds the H2SO4 uptake rates of single particles of each
+/// mode in a grid cell, together with the temperature and wet diameters for
+/// which they were computed. The uptake rates of all gases are proportional
+/// to these, so they can be reused while the state of the cell stays close
+/// to the one they were computed for (see
+/// GasAerExch::Config::uptake_rate_refresh_threshold).
+struct UptakeRateCache {
+  // temperature at which the rates were computed [K] (0 if never computed)
+  Real temperature;
+  // wet geometric mean diameters at which the rates were computed [m]
+  Real wet_diameter[AeroConfig::num_modes()];
+  // H2SO4 uptake rate for a number concentration of 1 #/m3 [m3/s]
+  Real uptkaer_ref[AeroConfig::num_modes()];
+};
+
+} // namespace gasaerexch
+
 /// @class GasAerExch
 /// This class implements MAM4's gas/aersol exchange  parameterization. Its
 /// structure is defined by the usage of the impl_ member in the AeroProcess
@@ -27,7 +46,11 @@ namespace mam4 {
 /// ../aero_process.hpp.
 class GasAerExch {
 public:
+#ifdef MAM4XX_ENABLE_NH3
+  static constexpr int num_gas_to_aer = 3;
+#else
   static constexpr int num_gas_to_aer = 2;
+#endif
   static constexpr int num_mode = AeroConfig::num_modes();
   static constexpr int num_gas = AeroConfig::num_gas_ids();
   static constexpr int num_aer = AeroConfig::num_aerosol_ids();
@@ -50,17 +73,29 @@ public:
   KOKKOS_INLINE_FUNCTION
   static const GasId (&Gases())[num_gas] {
     // see mam4xx/aero_modes.hpp
-    static const GasId gases[num_gas] = {GasId::O3,  GasId::H2O2, GasId::H2SO4,
-                                         GasId::SO2, GasId::DMS,  GasId::SOAG};
+    static const GasId gases[num_gas] = {
+        GasId::O3,  GasId::H2O2, GasId::H2SO4,
+        GasId::SO2, GasId::DMS,  GasId::SOAG,
+#ifdef MAM4XX_ENABLE_NH3
+        GasId::NH3
+#endif
+    };
     return gases;
   }
-  // NH3 -> NH4 condensation is a future enhancement
+#ifdef MAM4XX_ENABLE_NH3
+  static constexpr int iaer_nh4 = static_cast<int>(AeroId::NH4);
+  static constexpr int igas_nh3 = static_cast<int>(GasId::NH3);
+#else
+  // NH3 -> NH4 condensation requires MAM4XX_ENABLE_NH3
   static constexpr int iaer_nh4 = -1;
   static constexpr int igas_nh3 = -1;
+#endif
 
   // In MAM4, there are only two gases that condense to aerosols:
   // 1. H2SO4 -> SO4
   // 2. SOAG  -> SOA
+  // With MAM4XX_ENABLE_NH3, a third one condenses:
+  // 3. NH3   -> NH4
   KOKKOS_INLINE_FUNCTION
   static constexpr AeroId gas_to_aer(const GasId gas) {
     AeroId air = AeroId::None;
@@ -68,6 +103,10 @@ public:
       air = AeroId::SO4;
     else if (GasId::SOAG == gas)
       air = AeroId::SOA;
+#ifdef MAM4XX_ENABLE_NH3
+    else if (GasId::NH3 == gas)
+      air = AeroId::NH4;
+#endif
     return air;
   }
   //------------------------------------------------------------------
@@ -80,7 +119,11 @@ public:
   KOKKOS_INLINE_FUNCTION
   static constexpr Real uptk_rate_factor(const int i) {
     const Real uptk_rate[num_gas] = {
-        0.0, 0.0, 1.0, 0.0, 0.0, Constants::soag_h2so4_uptake_coeff_ratio};
+        0.0, 0.0, 1.0, 0.0, 0.0, Constants::soag_h2so4_uptake_coeff_ratio,
+#ifdef MAM4XX_ENABLE_NH3
+        2.08 // NH3 (as in E3SM's modal_aero_amicphys)
+#endif
+    };
     return uptk_rate[i];
   }
 
@@ -118,8 +161,27 @@ public:
 
     bool calculate_gas_uptake_coefficient = true;
 
-    // Do we have NH3? Not something supported at this time.
+    // If positive, the single-particle uptake rates are cached in the
+    // Diagnostics (uptkaer_ref_*) and recomputed only when the temperature or
+    // a wet diameter has changed by more than this relative amount since they
+    // were last computed. Otherwise they are recomputed at every call.
+    // Used only with calculate_gas_uptake_coefficient.
+    Real uptake_rate_refresh_threshold = 0;
+
+    // choice of the SOA substeps when dtsub_soa_fixed <= 0
+    gasaerexch::SOAStepControl soa_step_control;
+    // if enabled, records the number of SOA substeps at each level of each
+    // column (the column being the league rank of the team)
+    gasaerexch::SOASubstepStats soa_substep_stats;
+
+#ifdef MAM4XX_ENABLE_NH3
+    // Do we condense NH3 to NH4? If false, NH3 is left unchanged, as it is
+    // in a build without MAM4XX_ENABLE_NH3.
+    bool igas_nh3 = true;
+#else
+    // Do we have NH3? Only with MAM4XX_ENABLE_NH3.
     static constexpr bool igas_nh3 = false;
+#endif
 
     // qgas_netprod_otrproc = gas net production rate from other processes
     // such as gas-phase chemistry and emissions (mol/mol/s)
@@ -176,6 +238,25 @@ public:
                           const Diagnostics &diags,
                           const Tendencies &tends) const;
 
+  // mam_gasaerexch_1subarea_ -- applies gas-aerosol exchange to the mixing
+  // ratios of a single grid cell using the tables set up in init. This allows
+  // drivers that chain several processes at one level to reuse this process's
+  // configuration without going through the column views. If cache is given
+  // and the configuration caches uptake rates, the rates are taken from (and
+  // refreshed in) the cache.
+  KOKKOS_INLINE_FUNCTION
+  void mam_gasaerexch_1subarea_(const Real dt, const Real temp,
+                                const Real pmid, const Real aircon,
+                                Real qgas_cur[num_gas], Real qgas_avg[num_gas],
+                                Real qaer_cur[num_aer][num_mode],
+                                Real qnum_cur[num_mode],
+                                const Real dgn_awet[num_mode],
+                                Real uptkaer[num_gas][num_mode],
+                                Real &uptkrate_h2so4, int &niter_out,
+                                Real &g0_soa_out,
+                                gasaerexch::UptakeRateCache *cache =
+                                    nullptr) const;
+
 private:
   // Gas-Aerosol-Exchange-specific configuration
   Config config_;
@@ -183,6 +264,11 @@ private:
   bool l_gas_condense_to_mode[num_gas][num_mode] = {};
   int eqn_and_numerics_category[num_gas] = {};
   Real modes_mean_std_dev[num_mode] = {};
+
+  // per-gas and per-mode tables shared by all cells, set up in init
+  AeroId gas_to_aer_ids[num_gas] = {};
+  Real alnsg_aer[num_mode] = {};
+  Real uptk_rate[num_gas] = {};
 };
 
 namespace gasaerexch {
@@ -319,6 +405,178 @@ Real fuchs_sutugin(const Real &D_p, const Real &gasfreepath,
   return fuchs_sutugin;
 }
 
+// GaussHermite<NGHQ>::rule fills the abscissae x and weights w of the
+// NGHQ-point Gauss-Hermite quadrature rule (NGHQ = 2, 4, 10, or 20).
+template <int NGHQ> struct GaussHermite;
+
+template <> struct GaussHermite<2> {
+  KOKKOS_INLINE_FUNCTION
+  static void rule(Real x[2], Real w[2]) {
+    const Real xghq[2] = {-7.0710678118654746e-01, 7.0710678118654746e-01};
+    const Real wghq[2] = {8.8622692545275794e-01, 8.8622692545275794e-01};
+    for (int i = 0; i < 2; ++i) {
+      x[i] = xghq[i];
+      w[i] = wghq[i];
+    }
+  }
+};
+
+template <> struct GaussHermite<4> {
+  KOKKOS_INLINE_FUNCTION
+  static void rule(Real x[4], Real w[4]) {
+    const Real xghq[4] = {-1.6506801238858, -0.52464762327529,
+                          0.52464762327529, 1.6506801238858};
+    const Real wghq[4] = {0.081312835447245, 0.8049140900055, 0.8049140900055,
+                          0.081312835447245};
+    for (int i = 0; i < 4; ++i) {
+      x[i] = xghq[i];
+      w[i] = wghq[i];
+    }
+  }
+};
+
+template <> struct GaussHermite<10> {
+  KOKKOS_INLINE_FUNCTION
+  static void rule(Real x[10], Real w[10]) {
+    const Real xghq[10] = {
+        -3.436159118837737603327,  -2.532731674232789796409,
+        -1.756683649299881773451,  -1.036610829789513654178,
+        -0.3429013272237046087892, 0.3429013272237046087892,
+        1.036610829789513654178,   1.756683649299881773451,
+        2.532731674232789796409,   3.436159118837737603327};
+    const Real wghq[10] = {
+        7.64043285523262062916e-6,  0.001343645746781232692202,
+        0.0338743944554810631362,   0.2401386110823146864165,
+        0.6108626337353257987836,   0.6108626337353257987836,
+        0.2401386110823146864165,   0.03387439445548106313616,
+        0.001343645746781232692202, 7.64043285523262062916E-6};
+    for (int i = 0; i < 10; ++i) {
+      x[i] = xghq[i];
+      w[i] = wghq[i];
+    }
+  }
+};
+
+template <> struct GaussHermite<20> {
+  KOKKOS_INLINE_FUNCTION
+  static void rule(Real x[20], Real w[20]) {
+    const Real xghq[20] = {
+        -5.3874808900112,  -4.6036824495507, -3.9447640401156,
+        -3.3478545673832,  -2.7888060584281, -2.2549740020893,
+        -1.7385377121166,  -1.2340762153953, -0.73747372854539,
+        -0.2453407083009,  0.2453407083009,  0.73747372854539,
+        1.2340762153953,   1.7385377121166,  2.2549740020893,
+        2.7888060584281,   3.3478545673832,  3.9447640401156,
+        4.6036824495507,   5.3874808900112};
+    const Real wghq[20] = {
+        2.229393645534e-13, 4.399340992273e-10, 1.086069370769e-7,
+        7.80255647853e-6,   2.283386360164e-4,  0.003243773342238,
+        0.024810520887464,  0.10901720602002,   0.28667550536283,
+        0.46224366960061,   0.46224366960061,   0.28667550536283,
+        0.10901720602002,   0.024810520887464,  0.003243773342238,
+        2.283386360164e-4,  7.80255647853e-6,   1.086069370769e-7,
+        4.399340992273e-10, 2.229393645534e-13};
+    for (int i = 0; i < 20; ++i) {
+      x[i] = xghq[i];
+      w[i] = wghq[i];
+    }
+  }
+};
+
+// Computes the uptake rates uptkaer[g][n] of NGAS condensing gases to all
+// modes as gas_aer_uptkrates_1box1gas does for a single gas, using the
+// NGHQ-point Gauss-Hermite quadrature rule. Quantities that depend only on
+// the modes (or only on the gases) are computed once, and the loops over
+// gases, modes, and quadrature points have compile-time trip counts.
+template <int NGHQ, int NGAS>
+KOKKOS_INLINE_FUNCTION void gas_aer_uptkrates_1box(
+    const bool l_condense_to_mode[NGAS][GasAerExch::num_mode],
+    const Real temp, const Real pmid, const Real pstd, const Real mw_gas[NGAS],
+    const Real mw_air_gmol, const Real vol_molar_gas[NGAS],
+    const Real vol_molar_air, const Real accom[NGAS],
+    const Real r_universal_mJ, const Real pi, const Real beta_inp,
+    const Real dgncur_awet[GasAerExch::num_mode],
+    const Real lnsg[GasAerExch::num_mode],
+    Real uptkaer[NGAS][GasAerExch::num_mode]) {
+  constexpr int num_mode = GasAerExch::num_mode;
+  const Real tworootpi = 2 * haero::sqrt(pi);
+  const Real root2 = haero::sqrt(2.0);
+  const Real one = 1.0;
+  const Real two = 2.0;
+
+  Real xghq[NGHQ], wghq[NGHQ];
+  GaussHermite<NGHQ>::rule(xghq, wghq);
+
+  // pressure (atmospheres)
+  const Real p_in_atm = pmid / pstd;
+
+  // mode-dependent quantities, shared by all gases
+  Real lndpgn[num_mode];          // ln(D_p) at the mode's diameter (m)
+  Real lnsg_xghq[num_mode][NGHQ]; // offsets of quadrature points from lndpgn
+  for (int n = 0; n < num_mode; ++n) {
+    lndpgn[n] = haero::log(dgncur_awet[n]);
+    for (int iq = 0; iq < NGHQ; ++iq)
+      lnsg_xghq[n][iq] = root2 * lnsg[n] * xghq[iq];
+  }
+
+  for (int g = 0; g < NGAS; ++g) {
+    // gas diffusivity (m2/s)
+    const Real gasdiffus =
+        gas_diffusivity(temp, p_in_atm, mw_gas[g], mw_air_gmol,
+                        vol_molar_gas[g], vol_molar_air);
+    // gas mean free path (m)
+    const Real molecular_speed =
+        mean_molecular_speed(temp, mw_gas[g], r_universal_mJ, pi);
+    const Real gasfreepath = 3.0 * gasdiffus / molecular_speed;
+    const Real accomxp283 = accom[g] * 0.283;
+    const Real accomxp75 = accom[g] * 0.75;
+
+    for (int n = 0; n < num_mode; ++n) {
+      // beta = dln(uptake_rate)/dln(D_p)
+      //      = 2.0 in free molecular regime, 1.0 in continuum regime
+      // if uptake_rate ~= a * (D_p**beta), then the 2 point quadrature
+      // is very accurate
+      Real beta = 0;
+      if (haero::abs(beta_inp - 1.5) > 0.5) {
+        // D_p = dgncur_awet(n) * haero::exp( 1.5*(lnsg[n]**2) )
+        const Real D_p = dgncur_awet[n];
+        const Real knudsen = two * gasfreepath / D_p;
+
+        // tmpa = dln(fuchs_sutugin)/d(knudsen)
+        const Real tmpa =
+            one / (one + knudsen) -
+            (two * knudsen + one + accomxp283) /
+                (knudsen * (knudsen + one + accomxp283) + accomxp75);
+        beta = one - knudsen * tmpa;
+        beta = haero::max(one, haero::min(two, beta));
+      } else {
+        beta = beta_inp;
+      }
+      const Real constant =
+          tworootpi * haero::exp(beta * lndpgn[n] +
+                                 0.5 * haero::pow(beta * lnsg[n], 2.0));
+
+      // sum over gauss-hermite quadrature points
+      const Real lndp_center = lndpgn[n] + beta * lnsg[n] * lnsg[n];
+      Real sumghq = 0.0;
+      for (int iq = 0; iq < NGHQ; ++iq) {
+        const Real D_p = haero::exp(lndp_center + lnsg_xghq[n][iq]);
+        const Real hh =
+            fuchs_sutugin(D_p, gasfreepath, accomxp283, accomxp75);
+        sumghq += wghq[iq] * D_p * hh / haero::pow(D_p, beta);
+      }
+      // gas-to-aerosol mass transfer rates
+      // (1/s) for number concentration = 1 #/m3
+      const Real uptkrate = constant * gasdiffus * sumghq;
+
+      // ------------------------------------------------------------------
+      // Unit of uptkrate is for number = 1 #/m3.
+      // ------------------------------------------------------------------
+      uptkaer[g][n] = l_condense_to_mode[g][n] ? uptkrate : 0.0;
+    }
+  }
+}
+
 KOKKOS_INLINE_FUNCTION
 void gas_aer_uptkrates_1box1gas(
     const bool l_condense_to_mode[GasAerExch::num_mode], const Real temp,
@@ -352,136 +610,215 @@ void gas_aer_uptkrates_1box1gas(
   //      x = ln(D_p)
   //      dN/dx = log-normal particle number density distribution
   //----------------------------------------------------------------------
-  const Real tworootpi = 2 * haero::sqrt(pi);
-  const Real root2 = haero::sqrt(2.0);
-  const Real one = 1.0;
-  const Real two = 2.0;
-
-  // Dick's old version
-  // integer, parameter :: nghq = 2
-  // real(wp), save :: xghq(nghq), wghq(nghq) ! quadrature abscissae and
-  // weights data xghq / 0.70710678, -0.70710678 / data wghq / 0.88622693,
-  // 0.88622693 /
-
-  // choose
-  // nghq-----------------------------------------------------------------
-  const Kokkos::Array<Real, 20> xghq_20 = {
-      -5.3874808900112,  -4.6036824495507, -3.9447640401156, -3.3478545673832,
-      -2.7888060584281,  -2.2549740020893, -1.7385377121166, -1.2340762153953,
-      -0.73747372854539, -0.2453407083009, 0.2453407083009,  0.73747372854539,
-      1.2340762153953,   1.7385377121166,  2.2549740020893,  2.7888060584281,
-      3.3478545673832,   3.9447640401156,  4.6036824495507,  5.3874808900112};
-  const Kokkos::Array<Real, 20> wghq_20 = {
-      2.229393645534e-13, 4.399340992273e-10, 1.086069370769e-7,
-      7.80255647853e-6,   2.283386360164e-4,  0.003243773342238,
-      0.024810520887464,  0.10901720602002,   0.28667550536283,
-      0.46224366960061,   0.46224366960061,   0.28667550536283,
-      0.10901720602002,   0.024810520887464,  0.003243773342238,
-      2.283386360164e-4,  7.80255647853e-6,   1.086069370769e-7,
-      4.399340992273e-10, 2.229393645534e-13};
-  const Kokkos::Array<Real, 10> xghq_10 = {
-      -3.436159118837737603327,  -2.532731674232789796409,
-      -1.756683649299881773451,  -1.036610829789513654178,
-      -0.3429013272237046087892, 0.3429013272237046087892,
-      1.036610829789513654178,   1.756683649299881773451,
-      2.532731674232789796409,   3.436159118837737603327};
-  const Kokkos::Array<Real, 10> wghq_10 = {
-      7.64043285523262062916e-6,  0.001343645746781232692202,
-      0.0338743944554810631362,   0.2401386110823146864165,
-      0.6108626337353257987836,   0.6108626337353257987836,
-      0.2401386110823146864165,   0.03387439445548106313616,
-      0.001343645746781232692202, 7.64043285523262062916E-6};
-  const Kokkos::Array<Real, 4> xghq_4 = {-1.6506801238858, -0.52464762327529,
-                                         0.52464762327529, 1.6506801238858};
-  const Kokkos::Array<Real, 4> wghq_4 = {0.081312835447245, 0.8049140900055,
-                                         0.8049140900055, 0.081312835447245};
-  const Kokkos::Array<Real, 2> xghq_2 = {-7.0710678118654746e-01,
-                                         7.0710678118654746e-01};
-  const Kokkos::Array<Real, 2> wghq_2 = {8.8622692545275794e-01,
-                                         8.8622692545275794e-01};
-  Real const *xghq = nullptr;
-  Real const *wghq = nullptr;
+  //  The rate is computed by gas_aer_uptkrates_1box, specialized for the
+  //  requested nghq.
+  //----------------------------------------------------------------------
+  constexpr int num_mode = GasAerExch::num_mode;
+  bool l_condense[1][num_mode];
+  for (int n = 0; n < num_mode; ++n)
+    l_condense[0][n] = l_condense_to_mode[n];
+  const Real mw[1] = {mw_gas}, vol_molar[1] = {vol_molar_gas};
+  const Real accom_gas[1] = {accom};
+  Real uptk[1][num_mode];
   if (20 == nghq) {
-    xghq = xghq_20.data();
-    wghq = wghq_20.data();
+    gas_aer_uptkrates_1box<20, 1>(l_condense, temp, pmid, pstd, mw,
+                                  mw_air_gmol, vol_molar, vol_molar_air,
+                                  accom_gas, r_universal_mJ, pi, beta_inp,
+                                  dgncur_awet, lnsg, uptk);
   } else if (10 == nghq) {
-    xghq = xghq_10.data();
-    wghq = wghq_10.data();
+    gas_aer_uptkrates_1box<10, 1>(l_condense, temp, pmid, pstd, mw,
+                                  mw_air_gmol, vol_molar, vol_molar_air,
+                                  accom_gas, r_universal_mJ, pi, beta_inp,
+                                  dgncur_awet, lnsg, uptk);
   } else if (4 == nghq) {
-    xghq = xghq_4.data();
-    wghq = wghq_4.data();
+    gas_aer_uptkrates_1box<4, 1>(l_condense, temp, pmid, pstd, mw, mw_air_gmol,
+                                 vol_molar, vol_molar_air, accom_gas,
+                                 r_universal_mJ, pi, beta_inp, dgncur_awet,
+                                 lnsg, uptk);
   } else if (2 == nghq) {
-    xghq = xghq_2.data();
-    wghq = wghq_2.data();
+    gas_aer_uptkrates_1box<2, 1>(l_condense, temp, pmid, pstd, mw, mw_air_gmol,
+                                 vol_molar, vol_molar_air, accom_gas,
+                                 r_universal_mJ, pi, beta_inp, dgncur_awet,
+                                 lnsg, uptk);
   } else {
     printf("nghq integration option is not available: %d, "
            "valid are 20, 10, 4, and 2\n",
            nghq);
     Kokkos::abort("Invalid integration order requested.");
   }
-  //-----------------------------------------------------------------------
+  for (int n = 0; n < num_mode; ++n)
+    uptkaer[n] = uptk[0][n];
+}
 
-  // pressure (atmospheres)
-  const Real p_in_atm = pmid / pstd;
-  // gas diffusivity (m2/s)
-  const Real gasdiffus = gas_diffusivity(temp, p_in_atm, mw_gas, mw_air_gmol,
-                                         vol_molar_gas, vol_molar_air);
-  // gas mean free path (m)
-  const Real molecular_speed =
-      mean_molecular_speed(temp, mw_gas, r_universal_mJ, pi);
-  const Real gasfreepath = 3.0 * gasdiffus / molecular_speed;
-  const Real accomxp283 = accom * 0.283;
-  const Real accomxp75 = accom * 0.75;
-
-  // outermost loop over all modes
+// h2so4_uptkrates_per_particle -- computes the reference uptake coefficient
+// of H2SO4 for all aerosol modes, for a number concentration of 1 #/m3
+KOKKOS_INLINE_FUNCTION
+void h2so4_uptkrates_per_particle(
+    const int nghq,                              // in
+    const Real temp,                             // in
+    const Real pmid,                             // in
+    const Real dgn_awet[GasAerExch::num_mode],   // in
+    const Real alnsg_aer[GasAerExch::num_mode],  // in
+    Real uptkaer_ref[GasAerExch::num_mode]) {    // out
+  const Real pstd = Constants::pressure_stp;                       // [Pa]
+  const Real mw_h2so4_gmol = 1000 * Constants::molec_weight_h2so4; // [g/mol]
+  const Real mw_air_gmol = 1000 * Constants::molec_weight_dry_air; // [g/mol]
+  const Real vol_molar_h2so4 = Constants::molec_diffusion_h2so4;   // [-]
+  const Real vol_molar_air = Constants::molec_diffusion_dry_air;   // [-]
+  const Real accom_coef_h2so4 = Constants::accom_coef_h2so4;       // [-]
+  const Real r_universal_mJ = 1000 * Constants::r_gas; // [mJ/(K mol)]
+  const Real r_pi = Constants::pi;
+
+  const Real beta_inp = 0; // quadrature parameter (--)
+
+  // do calcullation for ALL modes
+  const bool l_condense_to_mode[GasAerExch::num_mode] = {true, true, true,
+                                                         true};
+  // initialize with zero (-> no uptake)
+  for (int imode = 0; imode < GasAerExch::num_mode; ++imode)
+    uptkaer_ref[imode] = 0;
+  gasaerexch::gas_aer_uptkrates_1box1gas(
+      l_condense_to_mode, temp, pmid, pstd, mw_h2so4_gmol, mw_air_gmol,
+      vol_molar_h2so4, vol_molar_air, accom_coef_h2so4, r_universal_mJ, r_pi,
+      beta_inp, nghq, dgn_awet, alnsg_aer, uptkaer_ref);
+}
+
+// scale_gas_uptkrates -- assigns the uptake rate of each gas species to each
+// mode from the reference uptake coefficients of H2SO4
+KOKKOS_INLINE_FUNCTION
+void scale_gas_uptkrates(
+    const int igas_h2so4, // in
+    const bool l_gas_condense_to_mode[GasAerExch::num_gas]
+                                     [GasAerExch::num_mode],   // in
+    const Real uptk_rate_factor[GasAerExch::num_gas],        // in
+    const Real aircon,                                       // in
+    const Real qnum_cur[GasAerExch::num_mode],               // in
+    const Real uptkaer_ref[GasAerExch::num_mode],            // in
+    Real uptkaer[GasAerExch::num_gas][GasAerExch::num_mode], // out
+    Real &uptkrate_h2so4) {                                  // out
+  const int num_mode = GasAerExch::num_mode;
+  const int num_gas = GasAerExch::num_gas;
+
+  // -------------------------------------------------------------
+  // Unit conversion: uptkrate is for number = 1 #/m3, so mult. by
+  // number conc. (#/m3)
+  //--------------------------------------------------------------
+  Real uptkaer_num[num_mode];
+  for (int imode = 0; imode < num_mode; ++imode)
+    uptkaer_num[imode] = uptkaer_ref[imode] * (qnum_cur[imode] * aircon);
+
+  //===============================================================
+  // Assign uptake rate to each gas species and each mode using the
+  // ref. value uptkaer_ref calculated above and the uptake rate
+  // factor specified as constants at the beginning of the module
+  //===============================================================
+  // gas to aerosol mass transfer rate (1/s)
+  for (int igas = 0; igas < num_gas; ++igas)
+    for (int imode = 0; imode < num_mode; ++imode)
+      uptkaer[igas][imode] = 0.0; // default is no uptake
+
+  for (int igas = 0; igas < num_gas; ++igas) {
+    for (int imode = 0; imode < num_mode; ++imode)
+      if (l_gas_condense_to_mode[igas][imode])
+        uptkaer[igas][imode] = uptkaer_num[imode] * uptk_rate_factor[igas];
+  }
+
+  // total uptake rate (sum of all aerosol modes) for h2so4.
+  // Diagnosd for calling routine. Not used in this subroutne.
+  uptkrate_h2so4 = 0;
+  for (int n = 0; n < num_mode; ++n)
+    uptkrate_h2so4 += uptkaer[igas_h2so4][n];
+}
+
+// uptkrates_stale -- returns true if the temperature or a wet diameter has
+// changed by more than the given relative threshold since the rates in the
+// cache were computed (or if they never were)
+KOKKOS_INLINE_FUNCTION
+bool uptkrates_stale(const Real threshold, const Real temp,
+                     const Real dgn_awet[GasAerExch::num_mode],
+                     const UptakeRateCache &cache) {
+  if (haero::abs(temp - cache.temperature) > threshold * cache.temperature)
+    return true;
   for (int n = 0; n < GasAerExch::num_mode; ++n) {
-    const Real lndpgn = haero::log(dgncur_awet[n]); // (m)
-
-    // beta = dln(uptake_rate)/dln(D_p)
-    //      = 2.0 in free molecular regime, 1.0 in continuum regime
-    // if uptake_rate ~= a * (D_p**beta), then the 2 point quadrature
-    // is very accurate
-    Real beta = 0;
-    if (std::abs(beta_inp - 1.5) > 0.5) {
-      // D_p = dgncur_awet(n) * haero::exp( 1.5*(lnsg[n]**2) )
-      const Real D_p = dgncur_awet[n];
-      const Real knudsen = two * gasfreepath / D_p;
-
-      // tmpa = dln(fuchs_sutugin)/d(knudsen)
-      const Real tmpa =
-          one / (one + knudsen) -
-          (two * knudsen + one + accomxp283) /
-              (knudsen * (knudsen + one + accomxp283) + accomxp75);
-      beta = one - knudsen * tmpa;
-      beta = haero::max(one, haero::min(two, beta));
-    } else {
-      beta = beta_inp;
-    }
-    const Real constant =
-        tworootpi *
-        haero::exp(beta * lndpgn + 0.5 * haero::pow(beta * lnsg[n], 2.0));
-
-    // sum over gauss-hermite quadrature points
-    Real sumghq = 0.0;
-    for (int iq = 0; iq < nghq; ++iq) {
-      const Real lndp =
-          lndpgn + beta * lnsg[n] * lnsg[n] + root2 * lnsg[n] * xghq[iq];
-      const Real D_p = haero::exp(lndp);
-
-      const Real hh = fuchs_sutugin(D_p, gasfreepath, accomxp283, accomxp75);
-      sumghq += wghq[iq] * D_p * hh / haero::pow(D_p, beta);
-    }
-    // gas-to-aerosol mass transfer rates
-    // (1/s) for number concentration = 1 #/m3
-    const Real uptkrate = constant * gasdiffus * sumghq;
-
-    // --------------------------------------------------------------------
-    // Unit of uptkrate is for number = 1 #/m3.
-    // --------------------------------------------------------------------
-    uptkaer[n] = l_condense_to_mode[n] ? uptkrate : 0.0; // zero means no uptake
+    if (haero::abs(dgn_awet[n] - cache.wet_diameter[n]) >
+        threshold * cache.wet_diameter[n])
+      return true;
+  }
+  return false;
+}
+
+// cached_gas_uptkrates -- computes the uptake rate of each gas species to each
+// mode like mam_gasaerexch_1subarea does, but from the reference uptake
+// coefficients in the given cache, which are recomputed (and the cache
+// updated) only if they are stale
+KOKKOS_INLINE_FUNCTION
+void cached_gas_uptkrates(
+    const int nghq,       // in
+    const int igas_h2so4, // in
+    const Real threshold, // in
+    const bool l_gas_condense_to_mode[GasAerExch::num_gas]
+                                     [GasAerExch::num_mode],   // in
+    const Real temp,                                         // in
+    const Real pmid,                                         // in
+    const Real aircon,                                       // in
+    const Real qnum_cur[GasAerExch::num_mode],               // in
+    const Real dgn_awet[GasAerExch::num_mode],               // in
+    const Real alnsg_aer[GasAerExch::num_mode],              // in
+    const Real uptk_rate_factor[GasAerExch::num_gas],        // in
+    UptakeRateCache &cache,                                  // inout
+    Real uptkaer[GasAerExch::num_gas][GasAerExch::num_mode], // out
+    Real &uptkrate_h2so4) {                                  // out
+  if (uptkrates_stale(threshold, temp, dgn_awet, cache)) {
+    h2so4_uptkrates_per_particle(nghq, temp, pmid, dgn_awet, alnsg_aer,
+                                 cache.uptkaer_ref);
+    cache.temperature = temp;
+    for (int n = 0; n < GasAerExch::num_mode; ++n)
+      cache.wet_diameter[n] = dgn_awet[n];
+  }
+  scale_gas_uptkrates(igas_h2so4, l_gas_condense_to_mode, uptk_rate_factor,
+                      aircon, qnum_cur, cache.uptkaer_ref, uptkaer,
+                      uptkrate_h2so4);
+}
+
+// load_uptkrate_cache -- returns the uptake rate cache stored in the given
+// diagnostics at level k
+KOKKOS_INLINE_FUNCTION
+UptakeRateCache load_uptkrate_cache(const Diagnostics &diags, const int k) {
+  UptakeRateCache cache;
+  cache.temperature = diags.uptkaer_ref_temperature(k);
+  for (int n = 0; n < GasAerExch::num_mode; ++n) {
+    cache.wet_diameter[n] = diags.uptkaer_ref_wet_diameter[n](k);
+    cache.uptkaer_ref[n] = diags.uptkaer_ref[n](k);
+  }
+  return cache;
+}
+
+// store_uptkrate_cache -- stores the given uptake rate cache in the given
+// diagnostics at level k
+KOKKOS_INLINE_FUNCTION
+void store_uptkrate_cache(const UptakeRateCache &cache,
+                          const Diagnostics &diags, const int k) {
+  diags.uptkaer_ref_temperature(k) = cache.temperature;
+  for (int n = 0; n < GasAerExch::num_mode; ++n) {
+    diags.uptkaer_ref_wet_diameter[n](k) = cache.wet_diameter[n];
+    diags.uptkaer_ref[n](k) = cache.uptkaer_ref[n];
   }
 }
 
+// uptkrate_cache_enabled -- returns true if the given configuration caches the
+// uptake rates, in which case the given diagnostics must hold the cache
+KOKKOS_INLINE_FUNCTION
+bool uptkrate_cache_enabled(const GasAerExch::Config &config,
+                            const Diagnostics &diags) {
+  if (!config.calculate_gas_uptake_coefficient ||
+      !(config.uptake_rate_refresh_threshold > 0))
+    return false;
+  if (diags.uptkaer_ref_temperature.data() == nullptr)
+    Kokkos::abort("GasAerExch: uptake_rate_refresh_threshold is set, but the "
+                  "diagnostics hold no uptake rate cache (uptkaer_ref_*)\n");
+  return true;
+}
+
 KOKKOS_INLINE_FUNCTION
 void mam_gasaerexch_1subarea(
     const int nghq,                               // in
@@ -512,64 +849,24 @@ void mam_gasaerexch_1subarea(
     Real uptkaer[GasAerExch::num_gas][GasAerExch::num_mode], // inout
     Real &uptkrate_h2so4,                                    // out
     int &niter_out,                                          // out
-    Real &g0_soa_out) {                                      // out
+    Real &g0_soa_out,                                        // out
+    const SOAStepControl &soa_control = SOAStepControl()) {  // in
   const int num_mode = GasAerExch::num_mode;
-  const int num_gas = GasAerExch::num_gas;
 
-  const Real pstd = Constants::pressure_stp;                       // [Pa]
-  const Real mw_h2so4_gmol = 1000 * Constants::molec_weight_h2so4; // [g/mol]
-  const Real mw_air_gmol = 1000 * Constants::molec_weight_dry_air; // [g/mol]
-  const Real vol_molar_h2so4 = Constants::molec_diffusion_h2so4;   // [-]
-  const Real vol_molar_air = Constants::molec_diffusion_dry_air;   // [-]
-  const Real accom_coef_h2so4 = Constants::accom_coef_h2so4;       // [-]
+  const Real pstd = Constants::pressure_stp;           // [Pa]
   const Real r_universal_mJ = 1000 * Constants::r_gas; // [mJ/(K mol)]
-  const Real r_pi = Constants::pi;
 
-  const Real beta_inp = 0; // quadrature parameter (--)
   //===============================================================
   // Calculate the reference uptake coefficient for all
   // aerosol modes using properties of the H2SO4 gas
   //===============================================================
   if (l_calc_gas_uptake_coeff) {
-    // do calcullation for ALL modes
-    const bool l_condense_to_mode[num_mode] = {true, true, true, true};
-    // initialize with zero (-> no uptake)
-    Real uptkaer_ref[num_mode] = {0, 0, 0, 0};
-    gasaerexch::gas_aer_uptkrates_1box1gas(
-        l_condense_to_mode, temp, pmid, pstd, mw_h2so4_gmol, mw_air_gmol,
-        vol_molar_h2so4, vol_molar_air, accom_coef_h2so4, r_universal_mJ, r_pi,
-        beta_inp, nghq, dgn_awet, alnsg_aer, uptkaer_ref);
-
-    // -------------------------------------------------------------
-    // Unit conversion: uptkrate is for number = 1 #/m3, so mult. by
-    // number conc. (#/m3)
-    //--------------------------------------------------------------
-    for (int imode = 0; imode < num_mode; ++imode) {
-      if (l_condense_to_mode[imode]) {
-        uptkaer_ref[imode] *= qnum_cur[imode] * aircon;
-      }
-    }
-    //===============================================================
-    // Assign uptake rate to each gas species and each mode using the
-    // ref. value uptkaer_ref calculated above and the uptake rate
-    // factor specified as constants at the beginning of the module
-    //===============================================================
-    // gas to aerosol mass transfer rate (1/s)
-    for (int igas = 0; igas < num_gas; ++igas)
-      for (int imode = 0; imode < num_mode; ++imode)
-        uptkaer[igas][imode] = 0.0; // default is no uptake
-
-    for (int igas = 0; igas < num_gas; ++igas) {
-      for (int imode = 0; imode < num_mode; ++imode)
-        if (l_gas_condense_to_mode[igas][imode])
-          uptkaer[igas][imode] = uptkaer_ref[imode] * uptk_rate_factor[igas];
-    }
-
-    // total uptake rate (sum of all aerosol modes) for h2so4.
-    // Diagnosd for calling routine. Not used in this subroutne.
-    uptkrate_h2so4 = 0;
-    for (int n = 0; n < num_mode; ++n)
-      uptkrate_h2so4 += uptkaer[igas_h2so4][n];
+    Real uptkaer_ref[num_mode];
+    h2so4_uptkrates_per_particle(nghq, temp, pmid, dgn_awet, alnsg_aer,
+                                 uptkaer_ref);
+    scale_gas_uptkrates(igas_h2so4, l_gas_condense_to_mode, uptk_rate_factor,
+                        aircon, qnum_cur, uptkaer_ref, uptkaer,
+                        uptkrate_h2so4);
   }
   // =============================================================
   //  Solve condensation equation for non-volatile species
@@ -662,7 +959,7 @@ void mam_gasaerexch_1subarea(
   mam_soaexch_1subarea(GasAerExch::npca, ntot_soamode, ntot_soaspec, soaspec,
                        gas_to_aer, dt, dtsub_soa_fixed, pstd, r_universal_mJ,
                        temp, pmid, uptkaer, qaer_poa, qgas_cur, qgas_avg,
-                       qaer_cur, niter, soa_out);
+                       qaer_cur, niter, soa_out, soa_control);
   niter_out = niter;
   g0_soa_out = soa_out;
 }
@@ -695,7 +992,6 @@ void gas_aerosol_uptake_rates_1box(
 
   const int iaer_so4 = GasAerExch::iaer_so4;
   const int iaer_pom = GasAerExch::iaer_pom;
-  const bool l_calc_gas_uptake_coeff = config.calculate_gas_uptake_coefficient;
   const Real dtsub_soa_fixed = config.dtsub_soa_fixed;
   const Real &temp = atm.temperature(k);
   const Real &pmid = atm.pressure(k);
@@ -703,7 +999,7 @@ void gas_aerosol_uptake_rates_1box(
   const int ngas = GasAerExch::num_gas_to_aer;
 
   // set number of ghq points for direct ghq
-  const int nghq = 2; // aero_config.number_gauss_points_for_integration;
+  constexpr int nghq = AeroConfig::number_gauss_points_for_integration;
 
   // extract gas mixing ratios
   Real qgas_cur[num_gas], qgas_avg[num_gas], qaer_cur[num_aer][num_mode];
@@ -748,13 +1044,27 @@ void gas_aerosol_uptake_rates_1box(
   Real g0_soa_out = 0;
   const int ntot_soamode = config.ntot_soamode;
 
+  // reuse the cached uptake rates if they are still fresh
+  bool l_calc_gas_uptake_coeff = config.calculate_gas_uptake_coefficient;
+  if (uptkrate_cache_enabled(config, diags)) {
+    UptakeRateCache cache = load_uptkrate_cache(diags, k);
+    cached_gas_uptkrates(nghq, igas_h2so4,
+                         config.uptake_rate_refresh_threshold,
+                         l_gas_condense_to_mode, temp, pmid, aircon_kmol,
+                         qnum_cur, dgn_awet, alnsg_aer, uptk_rate_factor,
+                         cache, uptkaer, uptkrate_h2so4);
+    store_uptkrate_cache(cache, diags, k);
+    l_calc_gas_uptake_coeff = false;
+  }
+
   mam_gasaerexch_1subarea(nghq, igas_h2so4, igas_nh3, ntot_soamode, gas_to_aer,
                           iaer_so4, iaer_pom, l_calc_gas_uptake_coeff,
                           l_gas_condense_to_mode, eqn_and_numerics_category, dt,
                           dtsub_soa_fixed, temp, pmid, aircon_kmol, ngas,
                           qgas_cur, qgas_avg, qgas_netprod_otrproc, qaer_cur,
                           qnum_cur, dgn_awet, alnsg_aer, uptk_rate_factor,
-                          uptkaer, uptkrate_h2so4, niter_out, g0_soa_out);
+                          uptkaer, uptkrate_h2so4, niter_out, g0_soa_out,
+                          config.soa_step_control);
 
   for (int i = 0; i < num_mode; ++i)
     tends.n_mode_i[i](k) = (qnum_cur[i] - qnum_sv1[i]) / dt;
@@ -795,6 +1105,13 @@ inline void GasAerExch::init(const AeroConfig &aero_config,
   for (int imode = 0; imode < num_mode; ++imode)
     modes_mean_std_dev[imode] = modes(imode).mean_std_dev;
 
+  for (GasId gas : GasAerExch::Gases())
+    gas_to_aer_ids[static_cast<int>(gas)] = GasAerExch::gas_to_aer(gas);
+  for (int imode = 0; imode < num_mode; ++imode)
+    alnsg_aer[imode] = std::log(modes_mean_std_dev[imode]);
+  for (int igas = 0; igas < num_gas; ++igas)
+    uptk_rate[igas] = GasAerExch::uptk_rate_factor(igas);
+
   //-------------------------------------------------------------------
   // MAM currently uses a splitting method to deal with gas-aerosol
   // mass exchange. A quasi-analytical solution assuming timestep-wise
@@ -809,6 +1126,10 @@ inline void GasAerExch::init(const AeroConfig &aero_config,
     eqn_and_numerics_category[k] = NA;
   eqn_and_numerics_category[igas_soag] = IMPL;
   eqn_and_numerics_category[igas_h2so4] = ANAL;
+#ifdef MAM4XX_ENABLE_NH3
+  if (config_.igas_nh3)
+    eqn_and_numerics_category[igas_nh3] = ANAL;
+#endif
 
   //-------------------------------------------------------------------
   // Determine whether specific gases will condense to specific modes
@@ -836,6 +1157,39 @@ inline void GasAerExch::init(const AeroConfig &aero_config,
   }
 }
 
+// mam_gasaerexch_1subarea_ -- applies gas-aerosol exchange to a single cell
+KOKKOS_INLINE_FUNCTION
+void GasAerExch::mam_gasaerexch_1subarea_(
+    const Real dt, const Real temp, const Real pmid, const Real aircon,
+    Real qgas_cur[num_gas], Real qgas_avg[num_gas],
+    Real qaer_cur[num_aer][num_mode], Real qnum_cur[num_mode],
+    const Real dgn_awet[num_mode], Real uptkaer[num_gas][num_mode],
+    Real &uptkrate_h2so4, int &niter_out, Real &g0_soa_out,
+    gasaerexch::UptakeRateCache *cache) const {
+  // set number of ghq points for direct ghq
+  constexpr int nghq = AeroConfig::number_gauss_points_for_integration;
+
+  // reuse the cached uptake rates if they are still fresh
+  bool l_calc_gas_uptake_coeff = config_.calculate_gas_uptake_coefficient;
+  if (cache && l_calc_gas_uptake_coeff &&
+      config_.uptake_rate_refresh_threshold > 0) {
+    gasaerexch::cached_gas_uptkrates(
+        nghq, igas_h2so4, config_.uptake_rate_refresh_threshold,
+        l_gas_condense_to_mode, temp, pmid, aircon, qnum_cur, dgn_awet,
+        alnsg_aer, uptk_rate, *cache, uptkaer, uptkrate_h2so4);
+    l_calc_gas_uptake_coeff = false;
+  }
+
+  gasaerexch::mam_gasaerexch_1subarea(
+      nghq, igas_h2so4, config_.igas_nh3, config_.ntot_soamode, gas_to_aer_ids,
+      iaer_so4, iaer_pom, l_calc_gas_uptake_coeff,
+      l_gas_condense_to_mode, eqn_and_numerics_category, dt,
+      config_.dtsub_soa_fixed, temp, pmid, aircon, num_gas_to_aer, qgas_cur,
+      qgas_avg, config_.qgas_netprod_otrproc, qaer_cur, qnum_cur, dgn_awet,
+      alnsg_aer, uptk_rate, uptkaer, uptkrate_h2so4, niter_out, g0_soa_out,
+      config_.soa_step_control);
+}
+
 // compute_tendencies -- computes tendencies and updates diagnostics
 // NOTE: that both diags and tends are const below--this means their views
 // NOTE: are fixed, but the data in those views is allowed to vary.
@@ -848,20 +1202,14 @@ void GasAerExch::compute_tendencies(const AeroConfig &config,
                                     const Tendencies &tends) const {
   // const int nghq = 2;  // set number of ghq points for direct ghq
   const int nk = atm.num_levels();
-  Real alnsg_aer[num_mode];
-  for (int k = 0; k < num_mode; ++k)
-    alnsg_aer[k] = std::log(modes_mean_std_dev[k]);
-
-  Real uptk_rate[num_gas];
-  for (int k = 0; k < num_gas; ++k)
-    uptk_rate[k] = GasAerExch::uptk_rate_factor(k);
-
   Kokkos::parallel_for(
       Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
         gasaerexch::gas_aerosol_uptake_rates_1box(
             k, config, dt, atm, progs, diags, tends, config_,
             l_gas_condense_to_mode, eqn_and_numerics_category, uptk_rate,
             alnsg_aer);
+        config_.soa_substep_stats.record(team.league_rank(), k,
+                                         diags.num_substeps(k));
       });
 }
 } // namespace mam4
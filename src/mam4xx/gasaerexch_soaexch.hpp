@@ -12,9 +12,116 @@
 #include <haero/haero.hpp>
 #include <haero/math.hpp>
 
+#include <string>
+
 namespace mam4 {
 namespace gasaerexch {
 
+/// SOAStepControl selects how mam_soaexch_1subarea chooses the substeps of
+/// SOA condensation/evaporation when no fixed substep is prescribed.
+struct SOAStepControl {
+  // if true, substep sizes are chosen by local error control (see
+  // mam_soaexch_advance_in_time_controlled); otherwise, by the heuristic of
+  // soa_exch_substepsize
+  bool error_control = false;
+  // error tolerance of a substep, relative to the total (gas + aerosol)
+  // amount of each SOA species (used only with error_control)
+  Real rel_tolerance = 1.0e-3;
+  // maximum number of substeps per time step. With the heuristic, the
+  // integration stops there; with error control, the last substep covers the
+  // rest of the time step.
+  int max_substeps = 1000;
+};
+
+/// SOASubstepStats records the number of SOA substeps taken at each level of
+/// each column in the last time step, to bound the cost of SOA exchange and
+/// to find the levels and columns that dominate it. A default-constructed
+/// object records nothing.
+class SOASubstepStats final {
+public:
+  using CountView = DeviceType::view_2d<int>;
+
+  KOKKOS_INLINE_FUNCTION
+  SOASubstepStats() = default;
+
+  /// Creates statistics for the given numbers of columns and levels, with
+  /// all counts set to zero.
+  SOASubstepStats(const std::string &name, const int num_columns,
+                  const int num_levels)
+      : counts_(name, num_columns, num_levels) {}
+
+  KOKKOS_INLINE_FUNCTION
+  ~SOASubstepStats() = default;
+  KOKKOS_INLINE_FUNCTION
+  SOASubstepStats(const SOASubstepStats &rhs) = default;
+  KOKKOS_INLINE_FUNCTION
+  SOASubstepStats &operator=(const SOASubstepStats &rhs) = default;
+
+  /// Returns true if this object records statistics.
+  KOKKOS_INLINE_FUNCTION
+  bool enabled() const { return counts_.data() != nullptr; }
+
+  /// Records the number of substeps taken at level k of column icol. Columns
+  /// and levels outside those given at construction are ignored.
+  KOKKOS_INLINE_FUNCTION
+  void record(const int icol, const int k, const int num_substeps) const {
+    if (enabled() && icol < int(counts_.extent(0)) &&
+        k < int(counts_.extent(1)))
+      counts_(icol, k) = num_substeps;
+  }
+
+  /// Returns the recorded numbers of substeps, indexed by (column, level).
+  CountView::HostMirror substeps() const {
+    CountView::HostMirror counts = Kokkos::create_mirror_view(counts_);
+    Kokkos::deep_copy(counts, counts_);
+    return counts;
+  }
+
+  /// Returns the largest number of substeps recorded at any level.
+  int max_substeps() const {
+    const auto counts = substeps();
+    int max_count = 0;
+    for (int icol = 0; icol < int(counts.extent(0)); ++icol)
+      for (int k = 0; k < int(counts.extent(1)); ++k)
+        max_count = (counts(icol, k) > max_count) ? counts(icol, k) : max_count;
+    return max_count;
+  }
+
+  /// Returns the number of substeps summed over the levels of each column.
+  DeviceType::view_1d<int>::HostMirror column_substeps() const {
+    const auto counts = substeps();
+    DeviceType::view_1d<int>::HostMirror totals("soa_column_substeps",
+                                                counts.extent(0));
+    for (int icol = 0; icol < int(counts.extent(0)); ++icol)
+      for (int k = 0; k < int(counts.extent(1)); ++k)
+        totals(icol) += counts(icol, k);
+    return totals;
+  }
+
+  /// Returns the ratio of the largest number of substeps of a column to the
+  /// mean over all columns, which is 1 if the columns are balanced (or if no
+  /// substeps were recorded).
+  Real column_imbalance() const {
+    const auto totals = column_substeps();
+    const int ncol = totals.extent(0);
+    Real sum = 0, max_total = 0;
+    for (int icol = 0; icol < ncol; ++icol) {
+      sum += totals(icol);
+      max_total = (totals(icol) > max_total) ? totals(icol) : max_total;
+    }
+    return (sum > 0) ? max_total * ncol / sum : 1;
+  }
+
+  /// Sets all counts to zero.
+  void reset() const {
+    if (enabled())
+      Kokkos::deep_copy(counts_, 0);
+  }
+
+private:
+  CountView counts_;
+};
+
 // ==============================================================================
 // Calculate SOA species's eiquilibrium vapor mixing ratio under the ambient
 // condition, ignoring the solute effect.
@@ -197,6 +304,192 @@ Real soa_exch_substepsize(
 }
 //===============================================================================================
 
+//===============================================================================================
+// Determine which modes have non-zero transfer rates and are hence
+// involved in the subsequent calculations of soa gas-aerosol transfer.
+// (For diameter = 1 nm and number = 1 #/cm3, xferrate ~= 1e-9 s-1)
+//===============================================================================================
+KOKKOS_INLINE_FUNCTION
+void soaexch_uptake_modes(
+    const int ntot_soamode, // in
+    const int ntot_soaspec, // in
+    const GasId soaspec[],  // in len ntot_soaspec
+    const Real uptkaer[AeroConfig::num_gas_ids()]
+                      [AeroConfig::num_modes()],       // in
+    bool skip_soamode[AeroConfig::num_modes()],        // out
+    Real uptkaer_soag_tmp[][AeroConfig::num_modes()]) // out
+{
+  for (int n = 0; n < AeroConfig::num_modes(); ++n)
+    skip_soamode[n] = true;
+
+  for (int n = 0; n < ntot_soamode; ++n) {
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+      const int soa = static_cast<int>(soaspec[ll]);
+      if (uptkaer[soa][n] > 1.0e-15) {
+        uptkaer_soag_tmp[ll][n] = uptkaer[soa][n];
+        skip_soamode[n] = false;
+      } else {
+        uptkaer_soag_tmp[ll][n] = 0.0;
+      }
+    }
+  }
+}
+
+//===============================================================================================
+// Advance the SOA gas and aerosol mixing ratios over one substep of length
+// dt_cur, using the semi-implicit scheme of mam_soaexch_advance_in_time.
+// g_soa and a_soa hold the (non-negative) values at the beginning of the
+// substep on input, and the values at its end on output; tot_soa is the total
+// (gas + aerosol) amount of each SOA species, which the scheme conserves.
+//===============================================================================================
+KOKKOS_INLINE_FUNCTION
+void soaexch_substep(
+    const int ntot_soamode,    // in
+    const int ntot_soaspec,    // in
+    const bool skip_soamode[], // in
+    const Real uptkaer_soag_tmp[]
+                               [AeroConfig::num_modes()], // in len ntot_soaspec
+    const Real g0_soa[],                                  // in len ntot_soaspec
+    const Real a_opoa[AeroConfig::num_modes()],           // in
+    const Real tot_soa[],                                 // in len ntot_soaspec
+    const Real dt_cur,                                    // in
+    Real g_soa[],                                         // inout
+    Real a_soa[][AeroConfig::num_modes()])                // inout
+{
+  using haero::max;
+  static constexpr int max_mode = AeroConfig::num_modes();
+
+  const Real eps_aer = 1.0e-20; // epsilon to be used on denominator for
+                                // avoiding division by zero
+
+  // dt_cur * uptake-rate-coefficient
+  Real beta[AeroConfig::num_gas_ids()][max_mode] = {};
+
+  // variable name "sat": sat(m,ll) = g0_soa(ll)/a_ooa_sum(m) =
+  // g_star(m,ll)/a_soa(m,ll) used by the numerical integration scheme -- it is
+  // not a saturation rato!
+  Real sat_hybrid[AeroConfig::num_gas_ids()][max_mode] = {};
+
+  // ----------------------------------------------------------------------------
+  //  Define a variable beta = dt_cur * uptake-rate-coefficient.
+  //  This is used at a few places in the semi-implicit time integration
+  //  scheme.
+  // ----------------------------------------------------------------------------
+  for (int n = 0; n < ntot_soamode; ++n) {
+    if (!skip_soamode[n]) {
+      for (int ll = 0; ll < ntot_soaspec; ++ll)
+        beta[ll][n] = dt_cur * uptkaer_soag_tmp[ll][n];
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------
+  //  Linearize the ODE of each SOA species in each mode
+  // ------------------------------------------------------------------------------------------
+  //  Because the equilibrium SOA mixing ratio (that takes into account the
+  //  solvent effect) depends on the SOA (aerosol) mixing ratio in each mode,
+  //  the time evolution equations for SOAs (aerosol) are nonlinear.
+  //  To numerically solve these nonlinear equations using a
+  //  semi-implicit-in-time scheme, we need to linearize the equations. The
+  //  nonlinear pre-factor in front of an SOA mixing ratio on the RHS of the
+  //  SOA mixing ratio equation is
+  //      uptake-rate-coefficient * g0_soa / mixing-ratio-of-OOA
+  //  Let us denote
+  //      sat = g0_soa / mixing-ratio-of-OOA
+  //  The code block below provides an approximate value of sat (saved in the
+  //  array sat_hybrid) to be used in the semi-implicit solve further down
+  //  below. We refer to this "sat" variable as a "hybrid" one because the
+  //  calculation below uses different expressions for SOA condensation and
+  //  evaporation. The difference is in the SOA (aerosol) mixing ratios used
+  //  for calculating the OOA mixing ratio in the denominaotor of sat.
+  // ------------------------------------------------------------------------------------------
+
+  // temporary SOA aerosol mixrat (mol/mol) used for linearization
+  Real a_soa_hybrid[AeroConfig::num_gas_ids()];
+  for (int n = 0; n < ntot_soamode; ++n) {
+    if (skip_soamode[n])
+      continue;
+
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+
+      // First get an estimate of the equilibrium SOA mixing ratio (variable
+      // g_star_old) using the old SOA mixing ratio (variable a_soa)
+
+      // total ooa (=soa+opoa) in a mode, calculated using old SOA mixing
+      // ratio
+      Real a_ooa_sum_old = a_opoa[n];
+      for (int i = 0; i < ntot_soaspec; ++i)
+        a_ooa_sum_old += a_soa[i][n];
+      const Real sat_old = g0_soa[ll] / max(a_ooa_sum_old, eps_aer);
+
+      // soa gas mixrat that is in equilib with each aerosol mode (mol/mol)
+      // diagnosed using old gas and aerosol mixing ratios
+      const Real g_star_old = sat_old * a_soa[ll][n];
+
+      //  Using g_star_old and the current (old) g_soa to determine whether we
+      //  have
+      //   - supersaturation (meaning SOA will be condensing) or
+      //   - undersaturation (meaning SOA will be evaporating)
+
+      // SOA gas supersaturation mixrat (mol/mol at actual mw). < 0 means
+      // unsaturated
+      const Real g_soa_supersat = g_soa[ll] - g_star_old;
+
+      if (g_soa_supersat > 0.0) {
+        //  For modes where SOA is condensing, estimate an approximate "new"
+        //  a_soa(ll,n) using the Euler forward scheme in which both the SOA
+        //  gas mixing ratio and equilibrium mixing ratio are set to their
+        //  "old" values, i.e., the current g_soa and the above-calculated
+        //  g_star_old. Do this to get better estimate of "new" a_soa(ll,n)
+        //  and g_star(ll,n)
+
+        a_soa_hybrid[ll] = a_soa[ll][n] + beta[ll][n] * g_soa_supersat;
+
+      } else {
+        //  For modes where SOA is evaporating, simply use the "old" SOA
+        //  mixing ratio
+        a_soa_hybrid[ll] = a_soa[ll][n];
+      }
+    }
+
+    //  Now, calculate the total OOA in the mode using the a_soa_hybrid
+    //  calculated just now
+
+    // total ooa (=soa+opoa) in a mode, different for condensation/evaporation
+    // cases
+    Real a_ooa_sum_hybrid = a_opoa[n];
+    for (int i = 0; i < ntot_soaspec; ++i)
+      a_ooa_sum_hybrid += a_soa_hybrid[i];
+
+    //  With the newly calculated a_ooa_sum_hybrid, we can now calculate
+    //  the pre-factor in front of the SOA mixing ratio on the RHS of each SOA
+    //  equation, (i.e., variable sat_hybrid).
+
+    for (int ll = 0; ll < ntot_soaspec; ++ll)
+      sat_hybrid[ll][n] = g0_soa[ll] / max(a_ooa_sum_hybrid, eps_aer);
+  }
+  // ------------------------------------------------------------------------------------------
+  //  Implicit solve for the linearize equations
+  // ------------------------------------------------------------------------------------------
+  for (int ll = 0; ll < ntot_soaspec; ++ll) {
+    Real tmpa = 0.0;
+    Real tmpb = 0.0;
+    for (int n = 0; n < ntot_soamode; ++n) {
+      if (!skip_soamode[n]) {
+        tmpa += a_soa[ll][n] / (1.0 + beta[ll][n] * sat_hybrid[ll][n]);
+        tmpb += beta[ll][n] / (1.0 + beta[ll][n] * sat_hybrid[ll][n]);
+      }
+    }
+    g_soa[ll] = (tot_soa[ll] - tmpa) / (1.0 + tmpb);
+    g_soa[ll] = max(0.0, g_soa[ll]);
+    for (int n = 0; n < ntot_soamode; ++n) {
+      if (!skip_soamode[n]) {
+        a_soa[ll][n] = (a_soa[ll][n] + beta[ll][n] * g_soa[ll]) /
+                       (1.0 + beta[ll][n] * sat_hybrid[ll][n]);
+      }
+    }
+  }
+}
+
 //===============================================================================================
 // Time integration for the ODE set that describes the condensation/evaporation
 // of SOA
@@ -273,40 +566,13 @@ void mam_soaexch_advance_in_time(
   bool skip_soamode[max_mode] = {};
   // uptake rate of different modes for different soa species
   Real uptkaer_soag_tmp[AeroConfig::num_gas_ids()][max_mode] = {};
-  // dt_cur * uptake-rate-coefficient
-  Real beta[AeroConfig::num_gas_ids()][max_mode] = {};
 
-  const Real eps_aer = 1.0e-20; // epsilon to be used on denominator for
-                                // avoiding division by zero
   const Real eps_dt = 1.0e-3;
 
-  // variable name "sat": sat(m,ll) = g0_soa(ll)/a_ooa_sum(m) =
-  // g_star(m,ll)/a_soa(m,ll) used by the numerical integration scheme -- it is
-  // not a saturation rato!
-
-  Real sat_hybrid[AeroConfig::num_gas_ids()][max_mode] = {};
-
   Real tot_soa[AeroConfig::num_gas_ids()] = {}; // g_soa + sum( a_soa(:) )
 
-  // ----------------------------------------------------------------------
-  //  Determine which modes have non-zero transfer rates and are hence
-  //  involved in the subsequent calculations of soa gas-aerosol transfer.
-  //  (For diameter = 1 nm and number = 1 #/cm3, xferrate ~= 1e-9 s-1)
-  // ----------------------------------------------------------------------
-  for (int n = 0; n < max_mode; ++n)
-    skip_soamode[n] = true;
-
-  for (int n = 0; n < ntot_soamode; ++n) {
-    for (int ll = 0; ll < ntot_soaspec; ++ll) {
-      const int soa = static_cast<int>(soaspec[ll]);
-      if (uptkaer[soa][n] > 1.0e-15) {
-        uptkaer_soag_tmp[ll][n] = uptkaer[soa][n];
-        skip_soamode[n] = false;
-      } else {
-        uptkaer_soag_tmp[ll][n] = 0.0;
-      }
-    }
-  }
+  soaexch_uptake_modes(ntot_soamode, ntot_soaspec, soaspec, uptkaer,
+                       skip_soamode, uptkaer_soag_tmp);
   // -------------------------------------
   //  Time loop for SOA sub-stepping
   // -------------------------------------
@@ -377,125 +643,8 @@ void mam_soaexch_advance_in_time(
                                     g0_soa, alpha_astem, dt_full, tcur);
     }
 
-    // ----------------------------------------------------------------------------
-    //  Now that we have determined the sub-step size dt_cur,
-    //  define a variable beta = dt_cur * uptake-rate-coefficient.
-    //  This is used at a few places in the semi-implicit time integration
-    //  scheme.
-    // ----------------------------------------------------------------------------
-    for (int n = 0; n < ntot_soamode; ++n) {
-      if (!skip_soamode[n]) {
-        for (int ll = 0; ll < ntot_soaspec; ++ll)
-          beta[ll][n] = dt_cur * uptkaer_soag_tmp[ll][n];
-      }
-    }
-
-    // ------------------------------------------------------------------------------------------
-    //  Linearize the ODE of each SOA species in each mode
-    // ------------------------------------------------------------------------------------------
-    //  Because the equilibrium SOA mixing ratio (that takes into account the
-    //  solvent effect) depends on the SOA (aerosol) mixing ratio in each mode,
-    //  the time evolution equations for SOAs (aerosol) are nonlinear.
-    //  To numerically solve these nonlinear equations using a
-    //  semi-implicit-in-time scheme, we need to linearize the equations. The
-    //  nonlinear pre-factor in front of an SOA mixing ratio on the RHS of the
-    //  SOA mixing ratio equation is
-    //      uptake-rate-coefficient * g0_soa / mixing-ratio-of-OOA
-    //  Let us denote
-    //      sat = g0_soa / mixing-ratio-of-OOA
-    //  The code block below provides an approximate value of sat (saved in the
-    //  array sat_hybrid) to be used in the semi-implicit solve further down
-    //  below. We refer to this "sat" variable as a "hybrid" one because the
-    //  calculation below uses different expressions for SOA condensation and
-    //  evaporation. The difference is in the SOA (aerosol) mixing ratios used
-    //  for calculating the OOA mixing ratio in the denominaotor of sat.
-    // ------------------------------------------------------------------------------------------
-
-    // temporary SOA aerosol mixrat (mol/mol) used for linearization
-    Real a_soa_hybrid[AeroConfig::num_gas_ids()];
-    for (int n = 0; n < ntot_soamode; ++n) {
-      if (skip_soamode[n])
-        continue;
-
-      for (int ll = 0; ll < ntot_soaspec; ++ll) {
-
-        // First get an estimate of the equilibrium SOA mixing ratio (variable
-        // g_star_old) using the old SOA mixing ratio (variable a_soa)
-
-        // total ooa (=soa+opoa) in a mode, calculated using old SOA mixing
-        // ratio
-        Real a_ooa_sum_old = a_opoa[n];
-        for (int i = 0; i < ntot_soaspec; ++i)
-          a_ooa_sum_old += a_soa[i][n];
-        const Real sat_old = g0_soa[ll] / max(a_ooa_sum_old, eps_aer);
-
-        // soa gas mixrat that is in equilib with each aerosol mode (mol/mol)
-        // diagnosed using old gas and aerosol mixing ratios
-        const Real g_star_old = sat_old * a_soa[ll][n];
-
-        //  Using g_star_old and the current (old) g_soa to determine whether we
-        //  have
-        //   - supersaturation (meaning SOA will be condensing) or
-        //   - undersaturation (meaning SOA will be evaporating)
-
-        // SOA gas supersaturation mixrat (mol/mol at actual mw). < 0 means
-        // unsaturated
-        const Real g_soa_supersat = g_soa[ll] - g_star_old;
-
-        if (g_soa_supersat > 0.0) {
-          //  For modes where SOA is condensing, estimate an approximate "new"
-          //  a_soa(ll,n) using the Euler forward scheme in which both the SOA
-          //  gas mixing ratio and equilibrium mixing ratio are set to their
-          //  "old" values, i.e., the current g_soa and the above-calculated
-          //  g_star_old. Do this to get better estimate of "new" a_soa(ll,n)
-          //  and g_star(ll,n)
-
-          a_soa_hybrid[ll] = a_soa[ll][n] + beta[ll][n] * g_soa_supersat;
-
-        } else {
-          //  For modes where SOA is evaporating, simply use the "old" SOA
-          //  mixing ratio
-          a_soa_hybrid[ll] = a_soa[ll][n];
-        }
-      }
-
-      //  Now, calculate the total OOA in the mode using the a_soa_hybrid
-      //  calculated just now
-
-      // total ooa (=soa+opoa) in a mode, different for condensation/evaporation
-      // cases
-      Real a_ooa_sum_hybrid = a_opoa[n];
-      for (int i = 0; i < ntot_soaspec; ++i)
-        a_ooa_sum_hybrid += a_soa_hybrid[i];
-
-      //  With the newly calculated a_ooa_sum_hybrid, we can now calculate
-      //  the pre-factor in front of the SOA mixing ratio on the RHS of each SOA
-      //  equation, (i.e., variable sat_hybrid).
-
-      for (int ll = 0; ll < ntot_soaspec; ++ll)
-        sat_hybrid[ll][n] = g0_soa[ll] / max(a_ooa_sum_hybrid, eps_aer);
-    }
-    // ------------------------------------------------------------------------------------------
-    //  Implicit solve for the linearize equations
-    // ------------------------------------------------------------------------------------------
-    for (int ll = 0; ll < ntot_soaspec; ++ll) {
-      Real tmpa = 0.0;
-      Real tmpb = 0.0;
-      for (int n = 0; n < ntot_soamode; ++n) {
-        if (!skip_soamode[n]) {
-          tmpa += a_soa[ll][n] / (1.0 + beta[ll][n] * sat_hybrid[ll][n]);
-          tmpb += beta[ll][n] / (1.0 + beta[ll][n] * sat_hybrid[ll][n]);
-        }
-      }
-      g_soa[ll] = (tot_soa[ll] - tmpa) / (1.0 + tmpb);
-      g_soa[ll] = max(0.0, g_soa[ll]);
-      for (int n = 0; n < ntot_soamode; ++n) {
-        if (!skip_soamode[n]) {
-          a_soa[ll][n] = (a_soa[ll][n] + beta[ll][n] * g_soa[ll]) /
-                         (1.0 + beta[ll][n] * sat_hybrid[ll][n]);
-        }
-      }
-    }
+    soaexch_substep(ntot_soamode, ntot_soaspec, skip_soamode, uptkaer_soag_tmp,
+                    g0_soa, a_opoa, tot_soa, dt_cur, g_soa, a_soa);
 
     // ------------------------------------------------------------------------------------------
     //  Save mix ratios for soa species
@@ -531,6 +680,167 @@ void mam_soaexch_advance_in_time(
   }
 }
 
+//===============================================================================================
+// Time integration for the same ODE set as mam_soaexch_advance_in_time, with
+// substep sizes chosen by local error control. Each substep is taken both as
+// one step and as two half steps of the semi-implicit scheme; the difference
+// of the two results estimates the error of the two-half-step result, which
+// is kept. A substep whose error exceeds control.rel_tolerance times the total
+// amount of an SOA species is repeated with a shorter length, and the length
+// of the next substep is adapted to the error of the accepted one. Rejected
+// substeps count towards niter, and once control.max_substeps - 1 substeps
+// have been tried, the rest of the time step is covered in a single substep,
+// which bounds the cost at any level.
+//===============================================================================================
+KOKKOS_INLINE_FUNCTION
+void mam_soaexch_advance_in_time_controlled(
+    const int ntot_soamode,        // in
+    const int ntot_soaspec,        // in
+    const GasId soaspec[],         // in len ntot_soaspec
+    const AeroId gas_to_aer[],     // in
+    const Real dt_full,            // in
+    const Real alpha_astem,        // in
+    const SOAStepControl &control, // in
+    const Real uptkaer[AeroConfig::num_gas_ids()]
+                      [AeroConfig::num_modes()], // in
+    const Real g0_soa[],                         // in len ntot_soaspec
+    Real qgas_cur[AeroConfig::num_gas_ids()],    // inout
+    const Real a_opoa[AeroConfig::num_modes()],  // in
+    Real qaer_cur[AeroConfig::num_aerosol_ids()]
+                 [AeroConfig::num_modes()],   // inout
+    Real qgas_avg[AeroConfig::num_gas_ids()], // inout
+    int &niter)                               // out
+{
+  using haero::max;
+  using haero::min;
+  static constexpr int max_gas = AeroConfig::num_gas_ids();
+  static constexpr int max_mode = AeroConfig::num_modes();
+
+  const Real eps_dt = 1.0e-3;
+  const Real eps_gas = 1.0e-20; // epsilon to be used on denominator for
+                                // avoiding division by zero
+  // step size controller: safety factor, and bounds of the change of the
+  // substep size from one substep to the next
+  const Real safety = 0.9, min_factor = 0.2, max_factor = 5.0;
+
+  bool skip_soamode[max_mode] = {};
+  Real uptkaer_soag_tmp[max_gas][max_mode] = {};
+  soaexch_uptake_modes(ntot_soamode, ntot_soaspec, soaspec, uptkaer,
+                       skip_soamode, uptkaer_soag_tmp);
+
+  // the evolving SOA gas and aerosol mixing ratios (mol/mol at actual mw),
+  // forced to be non-negative, and their total over gas and aerosol
+  Real g_soa[max_gas] = {}, a_soa[max_gas][max_mode] = {};
+  Real tot_soa[max_gas] = {};
+  for (int i = 0; i < ntot_soaspec; ++i) {
+    const int soa = static_cast<int>(soaspec[i]);
+    const int iaer = static_cast<int>(gas_to_aer[soa]);
+    g_soa[i] = max(qgas_cur[soa], 0.0);
+    tot_soa[i] = g_soa[i];
+    for (int n = 0; n < ntot_soamode; ++n) {
+      if (!skip_soamode[n]) {
+        a_soa[i][n] = max(qaer_cur[iaer][n], 0.0);
+        tot_soa[i] += a_soa[i][n];
+      }
+    }
+  }
+
+  // qgas*dt integrated over a time step, used for calculating time average of
+  // qgas
+  Real qgas_avg_sum[max_gas] = {};
+
+  // the first substep size is the one given by the heuristic
+  Real tcur = 0.0;
+  Real dt_try = soa_exch_substepsize(ntot_soamode, ntot_soaspec, skip_soamode,
+                                     uptkaer_soag_tmp, a_soa, a_opoa, g_soa,
+                                     g0_soa, alpha_astem, dt_full, tcur);
+  tcur = 0.0;
+
+  niter = 0;
+  while (tcur < dt_full - eps_dt) {
+    ++niter;
+    const bool last = (niter >= control.max_substeps);
+    const Real dt_cur = last ? dt_full - tcur : min(dt_try, dt_full - tcur);
+
+    // one substep of length dt_cur
+    Real g_one[max_gas], a_one[max_gas][max_mode];
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+      g_one[ll] = g_soa[ll];
+      for (int n = 0; n < ntot_soamode; ++n)
+        a_one[ll][n] = a_soa[ll][n];
+    }
+    soaexch_substep(ntot_soamode, ntot_soaspec, skip_soamode, uptkaer_soag_tmp,
+                    g0_soa, a_opoa, tot_soa, dt_cur, g_one, a_one);
+
+    // two substeps of length dt_cur/2
+    Real g_two[max_gas], a_two[max_gas][max_mode], g_mid[max_gas];
+    Real tot_mid[max_gas];
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+      g_two[ll] = g_soa[ll];
+      for (int n = 0; n < ntot_soamode; ++n)
+        a_two[ll][n] = a_soa[ll][n];
+    }
+    soaexch_substep(ntot_soamode, ntot_soaspec, skip_soamode, uptkaer_soag_tmp,
+                    g0_soa, a_opoa, tot_soa, 0.5 * dt_cur, g_two, a_two);
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+      g_mid[ll] = g_two[ll];
+      tot_mid[ll] = g_two[ll];
+      for (int n = 0; n < ntot_soamode; ++n)
+        if (!skip_soamode[n])
+          tot_mid[ll] += a_two[ll][n];
+    }
+    soaexch_substep(ntot_soamode, ntot_soaspec, skip_soamode, uptkaer_soag_tmp,
+                    g0_soa, a_opoa, tot_mid, 0.5 * dt_cur, g_two, a_two);
+
+    // error estimate, relative to the tolerance
+    Real err = 0;
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+      const Real scale = control.rel_tolerance * max(tot_soa[ll], eps_gas);
+      err = max(err, haero::abs(g_two[ll] - g_one[ll]) / scale);
+      for (int n = 0; n < ntot_soamode; ++n)
+        if (!skip_soamode[n])
+          err = max(err, haero::abs(a_two[ll][n] - a_one[ll][n]) / scale);
+    }
+
+    // the error of the scheme is of second order in the substep size
+    const Real factor = (err > 0) ? safety / haero::sqrt(err) : max_factor;
+    if (err > 1 && !last) {
+      // reject the substep and try again with a shorter one
+      dt_try = dt_cur * max(factor, min_factor);
+      continue;
+    }
+
+    // accept the substep
+    for (int ll = 0; ll < ntot_soaspec; ++ll) {
+      qgas_avg_sum[ll] +=
+          0.5 * dt_cur * (g_soa[ll] + 0.5 * (g_mid[ll] - g_soa[ll])) +
+          0.5 * dt_cur * (g_mid[ll] + 0.5 * (g_two[ll] - g_mid[ll]));
+      g_soa[ll] = g_two[ll];
+      tot_soa[ll] = g_soa[ll];
+      for (int n = 0; n < ntot_soamode; ++n) {
+        if (!skip_soamode[n]) {
+          a_soa[ll][n] = a_two[ll][n];
+          tot_soa[ll] += a_soa[ll][n];
+        }
+      }
+    }
+    tcur += dt_cur;
+    dt_try = dt_cur * min(max(factor, min_factor), max_factor);
+  }
+
+  // save the mixing ratios of the SOA species (modes without uptake are left
+  // untouched) and the time average of the SOA gases
+  for (int i = 0; i < ntot_soaspec; ++i) {
+    const int soa = static_cast<int>(soaspec[i]);
+    const int iaer = static_cast<int>(gas_to_aer[soa]);
+    for (int n = 0; n < ntot_soamode; ++n)
+      if (!skip_soamode[n])
+        qaer_cur[iaer][n] = a_soa[i][n];
+    qgas_cur[soa] = g_soa[i];
+    qgas_avg[soa] = (tcur > 0) ? max(0.0, qgas_avg_sum[i] / tcur) : g_soa[i];
+  }
+}
+
 // --------------------------------------------------------------------
 // Calculate secondary organic aerosols, soa,
 // condensation/evaporation over time dt
@@ -555,7 +865,8 @@ void mam_soaexch_1subarea(const int mode_pca,          // in
                           Real qaer_cur[AeroConfig::num_aerosol_ids()]
                                        [AeroConfig::num_modes()], // inout
                           int &niter,                             // out
-                          Real &g0_soa) {                         // out
+                          Real &g0_soa,                           // out
+                          const SOAStepControl &control = SOAStepControl()) {
 
   // clang-format off
   // mode_pca         mam4::ModeIndex::PrimaryCarbon
@@ -576,6 +887,7 @@ void mam_soaexch_1subarea(const int mode_pca,          // in
   // qaer_cur         current aerosol mass mix ratio (mol/mol)
   // niter
   // g0_soa           ambient soa gas equilib mixrat (mol/mol at actual mw)
+  // control          choice of the substeps when dt_sub_soa_fixed <= 0
   // clang-format on
 
   // ntot_poaspec is the number of reacting gas species. The code only supports
@@ -629,12 +941,18 @@ void mam_soaexch_1subarea(const int mode_pca,          // in
   // -----------------------------------------------------------
   //  Time stepping -- uses multiple substeps to reach dtfull
   // -----------------------------------------------------------
-  const int niter_max = 1000;
+  const int niter_max = control.max_substeps;
 
-  mam_soaexch_advance_in_time(ntot_soamode, ntot_soaspec, soaspec, gas_to_aer,
-                              dt, dt_sub_soa_fixed, niter_max, alpha_astem,
-                              uptkaer, &g0_soa, qgas_cur, a_opoa, qaer_cur,
-                              qgas_avg, niter);
+  if (control.error_control && dt_sub_soa_fixed <= 0.0) {
+    mam_soaexch_advance_in_time_controlled(
+        ntot_soamode, ntot_soaspec, soaspec, gas_to_aer, dt, alpha_astem,
+        control, uptkaer, &g0_soa, qgas_cur, a_opoa, qaer_cur, qgas_avg, niter);
+  } else {
+    mam_soaexch_advance_in_time(ntot_soamode, ntot_soaspec, soaspec,
+                                gas_to_aer, dt, dt_sub_soa_fixed, niter_max,
+                                alpha_astem, uptkaer, &g0_soa, qgas_cur,
+                                a_opoa, qaer_cur, qgas_avg, niter);
+  }
 }
 } // namespace gasaerexch
 } // namespace mam4
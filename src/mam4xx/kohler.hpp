@@ -6,7 +6,7 @@
 #ifndef MAM4XX_KOHLER_HPP
 #define MAM4XX_KOHLER_HPP
 
-#include <mam4xx/mam4.hpp>
+#include <mam4xx/mam4_types.hpp>
 
 #include <haero/constants.hpp>
 #include <haero/floating_point.hpp>
@@ -206,6 +206,66 @@ struct KohlerPolynomial {
   }
 };
 
+/// Computes the wet radius at which a particle is in equilibrium with the
+/// ambient relative humidity s, i.e. the only positive root of the Kohler
+/// polynomial (see KohlerPolynomial), using only real arithmetic.
+///
+///   The polynomial is concave for r_w > 0, with K(r_d) = B r_d^4 >= 0 and
+///   K(r_0) = A (r_d^3 - r_0^3) <= 0 at the closed-form root of the polynomial
+///   without the Kelvin term, r_0 = r_d (1 - B / log(s))^(1/3). The root is
+///   therefore bracketed by [r_d, r_0], and Newton's method started from r_0
+///   decreases monotonically to it. A Newton step that leaves the bracket
+///   (which only roundoff can cause) is replaced by a bisection step.
+///
+///   This solver is shared by water_uptake::modal_aero_kohler, which replaces
+///   the complex-arithmetic quartic formula of MAM4, and by
+///   mode_avg_wet_particle_diam_water_uptake.
+///
+///   @param [in] log_rel_humidity log(s), with 0 < s < 1
+///   @param [in] hygro hygroscopicity B
+///   @param [in] dry_radius particle dry radius r_d
+///   @param [in] kelvin_a Kelvin coefficient A, in the units of dry_radius
+///   @param [in] rel_tol convergence tolerance relative to the wet radius
+///   @param [out] n_iter number of iterations taken
+///   @return wet radius, in the units of dry_radius
+KOKKOS_INLINE_FUNCTION
+double kohler_wet_radius(const double log_rel_humidity, const double hygro,
+                         const double dry_radius, const double kelvin_a,
+                         const double rel_tol, int &n_iter) {
+  static constexpr int max_iter = 50;
+  const double dry_radius_cubed = haero::cube(dry_radius);
+  double rwet_lo = dry_radius;
+  double rwet_hi = dry_radius * haero::cbrt(1 - hygro / log_rel_humidity);
+  double rwet = rwet_hi;
+  n_iter = 0;
+  while (n_iter < max_iter) {
+    ++n_iter;
+    const double rwet_squared = square(rwet);
+    const double k =
+        (log_rel_humidity * rwet - kelvin_a) * rwet_squared * rwet +
+        ((hygro - log_rel_humidity) * rwet + kelvin_a) * dry_radius_cubed;
+    const double dk =
+        (4 * log_rel_humidity * rwet - 3 * kelvin_a) * rwet_squared +
+        (hygro - log_rel_humidity) * dry_radius_cubed;
+    // K > 0 below the root and K < 0 above it
+    if (k > 0) {
+      rwet_lo = rwet;
+    } else {
+      rwet_hi = rwet;
+    }
+    double rwet_next = rwet - k / dk;
+    if (!(rwet_next > rwet_lo && rwet_next < rwet_hi)) {
+      rwet_next = 0.5 * (rwet_lo + rwet_hi);
+    }
+    const double step = haero::abs(rwet_next - rwet);
+    rwet = rwet_next;
+    if (step <= rel_tol * rwet) {
+      break;
+    }
+  }
+  return rwet;
+}
+
 /// Solver for the Kohler polynomial; templated so that it can
 /// use any root finding algorithm from the haero::math namespace.
 ///
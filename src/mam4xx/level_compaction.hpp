@@ -0,0 +1,172 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_LEVEL_COMPACTION_HPP
+#define MAM4XX_LEVEL_COMPACTION_HPP
+
+// This header provides active-level compaction for processes that act on only
+// some of the vertical levels of a column (e.g. nucleation, which does nothing
+// where there is too little H2SO4). Rather than giving every level a thread
+// that mostly exits through a branch, a team builds the list of its active
+// levels and runs the per-level kernel over that list only. The kernel is
+// handed the original level index, so its results are scattered directly to
+// their levels.
+//
+// The list of active levels is stored in level 0 team scratch memory, which
+// must be requested by the launch (column_batch_team_policy does so):
+//
+//   policy.set_scratch_size(0, Kokkos::PerTeam(
+//       ActiveLevels::scratch_size(num_levels)));
+
+#include <mam4xx/mam4_types.hpp>
+
+#include <haero/haero.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace mam4 {
+
+/// ActiveLevels holds the indices of the active levels of a column, in
+/// increasing order, in team scratch memory.
+class ActiveLevels final {
+public:
+  using ScratchSpace =
+      typename haero::ThreadTeamPolicy::execution_space::scratch_memory_space;
+  using IndexView = Kokkos::View<int *, ScratchSpace, Kokkos::MemoryUnmanaged>;
+
+  /// Returns the number of bytes of level 0 team scratch memory needed for a
+  /// column with num_levels levels.
+  static std::size_t scratch_size(const int num_levels) {
+    return IndexView::shmem_size(num_levels + 1);
+  }
+
+  /// Builds the list of levels k in [0, num_levels) for which is_active(k) is
+  /// true. This must be called by all threads of the team.
+  template <typename Predicate>
+  KOKKOS_INLINE_FUNCTION ActiveLevels(const ThreadTeam &team,
+                                      const int num_levels,
+                                      const Predicate &is_active)
+      : indices_(team.team_scratch(0), num_levels + 1),
+        num_levels_(num_levels) {
+    // the number of active levels is stored after the list
+    const IndexView indices = indices_;
+    Kokkos::parallel_scan(
+        Kokkos::TeamThreadRange(team, num_levels),
+        [&](const int k, int &offset, const bool final) {
+          const bool active = is_active(k);
+          if (final && active)
+            indices(offset) = k;
+          offset += active ? 1 : 0;
+          if (final && (k == num_levels - 1))
+            indices(num_levels) = offset;
+        });
+    team.team_barrier();
+    num_active_ = (num_levels > 0) ? indices_(num_levels) : 0;
+  }
+
+  /// Returns the number of levels in the column.
+  KOKKOS_INLINE_FUNCTION
+  int num_levels() const { return num_levels_; }
+
+  /// Returns the number of active levels.
+  KOKKOS_INLINE_FUNCTION
+  int num_active() const { return num_active_; }
+
+  /// Returns the index of the ith active level.
+  KOKKOS_INLINE_FUNCTION
+  int operator[](const int i) const { return indices_(i); }
+
+  /// Calls f(k) for every active level k, spreading the active levels over
+  /// the threads of the team.
+  template <typename Functor>
+  KOKKOS_INLINE_FUNCTION void for_each(const ThreadTeam &team,
+                                       const Functor &f) const {
+    const IndexView indices = indices_;
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, num_active_),
+                         [&](const int i) { f(indices(i)); });
+  }
+
+private:
+  IndexView indices_;
+  int num_levels_;
+  int num_active_;
+};
+
+/// LevelCompactionStats accumulates the number of levels visited by a
+/// compacting process and the number of them on which it was active, over all
+/// columns and launches. A default-constructed object records nothing.
+class LevelCompactionStats final {
+public:
+  using Counter = unsigned long long;
+
+  KOKKOS_INLINE_FUNCTION
+  LevelCompactionStats() = default;
+
+  /// Creates statistics with counters set to zero.
+  explicit LevelCompactionStats(const std::string &name)
+      : counts_(name, 2) {}
+
+  KOKKOS_INLINE_FUNCTION
+  ~LevelCompactionStats() = default;
+  KOKKOS_INLINE_FUNCTION
+  LevelCompactionStats(const LevelCompactionStats &rhs) = default;
+  KOKKOS_INLINE_FUNCTION
+  LevelCompactionStats &operator=(const LevelCompactionStats &rhs) = default;
+
+  /// Returns true if this object records statistics.
+  KOKKOS_INLINE_FUNCTION
+  bool enabled() const { return counts_.data() != nullptr; }
+
+  /// Records the active levels of a column. This must be called by all
+  /// threads of the team.
+  KOKKOS_INLINE_FUNCTION
+  void record(const ThreadTeam &team, const ActiveLevels &levels) const {
+    if (!enabled())
+      return;
+    const auto counts = counts_;
+    Kokkos::single(Kokkos::PerTeam(team), [&]() {
+      Kokkos::atomic_add(&counts(0), Counter(levels.num_levels()));
+      Kokkos::atomic_add(&counts(1), Counter(levels.num_active()));
+    });
+  }
+
+  /// Returns the number of levels visited.
+  Counter num_levels() const { return host_counts()(0); }
+
+  /// Returns the number of active levels.
+  Counter num_active() const { return host_counts()(1); }
+
+  /// Returns the fraction of visited levels that were active, or 0 if no
+  /// levels were visited.
+  Real active_fraction() const {
+    const auto counts = host_counts();
+    return (counts(0) > 0) ? Real(counts(1)) / Real(counts(0)) : 0;
+  }
+
+  /// Sets the counters to zero.
+  void reset() const {
+    if (enabled())
+      Kokkos::deep_copy(counts_, Counter(0));
+  }
+
+private:
+  using CounterView = DeviceType::view_1d<Counter>;
+
+  CounterView::HostMirror host_counts() const {
+    CounterView::HostMirror counts("level_compaction_counts", 2);
+    if (enabled())
+      Kokkos::deep_copy(counts, counts_);
+    return counts;
+  }
+
+  CounterView counts_;
+};
+
+} // namespace mam4
+
+#endif
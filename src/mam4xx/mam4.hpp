@@ -15,14 +15,18 @@
 #include <mam4xx/aging.hpp>
 #include <mam4xx/calcsize.hpp>
 #include <mam4xx/coagulation.hpp>
+#include <mam4xx/column_batch.hpp>
+#include <mam4xx/column_skip.hpp>
 #include <mam4xx/convproc.hpp>
 #include <mam4xx/drydep.hpp>
 #include <mam4xx/gas_chem.hpp>
 #include <mam4xx/gas_chem_mechanism.hpp>
 #include <mam4xx/gasaerexch.hpp>
 #include <mam4xx/hetfrz.hpp>
+#include <mam4xx/level_compaction.hpp>
 #include <mam4xx/lin_strat_chem.hpp>
 #include <mam4xx/mam4_types.hpp>
+#include <mam4xx/microphysics.hpp>
 #include <mam4xx/mo_chm_diags.hpp>
 #include <mam4xx/mo_photo.hpp>
 #include <mam4xx/mo_setext.hpp>
@@ -34,11 +38,15 @@
 #include <mam4xx/ndrop.hpp>
 #include <mam4xx/nucleate_ice.hpp>
 #include <mam4xx/nucleation.hpp>
+#include <mam4xx/packs.hpp>
+#include <mam4xx/profiling.hpp>
+#include <mam4xx/prognostics_storage.hpp>
 #include <mam4xx/rename.hpp>
 #include <mam4xx/spitfire_transport.hpp>
 #include <mam4xx/tropopause.hpp>
 #include <mam4xx/water_uptake.hpp>
 #include <mam4xx/wet_dep.hpp>
+#include <mam4xx/work_memory.hpp>
 namespace mam4 {
 
 using NucleationProcess = haero::AeroProcess<AeroConfig, Nucleation>;
@@ -53,6 +61,7 @@ using NucleateIceProcess = haero::AeroProcess<AeroConfig, NucleateIce>;
 using WetDepositionProcess = haero::AeroProcess<AeroConfig, WetDeposition>;
 using DryDepositionProcess = haero::AeroProcess<AeroConfig, DryDeposition>;
 using WaterUptakeProcess = haero::AeroProcess<AeroConfig, Water_Uptake>;
+using MicrophysicsProcess = haero::AeroProcess<AeroConfig, Microphysics>;
 
 } // namespace mam4
 
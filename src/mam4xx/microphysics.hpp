@@ -0,0 +1,387 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_MICROPHYSICS_HPP
+#define MAM4XX_MICROPHYSICS_HPP
+
+#include <mam4xx/aero_config.hpp>
+#include <mam4xx/aero_modes.hpp>
+#include <mam4xx/aging.hpp>
+#include <mam4xx/coagulation.hpp>
+#include <mam4xx/conversions.hpp>
+#include <mam4xx/gasaerexch.hpp>
+#include <mam4xx/mam4_types.hpp>
+#include <mam4xx/nucleation.hpp>
+#include <mam4xx/rename.hpp>
+
+#include <haero/atmosphere.hpp>
+#include <haero/constants.hpp>
+
+namespace mam4 {
+
+/// @class Microphysics
+/// This class runs MAM4's clear-air aerosol microphysics (gas-aerosol
+/// exchange, renaming, nucleation, coagulation, and primary carbon aging) as a
+/// single pass over vertical levels, following the ordering of
+/// mam_amicphys_1subarea_clear in the MAM4 box model. At each level the
+/// prognostics and size diagnostics are read once into local arrays, the
+/// processes are applied one after the other to those arrays, and the
+/// tendencies are written once at the end.
+///
+/// The dry/wet geometric mean diameters and wet densities are read from the
+/// diagnostics, so CalcSize and water uptake must run before this process.
+class Microphysics {
+public:
+  static constexpr int num_modes = AeroConfig::num_modes();
+  static constexpr int num_gases = AeroConfig::num_gas_ids();
+  static constexpr int num_aerosol_ids = AeroConfig::num_aerosol_ids();
+  static constexpr int nait = static_cast<int>(ModeIndex::Aitken);
+  static constexpr int igas_h2so4 = static_cast<int>(GasId::H2SO4);
+  static constexpr int iaer_so4 = static_cast<int>(AeroId::SO4);
+#ifdef MAM4XX_ENABLE_NH3
+  static constexpr int igas_nh3 = static_cast<int>(GasId::NH3);
+  static constexpr int iaer_nh4 = static_cast<int>(AeroId::NH4);
+#endif
+
+  // process-specific configuration data
+  struct Config {
+    // switches for the individual processes (primary carbon aging is always
+    // applied, since it only acts on the changes made by condensation and
+    // coagulation)
+    bool do_cond = true;
+    bool do_rename = true;
+    bool do_newnuc = true;
+    bool do_coag = true;
+
+    // configurations of the chained processes
+    GasAerExch::Config gasaerexch;
+    Rename::Config rename;
+    Nucleation::Config nucleation;
+    Coagulation::Config coagulation;
+
+    Config() {}
+    Config(const Config &) = default;
+    ~Config() = default;
+    Config &operator=(const Config &) = default;
+  };
+
+  // name -- unique name of the process implemented by this class
+  const char *name() const { return "MAM4 microphysics"; }
+
+  // init -- initializes the implementation with MAM4's configuration
+  void init(const AeroConfig &aero_config,
+            const Config &process_config = Config());
+
+  // validate -- validates the given atmospheric state and prognostics against
+  // assumptions made by this implementation, returning true if the states are
+  // valid, false if not
+  KOKKOS_INLINE_FUNCTION
+  bool validate(const AeroConfig &config, const ThreadTeam &team,
+                const Atmosphere &atm, const Surface &sfc,
+                const Prognostics &progs) const {
+    return atm.quantities_nonnegative(team) &&
+           progs.quantities_nonnegative(team);
+  }
+
+  // compute_tendencies -- computes tendencies and updates diagnostics
+  // NOTE: that both diags and tends are const below--this means their views
+  // NOTE: are fixed, but the data in those views is allowed to vary.
+  KOKKOS_INLINE_FUNCTION
+  void compute_tendencies(const AeroConfig &config, const ThreadTeam &team,
+                          Real t, Real dt, const Atmosphere &atm,
+                          const Surface &sfc, const Prognostics &progs,
+                          const Diagnostics &diags,
+                          const Tendencies &tends) const;
+
+  // mam_amicphys_1subarea_clear_ -- applies the microphysics chain to the
+  // mixing ratios of a single clear-air grid cell. Gas and aerosol mixing
+  // ratios are molar [kmol/kmol-air], number mixing ratios are [#/kmol-air],
+  // and aircon is the air molar concentration [kmol/m3]. If given,
+  // uptkrate_cache holds the cached gas uptake rates of the cell.
+  KOKKOS_INLINE_FUNCTION
+  void mam_amicphys_1subarea_clear_(
+      const Real dt, const Real temp, const Real pmid, const Real aircon,
+      const Real zmid, const Real pblh, const Real relhum,
+      Real dgn_a[num_modes], Real dgn_awet[num_modes], Real wetdens[num_modes],
+      Real qgas_cur[num_gases], Real qgas_avg[num_gases],
+      Real qnum_cur[num_modes], Real qaer_cur[num_aerosol_ids][num_modes],
+      Real uptkaer[num_gases][num_modes], Real &uptkrate_h2so4, int &niter_out,
+      Real &g0_soa_out,
+      gasaerexch::UptakeRateCache *uptkrate_cache = nullptr) const;
+
+private:
+  Config config_;
+
+  // the chained processes, which carry their own precomputed tables
+  GasAerExch gasaerexch_;
+  Rename rename_;
+  Nucleation nucleation_;
+  Coagulation coagulation_;
+};
+
+// init -- initializes the implementation with MAM4's configuration
+inline void Microphysics::init(const AeroConfig &aero_config,
+                               const Config &process_config) {
+  config_ = process_config;
+  gasaerexch_.init(aero_config, config_.gasaerexch);
+  rename_.init(aero_config, config_.rename);
+  nucleation_.init(aero_config, config_.nucleation);
+  coagulation_.init(aero_config, config_.coagulation);
+}
+
+KOKKOS_INLINE_FUNCTION
+void Microphysics::mam_amicphys_1subarea_clear_(
+    const Real dt, const Real temp, const Real pmid, const Real aircon,
+    const Real zmid, const Real pblh, const Real relhum, Real dgn_a[num_modes],
+    Real dgn_awet[num_modes], Real wetdens[num_modes], Real qgas_cur[num_gases],
+    Real qgas_avg[num_gases], Real qnum_cur[num_modes],
+    Real qaer_cur[num_aerosol_ids][num_modes],
+    Real uptkaer[num_gases][num_modes], Real &uptkrate_h2so4, int &niter_out,
+    Real &g0_soa_out, gasaerexch::UptakeRateCache *uptkrate_cache) const {
+
+  Real qgas_sv1[num_gases], qnum_sv1[num_modes];
+  Real qaer_sv1[num_aerosol_ids][num_modes];
+
+  // changes due to condensation and coagulation, which drive aging
+  Real qnum_del_cond[num_modes] = {}, qnum_del_coag[num_modes] = {};
+  Real qaer_del_cond[num_aerosol_ids][num_modes] = {};
+  Real qaer_del_coag[num_aerosol_ids][num_modes] = {};
+  Real qaer_del_coag_in[num_aerosol_ids][AeroConfig::max_agepair()] = {};
+
+  // growth of the aerosol species due to condensation, used by renaming
+  Real qaer_del_grow4rnam[num_aerosol_ids][num_modes] = {};
+
+  Real del_h2so4_aeruptk = 0;
+
+  // gas-aerosol exchange
+  if (config_.do_cond) {
+    for (int g = 0; g < num_gases; ++g)
+      qgas_sv1[g] = qgas_cur[g];
+    for (int n = 0; n < num_modes; ++n)
+      qnum_sv1[n] = qnum_cur[n];
+    for (int a = 0; a < num_aerosol_ids; ++a)
+      for (int n = 0; n < num_modes; ++n)
+        qaer_sv1[a][n] = qaer_cur[a][n];
+
+    gasaerexch_.mam_gasaerexch_1subarea_(
+        dt, temp, pmid, aircon, qgas_cur, qgas_avg, qaer_cur, qnum_cur,
+        dgn_awet, uptkaer, uptkrate_h2so4, niter_out, g0_soa_out,
+        uptkrate_cache);
+
+    for (int n = 0; n < num_modes; ++n)
+      qnum_del_cond[n] = qnum_cur[n] - qnum_sv1[n];
+    for (int a = 0; a < num_aerosol_ids; ++a) {
+      for (int n = 0; n < num_modes; ++n) {
+        qaer_del_cond[a][n] = qaer_cur[a][n] - qaer_sv1[a][n];
+        qaer_del_grow4rnam[a][n] = qaer_del_cond[a][n];
+      }
+    }
+    del_h2so4_aeruptk =
+        qgas_cur[igas_h2so4] -
+        (qgas_sv1[igas_h2so4] +
+         config_.gasaerexch.qgas_netprod_otrproc[igas_h2so4] * dt);
+  } else {
+    for (int g = 0; g < num_gases; ++g)
+      qgas_avg[g] = qgas_cur[g];
+  }
+
+  // renaming after "continuous growth"
+  if (config_.do_rename) {
+    // rename works on [mode][species] arrays; cloud-borne aerosols are not
+    // touched in a clear sub-area
+    Real qmol_i_cur[num_modes][num_aerosol_ids];
+    Real qmol_i_del[num_modes][num_aerosol_ids];
+    Real qnum_c_cur[num_modes] = {};
+    Real qmol_c_cur[num_modes][num_aerosol_ids] = {};
+    Real qmol_c_del[num_modes][num_aerosol_ids] = {};
+    for (int a = 0; a < num_aerosol_ids; ++a) {
+      for (int n = 0; n < num_modes; ++n) {
+        qmol_i_cur[n][a] = qaer_cur[a][n];
+        qmol_i_del[n][a] = qaer_del_grow4rnam[a][n];
+      }
+    }
+    const bool is_cloudy_cur = false;
+    rename_.mam_rename_1subarea_(is_cloudy_cur, qnum_cur, qmol_i_cur,
+                                 qmol_i_del, qnum_c_cur, qmol_c_cur,
+                                 qmol_c_del);
+    for (int a = 0; a < num_aerosol_ids; ++a)
+      for (int n = 0; n < num_modes; ++n)
+        qaer_cur[a][n] = qmol_i_cur[n][a];
+  }
+
+  // new particle formation (nucleation)
+  if (config_.do_newnuc) {
+    Real qaer_cur_tmp[num_modes][num_aerosol_ids];
+    for (int a = 0; a < num_aerosol_ids; ++a)
+      for (int n = 0; n < num_modes; ++n)
+        qaer_cur_tmp[n][a] = qaer_cur[a][n];
+    const Real qwtr_cur[num_modes] = {};
+    const Real del_h2so4_gasprod = 0;
+    Real dndt_ait = 0, dmdt_ait = 0, dso4dt_ait = 0, dnh4dt_ait = 0;
+    Real dnclusterdt = 0;
+    nucleation_.compute_tendencies_(
+        dt, temp, pmid, aircon, zmid, pblh, relhum, uptkrate_h2so4,
+        del_h2so4_gasprod, del_h2so4_aeruptk, qgas_cur, qgas_avg, qnum_cur,
+        qaer_cur_tmp, qwtr_cur, dndt_ait, dmdt_ait, dso4dt_ait, dnh4dt_ait,
+        dnclusterdt);
+
+    // apply the nucleation tendencies, limiting the so4 gain by the
+    // available h2so4
+    qnum_cur[nait] += dndt_ait * dt;
+    if (dso4dt_ait > 0) {
+      Real delta_q = dso4dt_ait * dt;
+      qaer_cur[iaer_so4][nait] += delta_q;
+      delta_q = haero::min(delta_q, qgas_cur[igas_h2so4]);
+      qgas_cur[igas_h2so4] -= delta_q;
+    }
+#ifdef MAM4XX_ENABLE_NH3
+    // likewise for the nh4 gain and the available nh3
+    if (nucleation_.nh3_enabled() && dnh4dt_ait > 0) {
+      Real delta_q = dnh4dt_ait * dt;
+      qaer_cur[iaer_nh4][nait] += delta_q;
+      delta_q = haero::min(delta_q, qgas_cur[igas_nh3]);
+      qgas_cur[igas_nh3] -= delta_q;
+    }
+#endif
+  }
+
+  // coagulation
+  if (config_.do_coag) {
+    for (int n = 0; n < num_modes; ++n)
+      qnum_sv1[n] = qnum_cur[n];
+    for (int a = 0; a < num_aerosol_ids; ++a)
+      for (int n = 0; n < num_modes; ++n)
+        qaer_sv1[a][n] = qaer_cur[a][n];
+
+    coagulation::mam_coag_1subarea(dt, temp, pmid, aircon, dgn_a, dgn_awet,
+                                   wetdens, qnum_cur, qaer_cur,
+                                   qaer_del_coag_in, coagulation_.tables());
+
+    for (int n = 0; n < num_modes; ++n)
+      qnum_del_coag[n] = qnum_cur[n] - qnum_sv1[n];
+    for (int a = 0; a < num_aerosol_ids; ++a)
+      for (int n = 0; n < num_modes; ++n)
+        qaer_del_coag[a][n] = qaer_cur[a][n] - qaer_sv1[a][n];
+  }
+
+  // primary carbon aging
+  aging::mam_pcarbon_aging_1subarea(dgn_a, qnum_cur, qnum_del_cond,
+                                    qnum_del_coag, qaer_cur, qaer_del_cond,
+                                    qaer_del_coag, qaer_del_coag_in);
+}
+
+// compute_tendencies -- computes tendencies and updates diagnostics
+// NOTE: that both diags and tends are const below--this means their views
+// NOTE: are fixed, but the data in those views is allowed to vary.
+KOKKOS_INLINE_FUNCTION
+void Microphysics::compute_tendencies(const AeroConfig &config,
+                                      const ThreadTeam &team, Real t, Real dt,
+                                      const Atmosphere &atm, const Surface &sfc,
+                                      const Prognostics &progs,
+                                      const Diagnostics &diags,
+                                      const Tendencies &tends) const {
+  const int nk = atm.num_levels();
+  Kokkos::parallel_for(
+      Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
+        // atmospheric state
+        const Real temp = atm.temperature(k);
+        const Real pmid = atm.pressure(k);
+        const Real zmid = atm.height(k);
+        const Real pblh = atm.planetary_boundary_layer_height;
+        const Real relhum =
+            conversions::relative_humidity_from_vapor_mixing_ratio(
+                atm.vapor_mixing_ratio(k), temp, pmid);
+        // air molar concentration (kmol/m3), as in the MAM4 box model
+        const Real aircon = pmid / (1000 * Constants::r_gas * temp);
+
+        // size diagnostics from CalcSize/water uptake
+        Real dgn_a[num_modes], dgn_awet[num_modes], wetdens[num_modes];
+        for (int n = 0; n < num_modes; ++n) {
+          dgn_a[n] = diags.dry_geometric_mean_diameter_i[n](k);
+          dgn_awet[n] = diags.wet_geometric_mean_diameter_i[n](k);
+          wetdens[n] = diags.wet_density[n](k);
+        }
+
+        // load the prognostics once
+        Real qgas_cur[num_gases], qgas_avg[num_gases] = {};
+        Real qgas_old[num_gases];
+        for (int g = 0; g < num_gases; ++g) {
+          qgas_cur[g] = progs.q_gas[g](k);
+          qgas_old[g] = qgas_cur[g];
+        }
+        Real qnum_cur[num_modes], qnum_old[num_modes];
+        for (int n = 0; n < num_modes; ++n) {
+          qnum_cur[n] = progs.n_mode_i[n](k);
+          qnum_old[n] = qnum_cur[n];
+        }
+        Real qaer_cur[num_aerosol_ids][num_modes];
+        Real qaer_old[num_aerosol_ids][num_modes];
+        for (int n = 0; n < num_modes; ++n) {
+          for (int a = 0; a < num_aerosol_ids; ++a) {
+            qaer_cur[a][n] = progs.q_aero_i[n][a](k);
+            qaer_old[a][n] = qaer_cur[a][n];
+          }
+        }
+        Real uptkaer[num_gases][num_modes];
+        for (int g = 0; g < num_gases; ++g)
+          for (int n = 0; n < num_modes; ++n)
+            uptkaer[g][n] = progs.uptkaer[g][n](k);
+
+        Real uptkrate_h2so4 = diags.uptkrate_h2so4(k);
+        int niter_out = 0;
+        Real g0_soa_out = 0;
+
+        // cached uptake rates, if the condensation configuration keeps them
+        gasaerexch::UptakeRateCache cache;
+        const bool use_cache =
+            config_.do_cond &&
+            gasaerexch::uptkrate_cache_enabled(config_.gasaerexch, diags);
+        if (use_cache)
+          cache = gasaerexch::load_uptkrate_cache(diags, k);
+
+        mam_amicphys_1subarea_clear_(dt, temp, pmid, aircon, zmid, pblh,
+                                     relhum, dgn_a, dgn_awet, wetdens,
+                                     qgas_cur, qgas_avg, qnum_cur, qaer_cur,
+                                     uptkaer, uptkrate_h2so4, niter_out,
+                                     g0_soa_out, use_cache ? &cache : nullptr);
+        if (use_cache)
+          gasaerexch::store_uptkrate_cache(cache, diags, k);
+        if (config_.do_cond)
+          config_.gasaerexch.soa_substep_stats.record(team.league_rank(), k,
+                                                      niter_out);
+
+        // write tendencies and updated state once. Gas production from
+        // other processes that was folded into the condensation step is not
+        // part of the microphysics tendency.
+        for (int g = 0; g < num_gases; ++g) {
+          const Real netprod =
+              config_.do_cond
+                  ? config_.gasaerexch.qgas_netprod_otrproc[g] * dt
+                  : 0;
+          tends.q_gas[g](k) = (qgas_cur[g] - (qgas_old[g] + netprod)) / dt;
+          progs.q_gas[g](k) = qgas_cur[g];
+          progs.q_gas_avg[g](k) = qgas_avg[g];
+        }
+        for (int n = 0; n < num_modes; ++n) {
+          tends.n_mode_i[n](k) = (qnum_cur[n] - qnum_old[n]) / dt;
+          progs.n_mode_i[n](k) = qnum_cur[n];
+          for (int a = 0; a < num_aerosol_ids; ++a) {
+            tends.q_aero_i[n][a](k) = (qaer_cur[a][n] - qaer_old[a][n]) / dt;
+            progs.q_aero_i[n][a](k) = qaer_cur[a][n];
+          }
+        }
+        for (int g = 0; g < num_gases; ++g)
+          for (int n = 0; n < num_modes; ++n)
+            progs.uptkaer[g][n](k) = uptkaer[g][n];
+
+        diags.g0_soa_out(k) = g0_soa_out;
+        diags.uptkrate_h2so4(k) = uptkrate_h2so4;
+        diags.num_substeps(k) = niter_out;
+      });
+}
+
+} // namespace mam4
+
+#endif
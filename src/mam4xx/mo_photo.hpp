@@ -3,6 +3,7 @@
 
 #include <haero/math.hpp>
 #include <mam4xx/aero_config.hpp>
+#include <mam4xx/column_batch.hpp>
 #include <mam4xx/gas_chem_mechanism.hpp>
 #include <mam4xx/mam4_types.hpp>
 #include <mam4xx/utils.hpp>
@@ -15,7 +16,8 @@ namespace mo_photo {
 constexpr int pver = mam4::nlev;
 constexpr int pverm = pver - 1;
 
-using View5D = DeviceType::view_ND<Real, 5>;
+// rsf_tab is stored in TableReal (see aero_config.hpp)
+using View5D = DeviceType::view_ND<TableReal, 5>;
 using View4D = DeviceType::view_ND<Real, 4>;
 using View2D = DeviceType::view_2d<Real>;
 using View1D = DeviceType::view_1d<Real>;
@@ -761,6 +763,14 @@ void table_photo(const View2D &photo, // out
   // } // end col_loop
 }
 
+// Calls kernel(team, icol) on each column of a batch of num_columns columns in
+// a single launch, profiled as a region named "table_photo". The kernel is
+// expected to call table_photo on column icol.
+template <typename Kernel>
+void table_photo_for_columns(const int num_columns, const Kernel &kernel) {
+  for_each_column("table_photo", num_columns, pver, kernel);
+}
+
 } // namespace mo_photo
 } // end namespace mam4
 
@@ -7,6 +7,7 @@
 #include <haero/math.hpp>
 
 #include <mam4xx/aero_config.hpp>
+#include <mam4xx/column_batch.hpp>
 #include <mam4xx/conversions.hpp>
 #include <mam4xx/mam4_types.hpp>
 #include <mam4xx/utils.hpp>
@@ -1343,6 +1344,14 @@ void setsox(const ThreadTeam &team, const int loffset, const Real dt,
       }); // end kokkos::parfor(k)
 } // end setsox()
 
+// Calls kernel(team, icol) on each column of a batch of num_columns columns in
+// a single launch, profiled as a region named "setsox". The kernel is expected
+// to call setsox on column icol.
+template <typename Kernel>
+void setsox_for_columns(const int num_columns, const Kernel &kernel) {
+  for_each_column("setsox", num_columns, mam4::nlev, kernel);
+}
+
 } // namespace mo_setsox
 } // namespace mam4
 #endif
@@ -4,6 +4,7 @@
 #include <Kokkos_Complex.hpp>
 #include <haero/math.hpp>
 #include <mam4xx/aero_config.hpp>
+#include <mam4xx/column_batch.hpp>
 #include <mam4xx/modal_aero_calcsize.hpp>
 #include <mam4xx/ndrop.hpp>
 #include <mam4xx/water_uptake.hpp>
@@ -14,6 +15,8 @@ namespace modal_aer_opt {
 using View1D = DeviceType::view_1d<Real>;
 using View2D = DeviceType::view_2d<Real>;
 using View3D = DeviceType::view_3d<Real>;
+// Chebyshev coefficient tables, stored in TableReal (see aero_config.hpp)
+using TableView3D = DeviceType::view_3d<TableReal>;
 using ComplexView2D = DeviceType::view_2d<Kokkos::complex<Real>>;
 using ComplexView1D = DeviceType::view_1d<Kokkos::complex<Real>>;
 using View5D = Kokkos::View<Real *****>;
@@ -73,13 +76,13 @@ struct AerosolOpticsDeviceData {
   // FIXME: add description of these tables.
   View1D refitabsw[ntot_amode][nswbands];
   View1D refrtabsw[ntot_amode][nswbands];
-  View3D abspsw[ntot_amode][nswbands];
-  View3D asmpsw[ntot_amode][nswbands];
+  TableView3D abspsw[ntot_amode][nswbands];
+  TableView3D asmpsw[ntot_amode][nswbands];
 
   View1D refrtablw[ntot_amode][nlwbands];
   View1D refitablw[ntot_amode][nlwbands];
-  View3D absplw[ntot_amode][nlwbands];
-  View3D extpsw[ntot_amode][nswbands];
+  TableView3D absplw[ntot_amode][nlwbands];
+  TableView3D extpsw[ntot_amode][nswbands];
 
   ComplexView1D crefwlw;
   ComplexView1D crefwsw;
@@ -93,11 +96,11 @@ inline void set_aerosol_optics_data_for_modal_aero_sw_views(
   for (int d1 = 0; d1 < ntot_amode; ++d1) {
     for (int d5 = 0; d5 < nswbands; ++d5) {
       aersol_optics_data.abspsw[d1][d5] =
-          View3D("abspsw", coef_number, refindex_real, refindex_im);
+          TableView3D("abspsw", coef_number, refindex_real, refindex_im);
       aersol_optics_data.extpsw[d1][d5] =
-          View3D("extpsw", coef_number, refindex_real, refindex_im);
+          TableView3D("extpsw", coef_number, refindex_real, refindex_im);
       aersol_optics_data.asmpsw[d1][d5] =
-          View3D("asmpsw", coef_number, refindex_real, refindex_im);
+          TableView3D("asmpsw", coef_number, refindex_real, refindex_im);
 
       aersol_optics_data.refrtabsw[d1][d5] = View1D("refrtabsw", refindex_real);
 
@@ -113,7 +116,7 @@ inline void set_aerosol_optics_data_for_modal_aero_lw_views(
   for (int d1 = 0; d1 < ntot_amode; ++d1)
     for (int d5 = 0; d5 < nlwbands; ++d5) {
       aersol_optics_data.absplw[d1][d5] =
-          View3D("absplw3", coef_number, refindex_real, refindex_im);
+          TableView3D("absplw3", coef_number, refindex_real, refindex_im);
       aersol_optics_data.refrtablw[d1][d5] = View1D("refrtablw", refindex_real);
       aersol_optics_data.refitablw[d1][d5] = View1D("refitablw", refindex_im);
     } // d5
@@ -458,11 +461,12 @@ void compute_factors(const int prefri, const Real ref_ind,
 
 } // compute_factors
 
-KOKKOS_INLINE_FUNCTION
-void binterp(const View3D &table, const Real ref_real, const Real ref_img,
-             const Real ref_real_tab[prefr], const Real ref_img_tab[prefi],
-             int &itab, int &jtab, Real &ttab, Real &utab, Real coef[ncoef],
-             const int itab_1) {
+template <typename TableView>
+KOKKOS_INLINE_FUNCTION void
+binterp(const TableView &table, const Real ref_real, const Real ref_img,
+        const Real ref_real_tab[prefr], const Real ref_img_tab[prefi],
+        int &itab, int &jtab, Real &ttab, Real &utab, Real coef[ncoef],
+        const int itab_1) {
   /*------------------------------------------------------------------------------
    Bilinear interpolation along the refractive index dimensions
    of the table to estimate Chebyshev coefficients at an
@@ -476,7 +480,7 @@ void binterp(const View3D &table, const Real ref_real, const Real ref_img,
 
   // intent-ins
   // ncol
-  // table(ncoef,prefr,prefi)
+  // table(ncoef,prefr,prefi) (a View3D or a TableView3D)
   // ref_real(pcols), ref_img(pcols) real and imganinary parts of refractive
   // indices [unitless] ref_real_tab(prefr), ref_img_tab(prefi) real and
   // imganinary table refractive indices [unitless]
@@ -508,80 +512,29 @@ void binterp(const View3D &table, const Real ref_real, const Real ref_img,
 
 } // binterp
 
+// computes the wet diameters and aerosol water required by aerosol_optics
+// with the fused calcsize and water uptake stage (mass mixing ratios are not
+// updated)
 KOKKOS_INLINE_FUNCTION
 void compute_calcsize_and_water_uptake_dr(
-    const Real &pmid, const Real &temperature, Real &cldn,
-    Real *state_q_kk,   // in
-    const Real *qqcw_k, // in
+    const modal_aero_calcsize::CalcsizeWaterUptakeParams &params,
+    const Real &pmid, const Real &temperature, const Real &cldn,
+    const Real *state_q_kk, // in
+    const Real *qqcw_k,     // in
     const Real &dt,
     // outputs
-    int nspec_amode[ntot_amode],
-    int lspectype_amode[ndrop::maxd_aspectype][ntot_amode],
-    Real specdens_amode[ndrop::maxd_aspectype],
-    int lmassptr_amode[ndrop::maxd_aspectype][ntot_amode],
-    Real spechygro[ndrop::maxd_aspectype], Real mean_std_dev_nmodes[ntot_amode],
     Real dgnumwet_m_kk[ntot_amode], Real qaerwat_m_kk[ntot_amode]) {
 
-  const bool do_adjust = true;
-  const bool do_aitacc_transfer = true;
   const bool update_mmr = false;
 
-  int numptr_amode[ntot_amode];
-  int mam_idx[ntot_amode][ndrop::nspec_max];
-  int mam_cnst_idx[ntot_amode][ndrop::nspec_max];
-
-  ndrop::get_e3sm_parameters(nspec_amode, lspectype_amode, lmassptr_amode,
-                             numptr_amode, specdens_amode, spechygro, mam_idx,
-                             mam_cnst_idx);
-
-  // FIXME: inv_density: we have different order of species in mam4xx.
-  Real inv_density[ntot_amode][AeroConfig::num_aerosol_ids()] = {};
-  Real num2vol_ratio_min[ntot_amode] = {};
-  Real num2vol_ratio_max[ntot_amode] = {};
-  Real num2vol_ratio_max_nmodes[ntot_amode] = {};
-  Real num2vol_ratio_min_nmodes[ntot_amode] = {};
-  Real num2vol_ratio_nom_nmodes[ntot_amode] = {};
-  Real dgnmin_nmodes[ntot_amode] = {};
-  Real dgnmax_nmodes[ntot_amode] = {};
-  Real dgnnom_nmodes[ntot_amode] = {};
-  // Real mean_std_dev_nmodes[ntot_amode] = {};
-  // outputs
-  bool noxf_acc2ait[AeroConfig::num_aerosol_ids()] = {};
-  int n_common_species_ait_accum = {};
-  int ait_spec_in_acc[AeroConfig::num_aerosol_ids()] = {};
-  int acc_spec_in_ait[AeroConfig::num_aerosol_ids()] = {};
-  // FIXME: inv_density
-  modal_aero_calcsize::init_calcsize(
-      inv_density, num2vol_ratio_min, num2vol_ratio_max,
-      num2vol_ratio_max_nmodes, num2vol_ratio_min_nmodes,
-      num2vol_ratio_nom_nmodes, dgnmin_nmodes, dgnmax_nmodes, dgnnom_nmodes,
-      mean_std_dev_nmodes,
-      // outputs
-      noxf_acc2ait, n_common_species_ait_accum, ait_spec_in_acc,
-      acc_spec_in_ait);
-
   Real dgncur_c_kk[ntot_amode] = {};
   Real dgnumdry_m_kk[ntot_amode] = {};
   Real ptend[pcnst] = {};
   Real dqqcwdt[pcnst] = {};
-  //  Calculate aerosol size distribution parameters and aerosol water uptake
-  // For prognostic aerosols
-  modal_aero_calcsize::modal_aero_calcsize_sub(
-      state_q_kk, // in
-      qqcw_k,     // in/out
-      dt, do_adjust, do_aitacc_transfer, update_mmr, lmassptr_amode,
-      numptr_amode,
-      inv_density, // in
-      num2vol_ratio_min, num2vol_ratio_max, num2vol_ratio_max_nmodes,
-      num2vol_ratio_min_nmodes, num2vol_ratio_nom_nmodes, dgnmin_nmodes,
-      dgnmax_nmodes, dgnnom_nmodes, mean_std_dev_nmodes,
+  modal_aero_calcsize::modal_aero_calcsize_water_uptake_dr(
+      params, state_q_kk, qqcw_k, dt, update_mmr, temperature, pmid, cldn,
       // outputs
-      noxf_acc2ait, n_common_species_ait_accum, ait_spec_in_acc,
-      acc_spec_in_ait, dgnumdry_m_kk, dgncur_c_kk, ptend, dqqcwdt);
-
-  mam4::water_uptake::modal_aero_water_uptake_dr(
-      nspec_amode, specdens_amode, spechygro, lspectype_amode, state_q_kk,
-      temperature, pmid, cldn, dgnumdry_m_kk, dgnumwet_m_kk, qaerwat_m_kk);
+      dgnumdry_m_kk, dgncur_c_kk, ptend, dqqcwdt, dgnumwet_m_kk, qaerwat_m_kk);
 } // compute_calcsize_water_uptake_dr
 
 KOKKOS_INLINE_FUNCTION
@@ -656,19 +609,18 @@ void modal_aero_sw_wo_diagnostics_k(
   Real cheb_kk[ncoef] = {};
   Real specvol[max_nspec] = {};
   // inputs
-  int nspec_amode[ntot_amode];
-  int lspectype_amode[ndrop::maxd_aspectype][ntot_amode];
-  int lmassptr_amode[ndrop::maxd_aspectype][ntot_amode];
-  Real specdens_amode[ndrop::maxd_aspectype];
-  Real spechygro[ndrop::maxd_aspectype];
+  const modal_aero_calcsize::CalcsizeWaterUptakeParams params;
+  const auto &nspec_amode = params.nspec_amode;
+  const auto &lspectype_amode = params.lspectype_amode;
+  const auto &lmassptr_amode = params.lmassptr_amode;
+  const auto &specdens_amode = params.specdens_amode;
+  const auto &mean_std_dev_nmodes = params.mean_std_dev_nmodes;
 
-  Real mean_std_dev_nmodes[ntot_amode] = {};
   Real dgnumwet_m_kk[ntot_amode] = {};
   Real qaerwat_m_kk[ntot_amode] = {};
-  compute_calcsize_and_water_uptake_dr(
-      pmid, temperature, cldn, state_q_kk, qqcw_k, dt, // in
-      nspec_amode, lspectype_amode, specdens_amode, lmassptr_amode, spechygro,
-      mean_std_dev_nmodes, dgnumwet_m_kk, qaerwat_m_kk);
+  compute_calcsize_and_water_uptake_dr(params, pmid, temperature, cldn,
+                                       state_q_kk, qqcw_k, dt, // in
+                                       dgnumwet_m_kk, qaerwat_m_kk);
 
   for (int mm = 0; mm < ntot_amode; ++mm) {
     //  get mode info
@@ -1032,20 +984,19 @@ void modal_aero_lw_k(const Real &pdeldry, const Real &pmid,
   // layer dry mass [kg/m2]
   const Real mass = pdeldry * rga;
   // e3sm parameters
-  int nspec_amode[ntot_amode];
-  int lspectype_amode[ndrop::maxd_aspectype][ntot_amode];
-  int lmassptr_amode[ndrop::maxd_aspectype][ntot_amode];
-  Real specdens_amode[ndrop::maxd_aspectype];
-  Real spechygro[ndrop::maxd_aspectype];
-  Real mean_std_dev_nmodes[ntot_amode] = {};
+  const modal_aero_calcsize::CalcsizeWaterUptakeParams params;
+  const auto &nspec_amode = params.nspec_amode;
+  const auto &lspectype_amode = params.lspectype_amode;
+  const auto &lmassptr_amode = params.lmassptr_amode;
+  const auto &specdens_amode = params.specdens_amode;
+  const auto &mean_std_dev_nmodes = params.mean_std_dev_nmodes;
 
   // calcsize and water_uptake_dr outputs that are required by aerosol_optics
   Real dgnumwet_m_kk[ntot_amode] = {};
   Real qaerwat_m_kk[ntot_amode] = {};
-  compute_calcsize_and_water_uptake_dr(
-      pmid, temperature, cldn, state_q_kk, qqcw_k, dt, // in
-      nspec_amode, lspectype_amode, specdens_amode, lmassptr_amode, spechygro,
-      mean_std_dev_nmodes, dgnumwet_m_kk, qaerwat_m_kk);
+  compute_calcsize_and_water_uptake_dr(params, pmid, temperature, cldn,
+                                       state_q_kk, qqcw_k, dt, // in
+                                       dgnumwet_m_kk, qaerwat_m_kk);
 
   for (int mm = 0; mm < ntot_amode; ++mm) {
 
@@ -1233,6 +1184,35 @@ void modal_aero_lw(const ThreadTeam &team, const Real dt,
       });
 } // modal_aero_lw
 
+// Calls kernel(team, icol) on each column of a batch of num_columns columns in
+// a single launch, profiled as a region named "modal_aero_lw". The kernel is
+// expected to call modal_aero_lw on column icol.
+template <typename Kernel>
+void modal_aero_lw_for_columns(const int num_columns, const Kernel &kernel) {
+  for_each_column("modal_aero_lw", num_columns, pver, kernel);
+}
+
+// Returns work memory for calling modal_aero_sw on each column of a batch of
+// num_columns columns (see column_batch.hpp).
+inline TeamWorkMemory modal_aero_sw_work_memory(const int num_columns) {
+  return column_batch_work_memory(get_work_len_aerosol_optics(), num_columns,
+                                  pver);
+}
+
+// Calls kernel(team, icol, work) on each column of a batch of num_columns
+// columns in a single launch, profiled as a region named "modal_aero_sw". The
+// kernel is expected to call modal_aero_sw on column icol with the given work
+// array, which comes from work_memory (see modal_aero_sw_work_memory).
+template <typename Kernel>
+void modal_aero_sw_for_columns(const int num_columns,
+                               const TeamWorkMemory &work_memory,
+                               const Kernel &kernel) {
+  EKAT_REQUIRE_MSG(work_memory.work_len() >= get_work_len_aerosol_optics(),
+                   "modal_aero_sw_for_columns: the work memory is smaller "
+                   "than modal_aero_sw needs");
+  for_each_column("modal_aero_sw", num_columns, pver, work_memory, kernel);
+}
+
 } // namespace modal_aer_opt
 
 } // end namespace mam4
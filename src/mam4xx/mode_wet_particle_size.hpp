@@ -97,20 +97,17 @@ void mode_avg_wet_particle_diam_water_uptake(const Diagnostics &diags,
     // check dry particle size is in bounds
     EKAT_KERNEL_ASSERT((dry_radius_microns <= dry_radius_max_microns));
 
-    // Set up Kohler solver
-    // (requires double precision)
-    typedef KohlerSolver<haero::math::NewtonSolver<KohlerPolynomial>>
-        SolverType;
-    const Real tol = solver_convergence_tol;
-    // Solve for the roots of the Kohler polynomial
+    // Solve for the positive root of the Kohler polynomial
     //
     //  This step replaces the mam4 subroutine modal_aero_kohler with
-    //  a new solver that is better conditioned and stable for
-    //  finite precision computations.
-    SolverType kohler_solver =
-        SolverType(rel_humidity, diags.hygroscopicity[mode_idx](k),
-                   dry_radius_microns, tol);
-    auto rwet_microns = kohler_solver.solve();
+    //  a real-arithmetic solver that is better conditioned and stable for
+    //  finite precision computations (requires double precision).
+    const Real tol = solver_convergence_tol;
+    const double kelvin_a = kelvin_coefficient() * meters_to_microns;
+    int n_iter = 0;
+    Real rwet_microns = kohler_wet_radius(
+        haero::log(rel_humidity), diags.hygroscopicity[mode_idx](k),
+        dry_radius_microns, kelvin_a, tol, n_iter);
 
     // set maximum wet radius of 30 microns
     //
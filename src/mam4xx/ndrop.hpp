@@ -8,6 +8,7 @@
 
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/aero_model.hpp>
+#include <mam4xx/column_batch.hpp>
 #include <mam4xx/conversions.hpp>
 #include <mam4xx/mam4_types.hpp>
 #include <mam4xx/utils.hpp>
@@ -1761,6 +1762,131 @@ void dropmixnuc(
                 exp45logsig, alogsig, ccn_k.data());
       }); // end parfor(k)
 } // dropmixnuc
+
+// =============================================================================
+KOKKOS_INLINE_FUNCTION
+int get_dropmixnuc_work_len() {
+  // raercol, raercol_cw (two time levels each), nact, mact, and
+  // eddy_diff, zn, csbot, zs, overlapp, overlapm, eddy_diff_kp,
+  // eddy_diff_km, qncld, srcn, source, dz, csbot_cscen, raertend, qqcwtend
+  int work_len =
+      4 * pver * ncnst_tot + 2 * pver * AeroConfig::num_modes() + 15 * pver;
+  return work_len;
+}
+// =============================================================================
+
+// Same as above, but with the work arrays carved from a single work array of
+// length get_dropmixnuc_work_len() (see work_memory.hpp). The contents of the
+// work array on entry are ignored.
+KOKKOS_INLINE_FUNCTION
+void dropmixnuc(
+    const ThreadTeam &team, const Real dtmicro,
+    const haero::ConstColumnView &temp, const haero::ConstColumnView &pmid,
+    const haero::ConstColumnView &pint, const haero::ConstColumnView &pdel,
+    const haero::ConstColumnView &rpdel, const haero::ConstColumnView &zm,
+    const ConstView2D &state_q, const haero::ConstColumnView &ncldwtr,
+    const haero::ConstColumnView &v_diffusivity,
+    const haero::ConstColumnView &cldn,
+    const int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
+    const Real specdens_amode[maxd_aspectype],
+    const Real spechygro[maxd_aspectype],
+    const int lmassptr_amode[maxd_aspectype][AeroConfig::num_modes()],
+    const Real voltonumbhi_amode[AeroConfig::num_modes()],
+    const Real voltonumblo_amode[AeroConfig::num_modes()],
+    const int numptr_amode[AeroConfig::num_modes()],
+    const int nspec_amode[maxd_aspectype],
+    const Real exp45logsig[AeroConfig::num_modes()],
+    const Real alogsig[AeroConfig::num_modes()], const Real aten,
+    const int mam_idx[AeroConfig::num_modes()][nspec_max],
+    const int mam_cnst_idx[AeroConfig::num_modes()][nspec_max],
+    const ColumnView &qcld, const ColumnView &wsub,
+    const ColumnView &cldo,               // in
+    const ColumnView qqcw_fld[ncnst_tot], // inout
+    const ColumnView ptend_q[aero_model::pcnst], const ColumnView &tendnd,
+    const View2D &factnum, const ColumnView &ndropcol,
+    const ColumnView &ndropmix, const ColumnView &nsource,
+    const ColumnView &wtke, const View2D &ccn,
+    const ColumnView coltend[ncnst_tot], const ColumnView coltend_cw[ncnst_tot],
+    const View1D &work) {
+  constexpr int ntot_amode = AeroConfig::num_modes();
+  auto work_ptr = (Real *)work.data();
+
+  View1D raercol_cw[pver][2], raercol[pver][2];
+  for (int k = 0; k < pver; ++k) {
+    for (int i = 0; i < 2; ++i) {
+      raercol[k][i] = View1D(work_ptr, ncnst_tot);
+      work_ptr += ncnst_tot;
+      raercol_cw[k][i] = View1D(work_ptr, ncnst_tot);
+      work_ptr += ncnst_tot;
+    }
+  }
+
+  View2D nact(work_ptr, pver, ntot_amode);
+  work_ptr += pver * ntot_amode;
+  View2D mact(work_ptr, pver, ntot_amode);
+  work_ptr += pver * ntot_amode;
+
+  constexpr int ncolumn_work = 15;
+  ColumnView column_work[ncolumn_work];
+  for (int i = 0; i < ncolumn_work; ++i) {
+    column_work[i] = ColumnView(work_ptr, pver);
+    work_ptr += pver;
+  }
+
+  /// error check
+  const int workspace_used(work_ptr - work.data()),
+      workspace_extent(work.extent(0));
+  if (workspace_used > workspace_extent) {
+    Kokkos::abort("Error dropmixnuc : workspace used is larger than it "
+                  "is provided\n");
+  }
+
+  // The work array may come from team scratch or an arena that holds the
+  // previous column's values. dropmixnuc only accumulates into nact and mact,
+  // never writes nact(pver-1,:) or the levels above top_lev, and some of the
+  // per-level temporaries start at top_lev, so zero the work to match the
+  // zero-initialized views of the overload above.
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(team, workspace_used),
+                       [&](int i) { work(i) = 0; });
+  team.team_barrier();
+
+  dropmixnuc(team, dtmicro, temp, pmid, pint, pdel, rpdel, zm, state_q, ncldwtr,
+             v_diffusivity, cldn, lspectype_amode, specdens_amode, spechygro,
+             lmassptr_amode, voltonumbhi_amode, voltonumblo_amode, numptr_amode,
+             nspec_amode, exp45logsig, alogsig, aten, mam_idx, mam_cnst_idx,
+             qcld, wsub, cldo, qqcw_fld, ptend_q, tendnd, factnum, ndropcol,
+             ndropmix, nsource, wtke, ccn, coltend, coltend_cw, raercol_cw,
+             raercol, nact, mact,
+             // eddy_diff, zn, csbot, zs, overlapp, overlapm, eddy_diff_kp,
+             // eddy_diff_km, qncld, srcn, source, dz, csbot_cscen, raertend,
+             // qqcwtend
+             column_work[0], column_work[1], column_work[2], column_work[3],
+             column_work[4], column_work[5], column_work[6], column_work[7],
+             column_work[8], column_work[9], column_work[10], column_work[11],
+             column_work[12], column_work[13], column_work[14]);
+} // dropmixnuc
+
+// Returns work memory for calling dropmixnuc on each column of a batch of
+// num_columns columns (see column_batch.hpp).
+inline TeamWorkMemory dropmixnuc_work_memory(const int num_columns) {
+  return column_batch_work_memory(get_dropmixnuc_work_len(), num_columns,
+                                  pver);
+}
+
+// Calls kernel(team, icol, work) on each column of a batch of num_columns
+// columns in a single launch, profiled as a region named "dropmixnuc". The
+// kernel is expected to call the overload of dropmixnuc above on column icol
+// with the given work array, which comes from work_memory (see
+// dropmixnuc_work_memory).
+template <typename Kernel>
+void dropmixnuc_for_columns(const int num_columns,
+                            const TeamWorkMemory &work_memory,
+                            const Kernel &kernel) {
+  EKAT_REQUIRE_MSG(work_memory.work_len() >= get_dropmixnuc_work_len(),
+                   "dropmixnuc_for_columns: the work memory is smaller than "
+                   "dropmixnuc needs");
+  for_each_column("dropmixnuc", num_columns, pver, work_memory, kernel);
+}
 } // namespace ndrop
 } // end namespace mam4
 
@@ -15,6 +15,7 @@
 
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/conversions.hpp>
+#include <mam4xx/level_compaction.hpp>
 #include <mam4xx/mam4_types.hpp>
 #include <mam4xx/utils.hpp>
 #include <mam4xx/wv_sat_methods.hpp>
@@ -252,10 +253,18 @@ public:
     Real _nucleate_ice_subgrid;
     // ice nucleation SO2 size threshold for aitken mode
     Real _so4_sz_thresh_icenuc;
+    // if true, ice nucleation is computed only on levels colder than
+    // freezing_pt_h2o - 5 K, which are the only levels it modifies (see
+    // level_compaction.hpp). The launch must then request
+    // ActiveLevels::scratch_size(nlev) bytes of level 0 team scratch memory.
+    bool compact_levels;
+    // if enabled, records the fraction of levels on which ice nucleation acts
+    // (used only with compact_levels)
+    LevelCompactionStats level_stats;
     Config(const Real nucleate_ice_subgrid = 120,
            const Real so4_sz_thresh_icenuc = 8.0e-8)
         : _nucleate_ice_subgrid(nucleate_ice_subgrid),
-          _so4_sz_thresh_icenuc(so4_sz_thresh_icenuc) {}
+          _so4_sz_thresh_icenuc(so4_sz_thresh_icenuc), compact_levels(false) {}
     Config(const Config &) = default;
     ~Config() = default;
     Config &operator=(const Config &) = default;
@@ -275,6 +284,7 @@ public:
   void init(const AeroConfig &aero_config,
             const Config &nucleate_ice_config = Config()) {
 
+    config_ = nucleate_ice_config;
     _nucleate_ice_subgrid = nucleate_ice_config._nucleate_ice_subgrid;
 
     _num_m3_to_cm3 = 1.0e-6;
@@ -359,87 +369,95 @@ public:
     const Real mincld = _mincld;
     const Real alnsg_amode_aitken = _alnsg_amode_aitken;
 
-    Kokkos::parallel_for(
-        Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int kk) {
-          const Real temp = atmosphere.temperature(kk);
-          if (temp < tmelt_m_five) {
-
-            const Real zero = 0;
-            const Real half = 0.5;
-            const Real sqrt_two = haero::sqrt(2.0);
-
-            const Real pmid = atmosphere.pressure(kk);
-            const Real air_density =
-                conversions::density_of_ideal_gas(temp, pmid);
-
-            // CHECK if this part of code is consistent with original code.
-            // relative humidity [unitless]
-            Real qv = atmosphere.vapor_mixing_ratio(kk);
-            // very low temperature produces inf relhum
-            Real es = zero;
-            Real qs = zero;
-
-            wv_sat_methods::wv_sat_qsat_water(temp, pmid, es, qs);
-            const Real relhum = qv / qs;
-            const Real icldm = haero::max(ast(kk), mincld);
-
-            // compute aerosol number for so4, soot, and dust with units #/cm^3
-            // remove soot number, because it is set to zero
-            Real so4_num = zero;
-            Real dst3_num = zero;
-
-            /* For modal aerosols, assume for the upper troposphere:
-            soot = accumulation mode
-            sulfate = aitken mode
-            dust = coarse mode
-            since modal has internal mixtures. */
-            Real dmc = coarse_dust(kk) * air_density;
-            Real ssmc = coarse_nacl(kk) * air_density;
-            Real so4mc = coarse_so4(kk) * air_density;
-
-            Real mommc = coarse_mom(kk) * air_density;
-            Real bcmc = coarse_bc(kk) * air_density;
-            Real pommc = coarse_pom(kk) * air_density;
-            Real soamc = coarse_soa(kk) * air_density;
-
-            if (dmc > zero) {
-              const Real wght =
-                  dmc / (ssmc + dmc + so4mc + bcmc + pommc + soamc + mommc);
-              dst3_num = wght * num_coarse(kk) * air_density * num_m3_to_cm3;
-            } // end dmc
-
-            if (dgnum_aitken(kk) > zero) {
-              // only allow so4 with D > 0.1 um in ice nucleation
-              so4_num =
-                  num_aitken(kk) * air_density * num_m3_to_cm3 *
-                  (half - half * haero::erf(haero::log(so4_sz_thresh_icenuc /
-                                                       dgnum_aitken(kk)) /
-                                            (sqrt_two * alnsg_amode_aitken)));
-            } // end dgnum_aitken
-
-            so4_num = haero::max(zero, so4_num);
-
-            // Real naai = zero;
-
-            nucleati(wsubi(kk), temp, pmid, relhum, icldm, air_density, so4_num,
-                     dst3_num, subgrid,
-                     // outputs
-                     naai(kk), nihf(kk), niimm(kk), nidep(kk), nimey(kk));
-
-            // QUESTION why nihf instead of naai
-            naai_hom(kk) = nihf(kk);
-            // is naai not saved?
-
-            // output activated ice (convert from #/kg -> #/m3)
-            // QUESTION: note that these variables are divided by rho in
-            // nucleati
-            nihf(kk) *= air_density;
-            niimm(kk) *= air_density;
-            nidep(kk) *= air_density;
-            nimey(kk) *= air_density;
-
-          } // end temp
-        }); // kokkos::parfor(k)
+    const auto compute_level = [&](const int kk) {
+      const Real temp = atmosphere.temperature(kk);
+      if (temp < tmelt_m_five) {
+
+        const Real zero = 0;
+        const Real half = 0.5;
+        const Real sqrt_two = haero::sqrt(2.0);
+
+        const Real pmid = atmosphere.pressure(kk);
+        const Real air_density = conversions::density_of_ideal_gas(temp, pmid);
+
+        // CHECK if this part of code is consistent with original code.
+        // relative humidity [unitless]
+        Real qv = atmosphere.vapor_mixing_ratio(kk);
+        // very low temperature produces inf relhum
+        Real es = zero;
+        Real qs = zero;
+
+        wv_sat_methods::wv_sat_qsat_water(temp, pmid, es, qs);
+        const Real relhum = qv / qs;
+        const Real icldm = haero::max(ast(kk), mincld);
+
+        // compute aerosol number for so4, soot, and dust with units #/cm^3
+        // remove soot number, because it is set to zero
+        Real so4_num = zero;
+        Real dst3_num = zero;
+
+        /* For modal aerosols, assume for the upper troposphere:
+        soot = accumulation mode
+        sulfate = aitken mode
+        dust = coarse mode
+        since modal has internal mixtures. */
+        Real dmc = coarse_dust(kk) * air_density;
+        Real ssmc = coarse_nacl(kk) * air_density;
+        Real so4mc = coarse_so4(kk) * air_density;
+
+        Real mommc = coarse_mom(kk) * air_density;
+        Real bcmc = coarse_bc(kk) * air_density;
+        Real pommc = coarse_pom(kk) * air_density;
+        Real soamc = coarse_soa(kk) * air_density;
+
+        if (dmc > zero) {
+          const Real wght =
+              dmc / (ssmc + dmc + so4mc + bcmc + pommc + soamc + mommc);
+          dst3_num = wght * num_coarse(kk) * air_density * num_m3_to_cm3;
+        } // end dmc
+
+        if (dgnum_aitken(kk) > zero) {
+          // only allow so4 with D > 0.1 um in ice nucleation
+          so4_num =
+              num_aitken(kk) * air_density * num_m3_to_cm3 *
+              (half - half * haero::erf(haero::log(so4_sz_thresh_icenuc /
+                                                   dgnum_aitken(kk)) /
+                                        (sqrt_two * alnsg_amode_aitken)));
+        } // end dgnum_aitken
+
+        so4_num = haero::max(zero, so4_num);
+
+        // Real naai = zero;
+
+        nucleati(wsubi(kk), temp, pmid, relhum, icldm, air_density, so4_num,
+                 dst3_num, subgrid,
+                 // outputs
+                 naai(kk), nihf(kk), niimm(kk), nidep(kk), nimey(kk));
+
+        // QUESTION why nihf instead of naai
+        naai_hom(kk) = nihf(kk);
+        // is naai not saved?
+
+        // output activated ice (convert from #/kg -> #/m3)
+        // QUESTION: note that these variables are divided by rho in
+        // nucleati
+        nihf(kk) *= air_density;
+        niimm(kk) *= air_density;
+        nidep(kk) *= air_density;
+        nimey(kk) *= air_density;
+
+      } // end temp
+    };
+
+    if (config_.compact_levels) {
+      const ActiveLevels active(team, nk, [&](const int kk) {
+        return atmosphere.temperature(kk) < tmelt_m_five;
+      });
+      config_.level_stats.record(team, active);
+      active.for_each(team, compute_level);
+    } else {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nk), compute_level);
+    }
   }
 
 public:
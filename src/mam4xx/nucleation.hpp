@@ -8,14 +8,19 @@
 
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/conversions.hpp>
+#include <mam4xx/level_compaction.hpp>
 #include <mam4xx/mam4_types.hpp>
 #include <mam4xx/merikanto2007.hpp>
 #include <mam4xx/vehkamaki2002.hpp>
 #include <mam4xx/wang2008.hpp>
 
+#include <ekat/ekat_assert.hpp>
 #include <haero/atmosphere.hpp>
 #include <haero/math.hpp>
 
+#include <cstring>
+#include <fstream>
+
 namespace mam4 {
 
 using haero::cube;
@@ -207,6 +212,337 @@ void ternary_nuc_merik2007(Real t, Real rh, Real c2, Real c3, Real &j_log,
   }
 }
 
+//-----------------------------------------------------------------------------
+// Tabulated nucleation rates
+//
+// The binary and ternary parameterizations above can be tabulated at
+// Nucleation::init (see Nucleation::Config::tabulate_rates) and interpolated
+// multilinearly at run time, with the analytic fits used wherever a point lies
+// outside a table. Since mer07_veh02_wang08_nuc_1box bounds its inputs to the
+// limits of validity of the fits, the tables span exactly those limits.
+//-----------------------------------------------------------------------------
+
+/// NucleationRateGrid gives the number of points along each dimension of the
+/// nucleation tables. Temperature and relative humidity (log-spaced for the
+/// binary table) are tabulated along with the logarithms of the H2SO4
+/// concentration and NH3 mixing ratio.
+struct NucleationRateGrid {
+  // binary table: (temp, rh, so4vol) in [230.15, 305.15] K x [1e-4, 1] x
+  // [1e4, 1e11] molecules/cm3
+  int binary_num_temperatures = 16;
+  int binary_num_relative_humidities = 25;
+  int binary_num_so4vols = 36;
+  // ternary table: (temp, rh, so4vol, nh3ppt) in [235, 295] K x [0.05, 0.95]
+  // x [5e4, 1e9] molecules/cm3 x [0.1, 1e3] ppt
+  int ternary_num_temperatures = 13;
+  int ternary_num_relative_humidities = 19;
+  int ternary_num_so4vols = 21;
+  int ternary_num_nh3ppts = 17;
+};
+
+/// NucleationRateTable holds values tabulated on a regular grid of up to 4
+/// dimensions, each of which may be log-spaced, and interpolates them
+/// multilinearly. The first value at each point is the logarithm of the
+/// nucleation rate. If has_gaps is set, points at which no nucleation occurs
+/// (marked by the log rate of -300 set by ternary_nuc_merik2007) are not
+/// interpolated across.
+struct NucleationRateTable {
+  static constexpr int max_dims = 4;
+  static constexpr int max_values = 5;
+  static constexpr Real no_nucleation = -300.0;
+
+  DeviceType::view_1d<const TableReal> data;
+  int num_dims = 0, num_values = 0;
+  bool has_gaps = false;
+  int n[max_dims] = {0, 0, 0, 0};
+  bool log_axis[max_dims] = {false, false, false, false};
+  // first point and spacing of each (possibly logarithmic) coordinate
+  Real lo[max_dims] = {0, 0, 0, 0};
+  Real dx[max_dims] = {1, 1, 1, 1};
+
+  KOKKOS_INLINE_FUNCTION
+  bool enabled() const { return data.data() != nullptr; }
+
+  /// Interpolates the values at the point x, returning false if the point is
+  /// outside the table or next to a point without nucleation.
+  KOKKOS_INLINE_FUNCTION
+  bool interpolate(const Real x[], Real values[]) const {
+    int i[max_dims];
+    Real w[max_dims];
+    for (int d = 0; d < num_dims; ++d) {
+      const Real xd = log_axis[d] ? haero::log(x[d]) : x[d];
+      const Real sd = (xd - lo[d]) / dx[d];
+      if (!(sd >= 0 && sd <= n[d] - 1))
+        return false;
+      i[d] = haero::min(static_cast<int>(sd), n[d] - 2);
+      w[d] = sd - i[d];
+    }
+    for (int v = 0; v < num_values; ++v)
+      values[v] = 0;
+    for (int c = 0; c < (1 << num_dims); ++c) {
+      Real wc = 1;
+      int offset = 0;
+      for (int d = 0; d < num_dims; ++d) {
+        const int cd = (c >> d) & 1;
+        wc *= cd ? w[d] : 1 - w[d];
+        offset = offset * n[d] + i[d] + cd;
+      }
+      offset *= num_values;
+      if (has_gaps && (data(offset) <= no_nucleation))
+        return false;
+      for (int v = 0; v < num_values; ++v)
+        values[v] += wc * data(offset + v);
+    }
+    return true;
+  }
+};
+
+/// NucleationTables holds the tabulated binary and ternary nucleation rates.
+/// A default-constructed object holds no tables, so its methods return false.
+struct NucleationTables {
+  // (temp, rh, so4vol) -> rateloge, cnum_h2so4, cnum_tot, radius_cluster
+  NucleationRateTable binary;
+  // (temp, rh, so4vol, nh3ppt) -> j_log, ntot, nacid, namm, r
+  NucleationRateTable ternary;
+
+  /// Interpolates the outputs of binary_nuc_vehk2002, returning false if
+  /// they must be computed analytically.
+  KOKKOS_INLINE_FUNCTION
+  bool binary_nuc(Real temp, Real rh, Real so4vol, Real &ratenucl,
+                  Real &rateloge, Real &cnum_h2so4, Real &cnum_tot,
+                  Real &radius_cluster) const {
+    if (!binary.enabled())
+      return false;
+    const Real x[3] = {temp, rh, so4vol};
+    Real v[NucleationRateTable::max_values];
+    if (!binary.interpolate(x, v))
+      return false;
+    rateloge = v[0];
+    ratenucl = exp(min(rateloge, log(1e38)));
+    cnum_h2so4 = v[1];
+    cnum_tot = v[2];
+    radius_cluster = v[3];
+    return true;
+  }
+
+  /// Interpolates the outputs of ternary_nuc_merik2007, returning false if
+  /// they must be computed analytically.
+  KOKKOS_INLINE_FUNCTION
+  bool ternary_nuc(Real t, Real rh, Real c2, Real c3, Real &j_log, Real &ntot,
+                   Real &nacid, Real &namm, Real &r) const {
+    if (!ternary.enabled())
+      return false;
+    const Real x[4] = {t, rh, c2, c3};
+    Real v[NucleationRateTable::max_values];
+    if (!ternary.interpolate(x, v))
+      return false;
+    j_log = v[0];
+    ntot = v[1];
+    nacid = v[2];
+    namm = v[3];
+    r = v[4];
+    return true;
+  }
+};
+
+namespace detail {
+
+// identifies files written by write_nucleation_tables
+constexpr char nucleation_table_magic[] = "mam4xx nucleation tables 2";
+
+// version of the fits tabulated by create_nucleation_tables; increment it
+// whenever binary_nuc_vehk2002 or ternary_nuc_merik2007 change, so that
+// cached tables computed with the old fits are not read back
+constexpr int nucleation_fit_version = 1;
+
+// NucleationTableHeader describes the tables held by a nucleation table file.
+// Tables are read back only from a file whose header matches the expected one.
+struct NucleationTableHeader {
+  int table_real_size = sizeof(TableReal);
+  int fit_version = nucleation_fit_version;
+  NucleationRateGrid grid;
+  // bounds of the binary (temp, rh, so4vol) and ternary (temp, rh, so4vol,
+  // nh3ppt) tables
+  Real binary_lo[3] = {230.15, 1.0e-4, 1.0e4};
+  Real binary_hi[3] = {305.15, 1.0, 1.0e11};
+  Real ternary_lo[4] = {235.0, 0.05, 5.0e4, 0.1};
+  Real ternary_hi[4] = {295.0, 0.95, 1.0e9, 1.0e3};
+};
+
+// Calls f(data, size) on each field of a nucleation table file header, in the
+// order in which they are stored.
+template <typename Header, typename F>
+void for_each_nucleation_table_field(Header &header, F &&f) {
+  f(&header.table_real_size, sizeof(header.table_real_size));
+  f(&header.fit_version, sizeof(header.fit_version));
+  f(&header.grid, sizeof(header.grid));
+  f(header.binary_lo, sizeof(header.binary_lo));
+  f(header.binary_hi, sizeof(header.binary_hi));
+  f(header.ternary_lo, sizeof(header.ternary_lo));
+  f(header.ternary_hi, sizeof(header.ternary_hi));
+}
+
+// Sets up the dimensions of a nucleation table with the given numbers of
+// points and bounds, returning the number of points in the table.
+inline int setup_nucleation_table(NucleationRateTable &table, const int nd,
+                                  const int nv, const int n[],
+                                  const Real lo[], const Real hi[],
+                                  const bool log_axis[]) {
+  table.num_dims = nd;
+  table.num_values = nv;
+  int npts = 1;
+  for (int d = 0; d < nd; ++d) {
+    EKAT_REQUIRE_MSG(n[d] >= 2, "NucleationRateGrid: at least 2 points are "
+                                "needed along each dimension");
+    table.n[d] = n[d];
+    table.log_axis[d] = log_axis[d];
+    table.lo[d] = log_axis[d] ? haero::log(lo[d]) : lo[d];
+    const Real x_hi = log_axis[d] ? haero::log(hi[d]) : hi[d];
+    table.dx[d] = (x_hi - table.lo[d]) / (n[d] - 1);
+    npts *= n[d];
+  }
+  return npts;
+}
+
+// Returns the coordinates of point ipt of the given table.
+inline void nucleation_table_point(const NucleationRateTable &table, int ipt,
+                                   Real x[]) {
+  for (int d = table.num_dims - 1; d >= 0; --d) {
+    const Real xd = table.lo[d] + (ipt % table.n[d]) * table.dx[d];
+    x[d] = table.log_axis[d] ? haero::exp(xd) : xd;
+    ipt /= table.n[d];
+  }
+}
+
+// Returns true if the two headers describe the same tables. The bounds are
+// compared bitwise, since tables are only reused for identical grids.
+inline bool same_nucleation_table_header(const NucleationTableHeader &a,
+                                         const NucleationTableHeader &b) {
+  return a.table_real_size == b.table_real_size &&
+         a.fit_version == b.fit_version &&
+         !std::memcmp(&a.grid, &b.grid, sizeof(a.grid)) &&
+         !std::memcmp(a.binary_lo, b.binary_lo, sizeof(a.binary_lo)) &&
+         !std::memcmp(a.binary_hi, b.binary_hi, sizeof(a.binary_hi)) &&
+         !std::memcmp(a.ternary_lo, b.ternary_lo, sizeof(a.ternary_lo)) &&
+         !std::memcmp(a.ternary_hi, b.ternary_hi, sizeof(a.ternary_hi));
+}
+
+// Reads the values of the binary and ternary tables from the given file,
+// returning false if it does not exist or its header does not match the
+// given one (tables for another grid, other bounds, other fits or another
+// TableReal).
+inline bool read_nucleation_tables(const char *filename,
+                                   const NucleationTableHeader &header,
+                                   TableReal *binary, const int binary_size,
+                                   TableReal *ternary, const int ternary_size) {
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    return false;
+  char magic[sizeof(nucleation_table_magic)];
+  file.read(magic, sizeof(magic));
+  if (!file || std::memcmp(magic, nucleation_table_magic, sizeof(magic)))
+    return false;
+  NucleationTableHeader file_header;
+  for_each_nucleation_table_field(
+      file_header, [&](void *data, const std::size_t size) {
+        file.read(reinterpret_cast<char *>(data), size);
+      });
+  if (!file || !same_nucleation_table_header(file_header, header))
+    return false;
+  file.read(reinterpret_cast<char *>(binary),
+            binary_size * sizeof(TableReal));
+  file.read(reinterpret_cast<char *>(ternary),
+            ternary_size * sizeof(TableReal));
+  return bool(file);
+}
+
+// Writes the given header and the values of the binary and ternary tables to
+// the given file.
+inline void write_nucleation_tables(const char *filename,
+                                    const NucleationTableHeader &header,
+                                    const TableReal *binary,
+                                    const int binary_size,
+                                    const TableReal *ternary,
+                                    const int ternary_size) {
+  std::ofstream file(filename, std::ios::binary);
+  EKAT_REQUIRE_MSG(file, "Could not open nucleation table file "
+                             << filename << " for writing");
+  file.write(nucleation_table_magic, sizeof(nucleation_table_magic));
+  for_each_nucleation_table_field(
+      header, [&](const void *data, const std::size_t size) {
+        file.write(reinterpret_cast<const char *>(data), size);
+      });
+  file.write(reinterpret_cast<const char *>(binary),
+             binary_size * sizeof(TableReal));
+  file.write(reinterpret_cast<const char *>(ternary),
+             ternary_size * sizeof(TableReal));
+  EKAT_REQUIRE_MSG(file, "Could not write nucleation table file " << filename);
+}
+
+} // namespace detail
+
+/// Tabulates the binary and ternary nucleation rates on the given grid. If
+/// cache_file is given, the tables are read from it if it holds tables for
+/// the same grid, bounds and fits, and are written to it otherwise.
+inline NucleationTables
+create_nucleation_tables(const NucleationRateGrid &grid,
+                         const char *cache_file = nullptr) {
+  NucleationTables tables;
+  detail::NucleationTableHeader header;
+  header.grid = grid;
+  const int nb[3] = {grid.binary_num_temperatures,
+                     grid.binary_num_relative_humidities,
+                     grid.binary_num_so4vols};
+  const bool logb[3] = {false, true, true};
+  const int npts_b = detail::setup_nucleation_table(
+      tables.binary, 3, 4, nb, header.binary_lo, header.binary_hi, logb);
+  const int nt[4] = {
+      grid.ternary_num_temperatures, grid.ternary_num_relative_humidities,
+      grid.ternary_num_so4vols, grid.ternary_num_nh3ppts};
+  const bool logt[4] = {false, false, true, true};
+  const int npts_t = detail::setup_nucleation_table(
+      tables.ternary, 4, 5, nt, header.ternary_lo, header.ternary_hi, logt);
+  tables.ternary.has_gaps = true;
+
+  DeviceType::view_1d<TableReal> binary_data("nucleation_binary_table",
+                                             npts_b * 4);
+  DeviceType::view_1d<TableReal> ternary_data("nucleation_ternary_table",
+                                              npts_t * 5);
+  auto binary = Kokkos::create_mirror_view(binary_data);
+  auto ternary = Kokkos::create_mirror_view(ternary_data);
+  if (!cache_file ||
+      !detail::read_nucleation_tables(cache_file, header, binary.data(),
+                                      npts_b * 4, ternary.data(),
+                                      npts_t * 5)) {
+    for (int ipt = 0; ipt < npts_b; ++ipt) {
+      Real x[3], ratenucl, rateloge, cnum_h2so4, cnum_tot, radius_cluster;
+      detail::nucleation_table_point(tables.binary, ipt, x);
+      binary_nuc_vehk2002(x[0], x[1], x[2], ratenucl, rateloge, cnum_h2so4,
+                          cnum_tot, radius_cluster);
+      const Real v[4] = {rateloge, cnum_h2so4, cnum_tot, radius_cluster};
+      for (int iv = 0; iv < 4; ++iv)
+        binary(ipt * 4 + iv) = v[iv];
+    }
+    for (int ipt = 0; ipt < npts_t; ++ipt) {
+      Real x[4], j_log, ntot = 0, nacid = 0, namm = 0, r = 0;
+      detail::nucleation_table_point(tables.ternary, ipt, x);
+      ternary_nuc_merik2007(x[0], x[1], x[2], x[3], j_log, ntot, nacid, namm,
+                            r);
+      const Real v[5] = {j_log, ntot, nacid, namm, r};
+      for (int iv = 0; iv < 5; ++iv)
+        ternary(ipt * 5 + iv) = v[iv];
+    }
+    if (cache_file)
+      detail::write_nucleation_tables(cache_file, header, binary.data(),
+                                      npts_b * 4, ternary.data(), npts_t * 5);
+  }
+  Kokkos::deep_copy(binary_data, binary);
+  Kokkos::deep_copy(ternary_data, ternary);
+  tables.binary.data = binary_data;
+  tables.ternary.data = ternary_data;
+  return tables;
+}
+
 //-----------------------------------------------------------------------------
 // Calculates new particle production from homogeneous nucleation
 // using nucleation rates from either
@@ -230,6 +566,9 @@ void ternary_nuc_merik2007(Real t, Real rh, Real c2, Real c3, Real &j_log,
 //   Aerosol indirect forcing in a global model with particle nucleation,
 //   Atmos. Chem. Phys. Discuss., 8, 13943-13998
 //   Atmos. Chem. Phys.  9, 239-260, 2009
+//
+// The binary and ternary rates are interpolated from the given tables, if
+// any.
 KOKKOS_INLINE_FUNCTION
 void mer07_veh02_wang08_nuc_1box(int newnuc_method_user_choice,
                                  int &newnuc_method_actual,        // in, out
@@ -242,8 +581,10 @@ void mer07_veh02_wang08_nuc_1box(int newnuc_method_user_choice,
                                  Real temp_in, Real rh_in, Real zm_in,
                                  Real pblh_in, // in
                                  Real &dnclusterdt, Real &rateloge,
-                                 Real &cnum_h2so4,                       // out
-                                 Real &cnum_nh3, Real &radius_cluster) { // out
+                                 Real &cnum_h2so4,                     // out
+                                 Real &cnum_nh3, Real &radius_cluster, // out
+                                 const NucleationTables &tables =
+                                     NucleationTables()) {
 
   Real rh_bb;     // bounded value of rh_in
   Real so4vol_bb; // bounded value of so4vol_in (molecules per cm3)
@@ -271,8 +612,10 @@ void mer07_veh02_wang08_nuc_1box(int newnuc_method_user_choice,
       rh_bb = max(0.05, min(0.95, rh_in));
       so4vol_bb = max(5.0e4, min(1.0e9, so4vol_in));
       nh3ppt_bb = max(0.1, min(1.0e3, nh3ppt_in));
-      ternary_nuc_merik2007(temp_bb, rh_bb, so4vol_bb, nh3ppt_bb, rateloge,
-                            cnum_tot, cnum_h2so4, cnum_nh3, radius_cluster);
+      if (!tables.ternary_nuc(temp_bb, rh_bb, so4vol_bb, nh3ppt_bb, rateloge,
+                              cnum_tot, cnum_h2so4, cnum_nh3, radius_cluster))
+        ternary_nuc_merik2007(temp_bb, rh_bb, so4vol_bb, nh3ppt_bb, rateloge,
+                              cnum_tot, cnum_h2so4, cnum_nh3, radius_cluster);
     }
     newnuc_method_actual = 3;
   } else {
@@ -283,8 +626,10 @@ void mer07_veh02_wang08_nuc_1box(int newnuc_method_user_choice,
       temp_bb = max(230.15, min(305.15, temp_in));
       rh_bb = max(1.0e-4, min(1.0, rh_in));
       so4vol_bb = max(1.0e4, min(1.0e11, so4vol_in));
-      binary_nuc_vehk2002(temp_bb, rh_bb, so4vol_bb, ratenuclt, rateloge,
-                          cnum_h2so4, cnum_tot, radius_cluster);
+      if (!tables.binary_nuc(temp_bb, rh_bb, so4vol_bb, ratenuclt, rateloge,
+                             cnum_h2so4, cnum_tot, radius_cluster))
+        binary_nuc_vehk2002(temp_bb, rh_bb, so4vol_bb, ratenuclt, rateloge,
+                            cnum_h2so4, cnum_tot, radius_cluster);
     }
     cnum_nh3 = 0.0;
     newnuc_method_actual = 2;
@@ -604,6 +949,33 @@ public:
     Real accom_coef_h2so4;
     Real newnuc_adjust_factor_dnaitdt;
 
+    // if true, tendencies are computed only on levels with enough H2SO4 to
+    // nucleate, and are set to zero elsewhere (see level_compaction.hpp).
+    // The launch must then request ActiveLevels::scratch_size(nlev) bytes of
+    // level 0 team scratch memory.
+    bool compact_levels;
+    // if enabled, records the fraction of levels on which nucleation acts
+    // (used only with compact_levels)
+    LevelCompactionStats level_stats;
+
+    // if true, init tabulates the binary and ternary nucleation rates on
+    // rate_grid, and they are interpolated instead of evaluated
+    bool tabulate_rates;
+    nucleation::NucleationRateGrid rate_grid;
+    // if not null, the file from which the tables are read if it holds
+    // tables for rate_grid, and to which they are written otherwise
+    const char *rate_table_file;
+
+    // if true, the H2SO4 uptake rate used to compute the growth of new
+    // particles is the one cached in Prognostics::uptkaer by gas-aerosol
+    // exchange (summed over modes), rather than zero
+    bool use_cached_uptake_rate;
+
+    // if true and MAM4XX_ENABLE_NH3 is defined, NH3 takes part in nucleation
+    // (ternary H2SO4-NH3-H2O nucleation with newnuc_method_user_choice = 3,
+    // and NH4 in the new particles). Otherwise NH3 is ignored.
+    bool do_nh3;
+
     // default constructor -- sets default values for parameters
     KOKKOS_INLINE_FUNCTION
     Config()
@@ -611,7 +983,9 @@ public:
           mw_so4a_host(mw_so4a), newnuc_method_user_choice(2),
           pbl_nuc_wang2008_user_choice(1), adjust_factor_bin_tern_ratenucl(1.0),
           adjust_factor_pbl_ratenucl(1.0), accom_coef_h2so4(1.0),
-          newnuc_adjust_factor_dnaitdt(1.0) {}
+          newnuc_adjust_factor_dnaitdt(1.0), compact_levels(false),
+          tabulate_rates(false), rate_table_file(nullptr),
+          use_cached_uptake_rate(false), do_nh3(true) {}
 
     KOKKOS_INLINE_FUNCTION
     Config(const Config &) = default;
@@ -627,17 +1001,30 @@ private:
   static constexpr int max_num_mode_species = AeroConfig::num_aerosol_ids();
   static const int nait = static_cast<int>(ModeIndex::Aitken);
   static const int igas_h2so4 = static_cast<int>(GasId::H2SO4);
+#ifdef MAM4XX_ENABLE_NH3
+  static const int igas_nh3 = static_cast<int>(GasId::NH3);
+  static const int iaer_nh4 = static_cast<int>(AeroId::NH4);
+#else
   // Turn off NH3. Any negative number would turn it off, this is what is
   // used in the mam_refactor code.
-  static const int igas_nh3 = -999888777; // static_cast<int>(GasId::NH3);
+  static const int igas_nh3 = -999888777;
+  static const int iaer_nh4 = -999888777;
+#endif
 
   static constexpr Real mw_so4a = 96.0;              // BAD_CONSTANT
   static constexpr Real mw_nh4a = 18.0;              // BAD_CONSTANT
   static constexpr Real pi = 3.14159265358979323846; // BAD_CONSTANT
 
+  // min h2so4 vapor for nuc calcs = 4.0e-16 mol/mol-air ~= 1.0e4
+  // molecules/cm3
+  static constexpr Real qh2so4_cutoff = 4.0e-16;
+
   // Nucleation-specific configuration
   Config config_;
 
+  // tabulated nucleation rates (if config_.tabulate_rates is set)
+  nucleation::NucleationTables tables_;
+
   // Mode parameters
   Real dgnum_aer[num_modes],  // mean geometric number diameter
       dgnumhi_aer[num_modes], // max geometric number diameter
@@ -649,11 +1036,14 @@ public:
 
   // init -- initializes the implementation with MAM4's configuration and with
   // a process-specific configuration.
-  KOKKOS_INLINE_FUNCTION
   void init(const AeroConfig &aero_config,
             const Config &nucl_config = Config()) {
     // Set nucleation-specific config parameters.
     config_ = nucl_config;
+    if (config_.tabulate_rates) {
+      tables_ = nucleation::create_nucleation_tables(config_.rate_grid,
+                                                     config_.rate_table_file);
+    }
 
     // Set mode parameters.
     for (int m = 0; m < num_modes; ++m) {
@@ -680,6 +1070,11 @@ public:
            progs.quantities_nonnegative(team);
   }
 
+  // nh3_enabled -- returns true if NH3 takes part in nucleation, i.e. if
+  // MAM4XX_ENABLE_NH3 is defined and config.do_nh3 is set
+  KOKKOS_INLINE_FUNCTION
+  bool nh3_enabled() const { return (igas_nh3 > 0) && config_.do_nh3; }
+
   // compute_tendencies -- computes tendencies and updates diagnostics
   // NOTE: that both diags and tends are const below--this means their views
   // NOTE: are fixed, but the data in those views is allowed to vary.
@@ -696,49 +1091,84 @@ public:
         6.02214e26; // BAD_CONSTANT (Avogadro's number ~ molecules/kmole)
     static constexpr Real r_universal = boltzmann * avogadro; // BAD_CONSTANT
     const int nk = atm.num_levels();
-    Kokkos::parallel_for(
-        Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int k) {
-          // extract atmospheric state
-          Real temp = atm.temperature(k);
-          Real pmid = atm.pressure(k);
-          Real aircon = pmid / (r_universal * temp);
-          Real zmid = atm.height(k);
-          Real pblh = atm.planetary_boundary_layer_height;
-          Real qv = atm.vapor_mixing_ratio(k);
-          Real relhum = conversions::relative_humidity_from_vapor_mixing_ratio(
-              qv, temp, pmid);
-          Real uptkrate_so4 = 0;
-          Real del_h2so4_gasprod = 0;
-          Real del_h2so4_aeruptk = 0;
-
-          // extract relevant gas mixing ratios (H2SO4 only for now)
-          Real qgas_cur[num_gases], qgas_avg[num_gases];
-          qgas_cur[igas_h2so4] = progs.q_gas[igas_h2so4](k);
-          qgas_avg[igas_h2so4] =
-              progs.q_gas[igas_h2so4](k); // is this good enough?
-
-          // extract relevant aerosol mixing ratios (SO4 in aitken mode only for
-          // now)
-          Real qnum_cur[num_modes], qaer_cur[num_modes][max_num_mode_species];
-          qnum_cur[nait] = progs.n_mode_i[nait](k);
-          qaer_cur[nait][iaer_so4] = progs.q_aero_i[nait][iaer_so4](k);
-
-          Real qwtr_cur[num_modes] = {}; // water vapor mmr
-          qwtr_cur[nait] = qv;
-
-          // compute tendencies at this level
-          Real dndt_ait, dmdt_ait, dso4dt_ait, dnh4dt_ait, dnclusterdt;
-          compute_tendencies_(dt, temp, pmid, aircon, zmid, pblh, relhum,
-                              uptkrate_so4, del_h2so4_gasprod,
-                              del_h2so4_aeruptk, qgas_cur, qgas_avg, qnum_cur,
-                              qaer_cur, qwtr_cur, dndt_ait, dmdt_ait,
-                              dso4dt_ait, dnh4dt_ait, dnclusterdt);
-
-          // Store the computed tendencies.
-          tends.n_mode_i[nait](k) = dndt_ait;
-          tends.q_aero_i[nait][iaer_so4](k) = dso4dt_ait;
-          tends.q_gas[igas_h2so4](k) = -dso4dt_ait;
-        });
+    const auto compute_level = [&](const int k) {
+      // extract atmospheric state
+      Real temp = atm.temperature(k);
+      Real pmid = atm.pressure(k);
+      Real aircon = pmid / (r_universal * temp);
+      Real zmid = atm.height(k);
+      Real pblh = atm.planetary_boundary_layer_height;
+      Real qv = atm.vapor_mixing_ratio(k);
+      Real relhum = conversions::relative_humidity_from_vapor_mixing_ratio(
+          qv, temp, pmid);
+      Real uptkrate_so4 = 0;
+      if (config_.use_cached_uptake_rate) {
+        for (int n = 0; n < num_modes; ++n)
+          uptkrate_so4 += progs.uptkaer[igas_h2so4][n](k);
+      }
+      Real del_h2so4_gasprod = 0;
+      Real del_h2so4_aeruptk = 0;
+
+      // extract relevant gas mixing ratios (H2SO4 only for now)
+      Real qgas_cur[num_gases], qgas_avg[num_gases];
+      qgas_cur[igas_h2so4] = progs.q_gas[igas_h2so4](k);
+      qgas_avg[igas_h2so4] = progs.q_gas[igas_h2so4](k); // is this good enough?
+#ifdef MAM4XX_ENABLE_NH3
+      if (nh3_enabled())
+        qgas_cur[igas_nh3] = progs.q_gas[igas_nh3](k);
+#endif
+
+      // extract relevant aerosol mixing ratios (SO4 in aitken mode only for
+      // now)
+      Real qnum_cur[num_modes], qaer_cur[num_modes][max_num_mode_species];
+      qnum_cur[nait] = progs.n_mode_i[nait](k);
+      qaer_cur[nait][iaer_so4] = progs.q_aero_i[nait][iaer_so4](k);
+
+      Real qwtr_cur[num_modes] = {}; // water vapor mmr
+      qwtr_cur[nait] = qv;
+
+      // compute tendencies at this level
+      Real dndt_ait, dmdt_ait, dso4dt_ait, dnh4dt_ait, dnclusterdt;
+      compute_tendencies_(dt, temp, pmid, aircon, zmid, pblh, relhum,
+                          uptkrate_so4, del_h2so4_gasprod, del_h2so4_aeruptk,
+                          qgas_cur, qgas_avg, qnum_cur, qaer_cur, qwtr_cur,
+                          dndt_ait, dmdt_ait, dso4dt_ait, dnh4dt_ait,
+                          dnclusterdt);
+
+      // Store the computed tendencies.
+      tends.n_mode_i[nait](k) = dndt_ait;
+      tends.q_aero_i[nait][iaer_so4](k) = dso4dt_ait;
+      tends.q_gas[igas_h2so4](k) = -dso4dt_ait;
+#ifdef MAM4XX_ENABLE_NH3
+      if (nh3_enabled()) {
+        tends.q_aero_i[nait][iaer_nh4](k) = dnh4dt_ait;
+        tends.q_gas[igas_nh3](k) = -dnh4dt_ait;
+      }
+#endif
+    };
+
+    if (config_.compact_levels) {
+      // nucleation happens only where the H2SO4 mixing ratio exceeds
+      // qh2so4_cutoff, and the tendencies vanish elsewhere
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nk), [&](int k) {
+        tends.n_mode_i[nait](k) = 0;
+        tends.q_aero_i[nait][iaer_so4](k) = 0;
+        tends.q_gas[igas_h2so4](k) = 0;
+#ifdef MAM4XX_ENABLE_NH3
+        if (nh3_enabled()) {
+          tends.q_aero_i[nait][iaer_nh4](k) = 0;
+          tends.q_gas[igas_nh3](k) = 0;
+        }
+#endif
+      });
+      const ActiveLevels active(team, nk, [&](const int k) {
+        return progs.q_gas[igas_h2so4](k) > qh2so4_cutoff;
+      });
+      config_.level_stats.record(team, active);
+      active.for_each(team, compute_level);
+    } else {
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nk), compute_level);
+    }
   }
 
   // This function computes relevant tendencies at a single vertical level. It
@@ -760,10 +1190,6 @@ public:
     static constexpr Real rgas = boltzmann * avogadro; // [J/K/mol] BAD_CONSTANT
     static constexpr Real ln_nuc_rate_cutoff = -13.82;
 
-    // min h2so4 vapor for nuc calcs = 4.0e-16 mol/mol-air ~= 1.0e4
-    // molecules/cm3
-    static constexpr Real qh2so4_cutoff = 4.0e-16;
-
     int newnuc_method_actual, pbl_nuc_wang2008_actual;
 
     constexpr int nsize = 1;
@@ -832,7 +1258,7 @@ public:
       return;
     }
 
-    if (igas_nh3 > 0) {
+    if (nh3_enabled()) {
       qnh3_cur = max(0.0, qgas_cur[igas_nh3]);
     } else {
       qnh3_cur = 0.0;
@@ -867,7 +1293,8 @@ public:
           ln_nuc_rate_cutoff,                                    // in
           adjust_factor_bin_tern_ratenucl, adjust_factor_pbl_ratenucl,  // in
           pi, so4vol, nh3ppt, temp, relhumnn, zmid, pblh,               // in
-          dnclusterdt, rateloge, cnum_h2so4, cnum_nh3, radius_cluster); // out
+          dnclusterdt, rateloge, cnum_h2so4, cnum_nh3, radius_cluster, // out
+          tables_);
 
     } else {
       rateloge = ln_nuc_rate_cutoff;
@@ -922,7 +1349,7 @@ public:
 
     // fraction of mass nuc going to so4
     tmpa = qso4a_del * mw_so4a_host;
-    if (igas_nh3 > 0) {
+    if (nh3_enabled()) {
       tmpb = tmpa + qnh4a_del * mw_nh4a_host;
       tmp_frso4 = max(tmpa, 1.0e-35) / max(tmpb, 1.0e-35);
     } else {
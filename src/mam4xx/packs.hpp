@@ -0,0 +1,79 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_PACKS_HPP
+#define MAM4XX_PACKS_HPP
+
+// This header defines the SIMD pack types used by level-vectorized kernels,
+// along with helpers for writing kernels that accept either a scalar or a
+// pack of vertical levels.
+
+#include <mam4xx/aero_config.hpp>
+#include <mam4xx/mam4_types.hpp>
+
+#include <ekat/ekat_pack.hpp>
+
+namespace mam4 {
+
+/// A pack of pack_size vertical levels (see aero_config.hpp)
+using PackType = ekat::Pack<Real, pack_size>;
+
+/// Information about the packing of a column's vertical levels
+using PackInfo = ekat::PackInfo<pack_size>;
+
+/// PackTraits provides uniform access to the lanes of scalars and packs, so
+/// that a kernel templated on its value type can handle the (few) operations
+/// that must be done lane by lane, such as table lookups.
+template <typename T> struct PackTraits {
+  using scalar_type = T;
+  using int_type = int;
+  static constexpr int size = 1;
+
+  KOKKOS_INLINE_FUNCTION
+  static scalar_type &lane(T &v, const int) { return v; }
+
+  KOKKOS_INLINE_FUNCTION
+  static const scalar_type &lane(const T &v, const int) { return v; }
+};
+
+template <typename T, int N> struct PackTraits<ekat::Pack<T, N>> {
+  using scalar_type = T;
+  using int_type = ekat::Pack<int, N>;
+  static constexpr int size = N;
+
+  KOKKOS_INLINE_FUNCTION
+  static scalar_type &lane(ekat::Pack<T, N> &v, const int i) { return v[i]; }
+
+  KOKKOS_INLINE_FUNCTION
+  static const scalar_type &lane(const ekat::Pack<T, N> &v, const int i) {
+    return v[i];
+  }
+};
+
+/// Loads the levels of the given pack from a column. Lanes past the last
+/// level of the column are filled with the value at the last level, so that
+/// computations on a partially filled pack stay finite.
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION PackType load_pack(const ViewType &column,
+                                          const int ipack, const int nlev) {
+  PackType p;
+  const int k0 = ipack * pack_size;
+  for (int s = 0; s < pack_size; ++s)
+    p[s] = column(k0 + s < nlev ? k0 + s : nlev - 1);
+  return p;
+}
+
+/// Stores the lanes of the given pack that correspond to levels of the column
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION void store_pack(const ViewType &column, const int ipack,
+                                       const int nlev, const PackType &p) {
+  const int k0 = ipack * pack_size;
+  for (int s = 0; s < pack_size && k0 + s < nlev; ++s)
+    column(k0 + s) = p[s];
+}
+
+} // namespace mam4
+
+#endif
@@ -0,0 +1,121 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_PROFILING_HPP
+#define MAM4XX_PROFILING_HPP
+
+// This header provides named profiling regions for the host-side launches of
+// MAM4 processes, and a host timer registry that accumulates the time spent
+// in each region. Both are enabled by configuring mam4xx with
+// MAM4XX_ENABLE_PROFILING=ON; otherwise MAM4XX_PROFILE_REGION expands to
+// nothing.
+//
+// Regions are pushed and popped on the host, so they must enclose kernel
+// launches, not code running inside a kernel. Since compute_tendencies and the
+// driver routines run inside kernels, they are profiled by their host launch
+// wrappers: compute_tendencies_for_columns names its region after the process,
+// and the per-function launchers built on for_each_column (see
+// column_batch.hpp), e.g. wetdep::aero_model_wetdep_for_columns or
+// mo_setsox::setsox_for_columns, name theirs after the function they run. The
+// regions are visible to any Kokkos Tools library (e.g. kp_space_time_stack),
+// and the timer registry can be dumped without one.
+
+#include <mam4xx/aero_config.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace mam4 {
+
+/// Cumulative host time and number of calls for a named region.
+struct TimerEntry {
+  double seconds = 0.0;
+  long calls = 0;
+};
+
+/// TimerRegistry accumulates the time spent in each named profiling region.
+/// It is a host-side singleton and is not thread-safe: regions should be
+/// entered from the thread that launches kernels.
+class TimerRegistry final {
+public:
+  /// Returns the registry.
+  static TimerRegistry &instance() {
+    static TimerRegistry registry;
+    return registry;
+  }
+
+  /// Adds the given elapsed time to the region with the given name.
+  void add(const std::string &name, const double seconds) {
+    auto &entry = entries_[name];
+    entry.seconds += seconds;
+    ++entry.calls;
+  }
+
+  /// Returns the entries of all regions entered so far, by name.
+  const std::map<std::string, TimerEntry> &entries() const { return entries_; }
+
+  /// Clears all entries.
+  void reset() { entries_.clear(); }
+
+  /// Writes a table of cumulative times and call counts to the given stream.
+  void report(std::ostream &out) const {
+    out << "mam4xx timers (region: seconds, calls)" << std::endl;
+    for (const auto &e : entries_) {
+      out << "  " << e.first << ": " << e.second.seconds << ", "
+          << e.second.calls << std::endl;
+    }
+  }
+
+private:
+  TimerRegistry() = default;
+  std::map<std::string, TimerEntry> entries_;
+};
+
+/// ScopedRegion pushes a named Kokkos profiling region on construction and
+/// pops it on destruction, recording the elapsed time in the TimerRegistry.
+/// The execution space is fenced before the timer stops, so the recorded time
+/// includes that of the kernels launched within the region.
+class ScopedRegion final {
+public:
+  explicit ScopedRegion(const std::string &name)
+      : name_(name), start_(std::chrono::steady_clock::now()) {
+    Kokkos::Profiling::pushRegion(name_);
+  }
+
+  ~ScopedRegion() {
+    Kokkos::fence();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start_;
+    Kokkos::Profiling::popRegion();
+    TimerRegistry::instance().add(name_, elapsed.count());
+  }
+
+  ScopedRegion(const ScopedRegion &) = delete;
+  ScopedRegion &operator=(const ScopedRegion &) = delete;
+
+private:
+  std::string name_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace mam4
+
+#define MAM4XX_PROFILE_CONCAT_(a, b) a##b
+#define MAM4XX_PROFILE_CONCAT(a, b) MAM4XX_PROFILE_CONCAT_(a, b)
+
+/// MAM4XX_PROFILE_REGION(name) profiles the rest of the enclosing (host) scope
+/// as a region with the given name.
+#ifdef MAM4XX_ENABLE_PROFILING
+#define MAM4XX_PROFILE_REGION(name)                                            \
+  ::mam4::ScopedRegion MAM4XX_PROFILE_CONCAT(mam4xx_region_, __LINE__)(name)
+#else
+#define MAM4XX_PROFILE_REGION(name)
+#endif
+
+#endif
@@ -0,0 +1,236 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_PROGNOSTICS_STORAGE_HPP
+#define MAM4XX_PROGNOSTICS_STORAGE_HPP
+
+// This header provides a backing store for Prognostics (and Tendencies) that
+// keeps all prognostic fields of a column in a single contiguous buffer.
+
+#include <mam4xx/aero_config.hpp>
+#include <mam4xx/mam4_types.hpp>
+#include <mam4xx/utils.hpp>
+
+#include <ekat/kokkos/ekat_subview_utils.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace mam4 {
+
+namespace detail {
+
+// Returns the number of species of mode m in the E3SM tracer layout, i.e. the
+// species of AeroConfig::num_species_in_mode(m) other than ammonium, which is
+// not part of state_q. This matches num_species_mode(m).
+KOKKOS_INLINE_FUNCTION
+constexpr int num_layout_species(const int m) {
+  int num_species = 0;
+  for (int s = 0; s < AeroConfig::num_species_in_mode(m); ++s) {
+#ifdef MAM4XX_ENABLE_NH3
+    if (AeroConfig::mode_species(m, s) == static_cast<int>(AeroId::NH4))
+      continue;
+#endif
+    ++num_species;
+  }
+  return num_species;
+}
+
+// Returns the number of (mode, species) pairs of the E3SM tracer layout.
+KOKKOS_INLINE_FUNCTION
+constexpr int num_layout_species() {
+  int num_species = 0;
+  for (int m = 0; m < AeroConfig::num_modes(); ++m)
+    num_species += num_layout_species(m);
+  return num_species;
+}
+
+// the species and number mixing ratios of all modes fill state_q after the
+// gases
+static_assert(utils::aero_start_ind() + num_layout_species() +
+                      AeroConfig::num_modes() ==
+                  pcnst,
+              "the mode species do not match the state_q layout");
+
+} // namespace detail
+
+/// PrognosticsStorage owns a single (ntracer x nlev) view holding every
+/// prognostic field of a column. Each tracer occupies a contiguous row, so the
+/// per-species column views of a Prognostics object created by prognostics()
+/// are zero-copy subviews of the buffer.
+///
+/// The rows are ordered as follows:
+/// * rows [0, pcnst) follow the E3SM state_q ordering used by
+///   utils::extract_stateq_from_prognostics (gases from
+///   utils::gasses_start_ind(), then the species and number mixing ratio of
+///   each mode from utils::aero_start_ind()). Rows for the water species
+///   (below utils::gasses_start_ind()) are not used by Prognostics.
+/// * rows [pcnst, 2*pcnst) follow the qqcw ordering of cloudborne aerosols
+///   used by utils::extract_qqcw_from_prognostics.
+/// * time-averaged gas mixing ratios, gas uptake rates, the aerosol
+///   species that are not present in a mode, and the gases that are not part
+///   of state_q (see utils::num_stateq_gasses()) come last.
+///
+/// With this ordering, state_q(k) and qqcw(k) return the state_q and qqcw
+/// arrays at level k as (strided) views into the buffer, so kernels can read
+/// and write them in place instead of copying them to and from the
+/// Prognostics object with the utils::extract_* / utils::inject_* functions.
+class PrognosticsStorage final {
+public:
+  /// (ntracer x nlev) view holding the prognostic fields of a column
+  using StorageView = DeviceType::view_2d<Real>;
+
+  /// view of all tracers (in state_q or qqcw order) at a single level
+  using LevelView = decltype(Kokkos::subview(
+      StorageView(), Kokkos::pair<int, int>(), 0));
+
+  /// Allocates storage for a column with the given number of vertical levels.
+  /// All fields are initialized to zero.
+  explicit PrognosticsStorage(int num_levels)
+      : data_("prognostics storage", num_tracers(), num_levels) {}
+
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsStorage() = default;
+  KOKKOS_INLINE_FUNCTION
+  ~PrognosticsStorage() = default;
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsStorage(const PrognosticsStorage &) = default;
+  KOKKOS_INLINE_FUNCTION
+  PrognosticsStorage &operator=(const PrognosticsStorage &) = default;
+
+  /// Returns the number of rows (tracers) in the buffer.
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int num_tracers() {
+    return 2 * pcnst + num_gas + num_gas * num_mode + 2 * num_absent_species +
+           num_extra_gas;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  int num_levels() const { return data_.extent(1); }
+
+  /// Returns the underlying (ntracer x nlev) buffer.
+  KOKKOS_INLINE_FUNCTION
+  const StorageView &data() const { return data_; }
+
+  /// Returns a Prognostics (or Tendencies) object whose views refer to the
+  /// data in this storage.
+  Prognostics prognostics() const {
+    Prognostics progs(num_levels());
+    for (int m = 0; m < num_mode; ++m) {
+      progs.n_mode_i[m] = ekat::subview(data_, num_index(m));
+      progs.n_mode_c[m] = ekat::subview(data_, pcnst + num_index(m));
+      for (int a = 0; a < num_aero; ++a) {
+        progs.q_aero_i[m][a] = ekat::subview(data_, aero_index(m, a));
+        progs.q_aero_c[m][a] =
+            ekat::subview(data_, cloudborne_aero_index(m, a));
+      }
+    }
+    for (int g = 0; g < num_gas; ++g) {
+      progs.q_gas[g] = ekat::subview(data_, gas_index(g));
+      progs.q_gas_avg[g] = ekat::subview(data_, gas_avg_index(g));
+      for (int m = 0; m < num_mode; ++m)
+        progs.uptkaer[g][m] = ekat::subview(data_, uptkaer_index(g, m));
+    }
+    return progs;
+  }
+
+  /// Returns the interstitial aerosol and gas mixing ratios at level k in
+  /// state_q order. Entries below utils::gasses_start_ind() are not used.
+  KOKKOS_INLINE_FUNCTION
+  LevelView state_q(const int k) const {
+    return Kokkos::subview(data_, Kokkos::pair<int, int>(0, pcnst), k);
+  }
+
+  /// Returns the cloudborne aerosol mixing ratios at level k in qqcw order.
+  /// Entries below utils::aero_start_ind() are not used.
+  KOKKOS_INLINE_FUNCTION
+  LevelView qqcw(const int k) const {
+    return Kokkos::subview(data_, Kokkos::pair<int, int>(pcnst, 2 * pcnst),
+                           k);
+  }
+
+  /// Returns the row of the mass mixing ratio of gas g.
+  KOKKOS_INLINE_FUNCTION
+  static int gas_index(const int g) {
+    return (g < utils::num_stateq_gasses())
+               ? utils::gasses_start_ind() + g
+               : extra_gas_start_index() + g - utils::num_stateq_gasses();
+  }
+
+  /// Returns the row of the interstitial number mixing ratio of mode m.
+  KOKKOS_INLINE_FUNCTION
+  static int num_index(const int m) {
+    return mode_start_index(m) + detail::num_layout_species(m);
+  }
+
+  /// Returns the row of the interstitial mass mixing ratio of the species
+  /// with index a within mode m.
+  KOKKOS_INLINE_FUNCTION
+  static int aero_index(const int m, const int a) {
+    return (a < detail::num_layout_species(m)) ? mode_start_index(m) + a
+                                               : absent_species_index(m, a);
+  }
+
+  /// Returns the row of the cloudborne mass mixing ratio of the species with
+  /// index a within mode m.
+  KOKKOS_INLINE_FUNCTION
+  static int cloudborne_aero_index(const int m, const int a) {
+    return (a < detail::num_layout_species(m))
+               ? pcnst + mode_start_index(m) + a
+               : absent_species_index(m, a) + num_absent_species;
+  }
+
+  /// Returns the row of the time-averaged mass mixing ratio of gas g.
+  KOKKOS_INLINE_FUNCTION
+  static int gas_avg_index(const int g) { return 2 * pcnst + g; }
+
+  /// Returns the row of the uptake rate of gas g into mode m.
+  KOKKOS_INLINE_FUNCTION
+  static int uptkaer_index(const int g, const int m) {
+    return 2 * pcnst + num_gas + g * num_mode + m;
+  }
+
+private:
+  static constexpr int num_mode = AeroConfig::num_modes();
+  static constexpr int num_aero = AeroConfig::num_aerosol_ids();
+  static constexpr int num_gas = AeroConfig::num_gas_ids();
+
+  // number of (mode, species) pairs for which the species is not present in
+  // the mode
+  static constexpr int num_absent_species =
+      num_mode * num_aero - detail::num_layout_species();
+
+  // number of gases that are not part of state_q
+  static constexpr int num_extra_gas = num_gas - utils::num_stateq_gasses();
+
+  // row of the first gas that is not part of state_q
+  KOKKOS_INLINE_FUNCTION
+  static constexpr int extra_gas_start_index() {
+    return 2 * pcnst + num_gas + num_gas * num_mode + 2 * num_absent_species;
+  }
+
+  // row of the first species of mode m in state_q order
+  KOKKOS_INLINE_FUNCTION
+  static int mode_start_index(const int m) {
+    int index = utils::aero_start_ind();
+    for (int i = 0; i < m; ++i)
+      index += detail::num_layout_species(i) + 1;
+    return index;
+  }
+
+  // row of the (interstitial) species a absent from mode m
+  KOKKOS_INLINE_FUNCTION
+  static int absent_species_index(const int m, const int a) {
+    int index = 2 * pcnst + num_gas + num_gas * num_mode;
+    for (int i = 0; i < m; ++i)
+      index += num_aero - detail::num_layout_species(i);
+    return index + a - detail::num_layout_species(m);
+  }
+
+  StorageView data_;
+};
+
+} // namespace mam4
+
+#endif
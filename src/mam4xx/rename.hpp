@@ -224,7 +224,9 @@ void do_num_and_mass_transfer(
   qnum[src_mode] -= num_trans;
   qnum[dest_mode] += num_trans;
 
-  for (int ispec = 0; ispec < AeroConfig::num_aerosol_ids(); ++ispec) {
+  // only the species of the source mode are transferred
+  for (int s = 0; s < AeroConfig::num_species_in_mode(src_mode); ++s) {
+    const int ispec = AeroConfig::mode_species(src_mode, s);
     const Real vol_trans = qmol[src_mode][ispec] * xfer_vol_frac;
     qmol[src_mode][ispec] -= vol_trans;
     qmol[dest_mode][ispec] += vol_trans;
@@ -505,7 +507,8 @@ public:
     // coarse, primary carbon), and the species indexing works as follows:
     // rename_spec_arr[x \in {0,...,3}][y \in {0,...,6}] =
     //                                  m4x_spec_arr[x][mam4xx2rename_idx[x][y]]
-    int _mam4xx2rename_idx[4][7];
+    // (with y = 7 for ammonium, if enabled)
+    int _mam4xx2rename_idx[4][AeroConfig::num_aerosol_ids()];
 
     // default constructor--sets default values for parameters
     KOKKOS_INLINE_FUNCTION
@@ -516,10 +519,18 @@ public:
           // species) used for avoiding overflow. it corresponds to dp = 1 nm
           // and number = 1e-5 #/mg-air ~= 1e-5 #/cm3-air
           _smallest_dryvol_value{1.0e-25}, _mam4xx2rename_idx{
+#ifdef MAM4XX_ENABLE_NH3
+                                               {0, 1, 2, 3, 4, 5, 6, 7},
+                                               {0, 1, -1, -1, 4, 6, -1, 7},
+                                               {0, 1, 2, 3, 4, 5, 6, 7},
+                                               {2, 3, 6, -1, -1, -1, -1, -1}
+#else
                                                {0, 1, 2, 3, 4, 5, 6},
                                                {0, 1, -1, -1, 4, 6, -1},
                                                {0, 1, 2, 3, 4, 5, 6},
-                                               {2, 3, 6, -1, -1, -1, -1}} {}
+                                               {2, 3, 6, -1, -1, -1, -1}
+#endif
+                                           } {}
 
     KOKKOS_INLINE_FUNCTION
     Config(const Config &) = default;
@@ -623,7 +634,6 @@ public:
 
     const int nk = atmosphere.num_levels();
     const int nmodes = AeroConfig::num_modes();
-    const int nspec = AeroConfig::num_aerosol_ids();
 
     const auto dest_mode_of_mode = config_._dest_mode_of_mode;
     const auto is_cloudy = diagnostics.is_cloudy;
@@ -665,16 +675,16 @@ public:
         Kokkos::TeamThreadRange(team, nk), KOKKOS_CLASS_LAMBDA(int kk) {
           Real qnum_i_cur[AeroConfig::num_modes()];
           Real qmol_i_cur[AeroConfig::num_modes()]
-                         [AeroConfig::num_aerosol_ids()];
+                         [AeroConfig::num_aerosol_ids()] = {};
           Real qmol_i_del[AeroConfig::num_modes()]
-                         [AeroConfig::num_aerosol_ids()];
+                         [AeroConfig::num_aerosol_ids()] = {};
 
           //
           Real qnum_c_cur[AeroConfig::num_modes()];
           Real qmol_c_cur[AeroConfig::num_modes()]
-                         [AeroConfig::num_aerosol_ids()];
+                         [AeroConfig::num_aerosol_ids()] = {};
           Real qmol_c_del[AeroConfig::num_modes()]
-                         [AeroConfig::num_aerosol_ids()];
+                         [AeroConfig::num_aerosol_ids()] = {};
 
           const bool &is_cloudy_cur = is_cloudy(kk);
           int rename_idx = 0;
@@ -683,9 +693,12 @@ public:
           for (int imode = 0; imode < nmodes; ++imode) {
             qnum_i_cur[imode] = prognostics.n_mode_i[imode](kk);
             qnum_c_cur[imode] = prognostics.n_mode_c[imode](kk);
-            for (int jspec = 0; jspec < nspec; ++jspec) {
+            // only the slots of the species in this mode are filled; the
+            // others stay zero
+            for (int jspec = 0; jspec < AeroConfig::num_species_in_mode(imode);
+                 ++jspec) {
               // get the mapping from the mam4xx species ordering to rename's
-              rename_idx = _mam4xx2rename_idx[imode][jspec];
+              rename_idx = AeroConfig::mode_species(imode, jspec);
               // convert mass mixing ratios to molar mixing ratios
               qmol_i_cur[imode][rename_idx] = conversions::vmr_from_mmr(
                   prognostics.q_aero_i[imode][rename_idx](kk),
@@ -799,6 +812,30 @@ public:
         // aerosol number mixing ratios [#/kmol-air]
         qnum_i_cur, qmol_c_cur, qnum_c_cur);
   } // end mam_rename_1subarea_()
+
+  // Same as above, but using the renaming pairs and mode parameters set up in
+  // init. This is the entry point for drivers that chain several processes
+  // within a single grid cell.
+  KOKKOS_INLINE_FUNCTION
+  void mam_rename_1subarea_(
+      const bool is_cloudy_cur, Real qnum_i_cur[AeroConfig::num_modes()],
+      Real qmol_i_cur[AeroConfig::num_modes()][AeroConfig::num_aerosol_ids()],
+      Real qmol_i_del[AeroConfig::num_modes()][AeroConfig::num_aerosol_ids()],
+      Real qnum_c_cur[AeroConfig::num_modes()],
+      Real qmol_c_cur[AeroConfig::num_modes()][AeroConfig::num_aerosol_ids()],
+      Real qmol_c_del[AeroConfig::num_modes()][AeroConfig::num_aerosol_ids()])
+      const {
+    if (_num_pairs <= 0)
+      return;
+    mam_rename_1subarea_(is_cloudy_cur, config_._smallest_dryvol_value,
+                         config_._dest_mode_of_mode, _mean_std_dev,
+                         _fmode_dist_tail_fac, _num2vol_ratio_lo_rlx,
+                         _num2vol_ratio_hi_rlx, _ln_diameter_tail_fac,
+                         _num_pairs, _diameter_cutoff, _ln_dia_cutoff,
+                         _diameter_threshold, _mass_2_vol, _dgnum_amode,
+                         qnum_i_cur, qmol_i_cur, qmol_i_del, qnum_c_cur,
+                         qmol_c_cur, qmol_c_del);
+  } // end mam_rename_1subarea_()
 };  // end class Rename
 
 } // end namespace mam4
@@ -43,6 +43,14 @@ constexpr int aero_start_ind() {
   return 15;
 } // aerosols start at index 15 (index 16 in Fortran version)
 
+// number of gasses in state_q array of e3sm. Gases beyond these (e.g.
+// GasId::NH3) are not part of the e3sm tracer layout and are not exchanged
+// with state_q
+KOKKOS_INLINE_FUNCTION
+constexpr int num_stateq_gasses() {
+  return aero_start_ind() - gasses_start_ind();
+}
+
 // Because CUDA C++ doesn't allow us to declare and use constants outside of
 // KOKKOS_INLINE_FUNCTIONS, we define this macro that allows us to (re)define
 // these constants where needed within two such functions so we don't define
@@ -185,8 +193,8 @@ void transfer_tendencies_num_to_tendecines(const Real n_mode_i[],
 ) {
   int s_idx = ekat::ScalarTraits<int>::invalid();
   s_idx = gasses_start_ind() +
-          AeroConfig::num_gas_ids(); // gases start at index 9 (index 10 in
-                                     // Fortran version)
+          num_stateq_gasses(); // gases start at index 9 (index 10 in
+                               // Fortran version)
 
   // Now start adding aerosols mmr into the state_q
   for (int m = 0; m < AeroConfig::num_modes(); ++m) {
@@ -206,7 +214,7 @@ void get_num_idx_in_state_q(int idxs[AeroConfig::num_modes()]) {
   // index of accum and aitken mode for num concetration in state_q
   int s_idx =
       gasses_start_ind() +
-      AeroConfig::num_gas_ids(); // gases start at index 9 (index 10 in Fortran
+      num_stateq_gasses(); // gases start at index 9 (index 10 in Fortran
   for (int m = 0; m < AeroConfig::num_modes(); ++m) {
     s_idx += mam4::num_species_mode(m);
     idxs[m] = s_idx;
@@ -235,7 +243,7 @@ void extract_stateq_from_prognostics(const mam4::Prognostics &progs,
   if (progs.q_gas[0].data()) { // if gases are defined in dry_aero aerosol state
     s_idx = gasses_start_ind(); // gases start at index 9 (index 10 in Fortran
                                 // version)
-    for (int g = 0; g < AeroConfig::num_gas_ids(); ++g) {
+    for (int g = 0; g < num_stateq_gasses(); ++g) {
       // get mmr at level "klev"
       q[s_idx] = progs.q_gas[g](klev);
       s_idx++; // update index
@@ -267,7 +275,7 @@ void extract_ptend_from_tendencies(const Tendencies &tends, Real *ptend,
   if (tends.q_gas[0].data()) { // if gases are defined in dry_aero aerosol state
     s_idx = gasses_start_ind(); // gases start at index 9 (index 10 in Fortran
                                 // version)
-    for (int g = 0; g < AeroConfig::num_gas_ids(); ++g) {
+    for (int g = 0; g < num_stateq_gasses(); ++g) {
       // get mmr at level "klev"
       ptend[s_idx] = tends.q_gas[g](klev);
       s_idx++; // update index
@@ -298,7 +306,7 @@ void inject_stateq_to_prognostics(const Real *q, mam4::Prognostics &progs,
   if (progs.q_gas[0].data()) { // if gases are defined in dry_aero aerosol state
     s_idx = gasses_start_ind(); // gases start at index 9 (index 10 in Fortran
                                 // version)
-    for (int g = 0; g < AeroConfig::num_gas_ids(); ++g) {
+    for (int g = 0; g < num_stateq_gasses(); ++g) {
       // get mmr at level "klev"
       progs.q_gas[g](klev) = q[s_idx];
       s_idx++; // update index
@@ -332,7 +340,7 @@ void inject_ptend_to_tendencies(const Real *ptend, const Tendencies &tends,
   if (tends.q_gas[0].data()) { // if gases are defined in dry_aero aerosol state
     s_idx = gasses_start_ind(); // gases start at index 9 (index 10 in Fortran
                                 // version)
-    for (int g = 0; g < AeroConfig::num_gas_ids(); ++g) {
+    for (int g = 0; g < num_stateq_gasses(); ++g) {
       // get mmr at level "klev"
       tends.q_gas[g](klev) = ptend[s_idx];
       s_idx++; // update index
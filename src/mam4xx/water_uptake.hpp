@@ -11,6 +11,7 @@
 #include <haero/surface.hpp>
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/convproc.hpp>
+#include <mam4xx/kohler.hpp>
 #include <mam4xx/utils.hpp>
 #include <mam4xx/wv_sat_methods.hpp>
 namespace mam4 {
@@ -34,6 +35,8 @@ public:
   const char *name() const { return "MAM4 wet deposition"; }
 
   static constexpr Real eps = 1e-4; // Bad constant
+  // relative convergence tolerance of the wet radius (see kohler_wet_radius)
+  static constexpr Real kohler_tol = 1e-12;
 
   // init -- initializes the implementation with MAM4's configuration
   void init(const AeroConfig &aero_config,
@@ -201,21 +204,19 @@ void modal_aero_kohler(const Real rdry_in, const Real hygro, const Real rh,
       utils::min_max_bound(small_value_10, 1.0 - Water_Uptake::eps, rh);
 
   const Real slog = haero::log(ss);
-  const Real p43 = -aa / slog;
-  const Real p42 = 0.0;
-  const Real p41 = bb / slog - vol;
-  const Real p40 = aa * vol / slog;
 
   const Real pp = haero::abs(-bb / aa) / (rdry * rdry);
   Real rwet = 0.0;
-  int nsol = 0;
-  Kokkos::complex<Real> cx4[4] = {};
   if (pp < Water_Uptake::eps) {
     // approximate solution for small particles
     rwet = rdry * (1.0 + pp * (1.0 / 3.0) / (1.0 - slog * rdry / aa));
   } else {
-    makoh_quartic(cx4, p43, p42, p41, p40);
-    find_real_solution(rdry, cx4, rwet, nsol);
+    // the positive real root of the quartic
+    //   x**4 - (aa/slog) x**3 + (bb/slog - vol) x + aa vol/slog = 0,
+    // found without the complex arithmetic of makoh_quartic
+    int n_iter = 0;
+    rwet = kohler_wet_radius(slog, hygro, rdry, aa, Water_Uptake::kohler_tol,
+                             n_iter);
   }
 
   // bound and convert from microns to m
@@ -236,7 +237,7 @@ KOKKOS_INLINE_FUNCTION
 void modal_aero_water_uptake_wetaer(
     Real rhcrystal[AeroConfig::num_modes()],
     Real rhdeliques[AeroConfig::num_modes()],
-    Real dgncur_a[AeroConfig::num_modes()],
+    const Real dgncur_a[AeroConfig::num_modes()],
     Real dryrad[AeroConfig::num_modes()], Real hygro[AeroConfig::num_modes()],
     const Real rh, Real naer[AeroConfig::num_modes()],
     Real dryvol[AeroConfig::num_modes()], Real wetrad[AeroConfig::num_modes()],
@@ -356,10 +357,12 @@ void get_e3sm_parameters(
 
 KOKKOS_INLINE_FUNCTION
 void modal_aero_water_uptake_dryaer(
-    int nspec_amode[AeroConfig::num_modes()],
-    Real specdens_amode[maxd_aspectype], Real spechygro[maxd_aspectype],
-    int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
-    Real state_q[aero_model::pcnst], Real dgncur_a[AeroConfig::num_modes()],
+    const int nspec_amode[AeroConfig::num_modes()],
+    const Real specdens_amode[maxd_aspectype],
+    const Real spechygro[maxd_aspectype],
+    const int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
+    const Real state_q[aero_model::pcnst],
+    const Real dgncur_a[AeroConfig::num_modes()],
     Real hygro[AeroConfig::num_modes()], Real naer[AeroConfig::num_modes()],
     Real dryrad[AeroConfig::num_modes()], Real dryvol[AeroConfig::num_modes()],
     Real drymass[AeroConfig::num_modes()],
@@ -434,11 +437,13 @@ void modal_aero_water_uptake_dryaer(
 
 KOKKOS_INLINE_FUNCTION
 void modal_aero_water_uptake_dr_b4_wetdens(
-    int nspec_amode[AeroConfig::num_modes()],
-    Real specdens_amode[maxd_aspectype], Real spechygro[maxd_aspectype],
-    int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
-    Real state_q[aero_model::pcnst], Real temperature, Real pmid, Real cldn,
-    Real dgncur_a[AeroConfig::num_modes()],
+    const int nspec_amode[AeroConfig::num_modes()],
+    const Real specdens_amode[maxd_aspectype],
+    const Real spechygro[maxd_aspectype],
+    const int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
+    const Real state_q[aero_model::pcnst], Real temperature, Real pmid,
+    Real cldn,
+    const Real dgncur_a[AeroConfig::num_modes()],
     Real dgncur_awet[AeroConfig::num_modes()],
     Real qaerwat[AeroConfig::num_modes()], Real wetvol[AeroConfig::num_modes()],
     Real wtrvol[AeroConfig::num_modes()], Real drymass[AeroConfig::num_modes()],
@@ -476,11 +481,13 @@ void modal_aero_water_uptake_dr_b4_wetdens(
 
 KOKKOS_INLINE_FUNCTION
 void modal_aero_water_uptake_dr(
-    int nspec_amode[AeroConfig::num_modes()],
-    Real specdens_amode[maxd_aspectype], Real spechygro[maxd_aspectype],
-    int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
-    Real state_q[aero_model::pcnst], Real temperature, Real pmid, Real cldn,
-    Real dgncur_a[AeroConfig::num_modes()],
+    const int nspec_amode[AeroConfig::num_modes()],
+    const Real specdens_amode[maxd_aspectype],
+    const Real spechygro[maxd_aspectype],
+    const int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
+    const Real state_q[aero_model::pcnst], Real temperature, Real pmid,
+    Real cldn,
+    const Real dgncur_a[AeroConfig::num_modes()],
     Real dgncur_awet[AeroConfig::num_modes()],
     Real qaerwat[AeroConfig::num_modes()],
     Real wetdens[AeroConfig::num_modes()]) {
@@ -504,11 +511,13 @@ void modal_aero_water_uptake_dr(
 
 KOKKOS_INLINE_FUNCTION
 void modal_aero_water_uptake_dr(
-    int nspec_amode[AeroConfig::num_modes()],
-    Real specdens_amode[maxd_aspectype], Real spechygro[maxd_aspectype],
-    int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
-    Real state_q[aero_model::pcnst], Real temperature, Real pmid, Real cldn,
-    Real dgncur_a[AeroConfig::num_modes()],
+    const int nspec_amode[AeroConfig::num_modes()],
+    const Real specdens_amode[maxd_aspectype],
+    const Real spechygro[maxd_aspectype],
+    const int lspectype_amode[maxd_aspectype][AeroConfig::num_modes()],
+    const Real state_q[aero_model::pcnst], Real temperature, Real pmid,
+    Real cldn,
+    const Real dgncur_a[AeroConfig::num_modes()],
     Real dgncur_awet[AeroConfig::num_modes()],
     Real qaerwat[AeroConfig::num_modes()]) {
 
@@ -13,6 +13,8 @@
 #include <limits>
 #include <mam4xx/aero_config.hpp>
 #include <mam4xx/aero_model.hpp>
+#include <mam4xx/column_batch.hpp>
+#include <mam4xx/column_skip.hpp>
 #include <mam4xx/modal_aer_opt.hpp>
 #include <mam4xx/utils.hpp>
 
@@ -804,6 +806,76 @@ void wetdep_resusp(const int is_st_cu, const int mam_prevap_resusp_optcc,
   }
 }
 
+// ==============================================================================
+// Computes the convective (srcc) and stratiform (srcs) scavenging tendencies
+// [kg/kg/s] of wetdepa_v2 and the fractions of them taken by in-cloud
+// processes (finc, fins), given the precipitation from above (precabs,
+// precabc) [kg/m2/s]. The tendencies are limited so that no more than the
+// available tracer is removed.
+KOKKOS_INLINE_FUNCTION
+void wetdep_scavenging_tendencies(
+    const Real deltat, const Real cmfdqr, const Real dlf, const Real conicw,
+    const Real precs, const Real cwat, const Real cldt, const Real cldc,
+    const Real cldvcu, const Real cldvst, const Real sol_factb,
+    const Real sol_facti, const Real sol_factic, const bool is_strat_cloudborne,
+    const Real scavcoef, const Real f_act_conv, const Real tracer,
+    const Real qqcw, const Real precabs, const Real precabc, Real &srcc,
+    Real &finc, Real &srcs, Real &fins) {
+  // BAD CONSTANT
+  const Real small_value_2 = 1.e-2;
+  const Real small_value_12 = 1.e-12;
+  const Real small_value_36 = 1.e-36;
+
+  // temporary saved tracer value
+  const Real clddiff = cldt - cldc;
+  // temporarily calculation of tracer [kg/kg]
+  const Real tracer_tmp = haero::min(
+      qqcw, tracer * (clddiff / haero::max(small_value_2, (1. - clddiff))));
+  // calculate in-cumulus and mean tracer values for wetdep_scavenging use
+  // in-cumulus tracer concentration [kg/kg]
+  const Real tracer_incu = f_act_conv * (tracer + tracer_tmp);
+  // mean tracer concenration [kg/kg]
+  Real tracer_mean =
+      tracer * (1. - cldc * f_act_conv) - cldc * f_act_conv * tracer_tmp;
+  tracer_mean = haero::max(0., tracer_mean);
+
+  // now do the convective scavenging
+
+  // fracp: fraction of convective cloud water converted to rain
+  // Sungsu: Below new formula of 'fracp' is necessary since 'conicw'
+  // is a LWC/IWC that has already precipitated out, that is, 'conicw' does
+  // not contain precipitation at all !
+  Real fracp =
+      cmfdqr * deltat /
+      haero::max(small_value_12, cldc * conicw + (cmfdqr + dlf) * deltat);
+  fracp = utils::min_max_bound(0.0, 1.0, fracp) * cldc;
+
+  // 2 is for convective:
+  wetdep_scavenging(2, is_strat_cloudborne, deltat, fracp, precabc, cldvcu,
+                    scavcoef, sol_factb, sol_factic, tracer_incu, tracer_mean,
+                    srcc, finc);
+
+  // now do the stratiform scavenging
+
+  // fracp: fraction of convective cloud water converted to rain
+  fracp = precs * deltat / haero::max(cwat + precs * deltat, small_value_12);
+  fracp = utils::min_max_bound(0.0, 1.0, fracp);
+
+  // 1 for stratiform:
+  wetdep_scavenging(1, is_strat_cloudborne, deltat, fracp, precabs, cldvst,
+                    scavcoef, sol_factb, sol_facti, tracer, tracer_mean, srcs,
+                    fins);
+
+  // rat =  ratio of amount available to amount removed [fraction]
+  // make sure we dont take out more than is there
+  // ratio of amount available to amount removed
+  const Real rat = tracer / haero::max(deltat * (srcc + srcs), small_value_36);
+  if (rat < 1) {
+    srcs = srcs * rat;
+    srcc = srcc * rat;
+  }
+}
+
 // ==============================================================================
 // ==============================================================================
 KOKKOS_INLINE_FUNCTION
@@ -899,7 +971,6 @@ void wetdepa_v2(const Real deltat, const Real pdel, const Real cmfdqr,
 #endif
   // BAD CONSTANT
   const Real small_value_2 = 1.e-2;
-  const Real small_value_12 = 1.e-12;
   const Real small_value_36 = 1.e-36;
 
   fracis = scavt = iscavt = icscavt = isscavt = bcscavt = bsscavt = rcscavt =
@@ -935,64 +1006,22 @@ void wetdepa_v2(const Real deltat, const Real pdel, const Real cmfdqr,
 
   // ****************** Scavenging **************************
 
-  // temporary saved tracer value
-  const Real clddiff = cldt - cldc;
-  // temporarily calculation of tracer [kg/kg]
-  const Real tracer_tmp = haero::min(
-      qqcw, tracer * (clddiff / haero::max(small_value_2, (1. - clddiff))));
-  // calculate in-cumulus and mean tracer values for wetdep_scavenging use
-  // in-cumulus tracer concentration [kg/kg]
-  const Real tracer_incu = f_act_conv * (tracer + tracer_tmp);
-  // mean tracer concenration [kg/kg]
-  Real tracer_mean =
-      tracer * (1. - cldc * f_act_conv) - cldc * f_act_conv * tracer_tmp;
-  tracer_mean = haero::max(0., tracer_mean);
-
-  // now do the convective scavenging
-
-  // fracp: fraction of convective cloud water converted to rain
-  // Sungsu: Below new formula of 'fracp' is necessary since 'conicw'
-  // is a LWC/IWC that has already precipitated out, that is, 'conicw' does
-  // not contain precipitation at all !
-  Real fracp =
-      cmfdqr * deltat /
-      haero::max(small_value_12, cldc * conicw + (cmfdqr + dlf) * deltat);
-  fracp = utils::min_max_bound(0.0, 1.0, fracp) * cldc;
-
-  Real srcc = 0; // tendency for convective rain scavenging [kg/kg/s]
-  Real finc = 0; // fraction of rem. rate by conv. rain [fraction]
-  // 2 is for convective:
-  wetdep_scavenging(2, is_strat_cloudborne, deltat, fracp, precabc, cldvcu,
-                    scavcoef, sol_factb, sol_factic, tracer_incu, tracer_mean,
-                    srcc, finc);
-
-  // now do the stratiform scavenging
-
-  // fracp: fraction of convective cloud water converted to rain
-  fracp = precs * deltat / haero::max(cwat + precs * deltat, small_value_12);
-  fracp = utils::min_max_bound(0.0, 1.0, fracp);
-
+  Real srcc; // tendency for convective rain scavenging [kg/kg/s]
+  Real finc; // fraction of rem. rate by conv. rain [fraction]
   Real srcs; // tendency for stratiform rain scavenging [kg/kg/s]
   Real fins; // fraction of rem. rate by strat rain [fraction]
-  // 1 for stratiform:
-  wetdep_scavenging(1, is_strat_cloudborne, deltat, fracp, precabs, cldvst,
-                    scavcoef, sol_factb, sol_facti, tracer, tracer_mean, srcs,
-                    fins);
-
-  // rat =  ratio of amount available to amount removed [fraction]
-  // make sure we dont take out more than is there
-  // ratio of amount available to amount removed
-  const Real rat = tracer / haero::max(deltat * (srcc + srcs), small_value_36);
-  if (rat < 1) {
-    srcs = srcs * rat;
-    srcc = srcc * rat;
-  }
+  wetdep_scavenging_tendencies(deltat, cmfdqr, dlf, conicw, precs, cwat, cldt,
+                               cldc, cldvcu, cldvst, sol_factb, sol_facti,
+                               sol_factic, is_strat_cloudborne, scavcoef,
+                               f_act_conv, tracer, qqcw, precabs, precabc,
+                               srcc, finc, srcs, fins);
   // total scavenging tendency [kg/kg/s]
   const Real srct = (srcc + srcs) * omsm;
 
   // fraction that is not removed within the cloud
   // (assumed to be interstitial, and subject to convective transport)
-  fracp = deltat * srct / haero::max(cldvst * tracer, small_value_36);
+  const Real fracp =
+      deltat * srct / haero::max(cldvst * tracer, small_value_36);
   fracis = 1. - utils::min_max_bound(0.0, 1.0, fracp);
 
   // ****************** Resuspension **************************
@@ -1064,6 +1093,67 @@ void wetdepa_v2(const Real deltat, const Real pdel, const Real cmfdqr,
   rsscavt = rsscavt_ik;
 }
 // ==============================================================================
+// Computes the update of the stratiform and convective scavenged tracer fluxes
+// from above done by wetdepa_v2 at one level. Given the precipitation fluxes
+// from above, this update is affine:
+//   scavabs_new = scavabs_ratio * scavabs + scavabs_source
+//   scavabc_new = scavabc_ratio * scavabc + scavabc_source
+// The inputs are those of wetdepa_v2, and the fluxes from above are not
+// modified.
+KOKKOS_INLINE_FUNCTION
+void wetdep_scavab_update(
+    const Real deltat, const Real pdel, const Real cmfdqr, const Real evapc,
+    const Real dlf, const Real conicw, const Real precs, const Real evaps,
+    const Real cwat, const Real cldt, const Real cldc, const Real cldvcu,
+    const Real cldvst, const Real sol_factb, const Real sol_facti,
+    const Real sol_factic, const int mam_prevap_resusp_optcc,
+    const bool is_strat_cloudborne, const Real scavcoef,
+    const Real f_act_conv, const Real tracer, const Real qqcw,
+    const Real precabs, const Real precabc, const Real precabs_base,
+    const Real precabc_base, const Real precnums_base,
+    const Real precnumc_base, Real &scavabs_ratio, Real &scavabs_source,
+    Real &scavabc_ratio, Real &scavabc_source) {
+  const Real gravit = Constants::gravity;
+
+  Real srcc, finc, srcs, fins;
+  wetdep_scavenging_tendencies(deltat, cmfdqr, dlf, conicw, precs, cwat, cldt,
+                               cldc, cldvcu, cldvst, sol_factb, sol_facti,
+                               sol_factic, is_strat_cloudborne, scavcoef,
+                               f_act_conv, tracer, qqcw, precabs, precabc,
+                               srcc, finc, srcs, fins);
+  if (mam_prevap_resusp_optcc >= 100) {
+    // wetdep_resusp scales the flux from above, so it returns the ratio for a
+    // unit flux from above
+    const Real unit_flux = 1.0;
+    Real precabx_tmp, precabx_base_tmp, precnumx_base_tmp, resusp_x;
+    wetdep_resusp(1, mam_prevap_resusp_optcc, pdel, evaps, precabs,
+                  precabs_base, unit_flux, precnums_base, precabx_tmp,
+                  precabx_base_tmp, scavabs_ratio, precnumx_base_tmp,
+                  resusp_x);
+    wetdep_resusp(2, mam_prevap_resusp_optcc, pdel, evapc, precabc,
+                  precabc_base, unit_flux, precnumc_base, precabx_tmp,
+                  precabx_base_tmp, scavabc_ratio, precnumx_base_tmp,
+                  resusp_x);
+    // wetdep_prevap adds the scavenged aerosol mass
+    scavabs_source = scavabc_source = 0.0;
+    if (mam_prevap_resusp_optcc <= 130) {
+      scavabs_source = haero::max(0.0, srcs * pdel / gravit);
+      scavabc_source = haero::max(0.0, srcc * pdel / gravit);
+    }
+  } else {
+    // as in update_scavenging
+    Real fracev_st, fracev_cu;
+    compute_evap_frac(mam_prevap_resusp_optcc, pdel, evaps, precabs,
+                      fracev_st);
+    compute_evap_frac(mam_prevap_resusp_optcc, pdel, evapc, precabc,
+                      fracev_cu);
+    scavabs_ratio = 1 - fracev_st;
+    scavabc_ratio = 1 - fracev_cu;
+    scavabs_source = srcs * pdel / gravit;
+    scavabc_source = srcc * pdel / gravit;
+  }
+}
+// ==============================================================================
 
 /**
  * @brief Estimate the cloudy volume which is occupied by rain or cloud water as
@@ -1154,6 +1244,28 @@ void zero_values(const ThreadTeam &team, const View1D &vec, const int nlev) {
                        [&](int k) { vec[k] = 0; });
 }
 
+// Returns true if there is stratiform or convective precipitation production
+// or evaporation on any level of the column. Without any, wet removal changes
+// neither the tracers nor the deposition fluxes of the column. The rates are
+// compared with zero exactly, so a column with any precipitation at all takes
+// the full computation. This must be called by all threads of the team.
+KOKKOS_INLINE_FUNCTION
+bool column_has_precipitation(const ThreadTeam &team, const View1D &prain,
+                              const View1D &evapr, const View1D &rprddp,
+                              const View1D &rprdsh, const View1D &evapcdp,
+                              const View1D &evapcsh, const int nlev) {
+  int num_wet_levels = 0;
+  Kokkos::parallel_reduce(
+      Kokkos::TeamThreadRange(team, nlev),
+      [&](int k, int &count) {
+        const bool wet = prain[k] != 0 || evapr[k] != 0 || rprddp[k] != 0 ||
+                         rprdsh[k] != 0 || evapcdp[k] != 0 || evapcsh[k] != 0;
+        count += wet ? 1 : 0;
+      },
+      num_wet_levels);
+  return 0 < num_wet_levels;
+}
+
 KOKKOS_INLINE_FUNCTION
 void sum_deep_and_shallow(const ThreadTeam &team, const View1D &conicw,
                           const View1D &icwmrdp, const View1D &dp_frac,
@@ -1210,10 +1322,10 @@ KOKKOS_INLINE_FUNCTION
 void modal_aero_bcscavcoef_get(
     const ThreadTeam &team, const Diagnostics &diags,
     Kokkos::View<bool *> isprx,
-    const Real scavimptblvol[aero_model::nimptblgrow_total]
-                            [AeroConfig::num_modes()],
-    const Real scavimptblnum[aero_model::nimptblgrow_total]
-                            [AeroConfig::num_modes()],
+    const TableReal scavimptblvol[aero_model::nimptblgrow_total]
+                                 [AeroConfig::num_modes()],
+    const TableReal scavimptblnum[aero_model::nimptblgrow_total]
+                                 [AeroConfig::num_modes()],
     const View1D &scavcoefnum, const View1D &scavcoefvol, const int imode,
     const int nlev) {
   Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nlev), [&](int k) {
@@ -1231,10 +1343,10 @@ KOKKOS_INLINE_FUNCTION
 void modal_aero_bcscavcoef_get(
     const ThreadTeam &team, const View2D &wet_geometric_mean_diameter_i,
     Kokkos::View<bool *> isprx,
-    const Real scavimptblvol[aero_model::nimptblgrow_total]
-                            [AeroConfig::num_modes()],
-    const Real scavimptblnum[aero_model::nimptblgrow_total]
-                            [AeroConfig::num_modes()],
+    const TableReal scavimptblvol[aero_model::nimptblgrow_total]
+                                 [AeroConfig::num_modes()],
+    const TableReal scavimptblnum[aero_model::nimptblgrow_total]
+                                 [AeroConfig::num_modes()],
     const View1D &scavcoefnum, const View1D &scavcoefvol, const int imode,
     const int nlev) {
   Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nlev), [&](int k) {
@@ -1353,6 +1465,124 @@ void compute_q_tendencies_phase_2(
   // utils::inject_qqcw_to_prognostics(qqcw_all, progs, k);
 }
 
+// Returns the mam_prevap_resusp_optcc value of a tracer, which controls the
+// prevap_resusp calculations in wetdepa_v2:
+//     0 = no resuspension
+//   130 = non-linear resuspension of aerosol mass based on scavenged aerosol
+//         mass
+//   230 = non-linear resuspension of aerosol number based on raindrop number
+// the 130 thru 230 all use the new prevap_resusp code block in wetdepa_v2
+KOKKOS_INLINE_FUNCTION
+int prevap_resusp_option(const int jnummaswtr, const int lphase,
+                         const int imode) {
+  const int mam_prevap_resusp_no = 0;
+  const int mam_prevap_resusp_mass = 130;
+  const int mam_prevap_resusp_num = 230;
+  const int jaeronumb = 0, jaeromass = 1;
+  const int modeptr_coarse = static_cast<int>(ModeIndex::Coarse);
+  if (jnummaswtr == jaeromass) // dry mass
+    return mam_prevap_resusp_mass;
+  else if (jnummaswtr == jaeronumb && lphase == 1 &&
+           imode == modeptr_coarse) // number
+    return mam_prevap_resusp_num;
+  return mam_prevap_resusp_no;
+}
+
+// Returns f_act_conv for an interstitial (lphase=1) coarse mode tracer. For
+// the convective in-cloud, we conceptually treat the coarse dust and seasalt
+// as being externally mixed, and apply f_act_conv =
+// f_act_conv_coarse_dust/nacl to dust/seasalt. Number and sulfate are
+// conceptually partitioned to the dust and seasalt on a mass basis, so the
+// f_act_conv for number and sulfate are mass-weighted averages of the values
+// used for dust/seasalt
+KOKKOS_INLINE_FUNCTION
+Real coarse_f_act_conv(const int jnummaswtr, const int lspec, const int imode,
+                       const Real f_act_conv_coarse,
+                       const Real f_act_conv_coarse_dust,
+                       const Real f_act_conv_coarse_nacl) {
+  const int jaeromass = 1;
+  if (jnummaswtr == jaeromass) {
+    if (aero_model::lmassptr_amode(lspec, imode) ==
+        aero_model::lptr_dust_a_amode(imode))
+      return f_act_conv_coarse_dust;
+    else if (aero_model::lmassptr_amode(lspec, imode) ==
+             aero_model::lptr_nacl_a_amode(imode))
+      return f_act_conv_coarse_nacl;
+  }
+  return f_act_conv_coarse;
+}
+
+// Computes the wet removal tendencies of a tracer at level k for
+// compute_q_tendencies, and advances the precipitation and scavenged tracer
+// fluxes from above (precabs, ..., precnumc_base) to level k + 1.
+KOKKOS_INLINE_FUNCTION
+void compute_q_tendencies_level(
+    const int k, const View1D &f_act_conv, const View1D &f_act_conv_coarse,
+    const View1D &f_act_conv_coarse_dust, const View1D &f_act_conv_coarse_nacl,
+    const View1D &scavcoefnum, const View1D &scavcoefvol, const View1D &totcond,
+    const View1D &cmfdqr, const View1D &conicw, const View1D &evapc,
+    const View1D &evapr, const View1D &prain, const View1D &dlf,
+    const View1D &cldt, const View1D &cldcu, const View1D &cldvst,
+    const View1D &cldvcu, const View1D &sol_facti, const View1D &sol_factic,
+    const View1D &sol_factb, const View1D &scavt, const View1D &bcscavt,
+    const View1D &rcscavt, const View2D &rtscavt_sv, const View2D &state_q,
+    const View2D &qqcw, const View2D &ptend_q, haero::ConstColumnView pdel,
+    const Real dt, const int jnummaswtr, const int jnv, const int mm,
+    const int lphase, const int imode, const int lspec, Real &precabs,
+    Real &precabc, Real &scavabs, Real &scavabc, Real &precabs_base,
+    Real &precabc_base, Real &precnums_base, Real &precnumc_base) {
+  const auto rtscavt_sv_k = ekat::subview(rtscavt_sv, k);
+  const int mam_prevap_resusp_optcc =
+      prevap_resusp_option(jnummaswtr, lphase, imode);
+  if (lphase == 1 && imode == static_cast<int>(ModeIndex::Coarse))
+    f_act_conv[k] = coarse_f_act_conv(
+        jnummaswtr, lspec, imode, f_act_conv_coarse[k],
+        f_act_conv_coarse_dust[k], f_act_conv_coarse_nacl[k]);
+  const int k_p1 = static_cast<int>(haero::min(k + 1, nlev - 1));
+  // OK, this is from the old mam4: Phase 2 is before Phase 1.
+  // Note that the phase loops goes from 2 to 1 in reverse order
+  // and the qqcw_sav is set first in phase 2 the used in phase 1.
+  if (lphase == 1) {
+    // traces reflects changes from modal_aero_calcsize and is the
+    // "most current" q
+    compute_q_tendencies_phase_1(
+        // These are the output values
+        scavt[k], bcscavt[k], rcscavt[k], rtscavt_sv_k.data(),
+        // The rest of the values are input only.
+        f_act_conv[k], scavcoefnum[k], scavcoefvol[k], totcond[k],
+        cmfdqr[k], conicw[k], evapc[k], evapr[k], prain[k], dlf[k], cldt[k],
+        cldcu[k], cldvst[k], cldvst[k_p1], cldvcu[k], cldvcu[k_p1],
+        sol_facti[k], sol_factic[k], sol_factb[k], state_q(k, mm),
+        ptend_q(k, mm), qqcw(k, mm), pdel[k], dt, mam_prevap_resusp_optcc,
+        jnv, mm, precabs, precabc, scavabs, scavabc, precabs_base,
+        precabc_base, precnums_base, precnumc_base);
+
+  } else { // if (lphase == 2)
+    // There is no cloud-borne aerosol water in the model, so this
+    // code block should NEVER execute for lspec =
+    // nspec_amode(m)+1 (i.e., jnummaswtr = 2). The code only
+    // worked because the "do lspec" loop cycles when lspec =
+    // nspec_amode(m)+1, but that does not make the code correct.
+    // FIXME: Not sure if this is a bug or not as qqcw_tmp seem
+    // different from the previous call and qqcw_tmp is always
+    // zero. May need further check.  - Shuaiqi Tang in
+    // refactoring for MAM4xx
+    const Real qqcw_tmp = 0.0;
+    compute_q_tendencies_phase_2(
+        // These are the output values
+        scavt[k], bcscavt[k], rcscavt[k], rtscavt_sv_k.data(), qqcw_tmp,
+        qqcw(k, mm),
+        // The rest of the values are input only.
+        // progs,
+        f_act_conv[k], scavcoefnum[k], scavcoefvol[k], totcond[k],
+        cmfdqr[k], conicw[k], evapc[k], evapr[k], prain[k], dlf[k], cldt[k],
+        cldcu[k], cldvst[k], cldvst[k_p1], cldvcu[k], cldvcu[k_p1],
+        sol_facti[k], sol_factic[k], sol_factb[k], pdel[k], dt,
+        mam_prevap_resusp_optcc, jnv, mm, k, precabs, precabc, scavabs,
+        scavabc, precabs_base, precabc_base, precnums_base, precnumc_base);
+  }
+}
+
 KOKKOS_INLINE_FUNCTION
 void compute_q_tendencies(
     const ThreadTeam &team,
@@ -1373,16 +1603,6 @@ void compute_q_tendencies(
     const int jnv, const int mm, const int lphase, const int imode,
     const int lspec) {
 
-  // clang-format off
-  //   0 = no resuspension
-  // 130 = non-linear resuspension of aerosol mass based on scavenged aerosol mass
-  // 230 = non-linear resuspension of aerosol number based on raindrop number
-  // the 130 thru 230 all use the new prevap_resusp code block in subr wetdepa_v2
-  // clang-format on
-  const int mam_prevap_resusp_no = 0;
-  const int mam_prevap_resusp_mass = 130;
-  const int mam_prevap_resusp_num = 230;
-  const int jaeronumb = 0, jaeromass = 1;
   Real precabs = 0;
   Real precabc = 0;
   Real scavabs = 0;
@@ -1395,88 +1615,245 @@ void compute_q_tendencies(
   // because precabs requires values from the previous elevation (k-1).
   Kokkos::parallel_for(Kokkos::TeamThreadRange(team, 1), [&](int idummy) {
     for (int k = 0; k < nlev; ++k) {
-      const auto rtscavt_sv_k = ekat::subview(rtscavt_sv, k);
-      // mam_prevap_resusp_optcc values control the prevap_resusp
-      // calculations in wetdepa_v2:
-      //     0 = no resuspension
-      //   130 = non-linear resuspension of aerosol mass   based on
-      //   scavenged aerosol mass 230 = non-linear resuspension of
-      //   aerosol number based on raindrop number the 130 thru 230
-      //   all use the new prevap_resusp code block in subr wetdepa_v2
-      int mam_prevap_resusp_optcc = mam_prevap_resusp_no;
-      const int modeptr_coarse = static_cast<int>(ModeIndex::Coarse);
-      if (jnummaswtr == jaeromass) // dry mass
-        mam_prevap_resusp_optcc = mam_prevap_resusp_mass;
-      else if (jnummaswtr == jaeronumb && lphase == 1 &&
-               imode == modeptr_coarse) // number
-        mam_prevap_resusp_optcc = mam_prevap_resusp_num;
-
-      // set f_act_conv for interstitial (lphase=1) coarse mode
-      // species for the convective in-cloud, we conceptually treat
-      // the coarse dust and seasalt as being externally mixed, and
-      // apply f_act_conv = f_act_conv_coarse_dust/nacl to
-      // dust/seasalt number and sulfate are conceptually partitioned
-      // to the dust and seasalt on a mass basis, so the f_act_conv
-      // for number and sulfate are mass-weighted averages of the
-      // values used for dust/seasalt
-      if (lphase == 1 && imode == modeptr_coarse) {
-        f_act_conv[k] = f_act_conv_coarse[k];
-        if (jnummaswtr == jaeromass) {
-          if (aero_model::lmassptr_amode(lspec, imode) ==
-              aero_model::lptr_dust_a_amode(imode))
-            f_act_conv[k] = f_act_conv_coarse_dust[k];
-          else if (aero_model::lmassptr_amode(lspec, imode) ==
-                   aero_model::lptr_nacl_a_amode(imode))
-            f_act_conv[k] = f_act_conv_coarse_nacl[k];
-        }
-      }
+      compute_q_tendencies_level(
+          k, f_act_conv, f_act_conv_coarse, f_act_conv_coarse_dust,
+          f_act_conv_coarse_nacl, scavcoefnum, scavcoefvol, totcond, cmfdqr,
+          conicw, evapc, evapr, prain, dlf, cldt, cldcu, cldvst, cldvcu,
+          sol_facti, sol_factic, sol_factb, scavt, bcscavt, rcscavt,
+          rtscavt_sv, state_q, qqcw, ptend_q, pdel, dt, jnummaswtr, jnv, mm,
+          lphase, imode, lspec, precabs, precabc, scavabs, scavabc,
+          precabs_base, precabc_base, precnums_base, precnumc_base);
+    }
+  });
+}
+
+// Indices of the precipitation fluxes from above stored for each level by
+// compute_precip_fluxes. Tracers without resuspension
+// (mam_prevap_resusp_optcc = 0) only change precabs and precabc, so their
+// other fluxes stay zero. Tracers with resuspension share the other set.
+enum PrecipFlux {
+  precabs_noresusp = 0,
+  precabc_noresusp,
+  precabs_resusp,
+  precabc_resusp,
+  precabs_base_resusp,
+  precabc_base_resusp,
+  precnums_base_resusp,
+  precnumc_base_resusp,
+  num_precip_fluxes
+};
+
+// Computes the precipitation fluxes from above at each level into
+// precip_fluxes(k, PrecipFlux). wetdepa_v2 updates them in the same way for
+// every tracer. Without resuspension they are sums over the levels above,
+// computed with parallel scans. With resuspension, the precipitation is
+// bounded by its value at an effective cloud base and reset where it
+// vanishes, which is not a scan, so those fluxes are computed in one sweep.
+KOKKOS_INLINE_FUNCTION
+void compute_precip_fluxes(const ThreadTeam &team, const View1D &cmfdqr,
+                           const View1D &evapc, const View1D &evapr,
+                           const View1D &prain, const View1D &cldvst,
+                           const View1D &cldvcu, haero::ConstColumnView pdel,
+                           const View2D &precip_fluxes) {
+  const Real gravit = Constants::gravity;
+  // as in update_scavenging
+  Kokkos::parallel_scan(
+      Kokkos::TeamThreadRange(team, nlev),
+      [&](const int k, Real &precabs, const bool final) {
+        if (final)
+          precip_fluxes(k, precabs_noresusp) = precabs;
+        precabs += (prain[k] - evapr[k]) * pdel[k] / gravit;
+      });
+  Kokkos::parallel_scan(
+      Kokkos::TeamThreadRange(team, nlev),
+      [&](const int k, Real &precabc, const bool final) {
+        if (final)
+          precip_fluxes(k, precabc_noresusp) = precabc;
+        precabc += (cmfdqr[k] - evapc[k]) * pdel[k] / gravit;
+      });
+
+  // as in wetdepa_v2; the number fluxes are only used with
+  // mam_prevap_resusp_optcc = 230, and the other fluxes do not depend on it
+  Kokkos::single(Kokkos::PerTeam(team), [&]() {
+    const int mam_prevap_resusp_optcc = 230;
+    const Real small_value_2 = 1.e-2;
+    const Real scavabx_old = 0, srcx = 0;
+    Real precabs = 0, precabc = 0;
+    Real precabs_base = 0, precabc_base = 0;
+    Real precnums_base = 0, precnumc_base = 0;
+    for (int k = 0; k < nlev; ++k) {
+      precip_fluxes(k, precabs_resusp) = precabs;
+      precip_fluxes(k, precabc_resusp) = precabc;
+      precip_fluxes(k, precabs_base_resusp) = precabs_base;
+      precip_fluxes(k, precabc_base_resusp) = precabc_base;
+      precip_fluxes(k, precnums_base_resusp) = precnums_base;
+      precip_fluxes(k, precnumc_base_resusp) = precnumc_base;
+
       const int k_p1 = static_cast<int>(haero::min(k + 1, nlev - 1));
-      // OK, this is from the old mam4: Phase 2 is before Phase 1.
-      // Note that the phase loops goes from 2 to 1 in reverse order
-      // and the qqcw_sav is set first in phase 2 the used in phase 1.
-      if (lphase == 1) {
-        // traces reflects changes from modal_aero_calcsize and is the
-        // "most current" q
-        compute_q_tendencies_phase_1(
-            // These are the output values
-            scavt[k], bcscavt[k], rcscavt[k], rtscavt_sv_k.data(),
-            // The rest of the values are input only.
-            f_act_conv[k], scavcoefnum[k], scavcoefvol[k], totcond[k],
-            cmfdqr[k], conicw[k], evapc[k], evapr[k], prain[k], dlf[k], cldt[k],
-            cldcu[k], cldvst[k], cldvst[k_p1], cldvcu[k], cldvcu[k_p1],
-            sol_facti[k], sol_factic[k], sol_factb[k], state_q(k, mm),
-            ptend_q(k, mm), qqcw(k, mm), pdel[k], dt, mam_prevap_resusp_optcc,
-            jnv, mm, precabs, precabc, scavabs, scavabc, precabs_base,
-            precabc_base, precnums_base, precnumc_base);
-
-      } else { // if (lphase == 2)
-        // There is no cloud-borne aerosol water in the model, so this
-        // code block should NEVER execute for lspec =
-        // nspec_amode(m)+1 (i.e., jnummaswtr = 2). The code only
-        // worked because the "do lspec" loop cycles when lspec =
-        // nspec_amode(m)+1, but that does not make the code correct.
-        // FIXME: Not sure if this is a bug or not as qqcw_tmp seem
-        // different from the previous call and qqcw_tmp is always
-        // zero. May need further check.  - Shuaiqi Tang in
-        // refactoring for MAM4xx
-        const Real qqcw_tmp = 0.0;
-        compute_q_tendencies_phase_2(
-            // These are the output values
-            scavt[k], bcscavt[k], rcscavt[k], rtscavt_sv_k.data(), qqcw_tmp,
-            qqcw(k, mm),
-            // The rest of the values are input only.
-            // progs,
-            f_act_conv[k], scavcoefnum[k], scavcoefvol[k], totcond[k],
-            cmfdqr[k], conicw[k], evapc[k], evapr[k], prain[k], dlf[k], cldt[k],
-            cldcu[k], cldvst[k], cldvst[k_p1], cldvcu[k], cldvcu[k_p1],
-            sol_facti[k], sol_factic[k], sol_factb[k], pdel[k], dt,
-            mam_prevap_resusp_optcc, jnv, mm, k, precabs, precabc, scavabs,
-            scavabc, precabs_base, precabc_base, precnums_base, precnumc_base);
-      }
+      Real precabx_tmp, precabx_base_tmp, scavabx_tmp, precnumx_base_tmp;
+      Real resusp_x, scavabx_new;
+      wetdep_resusp(1, mam_prevap_resusp_optcc, pdel[k], evapr[k], precabs,
+                    precabs_base, scavabx_old, precnums_base, precabx_tmp,
+                    precabx_base_tmp, scavabx_tmp, precnumx_base_tmp,
+                    resusp_x);
+      wetdep_prevap(1, mam_prevap_resusp_optcc, pdel[k], prain[k], srcx,
+                    haero::max(cldvst[k_p1], small_value_2), precabx_tmp,
+                    precabx_base_tmp, scavabx_tmp, precnumx_base_tmp, precabs,
+                    precabs_base, scavabx_new, precnums_base);
+      wetdep_resusp(2, mam_prevap_resusp_optcc, pdel[k], evapc[k], precabc,
+                    precabc_base, scavabx_old, precnumc_base, precabx_tmp,
+                    precabx_base_tmp, scavabx_tmp, precnumx_base_tmp,
+                    resusp_x);
+      wetdep_prevap(2, mam_prevap_resusp_optcc, pdel[k], cmfdqr[k], srcx,
+                    haero::max(cldvcu[k_p1], small_value_2), precabx_tmp,
+                    precabx_base_tmp, scavabx_tmp, precnumx_base_tmp, precabc,
+                    precabc_base, scavabx_new, precnumc_base);
     }
   });
 }
 
+// number of blocks of levels (of about 8 levels each) into which
+// aero_model_wetdep splits the column for compute_q_tendencies_scan
+constexpr int wetdep_scan_num_blocks = (mam4::nlev + 7) / 8;
+
+// Computes the same tendencies as compute_q_tendencies, with the levels
+// spread over the threads of the team instead of a single sweep down the
+// column. The precipitation fluxes from above come from
+// compute_precip_fluxes. The scavenged tracer fluxes from above then follow
+// an affine recurrence (see wetdep_scavab_update), a scan whose combine
+// operator is the composition of affine maps. That operator is associative,
+// as Kokkos team scans require, but a team parallel_scan only sums its
+// values and takes no custom join, so this one uses a blocked two-pass
+// scheme:
+// 1. the levels are split into at most num_blocks blocks of equal length
+//    (but the last), spread over the threads of the team, and the affine
+//    maps of each block are composed into block_maps(block, :);
+// 2. for each block, the maps of the blocks above it give the fluxes entering
+//    it, and the block is swept with compute_q_tendencies_level.
+// The number of blocks does not depend on the team size. With a single block
+// this is the sweep of compute_q_tendencies; otherwise the fluxes entering
+// the blocks differ from it by roundoff. block_maps must have nlev rows and 4
+// columns.
+KOKKOS_INLINE_FUNCTION
+void compute_q_tendencies_scan(
+    const ThreadTeam &team, const View1D &f_act_conv,
+    const View1D &f_act_conv_coarse, const View1D &f_act_conv_coarse_dust,
+    const View1D &f_act_conv_coarse_nacl, const View1D &scavcoefnum,
+    const View1D &scavcoefvol, const View1D &totcond, const View1D &cmfdqr,
+    const View1D &conicw, const View1D &evapc, const View1D &evapr,
+    const View1D &prain, const View1D &dlf, const View1D &cldt,
+    const View1D &cldcu, const View1D &cldvst, const View1D &cldvcu,
+    const View1D &sol_facti, const View1D &sol_factic,
+    const View1D &sol_factb, const View1D &scavt, const View1D &bcscavt,
+    const View1D &rcscavt, const View2D &rtscavt_sv, const View2D &state_q,
+    const View2D &qqcw, const View2D &ptend_q, const View2D &precip_fluxes,
+    const View2D &block_maps, haero::ConstColumnView pdel, const Real dt,
+    const int jnummaswtr, const int jnv, const int mm, const int lphase,
+    const int imode, const int lspec, const int num_blocks) {
+  const int mam_prevap_resusp_optcc =
+      prevap_resusp_option(jnummaswtr, lphase, imode);
+  const bool coarse_interstitial =
+      lphase == 1 && imode == static_cast<int>(ModeIndex::Coarse);
+  const int max_blocks = haero::max(1, haero::min(num_blocks, nlev));
+  const int block_len = (nlev + max_blocks - 1) / max_blocks;
+  const int nblocks = (nlev + block_len - 1) / block_len;
+
+  // loads the precipitation fluxes entering level k
+  auto load_precip_fluxes = [&](const int k, Real &precabs, Real &precabc,
+                                Real &precabs_base, Real &precabc_base,
+                                Real &precnums_base, Real &precnumc_base) {
+    if (mam_prevap_resusp_optcc >= 100) {
+      precabs = precip_fluxes(k, precabs_resusp);
+      precabc = precip_fluxes(k, precabc_resusp);
+      precabs_base = precip_fluxes(k, precabs_base_resusp);
+      precabc_base = precip_fluxes(k, precabc_base_resusp);
+      precnums_base = precip_fluxes(k, precnums_base_resusp);
+      precnumc_base = precip_fluxes(k, precnumc_base_resusp);
+    } else {
+      precabs = precip_fluxes(k, precabs_noresusp);
+      precabc = precip_fluxes(k, precabc_noresusp);
+      precabs_base = precabc_base = precnums_base = precnumc_base = 0;
+    }
+  };
+
+  // first pass: the affine maps of the scavenged tracer fluxes of each block
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nblocks), [&](int b) {
+    Kokkos::single(Kokkos::PerThread(team), [&]() {
+      Real scavabs_ratio = 1, scavabs_source = 0;
+      Real scavabc_ratio = 1, scavabc_source = 0;
+      const int kend = haero::min((b + 1) * block_len, nlev);
+      for (int k = b * block_len; k < kend; ++k) {
+        Real precabs, precabc, precabs_base, precabc_base, precnums_base,
+            precnumc_base;
+        load_precip_fluxes(k, precabs, precabc, precabs_base, precabc_base,
+                           precnums_base, precnumc_base);
+        // the tracer as in compute_q_tendencies_phase_1/2
+        const bool is_strat_cloudborne = lphase == 2;
+        const Real tracer = is_strat_cloudborne
+                                ? qqcw(k, mm)
+                                : state_q(k, mm) + ptend_q(k, mm) * dt;
+        const Real qqcw_k = is_strat_cloudborne ? 0.0 : qqcw(k, mm);
+        Real scavcoef = 0;
+        if (jnv)
+          scavcoef = (1 == jnv) ? scavcoefnum[k] : scavcoefvol[k];
+        const Real f_act_conv_k =
+            coarse_interstitial
+                ? coarse_f_act_conv(jnummaswtr, lspec, imode,
+                                    f_act_conv_coarse[k],
+                                    f_act_conv_coarse_dust[k],
+                                    f_act_conv_coarse_nacl[k])
+                : f_act_conv[k];
+        Real ratio_s, source_s, ratio_c, source_c;
+        wetdep_scavab_update(
+            dt, pdel[k], cmfdqr[k], evapc[k], dlf[k], conicw[k], prain[k],
+            evapr[k], totcond[k], cldt[k], cldcu[k], cldvcu[k], cldvst[k],
+            sol_factb[k], sol_facti[k], sol_factic[k],
+            mam_prevap_resusp_optcc, is_strat_cloudborne, scavcoef,
+            f_act_conv_k, tracer, qqcw_k, precabs, precabc, precabs_base,
+            precabc_base, precnums_base, precnumc_base, ratio_s, source_s,
+            ratio_c, source_c);
+        // apply this level's map after those of the levels above
+        scavabs_ratio = ratio_s * scavabs_ratio;
+        scavabs_source = ratio_s * scavabs_source + source_s;
+        scavabc_ratio = ratio_c * scavabc_ratio;
+        scavabc_source = ratio_c * scavabc_source + source_c;
+      }
+      block_maps(b, 0) = scavabs_ratio;
+      block_maps(b, 1) = scavabs_source;
+      block_maps(b, 2) = scavabc_ratio;
+      block_maps(b, 3) = scavabc_source;
+    });
+  });
+  team.team_barrier();
+
+  // second pass: the fluxes entering each block, then the tendencies
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nblocks), [&](int b) {
+    Kokkos::single(Kokkos::PerThread(team), [&]() {
+      Real scavabs = 0, scavabc = 0;
+      for (int j = 0; j < b; ++j) {
+        scavabs = block_maps(j, 0) * scavabs + block_maps(j, 1);
+        scavabc = block_maps(j, 2) * scavabc + block_maps(j, 3);
+      }
+      const int kbegin = b * block_len;
+      const int kend = haero::min(kbegin + block_len, nlev);
+      Real precabs, precabc, precabs_base, precabc_base, precnums_base,
+          precnumc_base;
+      load_precip_fluxes(kbegin, precabs, precabc, precabs_base,
+                         precabc_base, precnums_base, precnumc_base);
+      for (int k = kbegin; k < kend; ++k) {
+        compute_q_tendencies_level(
+            k, f_act_conv, f_act_conv_coarse, f_act_conv_coarse_dust,
+            f_act_conv_coarse_nacl, scavcoefnum, scavcoefvol, totcond, cmfdqr,
+            conicw, evapc, evapr, prain, dlf, cldt, cldcu, cldvst, cldvcu,
+            sol_facti, sol_factic, sol_factb, scavt, bcscavt, rcscavt,
+            rtscavt_sv, state_q, qqcw, ptend_q, pdel, dt, jnummaswtr, jnv, mm,
+            lphase, imode, lspec, precabs, precabc, scavabs, scavabc,
+            precabs_base, precabc_base, precnums_base, precnumc_base);
+      }
+    });
+  });
+}
+
 KOKKOS_INLINE_FUNCTION
 void update_q_tendencies(const ThreadTeam &team, const View2D &ptend_q,
                          const View1D &scavt, const int mm, const int nlev) {
@@ -1485,9 +1862,166 @@ void update_q_tendencies(const ThreadTeam &team, const View2D &ptend_q,
   });
 }
 
+// A wet-deposited tracer: the mode, phase (1 = interstitial, 2 =
+// cloud-borne) and species index of the tracer, and the corresponding
+// outputs of aero_model::index_ordering
+struct WetdepTracer {
+  int imode, lphase, lspec;
+  int mm, jnv, jnummaswtr;
+};
+
+// upper bound on the number of wet-deposited tracers (the aerosol mass and
+// number mixing ratios of both phases)
+constexpr int max_wetdep_tracers = 2 * (pcnst - utils::aero_start_ind());
+
+// Lists the wet-deposited tracers in the order in which aero_model_wetdep
+// processes them (accumulation, aitken, primary carbon, then coarse mode;
+// cloud-borne before interstitial; mass before number), and returns their
+// number.
+KOKKOS_INLINE_FUNCTION
+int list_wetdep_tracers(WetdepTracer tracers[max_wetdep_tracers]) {
+  const int mode_order_change[4] = {0, 1, 3, 2};
+  const int jaerowater = 2;
+  int ntracers = 0;
+  for (int mtmp = 0; mtmp < AeroConfig::num_modes(); ++mtmp) {
+    const int imode = mode_order_change[mtmp];
+    for (int lphase = 2; 1 <= lphase; --lphase) {
+      for (int lspec = 0; lspec < num_species_mode(imode) + 2; ++lspec) {
+        int mm, jnv, jnummaswtr;
+        aero_model::index_ordering(lspec, imode, lphase, mm, jnv, jnummaswtr);
+        // bypass wet aerosols
+        if (0 <= mm && jnummaswtr != jaerowater) {
+          WetdepTracer &tracer = tracers[ntracers++];
+          tracer.imode = imode;
+          tracer.lphase = lphase;
+          tracer.lspec = lspec;
+          tracer.mm = mm;
+          tracer.jnv = jnv;
+          tracer.jnummaswtr = jnummaswtr;
+        }
+      }
+    }
+  }
+  return ntracers;
+}
+
+// Computes the wet removal tendency of a single tracer with its own sweep
+// down the column, and returns its surface flux [kg/m2/s]. This is the
+// per-tracer counterpart of compute_q_tendencies, meant to be called by one
+// thread of a team, with the per-mode quantities (sol_fact*, f_act_conv and
+// the impaction scavenging coefficients) evaluated level by level. For
+// interstitial tracers, the tendency is added to ptend_q.
+//
+// Resuspension to the coarse mode is handled in one of two ways:
+// * if take_resusp is true, the tracer accumulates into and takes up
+//   rtscavt_sv(k, :) exactly as in compute_q_tendencies, so rtscavt_sv must
+//   already hold the contributions of all tracers processed before it;
+// * otherwise, the resuspension that the tracer sends to the coarse mode at
+//   level k is stored in resusp(k, slot) and rtscavt_sv is left untouched.
+KOKKOS_INLINE_FUNCTION
+Real compute_tracer_tendencies(
+    const WetdepTracer &tracer, const bool take_resusp,
+    const TableReal scavimptblvol[aero_model::nimptblgrow_total]
+                                 [AeroConfig::num_modes()],
+    const TableReal scavimptblnum[aero_model::nimptblgrow_total]
+                                 [AeroConfig::num_modes()],
+    const View2D &wet_geometric_mean_diameter_i, const Bool1D &isprx,
+    const View1D &f_act_conv_coarse, const View1D &f_act_conv_coarse_dust,
+    const View1D &f_act_conv_coarse_nacl, const View1D &totcond,
+    const View1D &cmfdqr, const View1D &conicw, const View1D &evapc,
+    const View1D &evapr, const View1D &prain, const View1D &dlf,
+    const View1D &cldt, const View1D &cldcu, const View1D &cldvst,
+    const View1D &cldvcu, const View2D &state_q, const View2D &qqcw,
+    const View2D &ptend_q, const View2D &rtscavt_sv, const View2D &resusp,
+    const int slot, haero::ConstColumnView pdel, const Real dt) {
+  const int imode = tracer.imode;
+  const int lphase = tracer.lphase;
+  const int mm = tracer.mm;
+  const int mmtoo = aero_model::mmtoo_prevap_resusp(mm);
+  const int mam_prevap_resusp_optcc =
+      prevap_resusp_option(tracer.jnummaswtr, lphase, imode);
+  const bool coarse_interstitial =
+      lphase == 1 && imode == static_cast<int>(ModeIndex::Coarse);
+  const Real dgnum_amode_imode = modes(imode).nom_diameter;
+  const Real gravit = Constants::gravity;
+  const Real zero = 0;
+
+  Real precabs = 0;
+  Real precabc = 0;
+  Real scavabs = 0;
+  Real scavabc = 0;
+  Real precabs_base = 0;
+  Real precabc_base = 0;
+  Real precnums_base = 0;
+  Real precnumc_base = 0;
+  // resuspension of the tracer at the current level, if not taken up
+  Real rtscavt_tracer[pcnst] = {};
+  Real sflx = 0;
+  for (int k = 0; k < nlev; ++k) {
+    Real sol_facti, sol_factic, sol_factb, f_act_conv;
+    aero_model::define_act_frac(lphase, imode, sol_facti, sol_factic,
+                                sol_factb, f_act_conv);
+    if (coarse_interstitial)
+      f_act_conv = coarse_f_act_conv(
+          tracer.jnummaswtr, tracer.lspec, imode, f_act_conv_coarse[k],
+          f_act_conv_coarse_dust[k], f_act_conv_coarse_nacl[k]);
+    Real *rtscavt_k =
+        take_resusp ? ekat::subview(rtscavt_sv, k).data() : rtscavt_tracer;
+    const int k_p1 = static_cast<int>(haero::min(k + 1, nlev - 1));
+    Real scavt = 0, bcscavt = 0, rcscavt = 0;
+    if (lphase == 1) {
+      Real scavcoefnum = 0, scavcoefvol = 0;
+      aero_model::modal_aero_bcscavcoef_get(
+          imode, isprx[k], wet_geometric_mean_diameter_i(imode, k),
+          dgnum_amode_imode, scavimptblvol, scavimptblnum, scavcoefnum,
+          scavcoefvol);
+      compute_q_tendencies_phase_1(
+          scavt, bcscavt, rcscavt, rtscavt_k, f_act_conv, scavcoefnum,
+          scavcoefvol, totcond[k], cmfdqr[k], conicw[k], evapc[k], evapr[k],
+          prain[k], dlf[k], cldt[k], cldcu[k], cldvst[k], cldvst[k_p1],
+          cldvcu[k], cldvcu[k_p1], sol_facti, sol_factic, sol_factb,
+          state_q(k, mm), ptend_q(k, mm), qqcw(k, mm), pdel[k], dt,
+          mam_prevap_resusp_optcc, tracer.jnv, mm, precabs, precabc, scavabs,
+          scavabc, precabs_base, precabc_base, precnums_base, precnumc_base);
+      // no other tracer reads or writes this entry
+      ptend_q(k, mm) += scavt;
+    } else {
+      // the impaction scavenging coefficients are not used for cloud-borne
+      // aerosols (jnv = 0)
+      const Real qqcw_tmp = 0.0;
+      compute_q_tendencies_phase_2(
+          scavt, bcscavt, rcscavt, rtscavt_k, qqcw_tmp, qqcw(k, mm),
+          f_act_conv, zero, zero, totcond[k], cmfdqr[k], conicw[k], evapc[k],
+          evapr[k], prain[k], dlf[k], cldt[k], cldcu[k], cldvst[k],
+          cldvst[k_p1], cldvcu[k], cldvcu[k_p1], sol_facti, sol_factic,
+          sol_factb, pdel[k], dt, mam_prevap_resusp_optcc, tracer.jnv, mm, k,
+          precabs, precabc, scavabs, scavabc, precabs_base, precabc_base,
+          precnums_base, precnumc_base);
+    }
+    if (!take_resusp) {
+      resusp(k, slot) = (mmtoo > 0) ? rtscavt_tracer[mmtoo] : zero;
+      if (mmtoo > 0)
+        rtscavt_tracer[mmtoo] = zero;
+    }
+    sflx += scavt * pdel[k] / gravit;
+  }
+  return sflx;
+}
+
 // =============================================================================
+// How aero_model_wetdep sweeps its tracers down the column
+enum class WetdepExecution {
+  Serial,         // tracer by tracer, each sweep on one thread
+  TracerParallel, // one tracer per thread (see compute_tracer_tendencies)
+  LevelScan       // tracer by tracer, each sweep spread over the team (see
+                  // compute_q_tendencies_scan)
+};
+
+// Returns the length of the work array of aero_model_wetdep, which depends on
+// its execution.
 KOKKOS_INLINE_FUNCTION
-int get_aero_model_wetdep_work_len() {
+int get_aero_model_wetdep_work_len(
+    const WetdepExecution execution = WetdepExecution::Serial) {
   // wet_geometric_mean_diameter_i + state_q + qqcw
   int work_len =
       // mam4::nlev * AeroConfig::num_modes() * mam4::nlev + //
@@ -1500,6 +2034,11 @@ int get_aero_model_wetdep_work_len() {
       3 * pcnst +             //  qsrflx_mzaer2cnvpr, rtscavt_sv
       2 * mam4::nlev * pcnst; // ptend_q, rtscavt_sv
                               // dry_geometric_mean_diameter_i, qaerwat, wetdens
+  if (execution == WetdepExecution::TracerParallel)
+    work_len += mam4::nlev * max_wetdep_tracers; // resusp
+  else if (execution == WetdepExecution::LevelScan)
+    work_len += mam4::nlev * (num_precip_fluxes + 4); // precip_fluxes,
+                                                      // block_maps
   return work_len;
 }
 // =============================================================================
@@ -1521,7 +2060,11 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
                        const View2D &qaerwat, const View2D &wetdens,
                        // output
                        const View1D &aerdepwetis, const View1D &aerdepwetcw,
-                       const View1D &work) {
+                       const View1D &work,
+                       const WetdepExecution execution =
+                           WetdepExecution::Serial,
+                       const ColumnSkipStats &skip_stats = ColumnSkipStats(),
+                       const bool allow_column_skip = true) {
   // cldn layer cloud fraction [fraction]; CLD
 
   // FIXME: do we need to set the variables inside of set_srf_wetdep ?
@@ -1534,7 +2077,6 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
 
   constexpr int ntot_amode = AeroConfig::num_modes();
   constexpr int nlev = mam4::nlev;
-  constexpr int maxd_aspectype = mam4::aero_model::maxd_aspectype;
   constexpr int zero = 0.0;
 
   auto work_ptr = (Real *)work.data();
@@ -1661,6 +2203,24 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
   View2D qsrflx_mzaer2cnvpr(work_ptr, aero_model::pcnst, 2);
   work_ptr += aero_model::pcnst * 2;
 
+  // resuspension to the coarse mode of each tracer, for the tracer-parallel
+  // execution
+  View2D resusp;
+  if (execution == WetdepExecution::TracerParallel) {
+    resusp = View2D(work_ptr, mam4::nlev, max_wetdep_tracers);
+    work_ptr += mam4::nlev * max_wetdep_tracers;
+  }
+
+  // precipitation fluxes from above and affine maps of the level blocks, for
+  // the level-scan execution
+  View2D precip_fluxes, block_maps;
+  if (execution == WetdepExecution::LevelScan) {
+    precip_fluxes = View2D(work_ptr, mam4::nlev, num_precip_fluxes);
+    work_ptr += mam4::nlev * num_precip_fluxes;
+    block_maps = View2D(work_ptr, mam4::nlev, 4);
+    work_ptr += mam4::nlev * 4;
+  }
+
   /// error check
   const int workspace_used(work_ptr - work.data()),
       workspace_extent(work.extent(0));
@@ -1727,99 +2287,40 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
   // accumulation modes is done in conjunction with the dry radius calculation
   // compute calcsize and
 
+  // e3sm species tables and calcsize tables, shared by all levels
+  const modal_aero_calcsize::CalcsizeWaterUptakeParams calcsize_params;
   Kokkos::parallel_for(Kokkos::TeamThreadRange(team, 0, nlev), [&](int kk) {
     const auto state_q_kk = ekat::subview(state_q, kk);
     const auto qqcw_kk = ekat::subview(qqcw, kk);
     const auto ptend_q_kk = ekat::subview(ptend_q, kk);
+    // the fused calcsize and water uptake stage computes all of these
     Real dgnumwet_m_kk[ntot_amode] = {};
-    // wetdens and qaerwat are input/ouput to water_uptake
     Real qaerwat_m_kk[ntot_amode] = {};
     Real wetdens_kk[ntot_amode] = {};
-    // dgncur_a is aerosol particle diameter and is an input to
-    // calcsize. But calcsize reset its value.
     Real dgnumdry_m_kk[ntot_amode] = {};
-    for (int imode = 0; imode < ntot_amode; imode++) {
-      dgnumwet_m_kk[imode] = wet_geometric_mean_diameter_i(imode, kk);
-      dgnumdry_m_kk[imode] = dry_geometric_mean_diameter_i(imode, kk);
-      qaerwat_m_kk[imode] = qaerwat(imode, kk);
-      wetdens_kk[imode] = wetdens(imode, kk);
-    }
 
     {
-
-      const bool do_adjust = true;
-      const bool do_aitacc_transfer = true;
       const bool update_mmr = true;
 
-      int numptr_amode[ntot_amode];
-      int mam_idx[ntot_amode][ndrop::nspec_max];
-      int mam_cnst_idx[ntot_amode][ndrop::nspec_max];
-      int nspec_amode[ntot_amode];
-      int lspectype_amode[maxd_aspectype][ntot_amode];
-      int lmassptr_amode[maxd_aspectype][ntot_amode];
-      Real specdens_amode[maxd_aspectype];
-      Real spechygro[maxd_aspectype];
-
-      ndrop::get_e3sm_parameters(nspec_amode, lspectype_amode, lmassptr_amode,
-                                 numptr_amode, specdens_amode, spechygro,
-                                 mam_idx, mam_cnst_idx);
-
-      Real inv_density[ntot_amode][AeroConfig::num_aerosol_ids()] = {};
-      Real num2vol_ratio_min[ntot_amode] = {};
-      Real num2vol_ratio_max[ntot_amode] = {};
-      Real num2vol_ratio_max_nmodes[ntot_amode] = {};
-      Real num2vol_ratio_min_nmodes[ntot_amode] = {};
-      Real num2vol_ratio_nom_nmodes[ntot_amode] = {};
-      Real dgnmin_nmodes[ntot_amode] = {};
-      Real dgnmax_nmodes[ntot_amode] = {};
-      Real dgnnom_nmodes[ntot_amode] = {};
-      //
-      Real mean_std_dev_nmodes[ntot_amode] = {};
-
-      // outputs
-      bool noxf_acc2ait[AeroConfig::num_aerosol_ids()] = {};
-      int n_common_species_ait_accum = {};
-      int ait_spec_in_acc[AeroConfig::num_aerosol_ids()] = {};
-      int acc_spec_in_ait[AeroConfig::num_aerosol_ids()] = {};
-      modal_aero_calcsize::init_calcsize(
-          inv_density, num2vol_ratio_min, num2vol_ratio_max,
-          num2vol_ratio_max_nmodes, num2vol_ratio_min_nmodes,
-          num2vol_ratio_nom_nmodes, dgnmin_nmodes, dgnmax_nmodes, dgnnom_nmodes,
-          mean_std_dev_nmodes,
-          // outputs
-          noxf_acc2ait, n_common_species_ait_accum, ait_spec_in_acc,
-          acc_spec_in_ait);
-
       Real dgncur_c_kk[ntot_amode] = {};
       Real dqqcwdt_kk[pcnst] = {};
       //  Calculate aerosol size distribution parameters and aerosol water
       //  uptake
       // For prognostic aerosols
-      modal_aero_calcsize::modal_aero_calcsize_sub(
-          state_q_kk.data(), // in/out
-          qqcw_kk.data(),    // in/out
-          dt, do_adjust, do_aitacc_transfer, update_mmr, lmassptr_amode,
-          numptr_amode,
-          inv_density, // in
-          num2vol_ratio_min, num2vol_ratio_max, num2vol_ratio_max_nmodes,
-          num2vol_ratio_min_nmodes, num2vol_ratio_nom_nmodes, dgnmin_nmodes,
-          dgnmax_nmodes, dgnnom_nmodes, mean_std_dev_nmodes, noxf_acc2ait,
-          n_common_species_ait_accum, ait_spec_in_acc, acc_spec_in_ait,
+      modal_aero_calcsize::modal_aero_calcsize_water_uptake_dr(
+          calcsize_params, state_q_kk.data(), qqcw_kk.data(), dt, update_mmr,
+          temperature(kk), pmid(kk), cldn_prev_step(kk),
           // outputs
-          dgnumdry_m_kk, dgncur_c_kk, ptend_q_kk.data(), dqqcwdt_kk);
-      // update could aerosol.
+          dgnumdry_m_kk, dgncur_c_kk, ptend_q_kk.data(), dqqcwdt_kk,
+          dgnumwet_m_kk, qaerwat_m_kk, wetdens_kk);
 
+      // update could aerosol.
       if (update_mmr) {
         // Note: it only needs to update aerosol variables.
         for (int i = utils::aero_start_ind(); i < pcnst; ++i) {
           qqcw(kk, i) = haero::max(zero, qqcw(kk, i) + dqqcwdt_kk[i] * dt);
         }
       } // end update could aerosols.
-
-      mam4::water_uptake::modal_aero_water_uptake_dr(
-          nspec_amode, specdens_amode, spechygro, lspectype_amode,
-          state_q_kk.data(), temperature(kk), pmid(kk), cldn_prev_step(kk),
-          dgnumdry_m_kk, dgnumwet_m_kk, qaerwat_m_kk, wetdens_kk);
     }
 
     // team.team_barrier();
@@ -1838,7 +2339,16 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
   // skip wet deposition if nwetdep is non-positive
   if (nwetdep < 1)
     return;
-  {
+
+  // a column without precipitation keeps the tendencies of calcsize and zero
+  // deposition fluxes, so it skips the wet removal unless allow_column_skip is
+  // false
+  const bool has_precipitation =
+      !allow_column_skip ||
+      wetdep::column_has_precipitation(team, prain, evapr, rprddp, rprdsh,
+                                       evapcdp, evapcsh, nlev);
+  skip_stats.record(team, !has_precipitation);
+  if (has_precipitation) {
 
     // // change mode order as mmode_loop_aa loops in a different order
     const int mode_order_change[4] = {0, 1, 3, 2};
@@ -1885,8 +2395,8 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
                       state_q, ptend_q, dt, nlev);
     team.team_barrier();
 
-    Real scavimptblnum[aero_model::nimptblgrow_total][ntot_amode];
-    Real scavimptblvol[aero_model::nimptblgrow_total][ntot_amode];
+    TableReal scavimptblnum[aero_model::nimptblgrow_total][ntot_amode];
+    TableReal scavimptblvol[aero_model::nimptblgrow_total][ntot_amode];
     {
 
       // const int num_modes = AeroConfig::num_modes();
@@ -1909,114 +2419,188 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
                                              scavimptblvol);
     }
 
-    // main loop over aerosol modes
-    for (int mtmp = 0; mtmp < AeroConfig::num_modes(); ++mtmp) {
-      // for mam4, do accum, aitken, pcarbon, then coarse
-      // so change the order of 2 and 3 here
-      // for mam4:
-      // do   accum = 0,
-      // then aitken = 1,
-      // then pcarbon - 3,
-      // then coarse = 2
-      const int imode = mode_order_change[mtmp];
-
-      // loop over interstitial (1) and cloud-borne (2) forms
-      // BSINGH (09/12/2014):Do cloudborne first for unified convection
-      // scheme so that the resuspension of cloudborne can be saved then
-      // applied to interstitial (RCE)
-
-      // do cloudborne (2) first then interstitial (1)
-      for (int lphase = 2; 1 <= lphase; --lphase) {
-
-        if (lphase == 1) { // interstial aerosol
-          // Computes lookup table for aerosol impaction/interception scavenging
-          // rates
-          wetdep::modal_aero_bcscavcoef_get(
-              team, wet_geometric_mean_diameter_i, isprx, scavimptblvol,
-              scavimptblnum, scavcoefnum, scavcoefvol, imode, nlev);
-        }
-        // define sol_factb and sol_facti values, and f_act_conv
-        wetdep::define_act_frac(team, sol_facti, sol_factic, sol_factb,
-                                f_act_conv, lphase, imode, nlev);
+    if (execution == WetdepExecution::TracerParallel) {
+      // Each thread of the team sweeps down the column for its own tracers,
+      // so no barriers are needed between tracers. The only coupling among
+      // tracers is the resuspension to the coarse mode, which the
+      // interstitial coarse-mode tracers take up; they are processed last,
+      // and each of them only resuspends into itself. So all other tracers
+      // are processed first, their resuspension is added to rtscavt_sv in
+      // the order of the serial loop below, and the interstitial coarse-mode
+      // tracers are processed after that. This reproduces the tendencies of
+      // the serial loop.
+      WetdepTracer tracers[max_wetdep_tracers];
+      const int ntracers = list_wetdep_tracers(tracers);
+      int nresusp = ntracers;
+      while (0 < nresusp && tracers[nresusp - 1].lphase == 1 &&
+             tracers[nresusp - 1].imode == static_cast<int>(ModeIndex::Coarse))
+        --nresusp;
+
+      // processes the tracers in [begin, end)
+      auto process_tracers = [&](const int begin, const int end,
+                                 const bool take_resusp) {
+        Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(team, begin, end), [&](int i) {
+              Kokkos::single(Kokkos::PerThread(team), [&]() {
+                const WetdepTracer &tracer = tracers[i];
+                const Real sflx = compute_tracer_tendencies(
+                    tracer, take_resusp, scavimptblvol, scavimptblnum,
+                    wet_geometric_mean_diameter_i, isprx, f_act_conv_coarse,
+                    f_act_conv_coarse_dust, f_act_conv_coarse_nacl, totcond,
+                    cmfdqr, conicw, evapc, evapr, prain, dlf, cldt, cldcu,
+                    cldvst, cldvcu, state_q, qqcw, ptend_q, rtscavt_sv,
+                    resusp, i, pdel, dt);
+                if (tracer.lphase == 1)
+                  aerdepwetis[tracer.mm] = sflx;
+                else
+                  aerdepwetcw[tracer.mm] = sflx;
+              });
+            });
+      };
+
+      process_tracers(0, nresusp, false);
+      team.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, nlev), [&](int k) {
+        Kokkos::single(Kokkos::PerThread(team), [&]() {
+          for (int i = 0; i < nresusp; ++i) {
+            const int mmtoo = aero_model::mmtoo_prevap_resusp(tracers[i].mm);
+            if (mmtoo > 0)
+              rtscavt_sv(k, mmtoo) += resusp(k, i);
+          }
+        });
+      });
+      team.team_barrier();
+      process_tracers(nresusp, ntracers, true);
+    } else {
+      if (execution == WetdepExecution::LevelScan) {
+        wetdep::compute_precip_fluxes(team, cmfdqr, evapc, evapr, prain,
+                                      cldvst, cldvcu, pdel, precip_fluxes);
         team.team_barrier();
+      }
 
-        // REASTER 08/12/2015 - changed ordering (mass then number) for
-        // prevap resuspend to coarse loop over number + chem constituents +
-        // water index for aerosol number / chem-mass / water-mass
-
-        for (int lspec = 0; lspec < num_species_mode(imode) + 2; ++lspec) {
-          int mm, jnv, jnummaswtr;
-          aero_model::index_ordering(lspec, imode, lphase, mm, jnv, jnummaswtr);
-          // bypass wet aerosols
-          if (0 <= mm && jnummaswtr != jaerowater) {
-
-            wetdep::compute_q_tendencies( // tendencies are in scavt
-                team, f_act_conv, f_act_conv_coarse, f_act_conv_coarse_dust,
-                f_act_conv_coarse_nacl, scavcoefnum, scavcoefvol, totcond,
-                cmfdqr, conicw, evapc, evapr, prain, dlf, cldt, cldcu, cldst,
-                cldvst, cldvcu, sol_facti, sol_factic, sol_factb, scavt,
-                bcscavt, rcscavt, rtscavt_sv, state_q, qqcw, ptend_q, pdel, dt,
-                jnummaswtr, jnv, mm, lphase, imode, lspec);
-            team.team_barrier();
-
-            // Note: update tendencies only in lphase == 1
-            if (lphase == 1) {
-              // Update ptend_q from the tendency, scavt
-              wetdep::update_q_tendencies(team, ptend_q, scavt, mm, nlev);
-            }
-            if (lphase == 1) {
-              aerdepwetis[mm] =
-                  aero_model::calc_sfc_flux(team, scavt, pdel, nlev);
-            } else // if (lphase == 2)
-            {
-              aerdepwetcw[mm] =
-                  aero_model::calc_sfc_flux(team, scavt, pdel, nlev);
-            }
+      // main loop over aerosol modes
+      for (int mtmp = 0; mtmp < AeroConfig::num_modes(); ++mtmp) {
+        // for mam4, do accum, aitken, pcarbon, then coarse
+        // so change the order of 2 and 3 here
+        // for mam4:
+        // do   accum = 0,
+        // then aitken = 1,
+        // then pcarbon - 3,
+        // then coarse = 2
+        const int imode = mode_order_change[mtmp];
+
+        // loop over interstitial (1) and cloud-borne (2) forms
+        // BSINGH (09/12/2014):Do cloudborne first for unified convection
+        // scheme so that the resuspension of cloudborne can be saved then
+        // applied to interstitial (RCE)
+
+        // do cloudborne (2) first then interstitial (1)
+        for (int lphase = 2; 1 <= lphase; --lphase) {
+
+          if (lphase == 1) { // interstial aerosol
+            // Computes lookup table for aerosol impaction/interception
+            // scavenging rates
+            wetdep::modal_aero_bcscavcoef_get(
+                team, wet_geometric_mean_diameter_i, isprx, scavimptblvol,
+                scavimptblnum, scavcoefnum, scavcoefvol, imode, nlev);
+          }
+          // define sol_factb and sol_facti values, and f_act_conv
+          wetdep::define_act_frac(team, sol_facti, sol_factic, sol_factb,
+                                  f_act_conv, lphase, imode, nlev);
+          team.team_barrier();
+
+          // REASTER 08/12/2015 - changed ordering (mass then number) for
+          // prevap resuspend to coarse loop over number + chem constituents +
+          // water index for aerosol number / chem-mass / water-mass
+
+          for (int lspec = 0; lspec < num_species_mode(imode) + 2; ++lspec) {
+            int mm, jnv, jnummaswtr;
+            aero_model::index_ordering(lspec, imode, lphase, mm, jnv,
+                                       jnummaswtr);
+            // bypass wet aerosols
+            if (0 <= mm && jnummaswtr != jaerowater) {
+
+              // tendencies are in scavt
+              if (execution == WetdepExecution::LevelScan)
+                wetdep::compute_q_tendencies_scan(
+                    team, f_act_conv, f_act_conv_coarse,
+                    f_act_conv_coarse_dust, f_act_conv_coarse_nacl,
+                    scavcoefnum, scavcoefvol, totcond, cmfdqr, conicw, evapc,
+                    evapr, prain, dlf, cldt, cldcu, cldvst, cldvcu, sol_facti,
+                    sol_factic, sol_factb, scavt, bcscavt, rcscavt,
+                    rtscavt_sv, state_q, qqcw, ptend_q, precip_fluxes,
+                    block_maps, pdel, dt, jnummaswtr, jnv, mm, lphase, imode,
+                    lspec, wetdep_scan_num_blocks);
+              else
+                wetdep::compute_q_tendencies(
+                    team, f_act_conv, f_act_conv_coarse,
+                    f_act_conv_coarse_dust, f_act_conv_coarse_nacl,
+                    scavcoefnum, scavcoefvol, totcond, cmfdqr, conicw, evapc,
+                    evapr, prain, dlf, cldt, cldcu, cldst, cldvst, cldvcu,
+                    sol_facti, sol_factic, sol_factb, scavt, bcscavt, rcscavt,
+                    rtscavt_sv, state_q, qqcw, ptend_q, pdel, dt, jnummaswtr,
+                    jnv, mm, lphase, imode, lspec);
+              team.team_barrier();
+
+              // Note: update tendencies only in lphase == 1
+              if (lphase == 1) {
+                // Update ptend_q from the tendency, scavt
+                wetdep::update_q_tendencies(team, ptend_q, scavt, mm, nlev);
+              }
+              if (lphase == 1) {
+                aerdepwetis[mm] =
+                    aero_model::calc_sfc_flux(team, scavt, pdel, nlev);
+              } else // if (lphase == 2)
+              {
+                aerdepwetcw[mm] =
+                    aero_model::calc_sfc_flux(team, scavt, pdel, nlev);
+              }
 #if 0
-            // Note: Commenting it out because it produces unused variable warnings.
-            Real rprdshsum = aero_model::calc_sfc_flux(team, rprdsh, pdel, nlev);
-            Real rprddpsum = aero_model::calc_sfc_flux(team, rprddp, pdel, nlev);
-            Real evapcdpsum = aero_model::calc_sfc_flux(team, evapcdp, pdel, nlev);
-            Real evapcshsum = aero_model::calc_sfc_flux(team, evapcsh, pdel, nlev);
-
-            // NOTE. Adding this team_barrier fixed one race condition.
-            team.team_barrier();
-            const Real sflxbc =
-                aero_model::calc_sfc_flux(team, bcscavt, pdel, nlev);
-            const Real sflxec =
-                aero_model::calc_sfc_flux(team, rcscavt, pdel, nlev);
-
-            // apportion convective surface fluxes to deep and shallow
-            // conv this could be done more accurately in subr wetdepa
-            // since deep and shallow rarely occur simultaneously, and
-            // these fields are just diagnostics, this approximate method
-            // is adequate only do this for interstitial aerosol, because
-            // conv clouds to not affect the stratiform-cloudborne
-            // aerosol.
-            // NOTE. Adding this team_barrier fixed one race condition.
-            team.team_barrier();
-
-            // FIXME: The following code is causing race condition errors in the
-            // computer-sanitizer.
-            //  I commented it out because we do not need it in the emaxx-mam4xx
-            //  interface.
-            {
-              Real sflxbcdp, sflxecdp;
-              aero_model::apportion_sfc_flux_deep(rprddpsum, rprdshsum,
-                                                evapcdpsum, evapcshsum, sflxbc,
-                                                sflxec, sflxbcdp, sflxecdp);
-
-              // when ma_convproc_intr is used, convective in-cloud wet
-              // removal is done there the convective (total and deep)
-              // precip-evap-resuspension includes in- and below-cloud
-              // contributions, so pass the below-cloud contribution to
-              // ma_convproc_intr
-              //
-              // NOTE: ma_convproc_intr no longer uses these
-              qsrflx_mzaer2cnvpr(mm, 0) = sflxec;
-              qsrflx_mzaer2cnvpr(mm, 1) = sflxecdp;
-            }
+              // Note: Commenting it out because it produces unused variable warnings.
+              Real rprdshsum = aero_model::calc_sfc_flux(team, rprdsh, pdel, nlev);
+              Real rprddpsum = aero_model::calc_sfc_flux(team, rprddp, pdel, nlev);
+              Real evapcdpsum = aero_model::calc_sfc_flux(team, evapcdp, pdel, nlev);
+              Real evapcshsum = aero_model::calc_sfc_flux(team, evapcsh, pdel, nlev);
+
+              // NOTE. Adding this team_barrier fixed one race condition.
+              team.team_barrier();
+              const Real sflxbc =
+                  aero_model::calc_sfc_flux(team, bcscavt, pdel, nlev);
+              const Real sflxec =
+                  aero_model::calc_sfc_flux(team, rcscavt, pdel, nlev);
+
+              // apportion convective surface fluxes to deep and shallow
+              // conv this could be done more accurately in subr wetdepa
+              // since deep and shallow rarely occur simultaneously, and
+              // these fields are just diagnostics, this approximate method
+              // is adequate only do this for interstitial aerosol, because
+              // conv clouds to not affect the stratiform-cloudborne
+              // aerosol.
+              // NOTE. Adding this team_barrier fixed one race condition.
+              team.team_barrier();
+
+              // FIXME: The following code is causing race condition errors in the
+              // computer-sanitizer.
+              //  I commented it out because we do not need it in the emaxx-mam4xx
+              //  interface.
+              {
+                Real sflxbcdp, sflxecdp;
+                aero_model::apportion_sfc_flux_deep(rprddpsum, rprdshsum,
+                                                  evapcdpsum, evapcshsum, sflxbc,
+                                                  sflxec, sflxbcdp, sflxecdp);
+
+                // when ma_convproc_intr is used, convective in-cloud wet
+                // removal is done there the convective (total and deep)
+                // precip-evap-resuspension includes in- and below-cloud
+                // contributions, so pass the below-cloud contribution to
+                // ma_convproc_intr
+                //
+                // NOTE: ma_convproc_intr no longer uses these
+                qsrflx_mzaer2cnvpr(mm, 0) = sflxec;
+                qsrflx_mzaer2cnvpr(mm, 1) = sflxecdp;
+              }
 #endif
+            }
           }
         }
       }
@@ -2036,6 +2620,31 @@ void aero_model_wetdep(const ThreadTeam &team, const Atmosphere &atm,
 
 } // aero_model_wetdep
 
+// Returns work memory for calling aero_model_wetdep with the given execution
+// on each column of a batch of num_columns columns (see column_batch.hpp).
+inline TeamWorkMemory aero_model_wetdep_work_memory(
+    const int num_columns,
+    const WetdepExecution execution = WetdepExecution::Serial) {
+  return column_batch_work_memory(get_aero_model_wetdep_work_len(execution),
+                                  num_columns, mam4::nlev);
+}
+
+// Calls kernel(team, icol, work) on each column of a batch of num_columns
+// columns in a single launch, profiled as a region named "aero_model_wetdep".
+// The kernel is expected to call aero_model_wetdep on column icol with the
+// given work array, which comes from work_memory (see
+// aero_model_wetdep_work_memory).
+template <typename Kernel>
+void aero_model_wetdep_for_columns(const int num_columns,
+                                   const TeamWorkMemory &work_memory,
+                                   const Kernel &kernel) {
+  EKAT_REQUIRE_MSG(work_memory.work_len() >= get_aero_model_wetdep_work_len(),
+                   "aero_model_wetdep_for_columns: the work memory is "
+                   "smaller than aero_model_wetdep needs");
+  for_each_column("aero_model_wetdep", num_columns, mam4::nlev, work_memory,
+                  kernel);
+}
+
 } // namespace wetdep
 
 /// @class WedDeposition
@@ -2112,8 +2721,10 @@ private:
   Kokkos::View<Real * [aero_model::maxd_aspectype + 2][aero_model::pcnst]>
       qqcw_sav;
 
-  Real scavimptblnum[aero_model::nimptblgrow_total][AeroConfig::num_modes()];
-  Real scavimptblvol[aero_model::nimptblgrow_total][AeroConfig::num_modes()];
+  TableReal scavimptblnum[aero_model::nimptblgrow_total]
+                         [AeroConfig::num_modes()];
+  TableReal scavimptblvol[aero_model::nimptblgrow_total]
+                         [AeroConfig::num_modes()];
 };
 
 inline void WetDeposition::init(const AeroConfig &aero_config,
@@ -0,0 +1,160 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MAM4XX_WORK_MEMORY_HPP
+#define MAM4XX_WORK_MEMORY_HPP
+
+// This header provides per-team work memory for functions that take a
+// caller-allocated work array (e.g. wetdep::aero_model_wetdep,
+// modal_aer_opt::modal_aero_sw, and ndrop::dropmixnuc). The work arrays are
+// carved from Kokkos team scratch memory when they fit, and from an arena in
+// global memory, with one slice per team, otherwise.
+//
+// Usage:
+// 1. On the host, create a TeamWorkMemory with the work length required by
+//    the called function (e.g. wetdep::get_aero_model_wetdep_work_len()) and
+//    the team policy of the launch, including any team scratch memory the
+//    launch already requests (see column_batch_work_memory in
+//    column_batch.hpp).
+// 2. Pass the team policy of the launch through TeamWorkMemory::configure,
+//    which adds the needed scratch memory to it.
+// 3. Within the kernel, call TeamWorkMemory::get(team) to obtain the work
+//    array of the team.
+
+#include <mam4xx/mam4_types.hpp>
+
+#include <ekat/ekat_assert.hpp>
+#include <haero/haero.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <cstddef>
+
+namespace mam4 {
+
+/// TeamWorkMemory provides each team of a TeamPolicy launch with a work array
+/// of a fixed number of Reals.
+class TeamWorkMemory final {
+public:
+  using ThreadTeamPolicy = haero::ThreadTeamPolicy;
+  /// the type of the work array handed to each team
+  using WorkView = DeviceType::view_1d<Real>;
+
+  /// where the work arrays of the teams are stored
+  enum class Location {
+    Scratch0, // level 0 team scratch memory (fast, small)
+    Scratch1, // level 1 team scratch memory
+    Arena     // a global-memory arena with one slice per team
+  };
+
+  /// Creates work memory of work_len Reals per team for launches with the
+  /// given team policy. The work arrays are placed in the fastest level of
+  /// team scratch memory that can hold them on top of the scratch memory the
+  /// policy already requests (e.g. that of column_batch_team_policy); if
+  /// neither level can (or if use_scratch is false), a global-memory arena
+  /// with one slice per team of the policy is allocated once here and reused
+  /// by every launch.
+  TeamWorkMemory(const int work_len, const ThreadTeamPolicy &policy,
+                 const bool use_scratch = true)
+      : work_len_(work_len), location_(Location::Arena) {
+    const std::size_t bytes = bytes_per_team(work_len);
+    const auto fits_in_scratch = [&](const int level) {
+      return use_scratch &&
+             policy.team_scratch_size(level) + bytes <= scratch_size_max(level);
+    };
+    if (fits_in_scratch(0)) {
+      location_ = Location::Scratch0;
+    } else if (fits_in_scratch(1)) {
+      location_ = Location::Scratch1;
+    } else {
+      arena_ = ArenaView("work_memory_arena", policy.league_size(), work_len);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  TeamWorkMemory() = default;
+  KOKKOS_INLINE_FUNCTION
+  ~TeamWorkMemory() = default;
+  KOKKOS_INLINE_FUNCTION
+  TeamWorkMemory(const TeamWorkMemory &rhs) = default;
+  KOKKOS_INLINE_FUNCTION
+  TeamWorkMemory &operator=(const TeamWorkMemory &rhs) = default;
+
+  /// Returns the number of bytes of team scratch memory needed to hold a work
+  /// array of work_len Reals.
+  static std::size_t bytes_per_team(const int work_len) {
+    return ScratchView::shmem_size(work_len);
+  }
+
+  /// Returns the number of bytes of team scratch memory available at the
+  /// given level (0 or 1) for the default execution space.
+  static std::size_t scratch_size_max(const int level) {
+    return ThreadTeamPolicy::scratch_size_max(level);
+  }
+
+  /// Returns the number of Reals in each team's work array.
+  KOKKOS_INLINE_FUNCTION
+  int work_len() const { return work_len_; }
+
+  /// Returns the location of the work arrays.
+  KOKKOS_INLINE_FUNCTION
+  Location location() const { return location_; }
+
+  /// Returns the number of bytes of team scratch memory that must be
+  /// requested for each team, or 0 if the work arrays live in the arena.
+  std::size_t scratch_bytes_per_team() const {
+    return (location_ == Location::Arena) ? 0 : bytes_per_team(work_len_);
+  }
+
+  /// Returns the given team policy with the team scratch memory needed by
+  /// this object added to what the policy already requests (e.g. by
+  /// column_batch_team_policy). Every launch that calls get() must use such a
+  /// policy, and the policy must not request more scratch memory than the one
+  /// this object was created with.
+  ThreadTeamPolicy configure(ThreadTeamPolicy policy) const {
+    if (location_ == Location::Arena) {
+      EKAT_REQUIRE_MSG(policy.league_size() <= int(arena_.extent(0)),
+                       "TeamWorkMemory: the work memory arena was created "
+                       "for fewer teams than the given policy has");
+    } else {
+      const int level = (location_ == Location::Scratch0) ? 0 : 1;
+      const std::size_t bytes =
+          policy.team_scratch_size(level) + scratch_bytes_per_team();
+      EKAT_REQUIRE_MSG(bytes <= scratch_size_max(level),
+                       "TeamWorkMemory: the given policy requests too much "
+                       "team scratch memory to also hold the work arrays");
+      policy.set_scratch_size(level, Kokkos::PerTeam(bytes));
+    }
+    return policy;
+  }
+
+  /// Returns the work array of the given team. Within a launch configured
+  /// with configure(), each team gets its own array, whose contents are
+  /// undefined on entry.
+  KOKKOS_INLINE_FUNCTION
+  WorkView get(const ThreadTeam &team) const {
+    if (location_ == Location::Arena) {
+      return WorkView(&arena_(team.league_rank(), 0), work_len_);
+    }
+    const int level = (location_ == Location::Scratch0) ? 0 : 1;
+    ScratchView work(team.team_scratch(level), work_len_);
+    return WorkView(work.data(), work_len_);
+  }
+
+private:
+  using ScratchSpace =
+      typename ThreadTeamPolicy::execution_space::scratch_memory_space;
+  using ScratchView =
+      Kokkos::View<Real *, ScratchSpace, Kokkos::MemoryUnmanaged>;
+  using ArenaView = DeviceType::view_2d<Real>;
+
+  int work_len_ = 0;
+  Location location_ = Location::Arena;
+  ArenaView arena_;
+};
+
+} // namespace mam4
+
+#endif
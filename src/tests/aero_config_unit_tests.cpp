@@ -143,4 +143,34 @@ TEST_CASE("aero_config", "") {
       }
     }
   }
+
+  SECTION("species per mode") {
+    // the compile-time tables list the species of each mode in the order of
+    // mode_aero_species in aero_modes.hpp
+    static_assert(AeroConfig::num_species_in_mode(3) == 3,
+                  "num_species_in_mode is not a constant expression");
+    for (int m = 0; m < AeroConfig::num_modes(); ++m) {
+      int num_species = 0;
+      for (int s = 0; s < AeroConfig::num_aerosol_ids(); ++s) {
+        const AeroId aero_id = mode_aero_species(m, s);
+        if (aero_id != AeroId::None) {
+          REQUIRE(AeroConfig::mode_species(m, num_species) ==
+                  static_cast<int>(aero_id));
+          ++num_species;
+        }
+      }
+      REQUIRE(AeroConfig::num_species_in_mode(m) == num_species);
+      for (int s = num_species; s < AeroConfig::num_aerosol_ids(); ++s) {
+        REQUIRE(AeroConfig::mode_species(m, s) == -1);
+      }
+      // ammonium is not part of the E3SM tracer layout of num_species_mode
+#ifdef MAM4XX_ENABLE_NH3
+      const bool has_nh4 =
+          mode_contains_species(static_cast<ModeIndex>(m), AeroId::NH4);
+      REQUIRE(num_species == num_species_mode(m) + (has_nh4 ? 1 : 0));
+#else
+      REQUIRE(num_species == num_species_mode(m));
+#endif
+    }
+  }
 }
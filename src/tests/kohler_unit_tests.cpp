@@ -6,6 +6,7 @@
 #include "kohler_verification.hpp"
 #include <mam4_test_config.hpp>
 #include <mam4xx/kohler.hpp>
+#include <mam4xx/water_uptake.hpp>
 
 #include <catch2/catch.hpp>
 #include <ekat/logging/ekat_logger.hpp>
@@ -264,4 +265,72 @@ TEST_CASE("kohler_verificiation", "") {
     REQUIRE(bisection_max_err < 5 * conv_tol);
     REQUIRE(bracket_max_err < 1.5 * conv_tol);
   }
+
+  SECTION("real_arithmetic_roots") {
+    const Real conv_tol = 1e-10;
+
+    const auto rh = verification.relative_humidity;
+    const auto hyg = verification.hygroscopicity;
+    const auto rdry = verification.dry_radius;
+    const auto true_sol = verification.true_sol;
+    Real max_err;
+    int max_iter;
+    Kokkos::parallel_reduce(
+        "KohlerVerification::real_roots", N3,
+        KOKKOS_LAMBDA(const int i, Real &err, int &it) {
+          const Real kelvin_a = kelvin_coefficient() * 1e6;
+          int n_iter = 0;
+          const Real rwet = kohler_wet_radius(log(rh(i)), hyg(i), rdry(i),
+                                              kelvin_a, conv_tol, n_iter);
+          const Real me = abs(rwet - true_sol(i));
+          err = (me > err ? me : err);
+          it = (n_iter > it ? n_iter : it);
+        },
+        Kokkos::Max<Real>(max_err), Kokkos::Max<int>(max_iter));
+
+    logger.info("real-arithmetic solve: max err = {}, max_iter = {}", max_err,
+                max_iter);
+
+    REQUIRE(max_err < 1.5 * conv_tol);
+  }
+}
+
+TEST_CASE("kohler_quartic_equivalence", "") {
+  // water_uptake::modal_aero_kohler, which uses kohler_wet_radius, finds the
+  // root that MAM4's complex-arithmetic quartic formula finds
+  static constexpr int N = 20;
+  static constexpr int N3 = N * N * N;
+  DeviceType::view_1d<Real> rel_diff("kohler_quartic_rel_diff", N3);
+  Kokkos::parallel_for(
+      "kohler_quartic_equivalence", N3, KOKKOS_LAMBDA(const int i) {
+        const Real rh = 0.05 + 0.9 * (i % N) / (N - 1);
+        const Real hygro = 0.05 + 1.2 * ((i / N) % N) / (N - 1);
+        const Real rdry = 1e-8 * pow(100.0, Real(i / (N * N)) / (N - 1));
+
+        Real rwet = 0;
+        water_uptake::modal_aero_kohler(rdry, hygro, rh, rwet);
+
+        // same polynomial, in microns, solved by makoh_quartic
+        const Real aa = 2.0e4 * 18.0 * 76.0 / (8.3e7 * 273.0);
+        const Real rdry_um = rdry * 1e6;
+        const Real vol = cube(rdry_um);
+        const Real slog = log(rh);
+        Kokkos::complex<Real> cx4[4] = {};
+        water_uptake::makoh_quartic(cx4, -aa / slog, 0.0,
+                                    hygro * vol / slog - vol, aa * vol / slog);
+        Real rwet_quartic = 0;
+        int nsol = 0;
+        water_uptake::find_real_solution(rdry_um, cx4, rwet_quartic, nsol);
+        rwet_quartic = (rwet_quartic < 30.0 ? rwet_quartic : 30.0) * 1e-6;
+
+        rel_diff(i) = abs(rwet - rwet_quartic) / rwet_quartic;
+      });
+  Real max_rel_diff;
+  Kokkos::parallel_reduce(
+      N3,
+      KOKKOS_LAMBDA(const int i, Real &diff) {
+        diff = (rel_diff(i) > diff ? rel_diff(i) : diff);
+      },
+      Kokkos::Max<Real>(max_rel_diff));
+  REQUIRE(max_rel_diff < 1e-6);
 }
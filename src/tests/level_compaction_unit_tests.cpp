@@ -0,0 +1,91 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <mam4xx/level_compaction.hpp>
+#include <mam4xx/mam4.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace mam4;
+
+TEST_CASE("active_levels", "mam4_level_compaction") {
+  const int ncol = 4, nlev = 72;
+  // level k of column icol is active if (k + icol) is a multiple of 3
+  const auto is_active = KOKKOS_LAMBDA(const int icol, const int k) {
+    return (k + icol) % 3 == 0;
+  };
+
+  LevelCompactionStats stats("test_stats");
+  REQUIRE(stats.enabled());
+  REQUIRE(stats.num_levels() == 0u);
+  REQUIRE(stats.active_fraction() == 0);
+
+  DeviceType::view_2d<int> visits("visits", ncol, nlev);
+  DeviceType::view_1d<int> num_active("num_active", ncol);
+  DeviceType::view_1d<int> num_unordered("num_unordered", ncol);
+  auto policy = haero::ThreadTeamPolicy(ncol, Kokkos::AUTO);
+  policy.set_scratch_size(0,
+                          Kokkos::PerTeam(ActiveLevels::scratch_size(nlev)));
+  Kokkos::parallel_for(
+      policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
+        const int icol = team.league_rank();
+        const ActiveLevels active(
+            team, nlev, [&](const int k) { return is_active(icol, k); });
+        stats.record(team, active);
+        active.for_each(team, [&](const int k) { visits(icol, k) += 1; });
+        Kokkos::single(Kokkos::PerTeam(team), [&]() {
+          num_active(icol) = active.num_active();
+          for (int i = 1; i < active.num_active(); ++i) {
+            if (active[i] <= active[i - 1])
+              ++num_unordered(icol);
+          }
+        });
+      });
+
+  auto h_visits = Kokkos::create_mirror_view(visits);
+  auto h_num_active = Kokkos::create_mirror_view(num_active);
+  auto h_num_unordered = Kokkos::create_mirror_view(num_unordered);
+  Kokkos::deep_copy(h_visits, visits);
+  Kokkos::deep_copy(h_num_active, num_active);
+  Kokkos::deep_copy(h_num_unordered, num_unordered);
+
+  int total_active = 0;
+  for (int icol = 0; icol < ncol; ++icol) {
+    int expected_active = 0;
+    for (int k = 0; k < nlev; ++k) {
+      // every active level is visited once, and no other level is
+      const int expected = is_active(icol, k) ? 1 : 0;
+      REQUIRE(h_visits(icol, k) == expected);
+      expected_active += expected;
+    }
+    REQUIRE(h_num_active(icol) == expected_active);
+    REQUIRE(h_num_unordered(icol) == 0);
+    total_active += expected_active;
+  }
+
+  using Counter = LevelCompactionStats::Counter;
+  REQUIRE(stats.num_levels() == Counter(ncol * nlev));
+  REQUIRE(stats.num_active() == Counter(total_active));
+  REQUIRE(stats.active_fraction() ==
+          Approx(Real(total_active) / (ncol * nlev)));
+
+  stats.reset();
+  REQUIRE(stats.num_levels() == 0u);
+  REQUIRE(stats.num_active() == 0u);
+}
+
+TEST_CASE("disabled_stats", "mam4_level_compaction") {
+  LevelCompactionStats stats;
+  REQUIRE(!stats.enabled());
+  REQUIRE(stats.num_levels() == 0u);
+  REQUIRE(stats.active_fraction() == 0);
+}
+
+TEST_CASE("column_batch_scratch", "mam4_level_compaction") {
+  // column batch launches can hold a list of active levels
+  const int ncol = 8, nlev = 72;
+  const auto policy = column_batch_team_policy(ncol, nlev);
+  REQUIRE(policy.team_scratch_size(0) >= ActiveLevels::scratch_size(nlev));
+}
@@ -152,3 +152,166 @@ TEST_CASE("test_compute_tendencies", "mam4_calcsize_process") {
     } // end species
   }   // end modes
 }
+
+TEST_CASE("fused_calcsize_water_uptake", "mam4_calcsize_process") {
+  // the fused size-and-water stage matches calcsize followed by water uptake
+  using namespace mam4;
+  constexpr int pcnst = aero_model::pcnst;
+  constexpr int ntot_amode = AeroConfig::num_modes();
+  constexpr int maxd_aspectype = ndrop::maxd_aspectype;
+
+  Real state_q[pcnst] = {}, qqcw[pcnst] = {};
+  state_q[0] = 0.01; // water vapor [kg/kg]
+  for (int i = utils::aero_start_ind(); i < pcnst; ++i) {
+    state_q[i] = 1.0e-10 * (1 + i % 5);
+    qqcw[i] = 0.5e-10 * (1 + i % 3);
+  }
+  int num_idx[ntot_amode];
+  utils::get_num_idx_in_state_q(num_idx);
+  for (int m = 0; m < ntot_amode; ++m) {
+    state_q[num_idx[m]] = 1.0e8 * (m + 1);
+    qqcw[num_idx[m]] = 0.5e8 * (m + 1);
+  }
+  const Real dt = 30.0, temp = 285.0, pmid = 8.0e4, cldn = 0.2;
+
+  // separate stages
+  int nspec_amode[ntot_amode], numptr_amode[ntot_amode];
+  int lspectype_amode[maxd_aspectype][ntot_amode];
+  int lmassptr_amode[maxd_aspectype][ntot_amode];
+  Real specdens_amode[maxd_aspectype], spechygro[maxd_aspectype];
+  int mam_idx[ntot_amode][ndrop::nspec_max];
+  int mam_cnst_idx[ntot_amode][ndrop::nspec_max];
+  ndrop::get_e3sm_parameters(nspec_amode, lspectype_amode, lmassptr_amode,
+                             numptr_amode, specdens_amode, spechygro, mam_idx,
+                             mam_cnst_idx);
+  Real inv_density[ntot_amode][AeroConfig::num_aerosol_ids()] = {};
+  Real v2n_min[ntot_amode] = {}, v2n_max[ntot_amode] = {};
+  Real v2n_max_nmodes[ntot_amode] = {}, v2n_min_nmodes[ntot_amode] = {};
+  Real v2n_nom_nmodes[ntot_amode] = {};
+  Real dgnmin[ntot_amode] = {}, dgnmax[ntot_amode] = {};
+  Real dgnnom[ntot_amode] = {}, sigmag[ntot_amode] = {};
+  bool noxf_acc2ait[AeroConfig::num_aerosol_ids()] = {};
+  int n_common = 0;
+  int ait_spec_in_acc[AeroConfig::num_aerosol_ids()] = {};
+  int acc_spec_in_ait[AeroConfig::num_aerosol_ids()] = {};
+  modal_aero_calcsize::init_calcsize(
+      inv_density, v2n_min, v2n_max, v2n_max_nmodes, v2n_min_nmodes,
+      v2n_nom_nmodes, dgnmin, dgnmax, dgnnom, sigmag, noxf_acc2ait, n_common,
+      ait_spec_in_acc, acc_spec_in_ait);
+
+  Real dgn_dry[ntot_amode] = {}, dgn_c[ntot_amode] = {};
+  Real ptend[pcnst] = {}, dqqcwdt[pcnst] = {};
+  modal_aero_calcsize::modal_aero_calcsize_sub(
+      state_q, qqcw, dt, true, true, true, lmassptr_amode, numptr_amode,
+      inv_density, v2n_min, v2n_max, v2n_max_nmodes, v2n_min_nmodes,
+      v2n_nom_nmodes, dgnmin, dgnmax, dgnnom, sigmag, noxf_acc2ait, n_common,
+      ait_spec_in_acc, acc_spec_in_ait, dgn_dry, dgn_c, ptend, dqqcwdt);
+  Real dgn_wet[ntot_amode] = {}, qaerwat[ntot_amode] = {};
+  Real wetdens[ntot_amode] = {};
+  water_uptake::modal_aero_water_uptake_dr(
+      nspec_amode, specdens_amode, spechygro, lspectype_amode, state_q, temp,
+      pmid, cldn, dgn_dry, dgn_wet, qaerwat, wetdens);
+
+  // fused stage
+  const modal_aero_calcsize::CalcsizeWaterUptakeParams params;
+  Real f_dgn_dry[ntot_amode] = {}, f_dgn_c[ntot_amode] = {};
+  Real f_ptend[pcnst] = {}, f_dqqcwdt[pcnst] = {};
+  Real f_dgn_wet[ntot_amode] = {}, f_qaerwat[ntot_amode] = {};
+  Real f_wetdens[ntot_amode] = {};
+  modal_aero_calcsize::modal_aero_calcsize_water_uptake_dr(
+      params, state_q, qqcw, dt, true, temp, pmid, cldn, f_dgn_dry, f_dgn_c,
+      f_ptend, f_dqqcwdt, f_dgn_wet, f_qaerwat, f_wetdens);
+
+  for (int m = 0; m < ntot_amode; ++m) {
+    CHECK(f_dgn_dry[m] == dgn_dry[m]);
+    CHECK(f_dgn_c[m] == dgn_c[m]);
+    CHECK(f_dgn_wet[m] == dgn_wet[m]);
+    CHECK(f_qaerwat[m] == qaerwat[m]);
+    CHECK(f_wetdens[m] == wetdens[m]);
+  }
+  for (int i = 0; i < pcnst; ++i) {
+    CHECK(f_ptend[i] == ptend[i]);
+    CHECK(f_dqqcwdt[i] == dqqcwdt[i]);
+  }
+}
+
+TEST_CASE("calcsize_accessors", "mam4_calcsize_process") {
+  // the calcsize engine gives the same sizes and tendencies on Prognostics
+  // column views as on state_q/qqcw rows holding the same state
+  using namespace mam4;
+  constexpr int pcnst = aero_model::pcnst;
+  constexpr int nmodes = AeroConfig::num_modes();
+
+  const modal_aero_calcsize::CalcsizeWaterUptakeParams params;
+  const calcsize::CalcSizeData &data = params;
+
+  const int nlev = 1;
+  mam4::Prognostics progs = mam4::testing::create_prognostics(nlev);
+  mam4::Diagnostics diags = mam4::testing::create_diagnostics(nlev);
+  mam4::Tendencies tends = mam4::testing::create_tendencies(nlev);
+
+  // a state with transfers in both directions between aitken and accumulation
+  Real state_q[pcnst] = {}, qqcw[pcnst] = {};
+  for (int m = 0; m < nmodes; ++m) {
+    for (int isp = 0; isp < num_species_mode(m); ++isp) {
+      const int idx = params.lmassptr_amode[isp][m] - 1;
+      state_q[idx] = 1.0e-10 * (1 + (idx + m) % 5);
+      qqcw[idx] = 0.5e-10 * (1 + idx % 3);
+      auto h_q_i = Kokkos::create_mirror_view(progs.q_aero_i[m][isp]);
+      auto h_q_c = Kokkos::create_mirror_view(progs.q_aero_c[m][isp]);
+      h_q_i(0) = state_q[idx];
+      h_q_c(0) = qqcw[idx];
+      Kokkos::deep_copy(progs.q_aero_i[m][isp], h_q_i);
+      Kokkos::deep_copy(progs.q_aero_c[m][isp], h_q_c);
+    }
+    const int idx = params.numptr_amode[m] - 1;
+    state_q[idx] = m == int(ModeIndex::Accumulation) ? 1.0e11 : 1.0e6;
+    qqcw[idx] = 0.5 * state_q[idx];
+    auto h_n_i = Kokkos::create_mirror_view(progs.n_mode_i[m]);
+    auto h_n_c = Kokkos::create_mirror_view(progs.n_mode_c[m]);
+    h_n_i(0) = state_q[idx];
+    h_n_c(0) = qqcw[idx];
+    Kokkos::deep_copy(progs.n_mode_i[m], h_n_i);
+    Kokkos::deep_copy(progs.n_mode_c[m], h_n_c);
+  }
+  const Real dt = 30.0;
+
+  Real dgncur_i[nmodes] = {}, dgncur_c[nmodes] = {};
+  Real ptend[pcnst] = {}, dqqcwdt[pcnst] = {};
+  const modal_aero_calcsize::StateQAccessor q_state(
+      state_q, qqcw, ptend, dqqcwdt, dgncur_i, dgncur_c, params.lmassptr_amode,
+      params.numptr_amode);
+  calcsize::calcsize_1level(data, q_state, dt, true, true);
+
+  Kokkos::parallel_for(
+      "calcsize_accessors", 1, KOKKOS_LAMBDA(const int k) {
+        const calcsize::PrognosticsAccessor q_progs(progs, &diags, &tends, k);
+        calcsize::calcsize_1level(data, q_progs, dt, true, true);
+      });
+
+  for (int m = 0; m < nmodes; ++m) {
+    auto h_dgn_i =
+        Kokkos::create_mirror_view(diags.dry_geometric_mean_diameter_i[m]);
+    auto h_dgn_c =
+        Kokkos::create_mirror_view(diags.dry_geometric_mean_diameter_c[m]);
+    auto h_dn_i = Kokkos::create_mirror_view(tends.n_mode_i[m]);
+    auto h_dn_c = Kokkos::create_mirror_view(tends.n_mode_c[m]);
+    Kokkos::deep_copy(h_dgn_i, diags.dry_geometric_mean_diameter_i[m]);
+    Kokkos::deep_copy(h_dgn_c, diags.dry_geometric_mean_diameter_c[m]);
+    Kokkos::deep_copy(h_dn_i, tends.n_mode_i[m]);
+    Kokkos::deep_copy(h_dn_c, tends.n_mode_c[m]);
+    CHECK(h_dgn_i(0) == dgncur_i[m]);
+    CHECK(h_dgn_c(0) == dgncur_c[m]);
+    CHECK(h_dn_i(0) == ptend[params.numptr_amode[m] - 1]);
+    CHECK(h_dn_c(0) == dqqcwdt[params.numptr_amode[m] - 1]);
+    for (int isp = 0; isp < num_species_mode(m); ++isp) {
+      const int idx = params.lmassptr_amode[isp][m] - 1;
+      auto h_dq_i = Kokkos::create_mirror_view(tends.q_aero_i[m][isp]);
+      auto h_dq_c = Kokkos::create_mirror_view(tends.q_aero_c[m][isp]);
+      Kokkos::deep_copy(h_dq_i, tends.q_aero_i[m][isp]);
+      Kokkos::deep_copy(h_dq_c, tends.q_aero_c[m][isp]);
+      CHECK(h_dq_i(0) == ptend[idx]);
+      CHECK(h_dq_c(0) == dqqcwdt[idx]);
+    }
+  }
+}
@@ -75,6 +75,119 @@ TEST_CASE("bm3ij_data", "mam4_coagulation_process") {
   REQUIRE(haero::abs(bm3i_f - bm3i_c) < threshold_error);
 }
 
+TEST_CASE("coagulation_tables", "mam4_coagulation_process") {
+
+  // the device-resident tables hold the values of bm0ij_data and bm3i_data,
+  // and the rates computed from them match those computed from the inline
+  // tables
+  const int n = 10;
+  const auto tables = coagulation::create_coagulation_tables();
+  REQUIRE(tables.bm0ij_table.extent(0) == std::size_t(n));
+  REQUIRE(tables.bm3i_table.extent(2) == std::size_t(n));
+
+  auto h_bm0ij = Kokkos::create_mirror_view(tables.bm0ij_table);
+  auto h_bm3i = Kokkos::create_mirror_view(tables.bm3i_table);
+  Kokkos::deep_copy(h_bm0ij, tables.bm0ij_table);
+  Kokkos::deep_copy(h_bm3i, tables.bm3i_table);
+  for (int n1 = 0; n1 < n; ++n1) {
+    for (int n2a = 0; n2a < n; ++n2a) {
+      for (int n2n = 0; n2n < n; ++n2n) {
+        REQUIRE(h_bm0ij(n1, n2a, n2n) ==
+                TableReal(coagulation::bm0ij_data(n1, n2a, n2n)));
+        REQUIRE(h_bm3i(n1, n2a, n2n) ==
+                TableReal(coagulation::bm3i_data(n1, n2a, n2n)));
+      }
+    }
+  }
+
+  const int num_modes = AeroConfig::num_modes();
+  const int npair = Coagulation::max_coagpair;
+  const Real temp = 250.0, pmid = 5.0e4;
+  Real dgn_awet[num_modes], wetdens[num_modes];
+  for (int m = 0; m < num_modes; ++m) {
+    dgn_awet[m] = modes(m).nom_diameter;
+    wetdens[m] = 1500.0;
+  }
+  Real bij0[npair], bij3[npair], bii0[npair], bjj0[npair];
+  coagulation::mam_coag_rates(temp, pmid, dgn_awet, wetdens, bij0, bij3, bii0,
+                              bjj0);
+
+  DeviceType::view_2d<Real> betas("betas", 4, npair);
+  Kokkos::parallel_for(
+      "coagulation_tables", 1, KOKKOS_LAMBDA(const int) {
+        Real d_dgn_awet[num_modes], d_wetdens[num_modes];
+        for (int m = 0; m < num_modes; ++m) {
+          d_dgn_awet[m] = modes(m).nom_diameter;
+          d_wetdens[m] = 1500.0;
+        }
+        Real b[4][npair];
+        coagulation::mam_coag_rates(temp, pmid, d_dgn_awet, d_wetdens, b[0],
+                                    b[1], b[2], b[3], tables);
+        for (int i = 0; i < 4; ++i)
+          for (int ip = 0; ip < npair; ++ip)
+            betas(i, ip) = b[i][ip];
+      });
+  auto h_betas = Kokkos::create_mirror_view(betas);
+  Kokkos::deep_copy(h_betas, betas);
+  for (int ip = 0; ip < npair; ++ip) {
+    CHECK(h_betas(0, ip) == Approx(bij0[ip]));
+    CHECK(h_betas(1, ip) == Approx(bij3[ip]));
+    CHECK(h_betas(2, ip) == Approx(bii0[ip]));
+    CHECK(h_betas(3, ip) == Approx(bjj0[ip]));
+  }
+}
+
+TEST_CASE("tabulated_coag_rates", "mam4_coagulation_process") {
+
+  // tabulated coagulation coefficients are close to the analytic ones within
+  // the grid and equal to them outside it
+  mam4::AeroConfig mam4_config;
+  Coagulation::Config config;
+  config.tabulate_rates = true;
+  Coagulation coag;
+  coag.init(mam4_config, config);
+  const auto tables = coag.tables();
+  REQUIRE(tables.rates.enabled());
+  for (int ib = 0; ib < 4; ++ib) {
+    REQUIRE(tables.rates.max_relative_error[ib] > 0);
+    REQUIRE(tables.rates.max_relative_error[ib] < 0.05);
+  }
+
+  const int num_modes = AeroConfig::num_modes();
+  const int npair = Coagulation::max_coagpair;
+  // the second point has an accumulation mode diameter beyond the grid
+  const Real temp[2] = {230.0, 280.0}, pmid[2] = {3.0e4, 8.5e4};
+  const Real dgn_acc[2] = {2.0e-7, 2.0e-5};
+  const int nacc = static_cast<int>(ModeIndex::Accumulation);
+  DeviceType::view_3d<Real> betas("betas", 2, 8, npair);
+  Kokkos::parallel_for(
+      "tabulated_coag_rates", 2, KOKKOS_LAMBDA(const int i) {
+        Real dgn_awet[num_modes], wetdens[num_modes];
+        for (int m = 0; m < num_modes; ++m) {
+          dgn_awet[m] = (m == nacc) ? dgn_acc[i] : modes(m).nom_diameter;
+          wetdens[m] = 1300.0 + 100.0 * m;
+        }
+        Real b[8][npair];
+        coagulation::mam_coag_rates(temp[i], pmid[i], dgn_awet, wetdens, b[0],
+                                    b[1], b[2], b[3], tables);
+        coagulation::mam_coag_rates(temp[i], pmid[i], dgn_awet, wetdens, b[4],
+                                    b[5], b[6], b[7]);
+        for (int v = 0; v < 8; ++v)
+          for (int ip = 0; ip < npair; ++ip)
+            betas(i, v, ip) = b[v][ip];
+      });
+  auto h_betas = Kokkos::create_mirror_view(betas);
+  Kokkos::deep_copy(h_betas, betas);
+  for (int v = 0; v < 4; ++v) {
+    for (int ip = 0; ip < npair; ++ip) {
+      CHECK(h_betas(0, v, ip) == Approx(h_betas(0, v + 4, ip)).epsilon(0.05));
+      // (only the first two pairs involve the accumulation mode)
+      if (ip < 2)
+        CHECK(h_betas(1, v, ip) == Approx(h_betas(1, v + 4, ip)));
+    }
+  }
+}
+
 TEST_CASE("intra_coag_rate_for_0th_moment", "mam4_coagulation_process") {
 
   Real a_const = 1.0;
@@ -100,6 +213,46 @@ TEST_CASE("intra_coag_rate_for_0th_moment", "mam4_coagulation_process") {
       esxx05, esxx25, n2x, qnxx);
 }
 
+TEST_CASE("packed_coag_rates", "mam4_coagulation_process") {
+
+  // coagulation rates computed for a pack of levels match those computed
+  // level by level
+  const int num_modes = AeroConfig::num_modes();
+  const int npair = Coagulation::max_coagpair;
+
+  PackType temp, pmid;
+  PackType dgn_awet[num_modes], wetdens[num_modes];
+  for (int s = 0; s < pack_size; ++s) {
+    temp[s] = 220.0 + 10.0 * s;
+    pmid[s] = 2.0e4 + 1.0e4 * s;
+    for (int n = 0; n < num_modes; ++n) {
+      dgn_awet[n][s] = modes(n).nom_diameter * (1.0 + 0.1 * s);
+      wetdens[n][s] = 1770.0 - 50.0 * s;
+    }
+  }
+
+  PackType betaij0[npair], betaij3[npair], betaii0[npair], betajj0[npair];
+  coagulation::mam_coag_rates(temp, pmid, dgn_awet, wetdens, betaij0, betaij3,
+                              betaii0, betajj0);
+
+  for (int s = 0; s < pack_size; ++s) {
+    Real dgn_awet_s[num_modes], wetdens_s[num_modes];
+    for (int n = 0; n < num_modes; ++n) {
+      dgn_awet_s[n] = dgn_awet[n][s];
+      wetdens_s[n] = wetdens[n][s];
+    }
+    Real bij0[npair], bij3[npair], bii0[npair], bjj0[npair];
+    coagulation::mam_coag_rates(temp[s], pmid[s], dgn_awet_s, wetdens_s, bij0,
+                                bij3, bii0, bjj0);
+    for (int ip = 0; ip < npair; ++ip) {
+      CHECK(betaij0[ip][s] == Approx(bij0[ip]));
+      CHECK(betaij3[ip][s] == Approx(bij3[ip]));
+      CHECK(betaii0[ip][s] == Approx(bii0[ip]));
+      CHECK(betajj0[ip][s] == Approx(bjj0[ip]));
+    }
+  }
+}
+
 TEST_CASE("test_compute_tendencies", "mam4_coagulation_process") {
 
   ekat::Comm comm;
@@ -183,3 +336,70 @@ TEST_CASE("test_compute_tendencies", "mam4_coagulation_process") {
     CHECK(!isnan(h_tend_qgas0(k)));
   }
 }
+
+TEST_CASE("vector_lanes", "mam4_coagulation_process") {
+
+  // spreading the pairs and species of each level over vector lanes gives
+  // the same tendencies as the level-by-level computation
+  const int nlev = 72;
+  const int num_modes = AeroConfig::num_modes();
+  const int num_aer = AeroConfig::num_aerosol_ids();
+  const Real pblh = 1000;
+  const Real Tv0 = 300, Gammav = 0.01, qv0 = 0.015, qv1 = 7.5e-4;
+  Atmosphere atm =
+      mam4::init_atm_const_tv_lapse_rate(nlev, pblh, Tv0, Gammav, qv0, qv1);
+  Surface sfc = mam4::testing::create_surface();
+
+  // runs coagulation with the given configuration on a fresh state
+  auto run = [&](const Coagulation::Config &coag_config, Prognostics &progs,
+                 Tendencies &tends) {
+    progs = mam4::testing::create_prognostics(nlev);
+    tends = mam4::testing::create_tendencies(nlev);
+    Diagnostics diags = mam4::testing::create_diagnostics(nlev);
+    for (int m = 0; m < num_modes; ++m) {
+      Kokkos::deep_copy(progs.n_mode_i[m], 1.0e9);
+      Kokkos::deep_copy(diags.wet_geometric_mean_diameter_i[m],
+                        modes(m).nom_diameter);
+      Kokkos::deep_copy(diags.wet_density[m], 1770.0);
+      for (int a = 0; a < num_aer; ++a)
+        Kokkos::deep_copy(progs.q_aero_i[m][a], 1.0e-10);
+    }
+    AeroConfig aero_config;
+    CoagulationProcess process(aero_config, coag_config);
+    const Real t = 0.0, dt = 30.0;
+    Kokkos::parallel_for(
+        column_batch_team_policy(1, nlev, Coagulation::max_coagpair),
+        KOKKOS_LAMBDA(const ThreadTeam &team) {
+          process.compute_tendencies(team, t, dt, atm, sfc, progs, diags,
+                                     tends);
+        });
+    Kokkos::fence();
+  };
+
+  Prognostics progs_ref = mam4::testing::create_prognostics(nlev);
+  Tendencies tends_ref = mam4::testing::create_tendencies(nlev);
+  run(Coagulation::Config(), progs_ref, tends_ref);
+
+  Coagulation::Config vector_config;
+  vector_config.use_vector_lanes = true;
+  Prognostics progs = mam4::testing::create_prognostics(nlev);
+  Tendencies tends = mam4::testing::create_tendencies(nlev);
+  run(vector_config, progs, tends);
+
+  for (int m = 0; m < num_modes; ++m) {
+    auto h_n_ref = Kokkos::create_mirror_view(tends_ref.n_mode_i[m]);
+    auto h_n = Kokkos::create_mirror_view(tends.n_mode_i[m]);
+    Kokkos::deep_copy(h_n_ref, tends_ref.n_mode_i[m]);
+    Kokkos::deep_copy(h_n, tends.n_mode_i[m]);
+    for (int k = 0; k < nlev; ++k)
+      CHECK(h_n(k) == Approx(h_n_ref(k)));
+    for (int a = 0; a < num_aer; ++a) {
+      auto h_q_ref = Kokkos::create_mirror_view(progs_ref.q_aero_i[m][a]);
+      auto h_q = Kokkos::create_mirror_view(progs.q_aero_i[m][a]);
+      Kokkos::deep_copy(h_q_ref, progs_ref.q_aero_i[m][a]);
+      Kokkos::deep_copy(h_q, progs.q_aero_i[m][a]);
+      for (int k = 0; k < nlev; ++k)
+        CHECK(h_q(k) == Approx(h_q_ref(k)));
+    }
+  }
+}
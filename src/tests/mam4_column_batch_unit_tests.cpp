@@ -0,0 +1,199 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "atmosphere_utils.hpp"
+#include "testing.hpp"
+#include <mam4xx/column_batch.hpp>
+#include <mam4xx/mam4.hpp>
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <limits>
+
+using namespace haero;
+using namespace mam4;
+
+namespace {
+
+// copies a single-column field into every column of a batch field
+template <typename ColView>
+void fill_columns(const ColumnBatchView &batch, const ColView &col) {
+  for (int icol = 0; icol < int(batch.extent(0)); ++icol)
+    Kokkos::deep_copy(Kokkos::subview(batch, icol, Kokkos::ALL()), col);
+}
+
+ColumnBatchView create_batch_view(const std::string &name, int ncol,
+                                  int nlev) {
+  return ColumnBatchView(name, ncol, nlev);
+}
+
+// returns a batch of ncol columns, each with the state of the given column
+AtmosphereColumns create_atmosphere_columns(const Atmosphere &atm,
+                                            const int ncol, const Real pblh) {
+  const int nlev = atm.num_levels();
+  AtmosphereColumns atm_cols;
+  atm_cols.temperature = create_batch_view("T", ncol, nlev);
+  atm_cols.pressure = create_batch_view("p", ncol, nlev);
+  atm_cols.vapor_mixing_ratio = create_batch_view("qv", ncol, nlev);
+  atm_cols.liquid_mixing_ratio = create_batch_view("qc", ncol, nlev);
+  atm_cols.cloud_liquid_number_mixing_ratio =
+      create_batch_view("nc", ncol, nlev);
+  atm_cols.ice_mixing_ratio = create_batch_view("qi", ncol, nlev);
+  atm_cols.cloud_ice_number_mixing_ratio = create_batch_view("ni", ncol, nlev);
+  atm_cols.height = create_batch_view("z", ncol, nlev);
+  atm_cols.hydrostatic_dp = create_batch_view("hdp", ncol, nlev);
+  atm_cols.interface_pressure = create_batch_view("pint", ncol, nlev + 1);
+  atm_cols.cloud_fraction = create_batch_view("cldfrac", ncol, nlev);
+  atm_cols.updraft_vel_ice_nucleation = create_batch_view("w", ncol, nlev);
+  atm_cols.planetary_boundary_layer_height =
+      DeviceType::view_1d<Real>("pblh", ncol);
+  Kokkos::deep_copy(atm_cols.planetary_boundary_layer_height, pblh);
+  fill_columns(atm_cols.temperature, atm.temperature);
+  fill_columns(atm_cols.pressure, atm.pressure);
+  fill_columns(atm_cols.vapor_mixing_ratio, atm.vapor_mixing_ratio);
+  fill_columns(atm_cols.height, atm.height);
+  fill_columns(atm_cols.hydrostatic_dp, atm.hydrostatic_dp);
+  return atm_cols;
+}
+
+} // namespace
+
+TEST_CASE("test_team_policy", "mam4_column_batch") {
+  const int ncol = 7, nlev = 72;
+  const auto policy = column_batch_team_policy(ncol, nlev);
+  REQUIRE(policy.league_size() == ncol);
+}
+
+TEST_CASE("test_compute_tendencies_for_columns", "mam4_column_batch") {
+  const int ncol = 5, nlev = 72;
+  const Real pblh = 1000;
+  const Real Tv0 = 300;     // reference virtual temperature [K]
+  const Real Gammav = 0.01; // virtual temperature lapse rate [K/m]
+  const Real qv0 =
+      0.015; // specific humidity at surface [kg h2o / kg moist air]
+  const Real qv1 = 7.5e-4; // specific humidity lapse rate [1 / m]
+  Atmosphere atm =
+      mam4::init_atm_const_tv_lapse_rate(nlev, pblh, Tv0, Gammav, qv0, qv1);
+  Surface sfc = mam4::testing::create_surface();
+
+  // single-column state
+  mam4::Prognostics progs = mam4::testing::create_prognostics(nlev);
+  mam4::Diagnostics diags = mam4::testing::create_diagnostics(nlev);
+  mam4::Tendencies tends = mam4::testing::create_tendencies(nlev);
+
+  // batched state, with every column identical to the single column
+  AtmosphereColumns atm_cols = create_atmosphere_columns(atm, ncol, pblh);
+
+  PrognosticsColumns progs_cols(ncol, nlev);
+  DiagnosticsColumns diags_cols(ncol, nlev);
+  TendenciesColumns tends_cols(ncol, nlev);
+  REQUIRE(progs_cols.num_columns() == ncol);
+  REQUIRE(atm_cols.num_columns() == ncol);
+  REQUIRE(atm_cols.num_levels() == nlev);
+
+  const int iso4 = static_cast<int>(AeroId::SO4);
+  const int ih2so4 = static_cast<int>(GasId::H2SO4);
+  Kokkos::deep_copy(progs.q_gas[ih2so4], 5.0e-12);
+  Kokkos::deep_copy(progs_cols.q_gas[ih2so4], 5.0e-12);
+  for (int n = 0; n < AeroConfig::num_modes(); ++n) {
+    Kokkos::deep_copy(progs.n_mode_i[n], 1.0e12);
+    Kokkos::deep_copy(progs.q_aero_i[n][iso4], 1.0e-10);
+    Kokkos::deep_copy(progs_cols.n_mode_i[n], 1.0e12);
+    Kokkos::deep_copy(progs_cols.q_aero_i[n][iso4], 1.0e-10);
+    Kokkos::deep_copy(diags.dry_geometric_mean_diameter_i[n],
+                      modes(n).nom_diameter);
+    Kokkos::deep_copy(diags.wet_geometric_mean_diameter_i[n],
+                      modes(n).nom_diameter);
+    Kokkos::deep_copy(diags.wet_density[n], 1770.0);
+    Kokkos::deep_copy(diags_cols.dry_geometric_mean_diameter_i[n],
+                      modes(n).nom_diameter);
+    Kokkos::deep_copy(diags_cols.wet_geometric_mean_diameter_i[n],
+                      modes(n).nom_diameter);
+    Kokkos::deep_copy(diags_cols.wet_density[n], 1770.0);
+  }
+
+  mam4::AeroConfig mam4_config;
+  mam4::MicrophysicsProcess process(mam4_config);
+  const Real t = 0.0, dt = 30.0;
+
+  // single column
+  auto team_policy = ThreadTeamPolicy(1u, Kokkos::AUTO);
+  Kokkos::parallel_for(
+      team_policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
+        process.compute_tendencies(team, t, dt, atm, sfc, progs, diags, tends);
+      });
+
+  // all columns in a single launch
+  compute_tendencies_for_columns(process, t, dt, atm_cols, sfc, progs_cols,
+                                 diags_cols, tends_cols);
+
+  auto h_tend = Kokkos::create_mirror_view(tends.q_gas[ih2so4]);
+  Kokkos::deep_copy(h_tend, tends.q_gas[ih2so4]);
+  auto h_tend_cols = Kokkos::create_mirror_view(tends_cols.q_gas[ih2so4]);
+  Kokkos::deep_copy(h_tend_cols, tends_cols.q_gas[ih2so4]);
+
+  // every column of the batch matches the single-column result
+  for (int icol = 0; icol < ncol; ++icol) {
+    for (int k = 0; k < nlev; ++k) {
+      CHECK(!std::isnan(h_tend_cols(icol, k)));
+      CHECK(h_tend_cols(icol, k) == h_tend(k));
+    }
+  }
+}
+
+TEST_CASE("test_vector_lanes_for_columns", "mam4_column_batch") {
+  // coagulation on vector lanes can be run on a batch, and gives the
+  // tendencies of the default coagulation up to roundoff
+  const int ncol = 3, nlev = 72;
+  const Real pblh = 1000;
+  const Real Tv0 = 300, Gammav = 0.01, qv0 = 0.015, qv1 = 7.5e-4;
+  Atmosphere atm =
+      mam4::init_atm_const_tv_lapse_rate(nlev, pblh, Tv0, Gammav, qv0, qv1);
+  Surface sfc = mam4::testing::create_surface();
+  AtmosphereColumns atm_cols = create_atmosphere_columns(atm, ncol, pblh);
+  const int num_modes = AeroConfig::num_modes();
+  const int num_aer = AeroConfig::num_aerosol_ids();
+
+  // runs coagulation with the given configuration and vector length
+  auto run = [&](const Coagulation::Config &coag_config,
+                 const int vector_length, TendenciesColumns &tends_cols) {
+    PrognosticsColumns progs_cols(ncol, nlev);
+    DiagnosticsColumns diags_cols(ncol, nlev);
+    for (int m = 0; m < num_modes; ++m) {
+      Kokkos::deep_copy(progs_cols.n_mode_i[m], 1.0e9);
+      for (int a = 0; a < num_aer; ++a)
+        Kokkos::deep_copy(progs_cols.q_aero_i[m][a], 1.0e-10);
+      Kokkos::deep_copy(diags_cols.dry_geometric_mean_diameter_i[m],
+                        modes(m).nom_diameter);
+      Kokkos::deep_copy(diags_cols.wet_geometric_mean_diameter_i[m],
+                        modes(m).nom_diameter);
+      Kokkos::deep_copy(diags_cols.wet_density[m], 1770.0);
+    }
+    AeroConfig aero_config;
+    CoagulationProcess process(aero_config, coag_config);
+    const Real t = 0.0, dt = 30.0;
+    compute_tendencies_for_columns(process, t, dt, atm_cols, sfc, progs_cols,
+                                   diags_cols, tends_cols, vector_length);
+    Kokkos::fence();
+  };
+
+  TendenciesColumns tends_ref(ncol, nlev);
+  run(Coagulation::Config(), 1, tends_ref);
+
+  Coagulation::Config vector_config;
+  vector_config.use_vector_lanes = true;
+  TendenciesColumns tends(ncol, nlev);
+  run(vector_config, Coagulation::max_coagpair, tends);
+
+  for (int m = 0; m < num_modes; ++m) {
+    auto h_n_ref = Kokkos::create_mirror_view(tends_ref.n_mode_i[m]);
+    auto h_n = Kokkos::create_mirror_view(tends.n_mode_i[m]);
+    Kokkos::deep_copy(h_n_ref, tends_ref.n_mode_i[m]);
+    Kokkos::deep_copy(h_n, tends.n_mode_i[m]);
+    for (int icol = 0; icol < ncol; ++icol)
+      for (int k = 0; k < nlev; ++k)
+        CHECK(h_n(icol, k) == Approx(h_n_ref(icol, k)));
+  }
+}
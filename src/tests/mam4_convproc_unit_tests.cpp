@@ -11,6 +11,7 @@
 #include <ekat/logging/ekat_logger.hpp>
 #include <ekat/mpi/ekat_comm.hpp>
 #include <set>
+#include <vector>
 
 // if you need something from the data/ directory
 // std::string data_file = MAM4_TEST_DATA_DIR;
@@ -214,3 +215,293 @@ TEST_CASE("assign_dotend", "mam4_convproc_process") {
     }
   }
 }
+TEST_CASE("ma_convproc_intr_skip_column", "mam4_convproc_process") {
+  // a column without deep convection skips the deep convective processing,
+  // which gives bitwise the same tendencies and wet deposition as taking it
+  using mam4::ConvProc;
+  const int nlev = mam4::nlev;
+  const int pcnst = mam4::aero_model::pcnst;
+  const Real dt = 1800.0;
+
+  // scratch views large enough for any of them
+  Kokkos::View<Real *> scratch[ConvProc::Col1DViewInd::NumScratch];
+  for (int i = 0; i < ConvProc::Col1DViewInd::NumScratch; ++i)
+    scratch[i] =
+        Kokkos::View<Real *>("scratch", (nlev + 1) * ConvProc::pcnst_extd);
+
+  // a column with the given value on the levels [kbegin, kend) and zero
+  // elsewhere
+  auto column = [&](const Real value, const int kbegin = 0,
+                    const int kend = mam4::nlev) {
+    ColumnView v = testing::create_column_view(nlev);
+    auto h_v = Kokkos::create_mirror_view(v);
+    for (int k = 0; k < nlev; ++k)
+      h_v(k) = (kbegin <= k && k < kend) ? value : 0.0;
+    Kokkos::deep_copy(v, h_v);
+    return v;
+  };
+  const ColumnView temperature = column(280.0);
+  const ColumnView pmid = column(5.0e4);
+  const ColumnView dp = column(12.5);
+  const ColumnView dp_frac = column(0.1, 40, 60);
+  const ColumnView icwmrdp = column(1.0e-4, 40, 60);
+  const ColumnView sh_frac = column(0.05, 50, 65);
+  const ColumnView icwmrsh = column(5.0e-5, 50, 65);
+  const ColumnView rprdsh = column(1.0e-8, 50, 65);
+  const ColumnView evapcsh = column(2.0e-9, 65, 70);
+  const ColumnView dlf = column(1.0e-8, 40, 65);
+  const ColumnView dlfsh = column(5.0e-9, 50, 65);
+  const ColumnView sh_e_ed_ratio = column(0.5, 50, 65);
+  // no mass fluxes and no deep convective precipitation
+  const ColumnView du = column(0.0);
+  const ColumnView eu = column(0.0);
+  const ColumnView ed = column(0.0);
+  const ColumnView rprddp = column(0.0);
+  const ColumnView evapcdp = column(0.0);
+
+  DeviceType::view_2d<Real> state_q("state_q", nlev, pcnst);
+  auto h_state_q = Kokkos::create_mirror_view(state_q);
+  for (int k = 0; k < nlev; ++k)
+    for (int i = 0; i < pcnst; ++i)
+      h_state_q(k, i) = 1.0e-9 * (1.0 + 0.01 * k + 0.1 * i);
+  Kokkos::deep_copy(state_q, h_state_q);
+
+  const ConvProc::Config config;
+  int species_class[pcnst], mmtoo_prevap_resusp[pcnst];
+  for (int i = 0; i < pcnst; ++i) {
+    species_class[i] = config.species_class[i];
+    mmtoo_prevap_resusp[i] = config.mmtoo_prevap_resusp[i];
+  }
+  const int ktop = config.ktop, kbot = config.kbot;
+
+  // runs ma_convproc_intr on nonzero initial tendencies and wet deposition
+  auto run = [&](const DeviceType::view_2d<Real> &ptend_q,
+                 const DeviceType::view_1d<Real> &aerdepwetis_dev,
+                 const DeviceType::view_1d<int> &ptend_lq_dev,
+                 const mam4::ColumnSkipStats &skip_stats,
+                 const bool allow_column_skip) {
+    auto h_ptend_q = Kokkos::create_mirror_view(ptend_q);
+    for (int k = 0; k < nlev; ++k)
+      for (int i = 0; i < pcnst; ++i)
+        h_ptend_q(k, i) = 1.0e-12 * (k - i);
+    Kokkos::deep_copy(ptend_q, h_ptend_q);
+    Kokkos::parallel_for(
+        ThreadTeamPolicy(1, 1), KOKKOS_LAMBDA(const ThreadTeam &team) {
+          Real aerdepwetis[pcnst];
+          for (int i = 0; i < pcnst; ++i)
+            aerdepwetis[i] = 1.0e-10 * i;
+          bool ptend_lq[pcnst] = {};
+          mam4::convproc::ma_convproc_intr(
+              team, scratch, true, false, nlev, temperature.data(),
+              pmid.data(), dp.data(), dp.data(), dt, dp_frac.data(),
+              icwmrdp.data(), rprddp.data(), evapcdp.data(), sh_frac.data(),
+              icwmrsh.data(), rprdsh.data(), evapcsh.data(), dlf.data(),
+              dlfsh.data(), sh_e_ed_ratio.data(), du.data(), eu.data(),
+              ed.data(), dp.data(), ktop, kbot, species_class,
+              mmtoo_prevap_resusp, state_q, ptend_q, ptend_lq, aerdepwetis,
+              skip_stats, allow_column_skip);
+          Kokkos::single(Kokkos::PerTeam(team), [&]() {
+            for (int i = 0; i < pcnst; ++i) {
+              aerdepwetis_dev[i] = aerdepwetis[i];
+              ptend_lq_dev[i] = ptend_lq[i];
+            }
+          });
+        });
+    Kokkos::fence();
+  };
+
+  DeviceType::view_2d<Real> ptend_q_ref("ptend_q_ref", nlev, pcnst);
+  DeviceType::view_1d<Real> aerdepwetis_ref("aerdepwetis_ref", pcnst);
+  DeviceType::view_1d<int> ptend_lq_ref("ptend_lq_ref", pcnst);
+  mam4::ColumnSkipStats skip_stats_ref("convproc_skip_stats_ref");
+  run(ptend_q_ref, aerdepwetis_ref, ptend_lq_ref, skip_stats_ref, false);
+  REQUIRE(skip_stats_ref.num_columns() == 1u);
+  REQUIRE(skip_stats_ref.num_skipped() == 0u);
+
+  DeviceType::view_2d<Real> ptend_q("ptend_q", nlev, pcnst);
+  DeviceType::view_1d<Real> aerdepwetis("aerdepwetis", pcnst);
+  DeviceType::view_1d<int> ptend_lq("ptend_lq", pcnst);
+  mam4::ColumnSkipStats skip_stats("convproc_skip_stats");
+  run(ptend_q, aerdepwetis, ptend_lq, skip_stats, true);
+  REQUIRE(skip_stats.num_columns() == 1u);
+  REQUIRE(skip_stats.num_skipped() == 1u);
+
+  auto h_ptend_q_ref = Kokkos::create_mirror_view(ptend_q_ref);
+  auto h_ptend_q = Kokkos::create_mirror_view(ptend_q);
+  Kokkos::deep_copy(h_ptend_q_ref, ptend_q_ref);
+  Kokkos::deep_copy(h_ptend_q, ptend_q);
+  // the shallow convection changes the tendencies of the column
+  bool changed = false;
+  for (int k = 0; k < nlev; ++k)
+    for (int i = 0; i < pcnst; ++i) {
+      REQUIRE(h_ptend_q(k, i) == h_ptend_q_ref(k, i));
+      changed = changed || h_ptend_q(k, i) != 1.0e-12 * (k - i);
+    }
+  REQUIRE(changed);
+  auto h_aerdepwetis_ref = Kokkos::create_mirror_view(aerdepwetis_ref);
+  auto h_aerdepwetis = Kokkos::create_mirror_view(aerdepwetis);
+  auto h_ptend_lq_ref = Kokkos::create_mirror_view(ptend_lq_ref);
+  auto h_ptend_lq = Kokkos::create_mirror_view(ptend_lq);
+  Kokkos::deep_copy(h_aerdepwetis_ref, aerdepwetis_ref);
+  Kokkos::deep_copy(h_aerdepwetis, aerdepwetis);
+  Kokkos::deep_copy(h_ptend_lq_ref, ptend_lq_ref);
+  Kokkos::deep_copy(h_ptend_lq, ptend_lq);
+  for (int i = 0; i < pcnst; ++i) {
+    REQUIRE(h_aerdepwetis(i) == h_aerdepwetis_ref(i));
+    REQUIRE(h_ptend_lq(i) == h_ptend_lq_ref(i));
+  }
+
+  // deep convective precipitation evaporation alone takes the full
+  // computation
+  Kokkos::deep_copy(Kokkos::subview(evapcdp, 60), 4.0e-9);
+  run(ptend_q, aerdepwetis, ptend_lq, skip_stats, true);
+  REQUIRE(skip_stats.num_columns() == 2u);
+  REQUIRE(skip_stats.num_skipped() == 1u);
+}
+TEST_CASE("find_convective_extent", "mam4_convproc_process") {
+  // the convective extent spans the levels with nonzero mass fluxes or deep
+  // convective precipitation
+  const int nlev = mam4::nlev;
+  std::vector<Real> du(nlev, 0.0), eu(nlev, 0.0), ed(nlev, 0.0),
+      rprd(nlev, 0.0), evapc(nlev, 0.0);
+  int ktop = -1, kbot = -1;
+  auto find_extent = [&]() {
+    mam4::convproc::find_convective_extent(nlev, du.data(), eu.data(),
+                                           ed.data(), rprd.data(),
+                                           evapc.data(), ktop, kbot);
+  };
+
+  // no convection gives an empty range
+  find_extent();
+  REQUIRE(ktop == nlev);
+  REQUIRE(kbot == nlev);
+
+  // precipitation without mass fluxes is still deep convection
+  for (int k = 50; k < 60; ++k)
+    rprd[k] = 1.0e-8;
+  for (int k = 60; k < 65; ++k)
+    evapc[k] = 2.0e-9;
+  find_extent();
+  REQUIRE(ktop == 50);
+  REQUIRE(kbot == 65);
+
+  // detrainment at the top, entrainment below, and a downdraft that reaches
+  // further down
+  for (int k = 30; k < 40; ++k)
+    du[k] = 1.0e-4;
+  for (int k = 38; k < 55; ++k)
+    eu[k] = 2.0e-4;
+  for (int k = 45; k < 60; ++k)
+    ed[k] = 5.0e-5;
+  find_extent();
+  REQUIRE(ktop == 30);
+  REQUIRE(kbot == 65);
+
+  // convection reaching the lowest level, which the fixed kbot = nlev - 1
+  // leaves out
+  eu[nlev - 1] = 1.0e-4;
+  find_extent();
+  REQUIRE(ktop == 30);
+  REQUIRE(kbot == nlev);
+}
+TEST_CASE("compute_tendencies_convective_extent", "mam4_convproc_process") {
+  // on a 72-level column whose deep convection lies within the fixed cloud
+  // top and bottom, detecting the convective extent gives the tendencies of
+  // the fixed extent, with and without mass fluxes
+  using mam4::ConvProc;
+  const int nlev = 72;
+  const int pcnst = mam4::aero_model::pcnst;
+  const Real t = 0.0, dt = 1800.0, pblh = 1000.0;
+
+  // a column with the given value on the levels [kbegin, kend) and zero
+  // elsewhere
+  auto column = [&](const Real value, const int kbegin = 0,
+                    const int kend = 72) {
+    ColumnView v = testing::create_column_view(nlev);
+    auto h_v = Kokkos::create_mirror_view(v);
+    for (int k = 0; k < nlev; ++k)
+      h_v(k) = (kbegin <= k && k < kend) ? value : 0.0;
+    Kokkos::deep_copy(v, h_v);
+    return v;
+  };
+  auto tracer_view = [&]() {
+    ColumnView v = testing::create_column_view(nlev * pcnst);
+    Kokkos::deep_copy(v, 0.0);
+    return mam4::Diagnostics::ColumnTracerView(v.data(), nlev, pcnst);
+  };
+
+  Atmosphere atm = mam4::testing::create_atmosphere(nlev, pblh);
+  atm.temperature = column(280.0);
+  atm.pressure = column(5.0e4);
+  atm.hydrostatic_dp = column(12.5);
+  mam4::Prognostics progs = mam4::testing::create_prognostics(nlev);
+  mam4::Diagnostics diags = mam4::testing::create_diagnostics(nlev);
+  mam4::Tendencies tends = mam4::testing::create_tendencies(nlev);
+
+  // the updraft entrains below and detrains above exactly the same mass, and
+  // the precipitation evaporates down to level 70, the last one of the fixed
+  // extent [47, 71)
+  diags.hydrostatic_dry_dp = column(12.5);
+  diags.delta_pressure = column(12.5);
+  diags.deep_convective_cloud_fraction = column(0.1, 50, 65);
+  diags.deep_convective_cloud_condensate = column(1.0e-4, 50, 65);
+  diags.deep_convective_precipitation_production = column(1.0e-8, 49, 61);
+  diags.deep_convective_precipitation_evaporation = column(2.0e-9, 61, 71);
+  diags.mass_detrain_rate_from_updraft = column(1.0 / 4096, 50, 55);
+  diags.mass_entrain_rate_into_updraft = column(1.0 / 8192, 55, 65);
+  diags.mass_entrain_rate_into_downdraft = column(1.0 / 16384, 56, 60);
+  diags.shallow_convective_cloud_fraction = column(0.0);
+  diags.shallow_convective_cloud_condensate = column(0.0);
+  diags.shallow_convective_precipitation_production = column(0.0);
+  diags.shallow_convective_precipitation_evaporation = column(0.0);
+  diags.total_convective_detrainment = column(0.0);
+  diags.shallow_convective_detrainment = column(0.0);
+  diags.shallow_convective_ratio = column(0.0);
+  diags.tracer_mixing_ratio = tracer_view();
+  diags.d_tracer_mixing_ratio_dt = tracer_view();
+  auto h_state_q = Kokkos::create_mirror_view(diags.tracer_mixing_ratio);
+  for (int k = 0; k < nlev; ++k)
+    for (int i = 0; i < pcnst; ++i)
+      h_state_q(k, i) = 1.0e-9 * (1.0 + 0.01 * k + 0.1 * i);
+  Kokkos::deep_copy(diags.tracer_mixing_ratio, h_state_q);
+
+  // returns the tracer tendencies of a run with or without detection
+  const mam4::AeroConfig aero_config;
+  auto run = [&](const bool detect_convective_extent) {
+    ConvProc::Config config;
+    config.nlev = nlev;
+    config.detect_convective_extent = detect_convective_extent;
+    ConvProc convproc;
+    convproc.init(aero_config, config);
+    Kokkos::deep_copy(diags.d_tracer_mixing_ratio_dt, 0.0);
+    Kokkos::parallel_for(
+        ThreadTeamPolicy(1u, 1u), KOKKOS_LAMBDA(const ThreadTeam &team) {
+          convproc.compute_tendencies(aero_config, team, t, dt, atm, progs,
+                                      diags, tends);
+        });
+    Kokkos::fence();
+    auto h_ptend_q = Kokkos::create_mirror_view(diags.d_tracer_mixing_ratio_dt);
+    Kokkos::deep_copy(h_ptend_q, diags.d_tracer_mixing_ratio_dt);
+    return h_ptend_q;
+  };
+
+  auto h_ptend_q_ref = run(false);
+  auto h_ptend_q = run(true);
+  bool changed = false;
+  for (int k = 0; k < nlev; ++k)
+    for (int i = 0; i < pcnst; ++i) {
+      CHECK(h_ptend_q(k, i) == Approx(h_ptend_q_ref(k, i)).epsilon(1.0e-12));
+      changed = changed || h_ptend_q_ref(k, i) != 0;
+    }
+  REQUIRE(changed);
+
+  // the precipitation alone is still processed over its levels
+  Kokkos::deep_copy(diags.mass_detrain_rate_from_updraft, 0.0);
+  Kokkos::deep_copy(diags.mass_entrain_rate_into_updraft, 0.0);
+  Kokkos::deep_copy(diags.mass_entrain_rate_into_downdraft, 0.0);
+  h_ptend_q_ref = run(false);
+  h_ptend_q = run(true);
+  for (int k = 0; k < nlev; ++k)
+    for (int i = 0; i < pcnst; ++i)
+      CHECK(h_ptend_q(k, i) == Approx(h_ptend_q_ref(k, i)).epsilon(1.0e-12));
+}
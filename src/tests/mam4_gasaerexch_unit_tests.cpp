@@ -254,6 +254,302 @@ TEST_CASE("gas_aer_uptkrates_1box1gas", "mam_gasaerexch") {
   }
 }
 
+TEST_CASE("gas_aer_uptkrates_1box", "mam_gasaerexch") {
+  // the batched uptake rates of several gases match those computed gas by gas
+  const int num_mode = mam4::GasAerExch::num_mode;
+  const int ngas = 2;
+  const bool l_condense_to_mode[ngas][num_mode] = {{true, true, true, true},
+                                                   {true, false, true, false}};
+  const Real temp = 255.0, pmid = 6.0e4, pstd = 101325.0;
+  const Real mw_gas[ngas] = {98.0784, 150.0};
+  const Real vol_molar_gas[ngas] = {42.88, 60.0};
+  const Real accom[ngas] = {0.65, 1.0};
+  const Real mw_air = 28.966, vol_molar_air = 20.1;
+  const Real r_universal = 8314.467591, r_pi = 3.1415926535897931;
+  const Real beta_inp = 0.0;
+  const Real alnsg_aer[num_mode] = {0.58778666490211906, 0.47000362924573563,
+                                    0.58778666490211906, 0.47000362924573563};
+  const Real dgn_awet[num_mode] = {1.27e-7, 2.98e-8, 2.33e-6, 5.30e-8};
+
+  Real uptkaer[ngas][num_mode];
+  gasaerexch::gas_aer_uptkrates_1box<4, ngas>(
+      l_condense_to_mode, temp, pmid, pstd, mw_gas, mw_air, vol_molar_gas,
+      vol_molar_air, accom, r_universal, r_pi, beta_inp, dgn_awet, alnsg_aer,
+      uptkaer);
+  for (int g = 0; g < ngas; ++g) {
+    Real uptkaer_g[num_mode];
+    gasaerexch::gas_aer_uptkrates_1box1gas(
+        l_condense_to_mode[g], temp, pmid, pstd, mw_gas[g], mw_air,
+        vol_molar_gas[g], vol_molar_air, accom[g], r_universal, r_pi,
+        beta_inp, 4, dgn_awet, alnsg_aer, uptkaer_g);
+    for (int n = 0; n < num_mode; ++n) {
+      REQUIRE(uptkaer[g][n] == Approx(uptkaer_g[n]));
+      REQUIRE((uptkaer[g][n] > 0) == l_condense_to_mode[g][n]);
+    }
+  }
+}
+
+TEST_CASE("cached_gas_uptkrates", "mam_gasaerexch") {
+  // cached uptake rates are reused until the temperature or a wet diameter
+  // drifts beyond the threshold, and always scale with the number
+  const int num_mode = mam4::GasAerExch::num_mode;
+  const int num_gas = mam4::GasAerExch::num_gas;
+  const int igas_h2so4 = mam4::GasAerExch::igas_h2so4;
+  const int igas_soag = mam4::GasAerExch::igas_soag;
+  const int nghq = 2;
+  const Real threshold = 0.01;
+  bool l_gas_condense_to_mode[num_gas][num_mode] = {};
+  Real uptk_rate_factor[num_gas];
+  for (int g = 0; g < num_gas; ++g) {
+    uptk_rate_factor[g] = mam4::GasAerExch::uptk_rate_factor(g);
+    for (int n = 0; n < num_mode; ++n)
+      l_gas_condense_to_mode[g][n] = (g == igas_h2so4 || g == igas_soag);
+  }
+  const Real pmid = 6.0e4, aircon = 2.8e-2;
+  const Real alnsg_aer[num_mode] = {0.58778666490211906, 0.47000362924573563,
+                                    0.58778666490211906, 0.47000362924573563};
+  Real temp = 255.0;
+  Real dgn_awet[num_mode] = {1.27e-7, 2.98e-8, 2.33e-6, 5.30e-8};
+  Real qnum[num_mode] = {1.0e9, 5.0e9, 1.0e6, 1.0e8};
+
+  // the rates computed without a cache
+  const auto uncached = [&](Real uptkaer[num_gas][num_mode], Real &total) {
+    Real uptkaer_ref[num_mode];
+    gasaerexch::h2so4_uptkrates_per_particle(nghq, temp, pmid, dgn_awet,
+                                             alnsg_aer, uptkaer_ref);
+    gasaerexch::scale_gas_uptkrates(igas_h2so4, l_gas_condense_to_mode,
+                                    uptk_rate_factor, aircon, qnum,
+                                    uptkaer_ref, uptkaer, total);
+  };
+
+  gasaerexch::UptakeRateCache cache = {};
+  Real uptkaer[num_gas][num_mode], expected[num_gas][num_mode];
+  Real total = 0, expected_total = 0;
+
+  // an empty cache is filled
+  gasaerexch::cached_gas_uptkrates(
+      nghq, igas_h2so4, threshold, l_gas_condense_to_mode, temp, pmid, aircon,
+      qnum, dgn_awet, alnsg_aer, uptk_rate_factor, cache, uptkaer, total);
+  uncached(expected, expected_total);
+  REQUIRE(cache.temperature == temp);
+  REQUIRE(total == expected_total);
+  for (int g = 0; g < num_gas; ++g)
+    for (int n = 0; n < num_mode; ++n)
+      REQUIRE(uptkaer[g][n] == expected[g][n]);
+  REQUIRE(expected_total > 0);
+
+  // small changes in temperature and diameter reuse the cached rates, which
+  // are still rescaled by the number concentrations
+  const Real first_total = total;
+  temp *= 1 + 0.5 * threshold;
+  dgn_awet[1] *= 1 - 0.5 * threshold;
+  for (int n = 0; n < num_mode; ++n)
+    qnum[n] *= 2;
+  gasaerexch::cached_gas_uptkrates(
+      nghq, igas_h2so4, threshold, l_gas_condense_to_mode, temp, pmid, aircon,
+      qnum, dgn_awet, alnsg_aer, uptk_rate_factor, cache, uptkaer, total);
+  REQUIRE(cache.temperature == 255.0);
+  REQUIRE(total == Approx(2 * first_total));
+  uncached(expected, expected_total);
+  REQUIRE(total == Approx(expected_total).epsilon(10 * threshold));
+
+  // a larger change in a diameter refreshes the cache
+  dgn_awet[2] *= 1 + 2 * threshold;
+  gasaerexch::cached_gas_uptkrates(
+      nghq, igas_h2so4, threshold, l_gas_condense_to_mode, temp, pmid, aircon,
+      qnum, dgn_awet, alnsg_aer, uptk_rate_factor, cache, uptkaer, total);
+  uncached(expected, expected_total);
+  REQUIRE(cache.temperature == temp);
+  REQUIRE(cache.wet_diameter[2] == dgn_awet[2]);
+  REQUIRE(total == expected_total);
+  for (int g = 0; g < num_gas; ++g)
+    for (int n = 0; n < num_mode; ++n)
+      REQUIRE(uptkaer[g][n] == expected[g][n]);
+}
+
+#ifdef MAM4XX_ENABLE_NH3
+TEST_CASE("nh3_condensation", "mam_gasaerexch") {
+  // NH3 condenses to NH4 in the modes that carry it, conserving the total
+  // ammonia, and is left alone when GasAerExch::Config::igas_nh3 is false
+  const int num_mode = mam4::GasAerExch::num_mode;
+  const int num_gas = mam4::GasAerExch::num_gas;
+  const int num_aer = mam4::GasAerExch::num_aer;
+  const int igas_nh3 = mam4::GasAerExch::igas_nh3;
+  const int iaer_nh4 = mam4::GasAerExch::iaer_nh4;
+  const int iaer_so4 = mam4::GasAerExch::iaer_so4;
+  const Real dt = 60.0, temp = 280.0, pmid = 8.0e4, aircon = 3.4e-2;
+  const Real dgn_awet[num_mode] = {1.27e-7, 2.98e-8, 2.33e-6, 5.30e-8};
+
+  const auto condense = [&](const bool do_nh3, Real qgas[num_gas],
+                            Real qaer[num_aer][num_mode]) {
+    GasAerExch::Config config;
+    config.igas_nh3 = do_nh3;
+    GasAerExch gasaerexch;
+    gasaerexch.init(AeroConfig(), config);
+    Real qgas_avg[num_gas] = {};
+    Real qnum[num_mode] = {1.0e9, 5.0e9, 1.0e6, 1.0e8};
+    Real uptkaer[num_gas][num_mode] = {};
+    Real uptkrate_h2so4 = 0, g0_soa = 0;
+    int niter = 0;
+    for (int g = 0; g < num_gas; ++g)
+      qgas[g] = 0;
+    for (int a = 0; a < num_aer; ++a)
+      for (int n = 0; n < num_mode; ++n)
+        qaer[a][n] = 0;
+    qgas[igas_nh3] = 1.0e-10;
+    for (int n = 0; n < num_mode; ++n)
+      qaer[iaer_so4][n] = 1.0e-10;
+    gasaerexch.mam_gasaerexch_1subarea_(dt, temp, pmid, aircon, qgas,
+                                        qgas_avg, qaer, qnum, dgn_awet,
+                                        uptkaer, uptkrate_h2so4, niter,
+                                        g0_soa);
+  };
+
+  Real qgas[num_gas], qaer[num_aer][num_mode];
+  condense(true, qgas, qaer);
+  REQUIRE(qgas[igas_nh3] < 1.0e-10);
+  Real total_nh4 = 0;
+  for (int n = 0; n < num_mode; ++n) {
+    REQUIRE(qaer[iaer_nh4][n] >= 0);
+    REQUIRE(qaer[iaer_nh4][n] <= 2 * qaer[iaer_so4][n]);
+    total_nh4 += qaer[iaer_nh4][n];
+  }
+  REQUIRE(total_nh4 > 0);
+  REQUIRE(qgas[igas_nh3] + total_nh4 == Approx(1.0e-10));
+
+  condense(false, qgas, qaer);
+  REQUIRE(qgas[igas_nh3] == 1.0e-10);
+  for (int n = 0; n < num_mode; ++n)
+    REQUIRE(qaer[iaer_nh4][n] == 0);
+}
+#endif
+
+TEST_CASE("mam_soaexch_advance_in_time_controlled", "mam_gasaerexch") {
+  // strong SOA condensation, which takes the heuristic many substeps
+  const int num_mode = AeroConfig::num_modes();
+  const int num_gas = AeroConfig::num_gas_ids();
+  const int num_aer = AeroConfig::num_aerosol_ids();
+  const int igas_soag = static_cast<int>(GasId::SOAG);
+  const int iaer_soa = static_cast<int>(AeroId::SOA);
+  const int ntot_soaspec = 1;
+  const GasId soaspec[ntot_soaspec] = {GasId::SOAG};
+  AeroId gas_to_aer[num_gas];
+  for (int g = 0; g < num_gas; ++g)
+    gas_to_aer[g] = AeroId::None;
+  gas_to_aer[igas_soag] = AeroId::SOA;
+
+  const Real dt = 1800, alpha_astem = 0.05;
+  const Real g0_soa[ntot_soaspec] = {2.5e-13};
+  const Real a_opoa[num_mode] = {1.0e-10, 1.0e-11, 0.0, 1.0e-11};
+  Real uptkaer[num_gas][num_mode] = {};
+  const Real uptkaer_soag[num_mode] = {1.0e-2, 5.0e-3, 1.0e-4, 1.0e-3};
+  for (int n = 0; n < num_mode; ++n)
+    uptkaer[igas_soag][n] = uptkaer_soag[n];
+
+  // initial state, total SOA, and the state after the time step
+  Real qgas0[num_gas] = {}, qaer0[num_aer][num_mode] = {};
+  qgas0[igas_soag] = 1.0e-9;
+  const Real qsoa0[num_mode] = {1.0e-10, 1.0e-11, 1.0e-12, 0.0};
+  for (int n = 0; n < num_mode; ++n)
+    qaer0[iaer_soa][n] = qsoa0[n];
+  const auto total_soa = [&](const Real qgas[num_gas],
+                             const Real qaer[num_aer][num_mode]) {
+    Real total = qgas[igas_soag];
+    for (int n = 0; n < num_mode; ++n)
+      total += qaer[iaer_soa][n];
+    return total;
+  };
+  const auto advance = [&](const gasaerexch::SOAStepControl &control,
+                           const Real dt_sub_fixed, Real qgas[num_gas],
+                           Real qaer[num_aer][num_mode]) {
+    Real qgas_avg[num_gas] = {};
+    for (int g = 0; g < num_gas; ++g)
+      qgas[g] = qgas0[g];
+    for (int a = 0; a < num_aer; ++a)
+      for (int n = 0; n < num_mode; ++n)
+        qaer[a][n] = qaer0[a][n];
+    int niter = 0;
+    if (control.error_control)
+      gasaerexch::mam_soaexch_advance_in_time_controlled(
+          num_mode, ntot_soaspec, soaspec, gas_to_aer, dt, alpha_astem,
+          control, uptkaer, g0_soa, qgas, a_opoa, qaer, qgas_avg, niter);
+    else
+      gasaerexch::mam_soaexch_advance_in_time(
+          num_mode, ntot_soaspec, soaspec, gas_to_aer, dt, dt_sub_fixed,
+          control.max_substeps, alpha_astem, uptkaer, g0_soa, qgas, a_opoa,
+          qaer, qgas_avg, niter);
+    REQUIRE(qgas_avg[igas_soag] >= 0);
+    return niter;
+  };
+
+  // reference solution with very short fixed substeps
+  gasaerexch::SOAStepControl control;
+  control.max_substeps = 1000000;
+  Real qgas_ref[num_gas], qaer_ref[num_aer][num_mode];
+  advance(control, 0.01, qgas_ref, qaer_ref);
+  const Real total0 = total_soa(qgas0, qaer0);
+  REQUIRE(total_soa(qgas_ref, qaer_ref) == Approx(total0));
+
+  // the error-controlled integrator agrees with the reference and conserves
+  // the total SOA
+  control.error_control = true;
+  control.rel_tolerance = 1.0e-4;
+  control.max_substeps = 1000;
+  Real qgas[num_gas], qaer[num_aer][num_mode];
+  const int niter = advance(control, -1, qgas, qaer);
+  REQUIRE(niter > 1);
+  REQUIRE(niter < control.max_substeps);
+  REQUIRE(total_soa(qgas, qaer) == Approx(total0));
+  for (int n = 0; n < num_mode; ++n)
+    REQUIRE(qaer[iaer_soa][n] ==
+            Approx(qaer_ref[iaer_soa][n]).epsilon(1.0e-2).margin(1.0e-14));
+
+  // a tighter tolerance takes more substeps
+  control.rel_tolerance = 1.0e-6;
+  REQUIRE(advance(control, -1, qgas, qaer) > niter);
+
+  // the substep cap bounds the number of substeps, and the last substep
+  // still covers the rest of the time step
+  control.max_substeps = 3;
+  REQUIRE(advance(control, -1, qgas, qaer) == control.max_substeps);
+  REQUIRE(total_soa(qgas, qaer) == Approx(total0));
+  REQUIRE(qgas[igas_soag] < 0.5 * qgas0[igas_soag]);
+}
+
+TEST_CASE("soa_substep_stats", "mam_gasaerexch") {
+  gasaerexch::SOASubstepStats disabled;
+  REQUIRE(!disabled.enabled());
+  REQUIRE(disabled.max_substeps() == 0);
+  REQUIRE(disabled.column_imbalance() == 1);
+
+  // column icol takes icol + 1 substeps at every level, plus 10 at level 0
+  const int ncol = 4, nlev = 8;
+  gasaerexch::SOASubstepStats stats("soa_substeps", ncol, nlev);
+  REQUIRE(stats.enabled());
+  Kokkos::parallel_for(
+      "record_substeps", ncol * nlev, KOKKOS_LAMBDA(const int i) {
+        const int icol = i / nlev, k = i % nlev;
+        stats.record(icol, k, icol + 1 + ((k == 0) ? 10 : 0));
+        // ignored
+        stats.record(ncol, k, 1000);
+      });
+  const auto substeps = stats.substeps();
+  REQUIRE(substeps(2, 0) == 13);
+  REQUIRE(substeps(2, 1) == 3);
+  REQUIRE(stats.max_substeps() == ncol + 10);
+  const auto totals = stats.column_substeps();
+  Real sum = 0;
+  for (int icol = 0; icol < ncol; ++icol) {
+    REQUIRE(totals(icol) == (icol + 1) * nlev + 10);
+    sum += totals(icol);
+  }
+  REQUIRE(stats.column_imbalance() == Approx(totals(ncol - 1) * ncol / sum));
+
+  stats.reset();
+  REQUIRE(stats.max_substeps() == 0);
+  REQUIRE(stats.column_imbalance() == 1);
+}
+
 TEST_CASE("mam_gasaerexch_1subarea_1gas_nonvolatile", "mam_gasaerexch") {
 
   // Since there does not seem to be a way to extract the internal epsilon
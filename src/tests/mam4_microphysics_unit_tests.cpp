@@ -0,0 +1,126 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "atmosphere_utils.hpp"
+#include "testing.hpp"
+#include <mam4xx/mam4.hpp>
+
+#include <ekat/ekat_type_traits.hpp>
+#include <ekat/logging/ekat_logger.hpp>
+#include <ekat/mpi/ekat_comm.hpp>
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace haero;
+using namespace mam4;
+
+TEST_CASE("test_constructor", "mam4_microphysics_process") {
+  mam4::AeroConfig mam4_config;
+  mam4::MicrophysicsProcess::ProcessConfig process_config;
+  mam4::MicrophysicsProcess process(mam4_config, process_config);
+  REQUIRE(process.name() == "MAM4 microphysics");
+  REQUIRE(process.aero_config() == mam4_config);
+}
+
+TEST_CASE("test_compute_tendencies", "mam4_microphysics_process") {
+  ekat::Comm comm;
+  ekat::logger::Logger<> logger("microphysics unit tests",
+                                ekat::logger::LogLevel::debug, comm);
+  const int nlev = 72;
+  const Real pblh = 1000;
+  // these values correspond to a humid atmosphere with relative humidity
+  // values approximately between 32% and 98%
+  const Real Tv0 = 300;     // reference virtual temperature [K]
+  const Real Gammav = 0.01; // virtual temperature lapse rate [K/m]
+  const Real qv0 =
+      0.015; // specific humidity at surface [kg h2o / kg moist air]
+  const Real qv1 = 7.5e-4; // specific humidity lapse rate [1 / m]
+  Atmosphere atm =
+      mam4::init_atm_const_tv_lapse_rate(nlev, pblh, Tv0, Gammav, qv0, qv1);
+
+  Surface sfc = mam4::testing::create_surface();
+  mam4::Prognostics progs = mam4::testing::create_prognostics(nlev);
+  mam4::Diagnostics diags = mam4::testing::create_diagnostics(nlev);
+  mam4::Tendencies tends = mam4::testing::create_tendencies(nlev);
+
+  const int num_modes = AeroConfig::num_modes();
+  const int iso4 = static_cast<int>(AeroId::SO4);
+  const int ih2so4 = static_cast<int>(GasId::H2SO4);
+
+  // sulfate in every mode, sulfuric acid gas, and nominal mode sizes
+  Kokkos::deep_copy(progs.q_gas[ih2so4], 5.0e-12);
+  for (int n = 0; n < num_modes; ++n) {
+    Kokkos::deep_copy(progs.n_mode_i[n], 1.0e12);
+    Kokkos::deep_copy(progs.q_aero_i[n][iso4], 1.0e-10);
+    Kokkos::deep_copy(diags.dry_geometric_mean_diameter_i[n],
+                      modes(n).nom_diameter);
+    Kokkos::deep_copy(diags.wet_geometric_mean_diameter_i[n],
+                      modes(n).nom_diameter);
+    Kokkos::deep_copy(diags.wet_density[n], 1770.0);
+  }
+
+  // turn off gas production from other processes so that sulfur is conserved
+  mam4::AeroConfig mam4_config;
+  mam4::MicrophysicsProcess::ProcessConfig process_config;
+  for (int g = 0; g < AeroConfig::num_gas_ids(); ++g)
+    process_config.gasaerexch.qgas_netprod_otrproc[g] = 0;
+  mam4::MicrophysicsProcess process(mam4_config, process_config);
+
+  // total sulfur before the microphysics pass
+  auto total_sulfur = [&]() {
+    std::vector<Real> s(nlev, 0);
+    auto h_qgas = Kokkos::create_mirror_view(progs.q_gas[ih2so4]);
+    Kokkos::deep_copy(h_qgas, progs.q_gas[ih2so4]);
+    for (int k = 0; k < nlev; ++k)
+      s[k] += h_qgas(k);
+    for (int n = 0; n < num_modes; ++n) {
+      auto h_qso4 = Kokkos::create_mirror_view(progs.q_aero_i[n][iso4]);
+      Kokkos::deep_copy(h_qso4, progs.q_aero_i[n][iso4]);
+      for (int k = 0; k < nlev; ++k)
+        s[k] += h_qso4(k);
+    }
+    return s;
+  };
+  const std::vector<Real> sulfur_in = total_sulfur();
+
+  // Single-column dispatch.
+  auto team_policy = ThreadTeamPolicy(1u, Kokkos::AUTO);
+  Real t = 0.0, dt = 30.0;
+  Kokkos::parallel_for(
+      team_policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
+        process.compute_tendencies(team, t, dt, atm, sfc, progs, diags, tends);
+      });
+  const std::vector<Real> sulfur_out = total_sulfur();
+
+  auto h_tend_qgas = Kokkos::create_mirror_view(tends.q_gas[ih2so4]);
+  Kokkos::deep_copy(h_tend_qgas, tends.q_gas[ih2so4]);
+  auto h_prog_nait = Kokkos::create_mirror_view(
+      progs.n_mode_i[static_cast<int>(ModeIndex::Aitken)]);
+  Kokkos::deep_copy(h_prog_nait,
+                    progs.n_mode_i[static_cast<int>(ModeIndex::Aitken)]);
+
+  std::ostringstream ss;
+  ss << "tend_qh2so4 [out]: [ ";
+  for (int k = 0; k < nlev; ++k)
+    ss << h_tend_qgas(k) << " ";
+  ss << "]";
+  logger.debug(ss.str());
+
+  const Real tol = 1000 * std::numeric_limits<Real>::epsilon();
+  for (int k = 0; k < nlev; ++k) {
+    CHECK(!isnan(h_tend_qgas(k)));
+    CHECK(!isnan(h_prog_nait(k)));
+    // condensation only removes h2so4 from the gas phase
+    CHECK(h_tend_qgas(k) <= 0);
+    CHECK(h_prog_nait(k) >= 0);
+    CHECK(sulfur_out[k] == Approx(sulfur_in[k]).epsilon(tol));
+  }
+}
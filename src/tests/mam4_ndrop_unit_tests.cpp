@@ -17,6 +17,9 @@
 #include <ekat/mpi/ekat_comm.hpp>
 #include <mam4xx/mam4.hpp>
 
+#include <functional>
+#include <vector>
+
 // using namespace haero;
 using namespace mam4;
 using namespace mam4::conversions;
@@ -268,3 +271,207 @@ TEST_CASE("test_maxsat", "mam4_ndrop") {
               FloatingPoint<Real>::equiv(smax, single_answer);
   REQUIRE(test);
 }
+
+// The work-array overload of dropmixnuc must give the same result as the
+// overload taking zero-initialized views, whatever the work array holds.
+TEST_CASE("test_dropmixnuc_work", "mam4_ndrop") {
+  const int ntot_amode = AeroConfig::num_modes();
+  const int maxd_aspectype = ndrop::maxd_aspectype;
+  const int nspec_max = ndrop::nspec_max;
+  const int ncnst_tot = ndrop::ncnst_tot;
+  const int pcnst = aero_model::pcnst;
+  const int psat = ndrop::psat;
+  const int pver = ndrop::pver;
+  using View1D = ndrop::View1D;
+  using View2D = ndrop::View2D;
+
+  int numptr_amode[ntot_amode];
+  {
+    int nspec_amode[ntot_amode];
+    int lspectype_amode[maxd_aspectype][ntot_amode];
+    int lmassptr_amode[maxd_aspectype][ntot_amode];
+    Real specdens_amode[maxd_aspectype], spechygro[maxd_aspectype];
+    int mam_idx[ntot_amode][nspec_max], mam_cnst_idx[ntot_amode][nspec_max];
+    ndrop::get_e3sm_parameters(nspec_amode, lspectype_amode, lmassptr_amode,
+                               numptr_amode, specdens_amode, spechygro,
+                               mam_idx, mam_cnst_idx);
+  }
+
+  // a column with a cloud between levels 40 and 55 that grows during the
+  // step, so that activation, mixing and the ccn calculation all take part
+  auto column = [](const std::function<Real(int)> &f, const int n) {
+    ColumnView view = haero::testing::create_column_view(n);
+    auto host = Kokkos::create_mirror_view(view);
+    for (int k = 0; k < n; ++k)
+      host(k) = f(k);
+    Kokkos::deep_copy(view, host);
+    return view;
+  };
+  auto in_cloud = [](const int k) { return 40 <= k && k <= 55; };
+  auto p_int = [](const int k) { return 1.0e3 + 9.9e4 * k / pver; };
+  auto p_mid = [&](const int k) { return 0.5 * (p_int(k) + p_int(k + 1)); };
+
+  const ColumnView temp =
+      column([](int k) { return 220.0 + 75.0 * k / (pver - 1); }, pver);
+  const ColumnView pmid = column(p_mid, pver);
+  const ColumnView pint = column(p_int, pver + 1);
+  const ColumnView pdel =
+      column([&](int k) { return p_int(k + 1) - p_int(k); }, pver);
+  const ColumnView rpdel =
+      column([&](int k) { return 1.0 / (p_int(k + 1) - p_int(k)); }, pver);
+  const ColumnView zm = column(
+      [&](int k) { return 7.0e3 * std::log(1.0e5 / p_mid(k)); }, pver);
+  const ColumnView kvh = column([](int k) { return 1.0 + 0.01 * k; }, pver);
+  const ColumnView cldn =
+      column([&](int k) { return in_cloud(k) ? 0.6 : 0.0; }, pver);
+  const ColumnView cldo =
+      column([&](int k) { return in_cloud(k) && k > 45 ? 0.3 : 0.0; }, pver);
+  const ColumnView ncldwtr =
+      column([&](int k) { return in_cloud(k) ? 5.0e7 : 0.0; }, pver);
+  const ColumnView wsub = column([](int) { return 0.4; }, pver);
+
+  View2D state_q("state_q", pver, pcnst);
+  {
+    auto host = Kokkos::create_mirror_view(state_q);
+    for (int k = 0; k < pver; ++k)
+      for (int i = 0; i < pcnst; ++i)
+        host(k, i) = 1.0e-9 * (1.0 + 0.01 * i + 0.001 * k);
+    for (int imode = 0; imode < ntot_amode; ++imode)
+      for (int k = 0; k < pver; ++k)
+        host(k, numptr_amode[imode] - 1) = 1.0e8 * (1.0 + 0.001 * k);
+    Kokkos::deep_copy(state_q, host);
+  }
+
+  // runs dropmixnuc and returns its outputs, one after the other
+  auto run = [&](const bool use_work) {
+    ColumnView qqcw[ncnst_tot], coltend[ncnst_tot], coltend_cw[ncnst_tot];
+    for (int i = 0; i < ncnst_tot; ++i) {
+      qqcw[i] = column(
+          [&](int k) { return in_cloud(k) ? 1.0e-10 * (1 + i) : 0.0; }, pver);
+      coltend[i] = haero::testing::create_column_view(pver);
+      coltend_cw[i] = haero::testing::create_column_view(pver);
+    }
+    ColumnView ptend_q[pcnst];
+    for (int i = 0; i < pcnst; ++i)
+      ptend_q[i] = haero::testing::create_column_view(pver);
+    ColumnView qcld = haero::testing::create_column_view(pver);
+    ColumnView tendnd = haero::testing::create_column_view(pver);
+    ColumnView ndropcol = haero::testing::create_column_view(pver);
+    ColumnView ndropmix = haero::testing::create_column_view(pver);
+    ColumnView nsource = haero::testing::create_column_view(pver);
+    ColumnView wtke = haero::testing::create_column_view(pver);
+    View2D factnum("factnum", ntot_amode, pver);
+    View2D ccn("ccn", pver, psat);
+
+    View1D raercol_cw[pver][2], raercol[pver][2];
+    for (int k = 0; k < pver; ++k) {
+      for (int i = 0; i < 2; ++i) {
+        raercol[k][i] = View1D("raercol", ncnst_tot);
+        raercol_cw[k][i] = View1D("raercol_cw", ncnst_tot);
+      }
+    }
+    View2D nact("nact", pver, ntot_amode);
+    View2D mact("mact", pver, ntot_amode);
+    constexpr int ncolumn_work = 15;
+    ColumnView column_work[ncolumn_work];
+    for (int i = 0; i < ncolumn_work; ++i)
+      column_work[i] = haero::testing::create_column_view(pver);
+
+    // a work array left over from some other computation
+    View1D work("work", ndrop::get_dropmixnuc_work_len());
+    Kokkos::deep_copy(work, 1.0e20);
+
+    Kokkos::parallel_for(
+        ThreadTeamPolicy(1u, Kokkos::AUTO),
+        KOKKOS_LAMBDA(const ThreadTeam &team) {
+          int nspec_amode[ntot_amode];
+          int lspectype_amode[maxd_aspectype][ntot_amode];
+          int lmassptr_amode[maxd_aspectype][ntot_amode];
+          Real specdens_amode[maxd_aspectype];
+          Real spechygro[maxd_aspectype];
+          int numptr_amode[ntot_amode];
+          int mam_idx[ntot_amode][nspec_max];
+          int mam_cnst_idx[ntot_amode][nspec_max];
+          ndrop::get_e3sm_parameters(
+              nspec_amode, lspectype_amode, lmassptr_amode, numptr_amode,
+              specdens_amode, spechygro, mam_idx, mam_cnst_idx);
+
+          Real exp45logsig[ntot_amode], alogsig[ntot_amode],
+              num2vol_ratio_min_nmodes[ntot_amode],
+              num2vol_ratio_max_nmodes[ntot_amode] = {};
+          Real aten = 0;
+          ndrop::ndrop_init(exp45logsig, alogsig, aten,
+                            num2vol_ratio_min_nmodes,  // voltonumbhi_amode
+                            num2vol_ratio_max_nmodes); // voltonumblo_amode
+
+          const Real dtmicro = 300;
+          if (use_work) {
+            ndrop::dropmixnuc(
+                team, dtmicro, temp, pmid, pint, pdel, rpdel, zm, state_q,
+                ncldwtr, kvh, cldn, lspectype_amode, specdens_amode, spechygro,
+                lmassptr_amode, num2vol_ratio_min_nmodes,
+                num2vol_ratio_max_nmodes, numptr_amode, nspec_amode,
+                exp45logsig, alogsig, aten, mam_idx, mam_cnst_idx, qcld, wsub,
+                cldo, qqcw, ptend_q, tendnd, factnum, ndropcol, ndropmix,
+                nsource, wtke, ccn, coltend, coltend_cw, work);
+          } else {
+            ndrop::dropmixnuc(
+                team, dtmicro, temp, pmid, pint, pdel, rpdel, zm, state_q,
+                ncldwtr, kvh, cldn, lspectype_amode, specdens_amode, spechygro,
+                lmassptr_amode, num2vol_ratio_min_nmodes,
+                num2vol_ratio_max_nmodes, numptr_amode, nspec_amode,
+                exp45logsig, alogsig, aten, mam_idx, mam_cnst_idx, qcld, wsub,
+                cldo, qqcw, ptend_q, tendnd, factnum, ndropcol, ndropmix,
+                nsource, wtke, ccn, coltend, coltend_cw, raercol_cw, raercol,
+                nact, mact, column_work[0], column_work[1], column_work[2],
+                column_work[3], column_work[4], column_work[5],
+                column_work[6], column_work[7], column_work[8],
+                column_work[9], column_work[10], column_work[11],
+                column_work[12], column_work[13], column_work[14]);
+          }
+        });
+
+    std::vector<Real> outputs;
+    auto append = [&](const ColumnView &view) {
+      auto host = Kokkos::create_mirror_view(view);
+      Kokkos::deep_copy(host, view);
+      for (int k = 0; k < pver; ++k)
+        outputs.push_back(host(k));
+    };
+    for (const auto &view : {qcld, tendnd, ndropcol, ndropmix, nsource, wtke})
+      append(view);
+    for (int i = 0; i < pcnst; ++i)
+      append(ptend_q[i]);
+    for (int i = 0; i < ncnst_tot; ++i) {
+      append(qqcw[i]);
+      append(coltend[i]);
+      append(coltend_cw[i]);
+    }
+    auto factnum_host = Kokkos::create_mirror_view(factnum);
+    Kokkos::deep_copy(factnum_host, factnum);
+    auto ccn_host = Kokkos::create_mirror_view(ccn);
+    Kokkos::deep_copy(ccn_host, ccn);
+    for (int k = 0; k < pver; ++k) {
+      for (int imode = 0; imode < ntot_amode; ++imode)
+        outputs.push_back(factnum_host(imode, k));
+      for (int l = 0; l < psat; ++l)
+        outputs.push_back(ccn_host(k, l));
+    }
+    return outputs;
+  };
+
+  const std::vector<Real> with_views = run(false);
+  const std::vector<Real> with_work = run(true);
+  REQUIRE(with_views.size() == with_work.size());
+  int num_diffs = 0;
+  for (std::size_t i = 0; i < with_views.size(); ++i)
+    if (with_views[i] != with_work[i])
+      ++num_diffs;
+  REQUIRE(num_diffs == 0);
+
+  // the outputs are not all zero, so the comparison is not vacuous
+  bool nonzero = false;
+  for (const Real value : with_views)
+    nonzero = nonzero || value != 0;
+  REQUIRE(nonzero);
+}
@@ -12,10 +12,12 @@
 #include <ekat/mpi/ekat_comm.hpp>
 
 #include <cmath>
+#include <cstdio>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 using namespace haero;
 
@@ -160,3 +162,175 @@ TEST_CASE("test_multicol_compute_tendencies", "mam4_nucleation_process") {
                                    mc_tends(icol));
       });
 }
+
+TEST_CASE("test_compact_levels", "mam4_nucleation_process") {
+  // Tendencies computed only on the levels with enough H2SO4 to nucleate
+  // must match those computed on every level.
+  int nlev = 72;
+  Real pblh = 1000;
+  const Real Tv0 = 300;     // reference virtual temperature [K]
+  const Real Gammav = 0.01; // virtual temperature lapse rate [K/m]
+  const Real qv0 =
+      0.015; // specific humidity at surface [kg h2o / kg moist air]
+  const Real qv1 = 7.5e-4; // specific humidity lapse rate [1 / m]
+  Atmosphere atm =
+      mam4::init_atm_const_tv_lapse_rate(nlev, pblh, Tv0, Gammav, qv0, qv1);
+
+  Surface sfc = mam4::testing::create_surface();
+  mam4::Prognostics progs = mam4::testing::create_prognostics(nlev);
+  mam4::Diagnostics diags = mam4::testing::create_diagnostics(nlev);
+  mam4::Tendencies tends = mam4::testing::create_tendencies(nlev);
+  mam4::Tendencies compact_tends = mam4::testing::create_tendencies(nlev);
+
+  // H2SO4 on every other level only
+  const int ih2so4 = static_cast<int>(mam4::GasId::H2SO4);
+  const int nait = static_cast<int>(mam4::ModeIndex::Aitken);
+  const int iso4 = mam4::aerosol_index_for_mode(mam4::ModeIndex::Aitken,
+                                                mam4::AeroId::SO4);
+  auto h_qh2so4 = Kokkos::create_mirror_view(progs.q_gas[ih2so4]);
+  for (int k = 0; k < nlev; ++k) {
+    h_qh2so4(k) = (k % 2 == 0) ? 5.0e-12 : 0.0;
+  }
+  Kokkos::deep_copy(progs.q_gas[ih2so4], h_qh2so4);
+  Kokkos::deep_copy(progs.n_mode_i[nait], 1.0e9);
+  // tendencies on inactive levels must be overwritten
+  Kokkos::deep_copy(compact_tends.q_gas[ih2so4], 1.0);
+
+  mam4::AeroConfig mam4_config;
+  mam4::Nucleation::Config compact_config;
+  compact_config.compact_levels = true;
+  compact_config.level_stats = mam4::LevelCompactionStats("nucleation");
+  mam4::NucleationProcess process(mam4_config);
+  mam4::NucleationProcess compact_process(mam4_config, compact_config);
+
+  auto team_policy = ThreadTeamPolicy(1u, Kokkos::AUTO);
+  team_policy.set_scratch_size(
+      0, Kokkos::PerTeam(mam4::ActiveLevels::scratch_size(nlev)));
+  Real t = 0.0, dt = 30.0;
+  Kokkos::parallel_for(
+      team_policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
+        process.compute_tendencies(team, t, dt, atm, sfc, progs, diags, tends);
+        compact_process.compute_tendencies(team, t, dt, atm, sfc, progs, diags,
+                                           compact_tends);
+      });
+
+  const auto compare = [&](const ColumnView &a, const ColumnView &b) {
+    auto h_a = Kokkos::create_mirror_view(a);
+    auto h_b = Kokkos::create_mirror_view(b);
+    Kokkos::deep_copy(h_a, a);
+    Kokkos::deep_copy(h_b, b);
+    for (int k = 0; k < nlev; ++k) {
+      REQUIRE(h_a(k) == h_b(k));
+    }
+  };
+  compare(tends.n_mode_i[nait], compact_tends.n_mode_i[nait]);
+  compare(tends.q_aero_i[nait][iso4], compact_tends.q_aero_i[nait][iso4]);
+  compare(tends.q_gas[ih2so4], compact_tends.q_gas[ih2so4]);
+
+  REQUIRE(compact_config.level_stats.active_fraction() == Approx(0.5));
+}
+
+TEST_CASE("test_tabulated_rates", "mam4_nucleation_process") {
+  // Nucleation rates interpolated from tables match the analytic ones at the
+  // table points and are close to them in between; tables are cached.
+  using mam4::nucleation::detail::NucleationTableHeader;
+  const char *cache_file = "nucleation_tables_test.bin";
+  std::remove(cache_file);
+  mam4::nucleation::NucleationRateGrid grid;
+  const auto tables =
+      mam4::nucleation::create_nucleation_tables(grid, cache_file);
+  REQUIRE(tables.binary.enabled());
+  REQUIRE(tables.ternary.enabled());
+
+  // the second call reads the cached tables
+  const auto cached_tables =
+      mam4::nucleation::create_nucleation_tables(grid, cache_file);
+  const auto compare = [&](const auto &a, const auto &b) {
+    auto h_a = Kokkos::create_mirror_view(a);
+    auto h_b = Kokkos::create_mirror_view(b);
+    Kokkos::deep_copy(h_a, a);
+    Kokkos::deep_copy(h_b, b);
+    REQUIRE(h_a.extent(0) == h_b.extent(0));
+    for (std::size_t i = 0; i < h_a.extent(0); ++i) {
+      REQUIRE(h_a(i) == h_b(i));
+    }
+  };
+  compare(tables.binary.data, cached_tables.binary.data);
+  compare(tables.ternary.data, cached_tables.ternary.data);
+
+  // cached tables computed with other fits or for other bounds are not read
+  // back: tables of zeros with such headers are replaced by the right ones
+  const int binary_size = tables.binary.data.extent(0);
+  const int ternary_size = tables.ternary.data.extent(0);
+  const std::vector<TableReal> binary_zeros(binary_size, 0);
+  const std::vector<TableReal> ternary_zeros(ternary_size, 0);
+  for (int i = 0; i < 2; ++i) {
+    NucleationTableHeader header;
+    header.grid = grid;
+    if (i == 0)
+      ++header.fit_version;
+    else
+      header.binary_hi[2] *= 10;
+    mam4::nucleation::detail::write_nucleation_tables(
+        cache_file, header, binary_zeros.data(), binary_size,
+        ternary_zeros.data(), ternary_size);
+    const auto recomputed_tables =
+        mam4::nucleation::create_nucleation_tables(grid, cache_file);
+    compare(tables.binary.data, recomputed_tables.binary.data);
+    compare(tables.ternary.data, recomputed_tables.ternary.data);
+  }
+  std::remove(cache_file);
+
+  // (temp, rh, so4vol): a table point and a point between table points.
+  // Returns the interpolated ln J, cnum_tot and radius, whether they were
+  // found in the tables, and the analytic ln J, cnum_tot and radius.
+  const Real temp[2] = {230.15, 262.0}, rh[2] = {1.0e-4, 0.47};
+  const Real so4vol[2] = {1.0e4, 3.0e7};
+  const auto interpolate = [&](const mam4::nucleation::NucleationTables &t) {
+    DeviceType::view_2d<Real> results("results", 2, 8);
+    Kokkos::parallel_for(
+        "tabulated_nucleation", 2, KOKKOS_LAMBDA(const int i) {
+          Real ratenucl, rateloge, cnum_h2so4, cnum_tot, radius;
+          const bool found =
+              t.binary_nuc(temp[i], rh[i], so4vol[i], ratenucl, rateloge,
+                           cnum_h2so4, cnum_tot, radius);
+          results(i, 0) = found ? rateloge : 0;
+          results(i, 1) = found ? cnum_tot : 0;
+          results(i, 2) = found ? radius : 0;
+          results(i, 3) = found ? 1 : 0;
+          mam4::nucleation::binary_nuc_vehk2002(temp[i], rh[i], so4vol[i],
+                                                ratenucl, rateloge,
+                                                cnum_h2so4, cnum_tot, radius);
+          results(i, 4) = rateloge;
+          results(i, 5) = cnum_tot;
+          results(i, 6) = radius;
+        });
+    auto h_results = Kokkos::create_mirror_view(results);
+    Kokkos::deep_copy(h_results, results);
+    for (int i = 0; i < 2; ++i) {
+      REQUIRE(h_results(i, 3) == 1);
+    }
+    return h_results;
+  };
+  const auto h_results = interpolate(tables);
+  const Real tol = std::numeric_limits<TableReal>::epsilon() * 100;
+  for (int v = 0; v < 3; ++v) {
+    REQUIRE(h_results(0, v) == Approx(h_results(0, v + 4)).epsilon(tol));
+  }
+  // Multilinear interpolation of ln J is second order in the grid spacing,
+  // which for the default binary grid is 5 K in temperature, 0.38 in ln rh
+  // and 0.46 in ln so4vol. The error at the second point is about 0.19 on
+  // that grid, and shrinks about fourfold when the spacing is halved.
+  REQUIRE(h_results(1, 0) == Approx(h_results(1, 4)).margin(0.25));
+  REQUIRE(h_results(1, 1) == Approx(h_results(1, 5)).epsilon(0.1));
+  REQUIRE(h_results(1, 2) == Approx(h_results(1, 6)).epsilon(0.1));
+
+  mam4::nucleation::NucleationRateGrid fine_grid = grid;
+  fine_grid.binary_num_temperatures = 2 * grid.binary_num_temperatures - 1;
+  fine_grid.binary_num_relative_humidities =
+      2 * grid.binary_num_relative_humidities - 1;
+  fine_grid.binary_num_so4vols = 2 * grid.binary_num_so4vols - 1;
+  const auto h_fine_results =
+      interpolate(mam4::nucleation::create_nucleation_tables(fine_grid));
+  REQUIRE(h_fine_results(1, 0) == Approx(h_fine_results(1, 4)).margin(0.0625));
+}
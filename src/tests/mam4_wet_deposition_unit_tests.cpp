@@ -432,3 +432,212 @@ TEST_CASE("fprecn_resusp_vs_fprec_evap_mpln(", "mam4_wet_deposition_process") {
 }
 });
 }
+
+TEST_CASE("aero_model_wetdep_executions", "mam4_wet_deposition_process") {
+  // sweeping each tracer down the column on its own team thread gives the
+  // same tendencies as the tracer-by-tracer computation, and spreading each
+  // sweep over the levels gives them up to roundoff; a column without
+  // precipitation skips the wet removal, which gives bitwise the same
+  // tendencies
+  using View1D = wetdep::View1D;
+  using View2D = wetdep::View2D;
+  const int nlev = mam4::nlev;
+  const int num_modes = AeroConfig::num_modes();
+  const int num_aer = AeroConfig::num_aerosol_ids();
+  const Real pblh = 1000, dt = 1800.0;
+
+  // a column with cloud between levels 30 and 50, and evaporating
+  // precipitation below
+  const int kcloud_top = 30, kcloud_bot = 50;
+  auto column = [&](const Real cloud, const Real below, const Real above) {
+    ColumnView v = haero::testing::create_column_view(nlev);
+    auto h_v = Kokkos::create_mirror_view(v);
+    for (int k = 0; k < nlev; ++k)
+      h_v(k) = (k < kcloud_top) ? above : (k < kcloud_bot) ? cloud : below;
+    Kokkos::deep_copy(v, h_v);
+    return v;
+  };
+  auto profile = [&](const Real top, const Real bot) {
+    ColumnView v = haero::testing::create_column_view(nlev);
+    auto h_v = Kokkos::create_mirror_view(v);
+    for (int k = 0; k < nlev; ++k)
+      h_v(k) = top + (bot - top) * (k + 0.5) / nlev;
+    Kokkos::deep_copy(v, h_v);
+    return v;
+  };
+  const Real dp = 9.0e4 / nlev;
+  Atmosphere atm(nlev, profile(220.0, 295.0), profile(1.0e4, 1.0e5),
+                 profile(1.0e-5, 1.5e-2), column(1.0e-4, 0.0, 0.0),
+                 column(1.0e8, 0.0, 0.0), column(1.0e-6, 0.0, 0.0),
+                 column(1.0e5, 0.0, 0.0), profile(1.6e4, 0.0),
+                 column(dp, dp, dp),
+                 haero::testing::create_column_view(nlev + 1),
+                 column(0.6, 0.0, 0.0), column(0.0, 0.0, 0.0), pblh);
+
+  const ColumnView cldt = column(0.6, 0.0, 0.0);
+  const ColumnView cldn_prev_step = column(0.6, 0.0, 0.0);
+  const ColumnView rprdsh = column(1.0e-8, 0.0, 0.0);
+  const ColumnView rprddp = column(2.0e-8, 0.0, 0.0);
+  const ColumnView evapcdp = column(0.0, 4.0e-9, 0.0);
+  const ColumnView evapcsh = column(0.0, 2.0e-9, 0.0);
+  const ColumnView dp_frac = column(0.1, 0.0, 0.0);
+  const ColumnView sh_frac = column(0.05, 0.0, 0.0);
+  const ColumnView icwmrdp = column(1.0e-4, 0.0, 0.0);
+  const ColumnView icwmrsh = column(5.0e-5, 0.0, 0.0);
+  const ColumnView evapr = column(0.0, 5.0e-9, 0.0);
+  const ColumnView dlf = column(0.0, 0.0, 0.0);
+  const ColumnView prain = column(3.0e-8, 0.0, 0.0);
+
+  // runs aero_model_wetdep on a fresh state
+  auto run = [&](const wetdep::WetdepExecution execution, Tendencies &tends,
+                 const View1D &aerdepwetis, const View1D &aerdepwetcw,
+                 const ColumnSkipStats &skip_stats = ColumnSkipStats(),
+                 const bool allow_column_skip = true) {
+    Prognostics progs = mam4::testing::create_prognostics(nlev);
+    tends = mam4::testing::create_tendencies(nlev);
+    for (int m = 0; m < num_modes; ++m) {
+      Kokkos::deep_copy(progs.n_mode_i[m], 1.0e8);
+      Kokkos::deep_copy(progs.n_mode_c[m], 5.0e7);
+      for (int a = 0; a < num_aer; ++a) {
+        Kokkos::deep_copy(progs.q_aero_i[m][a], 1.0e-9);
+        Kokkos::deep_copy(progs.q_aero_c[m][a], 5.0e-10);
+      }
+    }
+    View2D wet_geometric_mean_diameter_i("dgnumwet", num_modes, nlev);
+    View2D dry_geometric_mean_diameter_i("dgnum", num_modes, nlev);
+    View2D qaerwat("qaerwat", num_modes, nlev);
+    View2D wetdens("wetdens", num_modes, nlev);
+    View1D work("work",
+                wetdep::get_aero_model_wetdep_work_len(execution));
+    Kokkos::parallel_for(
+        ThreadTeamPolicy(1u, Kokkos::AUTO),
+        KOKKOS_LAMBDA(const ThreadTeam &team) {
+          auto progs_in = progs;
+          auto tends_in = tends;
+          wetdep::aero_model_wetdep(
+              team, atm, progs_in, tends_in, dt, cldt, cldn_prev_step,
+              rprdsh, rprddp, evapcdp, evapcsh, dp_frac, sh_frac, icwmrdp,
+              icwmrsh, evapr, dlf, prain, wet_geometric_mean_diameter_i,
+              dry_geometric_mean_diameter_i, qaerwat, wetdens, aerdepwetis,
+              aerdepwetcw, work, execution, skip_stats, allow_column_skip);
+        });
+    Kokkos::fence();
+  };
+
+  // compares the tendencies and surface fluxes of two runs, and returns the
+  // total surface flux of the reference
+  auto compare = [&](const Tendencies &tends_ref, const View1D &aerdepwetis_ref,
+                     const View1D &aerdepwetcw_ref, const Tendencies &tends,
+                     const View1D &aerdepwetis, const View1D &aerdepwetcw,
+                     const bool bitwise) {
+    for (int m = 0; m < num_modes; ++m) {
+      auto h_n_ref = Kokkos::create_mirror_view(tends_ref.n_mode_i[m]);
+      auto h_n = Kokkos::create_mirror_view(tends.n_mode_i[m]);
+      Kokkos::deep_copy(h_n_ref, tends_ref.n_mode_i[m]);
+      Kokkos::deep_copy(h_n, tends.n_mode_i[m]);
+      for (int k = 0; k < nlev; ++k) {
+        if (bitwise)
+          CHECK(h_n(k) == h_n_ref(k));
+        else
+          CHECK(h_n(k) == Approx(h_n_ref(k)));
+      }
+      for (int a = 0; a < num_aer; ++a) {
+        auto h_q_ref = Kokkos::create_mirror_view(tends_ref.q_aero_i[m][a]);
+        auto h_q = Kokkos::create_mirror_view(tends.q_aero_i[m][a]);
+        Kokkos::deep_copy(h_q_ref, tends_ref.q_aero_i[m][a]);
+        Kokkos::deep_copy(h_q, tends.q_aero_i[m][a]);
+        for (int k = 0; k < nlev; ++k) {
+          if (bitwise)
+            CHECK(h_q(k) == h_q_ref(k));
+          else
+            CHECK(h_q(k) == Approx(h_q_ref(k)));
+        }
+      }
+    }
+
+    // the surface fluxes may be summed in a different order
+    auto h_is_ref = Kokkos::create_mirror_view(aerdepwetis_ref);
+    auto h_cw_ref = Kokkos::create_mirror_view(aerdepwetcw_ref);
+    auto h_is = Kokkos::create_mirror_view(aerdepwetis);
+    auto h_cw = Kokkos::create_mirror_view(aerdepwetcw);
+    Kokkos::deep_copy(h_is_ref, aerdepwetis_ref);
+    Kokkos::deep_copy(h_cw_ref, aerdepwetcw_ref);
+    Kokkos::deep_copy(h_is, aerdepwetis);
+    Kokkos::deep_copy(h_cw, aerdepwetcw);
+    Real total_flux = 0;
+    for (int i = 0; i < aero_model::pcnst; ++i) {
+      CHECK(h_is(i) == Approx(h_is_ref(i)));
+      CHECK(h_cw(i) == Approx(h_cw_ref(i)));
+      total_flux += haero::abs(h_is_ref(i)) + haero::abs(h_cw_ref(i));
+    }
+    return total_flux;
+  };
+
+  Tendencies tends_ref = mam4::testing::create_tendencies(nlev);
+  View1D aerdepwetis_ref("aerdepwetis_ref", aero_model::pcnst);
+  View1D aerdepwetcw_ref("aerdepwetcw_ref", aero_model::pcnst);
+  run(wetdep::WetdepExecution::Serial, tends_ref, aerdepwetis_ref,
+      aerdepwetcw_ref);
+
+  Tendencies tends = mam4::testing::create_tendencies(nlev);
+  View1D aerdepwetis("aerdepwetis", aero_model::pcnst);
+  View1D aerdepwetcw("aerdepwetcw", aero_model::pcnst);
+  run(wetdep::WetdepExecution::TracerParallel, tends, aerdepwetis,
+      aerdepwetcw);
+  CHECK(compare(tends_ref, aerdepwetis_ref, aerdepwetcw_ref, tends,
+                aerdepwetis, aerdepwetcw, true) > 0);
+
+  // the scan splits the column into several blocks whatever the team size,
+  // so composing the affine maps of the blocks is exercised on any backend
+  REQUIRE(wetdep::wetdep_scan_num_blocks > 1);
+  run(wetdep::WetdepExecution::LevelScan, tends, aerdepwetis, aerdepwetcw);
+  CHECK(compare(tends_ref, aerdepwetis_ref, aerdepwetcw_ref, tends,
+                aerdepwetis, aerdepwetcw, false) > 0);
+
+  // the column has precipitation, so it is not skipped
+  ColumnSkipStats skip_stats("wetdep_skip_stats");
+  run(wetdep::WetdepExecution::Serial, tends, aerdepwetis, aerdepwetcw,
+      skip_stats);
+  CHECK(compare(tends_ref, aerdepwetis_ref, aerdepwetcw_ref, tends,
+                aerdepwetis, aerdepwetcw, true) > 0);
+  REQUIRE(skip_stats.num_columns() == 1u);
+  REQUIRE(skip_stats.num_skipped() == 0u);
+
+  // convective precipitation production or evaporation alone is wet removal,
+  // so such columns are not skipped
+  for (const ColumnView &rate : {rprddp, evapcdp, evapcsh, evapr, prain})
+    Kokkos::deep_copy(rate, 0.0);
+  run(wetdep::WetdepExecution::Serial, tends, aerdepwetis, aerdepwetcw,
+      skip_stats);
+  REQUIRE(skip_stats.num_columns() == 2u);
+  REQUIRE(skip_stats.num_skipped() == 0u);
+  Kokkos::deep_copy(rprdsh, 0.0);
+  Kokkos::deep_copy(evapcdp, column(0.0, 4.0e-9, 0.0));
+  run(wetdep::WetdepExecution::Serial, tends, aerdepwetis, aerdepwetcw,
+      skip_stats);
+  REQUIRE(skip_stats.num_columns() == 3u);
+  REQUIRE(skip_stats.num_skipped() == 0u);
+
+  // without precipitation the column of nonzero aerosols is skipped, deposits
+  // nothing, and keeps bitwise the tendencies of the full computation
+  Kokkos::deep_copy(evapcdp, 0.0);
+  run(wetdep::WetdepExecution::Serial, tends_ref, aerdepwetis_ref,
+      aerdepwetcw_ref, skip_stats, false);
+  REQUIRE(skip_stats.num_columns() == 4u);
+  REQUIRE(skip_stats.num_skipped() == 0u);
+  run(wetdep::WetdepExecution::Serial, tends, aerdepwetis, aerdepwetcw,
+      skip_stats);
+  REQUIRE(skip_stats.num_columns() == 5u);
+  REQUIRE(skip_stats.num_skipped() == 1u);
+  REQUIRE(skip_stats.skipped_fraction() == Approx(0.2));
+  CHECK(compare(tends_ref, aerdepwetis_ref, aerdepwetcw_ref, tends,
+                aerdepwetis, aerdepwetcw, true) == 0);
+  auto h_is = Kokkos::create_mirror_view(aerdepwetis);
+  auto h_cw = Kokkos::create_mirror_view(aerdepwetcw);
+  Kokkos::deep_copy(h_is, aerdepwetis);
+  Kokkos::deep_copy(h_cw, aerdepwetcw);
+  for (int i = 0; i < aero_model::pcnst; ++i) {
+    CHECK(h_is(i) == 0);
+    CHECK(h_cw(i) == 0);
+  }
+}
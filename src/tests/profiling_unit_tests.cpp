@@ -0,0 +1,85 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <mam4xx/column_batch.hpp>
+#include <mam4xx/mo_setsox.hpp>
+#include <mam4xx/profiling.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+using namespace mam4;
+
+TEST_CASE("timer_registry", "mam4_profiling") {
+  auto &registry = TimerRegistry::instance();
+  registry.reset();
+  REQUIRE(registry.entries().empty());
+
+  registry.add("coagulation", 1.0);
+  registry.add("coagulation", 0.5);
+  registry.add("nucleation", 0.25);
+  REQUIRE(registry.entries().size() == 2);
+  REQUIRE(registry.entries().at("coagulation").calls == 2);
+  REQUIRE(registry.entries().at("coagulation").seconds == 1.5);
+  REQUIRE(registry.entries().at("nucleation").calls == 1);
+
+  std::ostringstream ss;
+  registry.report(ss);
+  REQUIRE(ss.str().find("coagulation: 1.5, 2") != std::string::npos);
+
+  registry.reset();
+  REQUIRE(registry.entries().empty());
+}
+
+TEST_CASE("scoped_region", "mam4_profiling") {
+  auto &registry = TimerRegistry::instance();
+  registry.reset();
+  for (int i = 0; i < 3; ++i) {
+    ScopedRegion region("region");
+  }
+  REQUIRE(registry.entries().at("region").calls == 3);
+  REQUIRE(registry.entries().at("region").seconds >= 0.0);
+
+  // the macro records a region only if profiling is enabled
+  {
+    MAM4XX_PROFILE_REGION("macro region");
+  }
+#ifdef MAM4XX_ENABLE_PROFILING
+  REQUIRE(registry.entries().count("macro region") == 1);
+#else
+  REQUIRE(registry.entries().count("macro region") == 0);
+#endif
+  registry.reset();
+}
+
+TEST_CASE("column_launch_regions", "mam4_profiling") {
+  // the column launchers profile each launch under the name of the function
+  // they run, without going through compute_tendencies_for_columns
+  auto &registry = TimerRegistry::instance();
+  registry.reset();
+  const int ncol = 4;
+  DeviceType::view_1d<int> visits("visits", ncol);
+  for_each_column("launch", ncol, mam4::nlev,
+                  KOKKOS_LAMBDA(const ThreadTeam &team, const int icol) {
+                    Kokkos::single(Kokkos::PerTeam(team),
+                                   [&]() { visits(icol) += 1; });
+                  });
+  mo_setsox::setsox_for_columns(
+      ncol, KOKKOS_LAMBDA(const ThreadTeam &team, const int icol) {
+        Kokkos::single(Kokkos::PerTeam(team), [&]() { visits(icol) += 1; });
+      });
+  const auto visits_h =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), visits);
+  for (int icol = 0; icol < ncol; ++icol)
+    REQUIRE(visits_h(icol) == 2);
+#ifdef MAM4XX_ENABLE_PROFILING
+  REQUIRE(registry.entries().at("launch").calls == 1);
+  REQUIRE(registry.entries().at("setsox").calls == 1);
+#else
+  REQUIRE(registry.entries().empty());
+#endif
+  registry.reset();
+}
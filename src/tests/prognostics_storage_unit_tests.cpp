@@ -0,0 +1,99 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "atmosphere_utils.hpp"
+#include <mam4xx/mam4.hpp>
+#include <mam4xx/prognostics_storage.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <set>
+
+using namespace haero;
+using namespace mam4;
+
+TEST_CASE("storage_rows", "mam4_prognostics_storage") {
+  const int num_modes = AeroConfig::num_modes();
+  const int num_aero = AeroConfig::num_aerosol_ids();
+  const int num_gas = AeroConfig::num_gas_ids();
+
+  // every prognostic field has its own row in the buffer
+  std::set<int> rows;
+  for (int m = 0; m < num_modes; ++m) {
+    rows.insert(PrognosticsStorage::num_index(m));
+    rows.insert(pcnst + PrognosticsStorage::num_index(m));
+    for (int a = 0; a < num_aero; ++a) {
+      rows.insert(PrognosticsStorage::aero_index(m, a));
+      rows.insert(PrognosticsStorage::cloudborne_aero_index(m, a));
+    }
+  }
+  for (int g = 0; g < num_gas; ++g) {
+    rows.insert(PrognosticsStorage::gas_index(g));
+    rows.insert(PrognosticsStorage::gas_avg_index(g));
+    for (int m = 0; m < num_modes; ++m)
+      rows.insert(PrognosticsStorage::uptkaer_index(g, m));
+  }
+  const int num_fields = 2 * num_modes + 2 * num_modes * num_aero +
+                         2 * num_gas + num_gas * num_modes;
+  REQUIRE(int(rows.size()) == num_fields);
+  REQUIRE(*rows.begin() >= 0);
+  REQUIRE(*rows.rbegin() < PrognosticsStorage::num_tracers());
+}
+
+TEST_CASE("zero_copy_views", "mam4_prognostics_storage") {
+  const int nlev = 72;
+  PrognosticsStorage storage(nlev);
+  Prognostics progs = storage.prognostics();
+  REQUIRE(progs.num_levels() == nlev);
+  REQUIRE(storage.num_levels() == nlev);
+
+  // fill each field with a distinct value through the Prognostics views
+  const int num_modes = AeroConfig::num_modes();
+  const int num_aero = AeroConfig::num_aerosol_ids();
+  const int num_gas = AeroConfig::num_gas_ids();
+  for (int m = 0; m < num_modes; ++m) {
+    Kokkos::deep_copy(progs.n_mode_i[m], 1.0e6 * (m + 1));
+    Kokkos::deep_copy(progs.n_mode_c[m], 2.0e6 * (m + 1));
+    for (int a = 0; a < num_aero; ++a) {
+      Kokkos::deep_copy(progs.q_aero_i[m][a], 1.0e-9 * (num_aero * m + a + 1));
+      Kokkos::deep_copy(progs.q_aero_c[m][a], 2.0e-9 * (num_aero * m + a + 1));
+    }
+  }
+  for (int g = 0; g < num_gas; ++g)
+    Kokkos::deep_copy(progs.q_gas[g], 1.0e-12 * (g + 1));
+
+  // the state_q and qqcw views of the storage hold the same values as the
+  // arrays assembled by the extract functions
+  Atmosphere atm = init_atm_const_tv_lapse_rate(nlev, 1000, 300, 0.01, 0.015,
+                                                7.5e-4);
+  int mismatches = 0;
+  Kokkos::parallel_reduce(
+      "check_state_q", nlev,
+      KOKKOS_LAMBDA(const int k, int &nbad) {
+        Real state_q[pcnst] = {};
+        Real qqcw[pcnst] = {};
+        utils::extract_stateq_from_prognostics(progs, atm, state_q, k);
+        utils::extract_qqcw_from_prognostics(progs, qqcw, k);
+        const auto q_k = storage.state_q(k);
+        const auto qqcw_k = storage.qqcw(k);
+        for (int i = utils::gasses_start_ind(); i < pcnst; ++i) {
+          if (q_k(i) != state_q[i])
+            ++nbad;
+        }
+        for (int i = utils::aero_start_ind(); i < pcnst; ++i) {
+          if (qqcw_k(i) != qqcw[i])
+            ++nbad;
+        }
+      },
+      mismatches);
+  REQUIRE(mismatches == 0);
+
+  // writes through the storage are visible through the Prognostics views
+  Kokkos::deep_copy(storage.data(), 0.0);
+  auto h_num = Kokkos::create_mirror_view(progs.n_mode_i[0]);
+  Kokkos::deep_copy(h_num, progs.n_mode_i[0]);
+  for (int k = 0; k < nlev; ++k)
+    REQUIRE(h_num(k) == 0.0);
+}
@@ -60,6 +60,13 @@ Diagnostics create_diagnostics(int num_levels) {
     d.uptkrate_h2so4 = create_column_view(num_levels);
     Kokkos::deep_copy(d.uptkrate_h2so4, 0.0);
 
+    d.uptkaer_ref[mode] = create_column_view(num_levels);
+    d.uptkaer_ref_wet_diameter[mode] = create_column_view(num_levels);
+    d.uptkaer_ref_temperature = create_column_view(num_levels);
+    Kokkos::deep_copy(d.uptkaer_ref[mode], 0.0);
+    Kokkos::deep_copy(d.uptkaer_ref_wet_diameter[mode], 0.0);
+    Kokkos::deep_copy(d.uptkaer_ref_temperature, 0.0);
+
     d.g0_soa_out = create_column_view(num_levels);
     Kokkos::deep_copy(d.g0_soa_out, 0.0);
 
@@ -0,0 +1,137 @@
+// mam4xx: Copyright (c) 2022,
+// Battelle Memorial Institute and
+// National Technology & Engineering Solutions of Sandia, LLC (NTESS)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <mam4xx/mam4.hpp>
+#include <mam4xx/work_memory.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace mam4;
+
+namespace {
+
+// fills each team's work array with values that depend on the team, then
+// returns the number of values that were overwritten by another team
+int count_overlaps(const TeamWorkMemory &work_memory, const int num_teams) {
+  const int n = work_memory.work_len();
+  const auto policy = work_memory.configure(
+      column_batch_team_policy(num_teams, mam4::nlev));
+  int overlaps = 0;
+  Kokkos::parallel_reduce(
+      policy,
+      KOKKOS_LAMBDA(const ThreadTeam &team, int &nbad) {
+        const auto work = work_memory.get(team);
+        const Real offset = 1000.0 * team.league_rank();
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, n),
+                             [&](int i) { work(i) = offset + i; });
+        team.team_barrier();
+        int team_bad = 0;
+        Kokkos::parallel_reduce(
+            Kokkos::TeamThreadRange(team, n),
+            [&](int i, int &bad) {
+              if (work(i) != offset + i)
+                ++bad;
+            },
+            team_bad);
+        Kokkos::single(Kokkos::PerTeam(team), [&]() { nbad += team_bad; });
+      },
+      overlaps);
+  return overlaps;
+}
+
+} // namespace
+
+TEST_CASE("work_lengths", "mam4_work_memory") {
+  REQUIRE(wetdep::get_aero_model_wetdep_work_len() > 0);
+  REQUIRE(modal_aer_opt::get_work_len_aerosol_optics() > 0);
+  REQUIRE(ndrop::get_dropmixnuc_work_len() > 0);
+}
+
+TEST_CASE("scratch_memory", "mam4_work_memory") {
+  const int work_len = 200, num_teams = 16;
+  const auto policy = column_batch_team_policy(num_teams, mam4::nlev);
+  TeamWorkMemory work_memory(work_len, policy);
+  const std::size_t bytes = TeamWorkMemory::bytes_per_team(work_len);
+  REQUIRE(bytes >= work_len * sizeof(Real));
+  if (policy.team_scratch_size(0) + bytes <=
+      TeamWorkMemory::scratch_size_max(0)) {
+    REQUIRE(work_memory.location() == TeamWorkMemory::Location::Scratch0);
+  }
+  if (work_memory.location() != TeamWorkMemory::Location::Arena) {
+    REQUIRE(work_memory.scratch_bytes_per_team() == bytes);
+  }
+  REQUIRE(count_overlaps(work_memory, num_teams) == 0);
+}
+
+TEST_CASE("requested_scratch_memory", "mam4_work_memory") {
+  // a launch that already requests all but a few Reals of level 0 scratch
+  // memory leaves no room there for the work arrays
+  const int work_len = 200, num_teams = 16;
+  const std::size_t bytes = TeamWorkMemory::bytes_per_team(work_len);
+  const std::size_t max0 = TeamWorkMemory::scratch_size_max(0);
+  if (max0 >= bytes) {
+    const auto policy =
+        haero::ThreadTeamPolicy(num_teams, Kokkos::AUTO)
+            .set_scratch_size(0, Kokkos::PerTeam(max0 - bytes / 2));
+    TeamWorkMemory work_memory(work_len, policy);
+    REQUIRE(work_memory.location() != TeamWorkMemory::Location::Scratch0);
+    const auto configured = work_memory.configure(policy);
+    REQUIRE(std::size_t(configured.team_scratch_size(0)) <= max0);
+  }
+}
+
+TEST_CASE("column_batch_work_memory", "mam4_work_memory") {
+  // the work memory of the column-batch launchers sits on top of the active
+  // levels requested by column_batch_team_policy
+  const int num_columns = 8;
+  for (const int work_len : {wetdep::get_aero_model_wetdep_work_len(),
+                             modal_aer_opt::get_work_len_aerosol_optics(),
+                             ndrop::get_dropmixnuc_work_len()}) {
+    const auto work_memory =
+        column_batch_work_memory(work_len, num_columns, mam4::nlev);
+    const auto policy = column_batch_team_policy(num_columns, mam4::nlev);
+    if (work_memory.location() != TeamWorkMemory::Location::Arena) {
+      const int level =
+          (work_memory.location() == TeamWorkMemory::Location::Scratch0) ? 0
+                                                                          : 1;
+      REQUIRE(policy.team_scratch_size(level) +
+                  work_memory.scratch_bytes_per_team() <=
+              TeamWorkMemory::scratch_size_max(level));
+    }
+
+    // every column writes its own work array
+    DeviceType::view_1d<int> nbad("nbad", num_columns);
+    for_each_column("work_memory_test", num_columns, mam4::nlev, work_memory,
+                    KOKKOS_LAMBDA(const ThreadTeam &team, const int icol,
+                                  const TeamWorkMemory::WorkView &work) {
+                      const Real offset = 1000.0 * icol;
+                      Kokkos::parallel_for(
+                          Kokkos::TeamThreadRange(team, work_len),
+                          [&](int i) { work(i) = offset + i; });
+                      team.team_barrier();
+                      Kokkos::single(Kokkos::PerTeam(team), [&]() {
+                        for (int i = 0; i < work_len; ++i)
+                          if (work(i) != offset + i)
+                            ++nbad(icol);
+                      });
+                    });
+    const auto nbad_h =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), nbad);
+    for (int icol = 0; icol < num_columns; ++icol)
+      REQUIRE(nbad_h(icol) == 0);
+  }
+}
+
+TEST_CASE("arena_memory", "mam4_work_memory") {
+  // dropmixnuc's work arrays, forced into the global-memory arena
+  const int work_len = ndrop::get_dropmixnuc_work_len(), num_teams = 16;
+  TeamWorkMemory work_memory(
+      work_len, column_batch_team_policy(num_teams, mam4::nlev), false);
+  REQUIRE(work_memory.location() == TeamWorkMemory::Location::Arena);
+  REQUIRE(work_memory.scratch_bytes_per_team() == 0);
+  REQUIRE(count_overlaps(work_memory, num_teams) == 0);
+  // the arena is reused by later launches
+  REQUIRE(count_overlaps(work_memory, num_teams / 2) == 0);
+}
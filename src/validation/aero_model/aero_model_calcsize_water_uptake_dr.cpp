@@ -18,8 +18,6 @@ void aero_model_calcsize_water_uptake_dr(Ensemble *ensemble) {
     constexpr int pcnst = aero_model::pcnst;
     constexpr int pver = ndrop::pver;
     constexpr int ntot_amode = AeroConfig::num_modes();
-    constexpr int nspec_max = ndrop::nspec_max;
-    constexpr int maxd_aspectype = ndrop::maxd_aspectype;
 
     using View2D = DeviceType::view_2d<Real>;
     constexpr Real zero = 0.0;
@@ -75,49 +73,9 @@ void aero_model_calcsize_water_uptake_dr(Ensemble *ensemble) {
     auto team_policy = ThreadTeamPolicy(1u, Kokkos::AUTO);
     Kokkos::parallel_for(
         team_policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
-          Real inv_density[AeroConfig::num_modes()]
-                          [AeroConfig::num_aerosol_ids()] = {};
-          Real num2vol_ratio_min[AeroConfig::num_modes()] = {};
-          Real num2vol_ratio_max[AeroConfig::num_modes()] = {};
-          Real num2vol_ratio_max_nmodes[AeroConfig::num_modes()] = {};
-          Real num2vol_ratio_min_nmodes[AeroConfig::num_modes()] = {};
-          Real num2vol_ratio_nom_nmodes[AeroConfig::num_modes()] = {};
-          Real dgnmin_nmodes[AeroConfig::num_modes()] = {};
-          Real dgnmax_nmodes[AeroConfig::num_modes()] = {};
-          Real dgnnom_nmodes[AeroConfig::num_modes()] = {};
-          Real mean_std_dev_nmodes[AeroConfig::num_modes()] = {};
-          // outputs
-          bool noxf_acc2ait[AeroConfig::num_aerosol_ids()] = {};
-          int n_common_species_ait_accum = {};
-          int ait_spec_in_acc[AeroConfig::num_aerosol_ids()] = {};
-          int acc_spec_in_ait[AeroConfig::num_aerosol_ids()] = {};
-
-          modal_aero_calcsize::init_calcsize(
-              inv_density, num2vol_ratio_min, num2vol_ratio_max,
-              num2vol_ratio_max_nmodes, num2vol_ratio_min_nmodes,
-              num2vol_ratio_nom_nmodes, dgnmin_nmodes, dgnmax_nmodes,
-              dgnnom_nmodes, mean_std_dev_nmodes,
-              // outputs
-              noxf_acc2ait, n_common_species_ait_accum, ait_spec_in_acc,
-              acc_spec_in_ait);
-
-          const bool do_adjust = true;
-          const bool do_aitacc_transfer = true;
+          const modal_aero_calcsize::CalcsizeWaterUptakeParams params;
           const bool update_mmr = true;
 
-          int nspec_amode[ntot_amode];
-          int lspectype_amode[maxd_aspectype][ntot_amode];
-          int lmassptr_amode[maxd_aspectype][ntot_amode];
-          Real specdens_amode[maxd_aspectype];
-          Real spechygro[maxd_aspectype];
-          int numptr_amode[ntot_amode];
-          int mam_idx[ntot_amode][nspec_max];
-          int mam_cnst_idx[ntot_amode][nspec_max];
-
-          ndrop::get_e3sm_parameters(
-              nspec_amode, lspectype_amode, lmassptr_amode, numptr_amode,
-              specdens_amode, spechygro, mam_idx, mam_cnst_idx);
-
           // FIXME: top_lev is set to 1 in calcsize ?
           const int top_lev = 0; // 1( in fortran )
 
@@ -133,35 +91,19 @@ void aero_model_calcsize_water_uptake_dr(Ensemble *ensemble) {
                     Kokkos::subview(ptend_q, kk, Kokkos::ALL());
                 const auto dqqcwdt_k =
                     Kokkos::subview(dqqcwdt, kk, Kokkos::ALL());
-                modal_aero_calcsize::modal_aero_calcsize_sub(
-                    state_q_k.data(), // in
-                    qqcw_k.data(),    // in/out
-                    dt, do_adjust, do_aitacc_transfer, update_mmr,
-                    lmassptr_amode, numptr_amode,
-                    inv_density, // in
-                    num2vol_ratio_min, num2vol_ratio_max,
-                    num2vol_ratio_max_nmodes, num2vol_ratio_min_nmodes,
-                    num2vol_ratio_nom_nmodes, dgnmin_nmodes, dgnmax_nmodes,
-                    dgnnom_nmodes, mean_std_dev_nmodes, noxf_acc2ait,
-                    n_common_species_ait_accum, ait_spec_in_acc,
-                    acc_spec_in_ait,
-                    // outputs
-                    dgncur_i.data(), dgncur_c, ptend_q_k.data(),
-                    dqqcwdt_k.data());
-
                 const auto dgnumwet_kk =
                     Kokkos::subview(dgnumwet, kk, Kokkos::ALL());
-
                 const auto qaerwat_kk =
                     Kokkos::subview(qaerwat, kk, Kokkos::ALL());
-
                 const auto wetdens_kk =
                     Kokkos::subview(wetdens, kk, Kokkos::ALL());
 
-                mam4::water_uptake::modal_aero_water_uptake_dr(
-                    nspec_amode, specdens_amode, spechygro, lspectype_amode,
-                    state_q_k.data(), temperature(kk), pmid(kk), cldn(kk),
-                    dgncur_i.data(), dgnumwet_kk.data(), qaerwat_kk.data(),
+                modal_aero_calcsize::modal_aero_calcsize_water_uptake_dr(
+                    params, state_q_k.data(), qqcw_k.data(), dt, update_mmr,
+                    temperature(kk), pmid(kk), cldn(kk),
+                    // outputs
+                    dgncur_i.data(), dgncur_c, ptend_q_k.data(),
+                    dqqcwdt_k.data(), dgnumwet_kk.data(), qaerwat_kk.data(),
                     wetdens_kk.data());
 
                 if (update_mmr) {
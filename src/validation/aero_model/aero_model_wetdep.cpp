@@ -137,14 +137,14 @@ void aero_model_wetdep(Ensemble *ensemble) {
     wetdep::View2D ptend_q("ptend_q", nlev, aero_model::pcnst);
 
     // work arrays
-    const int work_len = wetdep::get_aero_model_wetdep_work_len();
-    wetdep::View1D work("work", work_len);
+    const auto work_memory = wetdep::aero_model_wetdep_work_memory(1);
     std::cout << "aero_model_wetdep : "
               << "\n";
 
-    auto team_policy = ThreadTeamPolicy(1u, Kokkos::AUTO);
-    Kokkos::parallel_for(
-        team_policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
+    wetdep::aero_model_wetdep_for_columns(
+        1, work_memory,
+        KOKKOS_LAMBDA(const ThreadTeam &team, const int,
+                      const wetdep::View1D &work) {
           auto progs_in = progs;
           auto tends_in = tends;
 
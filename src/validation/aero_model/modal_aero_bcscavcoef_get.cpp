@@ -21,10 +21,10 @@ void modal_aero_bcscavcoef_get(Ensemble *ensemble) {
     auto scavimptblvol_vector = input.get_array("scavimptblvol");
     auto scavimptblnum_vector = input.get_array("scavimptblnum");
 
-    Real scavimptblvol[aero_model::nimptblgrow_total][AeroConfig::num_modes()] =
-        {{}};
-    Real scavimptblnum[aero_model::nimptblgrow_total][AeroConfig::num_modes()] =
-        {{}};
+    TableReal scavimptblvol[aero_model::nimptblgrow_total]
+                           [AeroConfig::num_modes()] = {{}};
+    TableReal scavimptblnum[aero_model::nimptblgrow_total]
+                           [AeroConfig::num_modes()] = {{}};
 
     // Note:  scavimptblvol_vector and scavimptblnum_vector were written in
     // row-major order.
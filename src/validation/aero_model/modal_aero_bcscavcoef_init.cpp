@@ -17,10 +17,10 @@ void modal_aero_bcscavcoef_init(Ensemble *ensemble) {
     auto dgnum_amode = input.get_array("dgnum_amode");
     auto sigmag_amode = input.get_array("sigmag_amode");
 
-    Real scavimptblnum[aero_model::nimptblgrow_total][AeroConfig::num_modes()] =
-        {{}};
-    Real scavimptblvol[aero_model::nimptblgrow_total][AeroConfig::num_modes()] =
-        {{}};
+    TableReal scavimptblnum[aero_model::nimptblgrow_total]
+                           [AeroConfig::num_modes()] = {{}};
+    TableReal scavimptblvol[aero_model::nimptblgrow_total]
+                           [AeroConfig::num_modes()] = {{}};
 
     Real aerosol_dry_density[AeroConfig::num_modes()] = {};
     // Note: Original code uses the following aerosol densities.
@@ -20,7 +20,7 @@ void aer_rad_props_lw(Ensemble *ensemble) {
     constexpr int pver = mam4::nlev;
     constexpr int maxd_aspectype = ndrop::maxd_aspectype;
     using View1DHost = typename HostType::view_1d<Real>;
-    using View3DHost = typename HostType::view_3d<Real>;
+    using View3DHost = typename HostType::view_3d<TableReal>;
     constexpr Real zero = 0;
 
     const auto dt = input.get_array("dt")[0];
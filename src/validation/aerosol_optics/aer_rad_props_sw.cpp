@@ -18,7 +18,7 @@ using namespace ndrop;
 void aer_rad_props_sw(Ensemble *ensemble) {
   ensemble->process([=](const Input &input, Output &output) {
     using View1DHost = typename HostType::view_1d<Real>;
-    using View3DHost = typename HostType::view_3d<Real>;
+    using View3DHost = typename HostType::view_3d<TableReal>;
     constexpr Real zero = 0;
 
     constexpr int maxd_aspectype = ndrop::maxd_aspectype;
@@ -40,7 +40,7 @@ void binterp(Ensemble *ensemble) {
     int prefr = 7;
     int prefi = 10;
 
-    View3D table("table", ncoef, prefr, prefi);
+    TableView3D table("table", ncoef, prefr, prefi);
     auto table_host = Kokkos::create_mirror_view(table);
 
     int N1 = ncoef;
@@ -18,7 +18,7 @@ using namespace ndrop;
 void modal_aero_sw(Ensemble *ensemble) {
   ensemble->process([=](const Input &input, Output &output) {
     using View1DHost = typename HostType::view_1d<Real>;
-    using View3DHost = typename HostType::view_3d<Real>;
+    using View3DHost = typename HostType::view_3d<TableReal>;
     constexpr Real zero = 0;
 
     constexpr int maxd_aspectype = ndrop::maxd_aspectype;
@@ -241,12 +241,11 @@ void modal_aero_sw(Ensemble *ensemble) {
     View2D output_diagnostics_amode("output_diagnostics_amode", 3, ntot_amode);
 
     View2D qaerwat_m("qaerwat_m", pver, ntot_amode);
-    const int work_len = modal_aer_opt::get_work_len_aerosol_optics();
-    View1D work("work", work_len);
+    const auto work_memory = modal_aer_opt::modal_aero_sw_work_memory(1);
 
-    auto team_policy = ThreadTeamPolicy(1u, Kokkos::AUTO);
-    Kokkos::parallel_for(
-        team_policy, KOKKOS_LAMBDA(const ThreadTeam &team) {
+    modal_aer_opt::modal_aero_sw_for_columns(
+        1, work_memory,
+        KOKKOS_LAMBDA(const ThreadTeam &team, const int, const View1D &work) {
           modal_aero_sw(team, dt, state_q, qqcw, state_zm, temperature, pmid,
                         pdel, pdeldry, cldn,
                         // outputs
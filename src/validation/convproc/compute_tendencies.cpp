@@ -100,6 +100,8 @@ void compute_tendencies(Ensemble *ensemble) {
     convproc_config.convproc_do_aer = true;
     convproc_config.convproc_do_gas = false;
     convproc_config.nlev = nlev;
+    // use the cloud top and bottom of the Fortran reference
+    convproc_config.detect_convective_extent = false;
     convproc_config.ktop = ktop;
     convproc_config.kbot = kbot;
 
@@ -0,0 +1,68 @@
+# This script reports the drift of mam4xx's results from a (double-precision)
+# baseline. It is used in place of the usual comparison scripts when mam4xx is
+# configured with MAM4XX_SINGLE_PRECISION_TABLES=ON, in which case results that
+# depend on lookup tables are not expected to match the baselines to the
+# tolerances used in double precision.
+
+import os, sys, importlib, itertools
+import numpy as np
+
+# Look for data in whatever directory we're running in.
+sys.path.append(os.getcwd())
+
+def usage():
+    """Provides usage info."""
+    print('report_drift.py: reports the drift of outputs from a baseline.')
+    print('usage: python3 report_drift.py <module.py> <baseline.py> [max_rel_drift]')
+
+def to_array(values, pad_token=0):
+    """to_array(values) - Returns a flattened numpy array of the given values,
+    padding ragged lists with pad_token."""
+    if type(values) is list and 0 < len(values) and type(values[0]) is list :
+        values = [list(i) for i in \
+                  zip(*itertools.zip_longest(*values, fillvalue=pad_token))]
+    return np.array(values, dtype=float).ravel()
+
+def drift(x_comp, x_ref):
+    """drift(x_comp, x_ref) - Returns the largest absolute difference between
+    x_comp and x_ref, and that difference relative to the largest magnitude
+    in x_ref."""
+    max_abs = np.abs(np.subtract(x_comp, x_ref)).max(initial=0)
+    scale = np.abs(x_ref).max(initial=0)
+    if scale == 0:
+        scale = np.abs(x_comp).max(initial=0)
+    max_rel = max_abs / scale if scale > 0 else 0
+    return (max_abs, max_rel)
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        usage()
+        exit(0)
+
+    # Import the given data modules.
+    data = importlib.import_module(sys.argv[1].replace('.py', ''))
+    baseline = importlib.import_module(sys.argv[2].replace('.py', ''))
+
+    # Default: report the drift without checking it.
+    max_rel_drift = np.inf
+    if len(sys.argv) > 3:
+        max_rel_drift = float(sys.argv[3])
+
+    output_names = [o_name for o_name in dir(baseline.output) \
+                    if not o_name.startswith('_') \
+                    and not o_name.endswith('_')]
+
+    print('%-32s %14s %14s' % ('output', 'max abs drift', 'max rel drift'))
+    worst = 0
+    for o_name in output_names:
+        o1 = to_array(getattr(data.output, o_name))
+        o2 = to_array(getattr(baseline.output, o_name))
+        if o1.shape != o2.shape:
+            print('%-32s shape mismatch: %s vs %s' % (o_name, o1.shape, o2.shape))
+            exit(1)
+        max_abs, max_rel = drift(o1, o2)
+        print('%-32s %14.6e %14.6e' % (o_name, max_abs, max_rel))
+        worst = max(worst, max_rel)
+
+    print('largest relative drift: %e' % worst)
+    assert(worst <= max_rel_drift)